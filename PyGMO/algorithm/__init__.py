@@ -575,6 +575,37 @@ def _spea2_ctor(self, gen=100, cr = 0.95, eta_c = 10, m = 0.01, eta_m = 50, arch
 spea2._orig_init = spea2.__init__
 spea2.__init__ = _spea2_ctor
 
+_algorithm.async_evolution.DE = _algorithm._async_generator_type.DE
+_algorithm.async_evolution.PSO = _algorithm._async_generator_type.PSO
+_algorithm.async_evolution.SGA = _algorithm._async_generator_type.SGA
+def _async_evolution_ctor(self, n_eval = 1000, generator = async_evolution.DE, n_threads = 1, n_in_flight = 0, screen_output = False):
+	"""
+	Constructs an Asynchronous steady-state evolution
+	
+	Keeps n_in_flight candidates under evaluation on n_threads threads and, each time an evaluation completes,
+	inserts the result in the population and dispatches a new candidate built from the current population.
+	
+	USAGE: algorithm.async_evolution(n_eval = 1000, generator = async_evolution.DE, n_threads = 1, n_in_flight = 0, screen_output = False)
+	
+	* n_eval: number of evaluations per call to evolve
+	* generator: generator of the candidates (async_evolution.DE, async_evolution.PSO or async_evolution.SGA)
+	* n_threads: number of threads evaluating the candidates
+	* n_in_flight: number of candidates kept under evaluation (0 means twice n_threads)
+	* screen_output: activates screen output
+	
+	The throughput of the last evolve is available in the evaluations_per_second and idle_fraction attributes.
+	"""
+	# We set the defaults or the kwargs
+	arg_list=[]
+	arg_list.append(n_eval)
+	arg_list.append(generator)
+	arg_list.append(n_threads)
+	arg_list.append(n_in_flight)
+	self._orig_init(*arg_list)
+	self.screen_output = screen_output
+async_evolution._orig_init = async_evolution.__init__
+async_evolution.__init__ = _async_evolution_ctor
+
 def _sa_corana_ctor(self, iter = 10000, Ts = 10, Tf = .1, steps = 1, bin_size = 20, range = 1):
 	"""
 	Constructs Corana's Simulated Annealing
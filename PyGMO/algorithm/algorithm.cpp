@@ -251,7 +251,10 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.add_property("cmu",&algorithm::cmaes::get_cmu,&algorithm::cmaes::set_cmu)
 		.add_property("sigma",&algorithm::cmaes::get_sigma,&algorithm::cmaes::set_sigma)
 		.add_property("ftol",&algorithm::cmaes::get_ftol,&algorithm::cmaes::set_ftol)
-		.add_property("xtol",&algorithm::cmaes::get_xtol,&algorithm::cmaes::set_xtol);
+		.add_property("xtol",&algorithm::cmaes::get_xtol,&algorithm::cmaes::set_xtol)
+		.add_property("n_threads",&algorithm::cmaes::get_n_threads,&algorithm::cmaes::set_n_threads)
+		.add_property("eigen_lag",&algorithm::cmaes::get_eigen_lag,&algorithm::cmaes::set_eigen_lag)
+		.add_property("separable",&algorithm::cmaes::get_separable,&algorithm::cmaes::set_separable);
 
 	// Monte-carlo.
 	algorithm_wrapper<algorithm::monte_carlo>("monte_carlo","Monte-Carlo search.")
@@ -273,7 +276,10 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	algorithm_wrapper<algorithm::mbh>("mbh","Monotonic Basin Hopping.")
 		.def(init<optional<const algorithm::base &,int, double> >())
 		.def(init<optional<const algorithm::base &,int, const std::vector<double> &> >())
-		.add_property("algorithm",&algorithm::mbh::get_algorithm,&algorithm::mbh::set_algorithm);
+		.add_property("algorithm",&algorithm::mbh::get_algorithm,&algorithm::mbh::set_algorithm)
+		.add_property("n_trials",&algorithm::mbh::get_n_trials,&algorithm::mbh::set_n_trials)
+		.add_property("n_threads",&algorithm::mbh::get_n_threads,&algorithm::mbh::set_n_threads)
+		.add_property("target",&algorithm::mbh::get_target,&algorithm::mbh::set_target);
 	
 	// Constraints immune system.
 	algorithm_wrapper<algorithm::cstrs_immune_system>("cstrs_immune_system","Constraints immune system.")
@@ -290,7 +296,9 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	// Multistart.
 	algorithm_wrapper<algorithm::ms>("ms","Multistart.")
 		.def(init<const algorithm::base &, int>())
-		.add_property("algorithm",&algorithm::ms::get_algorithm,&algorithm::ms::set_algorithm);
+		.add_property("algorithm",&algorithm::ms::get_algorithm,&algorithm::ms::set_algorithm)
+		.add_property("n_threads",&algorithm::ms::get_n_threads,&algorithm::ms::set_n_threads)
+		.add_property("target",&algorithm::ms::get_target,&algorithm::ms::set_target);
 
 	// Constraints Co-Evolution.
 	algorithm_wrapper<algorithm::cstrs_co_evolution>("cstrs_co_evolution","Constraints Co-Evolution.")
@@ -365,12 +373,23 @@ BOOST_PYTHON_MODULE(_algorithm) {
 	algorithm_wrapper<algorithm::spea2>("spea2", "Strength Pareto Evolutionary Algorithm 2")
 		.def(init<optional<int, double, double, double, double, population::size_type> >());
 
+	// Asynchronous steady-state evolution.
+	enum_<algorithm::async_evolution::generator_type>("_async_generator_type")
+		.value("DE", algorithm::async_evolution::DE)
+		.value("PSO", algorithm::async_evolution::PSO)
+		.value("SGA", algorithm::async_evolution::SGA);
+	algorithm_wrapper<algorithm::async_evolution>("async_evolution", "Asynchronous steady-state evolution")
+		.def(init<optional<int, algorithm::async_evolution::generator_type, unsigned int, unsigned int> >())
+		.add_property("evaluations_per_second",&algorithm::async_evolution::get_evaluations_per_second)
+		.add_property("idle_fraction",&algorithm::async_evolution::get_idle_fraction);
+
 
 	// Differential evolution.
 	algorithm_wrapper<algorithm::de>("de", "Differential evolution algorithm.\n")
 		.def(init<optional<int,const double &, const double &, int, double, double> >())
 		.add_property("cr",&algorithm::de::get_cr,&algorithm::de::set_cr)
-		.add_property("f",&algorithm::de::get_f,&algorithm::de::set_f);
+		.add_property("f",&algorithm::de::get_f,&algorithm::de::set_f)
+		.add_property("n_threads",&algorithm::de::get_n_threads,&algorithm::de::set_n_threads);
 
 	// Differential evolution (jDE)
 	algorithm_wrapper<algorithm::jde>("jde", "Self-Adaptive Differential Evolution Algorithm: jDE.\n")
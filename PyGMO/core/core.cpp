@@ -120,6 +120,32 @@ inline static void archipelago_set_algorithm(archipelago &archi, int n, const al
 	archi.set_algorithm(boost::numeric_cast<archipelago::size_type>(n),a);
 }
 
+// Migration log of the archipelago, as a list of (timestamp,src,dst,count,best_f) tuples.
+inline static boost::python::list archipelago_get_migr_log(const archipelago &a)
+{
+	boost::python::list retval;
+	const std::vector<migration_log::record> records(a.get_migr_log().get_records());
+	for (std::vector<migration_log::record>::const_iterator it = records.begin(); it != records.end(); ++it) {
+		retval.append(boost::python::make_tuple((*it).timestamp,(*it).src,(*it).dst,(*it).count,(*it).best_f));
+	}
+	return retval;
+}
+
+inline static void archipelago_set_migr_log_capacity(archipelago &a, int n)
+{
+	a.get_migr_log().set_capacity(boost::numeric_cast<std::size_t>(n));
+}
+
+inline static void archipelago_open_migr_log_sink(archipelago &a, const std::string &path)
+{
+	a.get_migr_log().open_sink(path);
+}
+
+inline static void archipelago_close_migr_log_sink(archipelago &a)
+{
+	a.get_migr_log().close_sink();
+}
+
 inline static population::individual_type population_get_individual(const population &pop, int n)
 {
 	return pop.get_individual(boost::numeric_cast<population::size_type>(n));
@@ -130,11 +156,21 @@ inline static void population_set_x(population &pop, int n, const decision_vecto
 	pop.set_x(boost::numeric_cast<population::size_type>(n),x);
 }
 
+inline static void population_push_back(population &pop, const decision_vector &x)
+{
+	pop.push_back(x);
+}
+
 inline static void population_set_v(population &pop, int n, const decision_vector &v)
 {
 	pop.set_v(boost::numeric_cast<population::size_type>(n),v);
 }
 
+inline static void population_reinit(population &pop, population::init_type type, unsigned int n_threads, const std::vector<decision_vector> &seeds)
+{
+	pop.reinit(type,n_threads,seeds);
+}
+
 inline static void population_repair(population &pop, const int &idx, const algorithm::base_ptr &repair_algo)
 {
 	pop.repair(boost::numeric_cast<population::size_type>(idx),repair_algo);
@@ -277,9 +313,12 @@ BOOST_PYTHON_MODULE(_core)
 
 	typedef population::size_type (population::*get_best_1_idx)() const;
 	typedef std::vector<population::size_type> (population::*get_best_N_idx)(const population::size_type& N) const;
+	typedef population::size_type (population::*get_worst_1_idx)() const;
+	typedef std::vector<population::size_type> (population::*get_worst_N_idx)(const population::size_type& N) const;
 
 
 	class_<population>("population", "Population class.", init<const problem::base &,optional<int, boost::uint32_t> >())
+		.def(init<const problem::base &, int, population::init_type, optional<unsigned int, boost::uint32_t> >())
 		.def(init<const population &>())
 		.def("__copy__", &Py_copy_from_ctor<population>)
 		.def("__deepcopy__", &Py_deepcopy_from_ctor<population>)
@@ -297,18 +336,29 @@ BOOST_PYTHON_MODULE(_core)
 //		.def("update_pareto_information",&population::update_pareto_information, "updates crowding distance and front informations")
 		.def("get_best_idx",get_best_1_idx(&population::get_best_idx),"Get index of best individual.")
 		.def("get_best_idx",get_best_N_idx(&population::get_best_idx),"Get index of best N individual.")
-		.def("get_worst_idx",&population::get_worst_idx,"Get index of worst individual.")
+		.def("get_worst_idx",get_worst_1_idx(&population::get_worst_idx),"Get index of worst individual.")
+		.def("get_worst_idx",get_worst_N_idx(&population::get_worst_idx),"Get index of worst N individual.")
 		.def("set_x", &population_set_x,"Set decision vector of individual at position n.")
 		.def("set_v", &population_set_v,"Set velocity of individual at position n.")
-		.def("push_back", &population::push_back,"Append individual with given decision vector at the end of the population.")
+		.def("push_back", &population_push_back,"Append individual with given decision vector at the end of the population.")
 		.def("erase", &population::erase, "Erase individual at position")
 		.def("mean_velocity", &population::mean_velocity, "Calculates the mean velocity across particles")
 		.def("race", &race_return_tuple, "Race the individuals")
 		.def("repair", &population_repair, "Repair the individual at the given index")
+		.def("reinit", &population_reinit, "Re-initialise all individuals with the given strategy, number of threads and seed decision vectors")
+		.def("load_decision_vectors", &population::load_decision_vectors, "Read decision vectors from a text file")
+		.staticmethod("load_decision_vectors")
 		.def("cpp_loads", &py_cpp_loads<population>)
 		.def("cpp_dumps", &py_cpp_dumps<population>)
 		.def_pickle(population_pickle_suite());
 
+	// Population's initialisation strategies.
+	enum_<population::init_type>("init_type")
+		.value("uniform",population::UNIFORM)
+		.value("latin_hypercube",population::LATIN_HYPERCUBE)
+		.value("halton",population::HALTON)
+		.value("sobol",population::SOBOL);
+
 	// Individual and champion.
 	class_<population::individual_type>("individual","Individual class.",init<>())
 		.def("__repr__",&population::individual_type::human_readable)
@@ -398,6 +448,15 @@ BOOST_PYTHON_MODULE(_core)
 		.def("set_algorithm", &archipelago_set_algorithm,"Set algorithm on island.")
 		.def("dump_migr_history", &archipelago::dump_migr_history)
 		.def("clear_migr_history", &archipelago::clear_migr_history)
+		.def("get_migr_log", &archipelago_get_migr_log,
+			"Most recent migrations, as a list of (timestamp, src, dst, count, best_f) tuples (oldest first).")
+		.def("set_migr_log_capacity", &archipelago_set_migr_log_capacity,
+			"Set the number of migrations kept in memory to *n*.",boost::python::args("n"))
+		.def("open_migr_log_sink", &archipelago_open_migr_log_sink,
+			"Stream the migration records, in binary form, to the file *path*.",boost::python::args("path"))
+		.def("close_migr_log_sink", &archipelago_close_migr_log_sink,"Stop streaming the migration records.")
+		.def("get_saved_evaluations", &archipelago::get_saved_evaluations,
+			"Number of immigrants inserted without re-evaluation, their source and destination problems being identical.")
 		.def("cpp_loads", &py_cpp_loads<archipelago>,
 			"Load C++ serialized representation from string *str*.\n\n"
 			":Parameters:\n"
@@ -710,6 +710,29 @@ def _robust_ctor(self, problem = None, trials = 1, rho = 0.1, seed = 0):
 robust._orig_init = robust.__init__
 robust.__init__ = _robust_ctor
 
+def _surrogate_ctor(self, problem = None, max_samples = 500, length_scale = 0.2, nugget = 1e-6):
+    """
+    Learns online a gaussian process surrogate of the fitness of a problem, from its true evaluations.
+    Algorithms can then pre-screen candidates with prob.pre_screen(candidates, n) and evaluate only the promising ones.
+
+    USAGE: problem.surrogate(problem=PyGMO.ackley(10), max_samples=500, length_scale=0.2, nugget=1e-6)
+
+    * problem: PyGMO problem to be assisted by the surrogate
+    * max_samples: maximum number of samples kept in the model (the oldest are forgotten first)
+    * length_scale: length scale of the kernel, relative to the diagonal of the box
+    * nugget: regularization added to the diagonal of the kernel matrix
+    """
+    arg_list=[]
+    if problem == None:
+        problem = ackley(10)
+    arg_list.append(problem)
+    arg_list.append(max_samples)
+    arg_list.append(length_scale)
+    arg_list.append(nugget)
+    self._orig_init(*arg_list)
+surrogate._orig_init = surrogate.__init__
+surrogate.__init__ = _surrogate_ctor
+
 # Renaming and placing the enums
 _problem.death_penalty.method = _problem._death_method_type
 
@@ -67,6 +67,13 @@ std::vector<std::vector<double> > get_rotation_matrix_from_eigen(const problem::
 	return retval;
 }
 
+// Surrogate prediction of the fitness, returned together with its standard deviation
+tuple surrogate_predict(const problem::surrogate &p, const decision_vector &x) {
+	fitness_vector f, stddev;
+	p.predict(f,stddev,x);
+	return make_tuple(f,stddev);
+}
+
 // Wrapper to expose problems.
 template <class Problem>
 static inline class_<Problem,bases<problem::base> > problem_wrapper(const char *name, const char *descr)
@@ -94,6 +101,12 @@ static inline class_<Problem,bases<problem::base>,bases<problem::base_stochastic
 	retval.def("cpp_dumps", &py_cpp_dumps<Problem>);
 	retval.add_property("seed",&problem::base_stochastic::get_seed,&problem::base_stochastic::set_seed,
 		"Random seed used in the objective function evaluation.");
+	typedef fitness_vector (problem::base_stochastic::*return_fitness_seeded)(const decision_vector &, unsigned int) const;
+	typedef constraint_vector (problem::base_stochastic::*return_constraints_seeded)(const decision_vector &, unsigned int) const;
+	retval.def("objfun_seeded",return_fitness_seeded(&problem::base_stochastic::objfun_seeded),
+		"Compute and return fitness vector for the given seed, leaving the problem seed untouched.");
+	retval.def("compute_constraints_seeded",return_constraints_seeded(&problem::base_stochastic::compute_constraints_seeded),
+		"Compute and return constraint vector for the given seed, leaving the problem seed untouched.");
 	return retval;
 }
 
@@ -150,6 +163,8 @@ BOOST_PYTHON_MODULE(_problem) {
 	typedef void (problem::base::*best_x_setter)(const std::vector<decision_vector>&);
 	typedef constraint_vector (problem::base::*return_constraints)(const decision_vector &) const;
 	typedef fitness_vector (problem::base::*return_fitness)(const decision_vector &) const;
+	typedef constraint_vector (problem::base_stochastic::*return_constraints_seeded)(const decision_vector &, unsigned int) const;
+	typedef fitness_vector (problem::base_stochastic::*return_fitness_seeded)(const decision_vector &, unsigned int) const;
     class_<problem::python_base, boost::noncopyable>("_base",init<int,optional<int,int,int,int,const std::vector<double> &> >())
 		.def(init<const decision_vector &, const decision_vector &, optional<int,int,int,int, const double &> >())
 		.def(init<int,int,int,int,int,const double>())
@@ -241,6 +256,8 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def("compare_fitness",&problem::base::compare_fitness,"Compare fitness vectors.")
 		// Seed.
 		.add_property("seed",&problem::base_stochastic::get_seed,&problem::base_stochastic::set_seed,"Random seed used in the objective function evaluation.")
+		.def("objfun_seeded",return_fitness_seeded(&problem::base_stochastic::objfun_seeded),"Compute and return fitness vector for the given seed.")
+		.def("compute_constraints_seeded",return_constraints_seeded(&problem::base_stochastic::compute_constraints_seeded),"Compute and return constraint vector for the given seed.")
 		// Virtual methods that can be (re)implemented.
 		.def("get_name",&problem::base::get_name,&problem::python_base_stochastic::default_get_name)
 		.def("human_readable_extra", &problem::base::human_readable_extra, &problem::python_base_stochastic::default_human_readable_extra)
@@ -452,6 +469,25 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def(init<const problem::base &,unsigned int, const double, unsigned int>())
 		.add_property("rho", &problem::robust::get_rho);
 
+	// Surrogate-assisted meta-problem
+	meta_problem_wrapper<problem::surrogate>("surrogate", "Surrogate-assisted problem")
+		.def(init<const problem::base &, unsigned int, double, double>())
+		.def("predict", &surrogate_predict,
+			"Surrogate prediction of the fitness and of its standard deviation\n\n"
+			"  USAGE:: (f, stddev) = prob.predict(x)")
+		.def("pre_screen", &problem::surrogate::pre_screen,
+			"Indices of the n most promising candidates according to the surrogate\n\n"
+			"  USAGE:: idx = prob.pre_screen(candidates, n, kappa)\n"
+			"   - candidates: list of decision vectors\n"
+			"   - n: number of candidates to select\n"
+			"   - kappa: weight of the standard deviation in the lower confidence bound")
+		.def("add_sample", &problem::surrogate::add_sample)
+		.def("train", &problem::surrogate::train)
+		.def("reset_counters", &problem::surrogate::reset_counters)
+		.add_property("n_samples", &problem::surrogate::get_n_samples)
+		.add_property("true_evaluations", &problem::surrogate::get_true_evaluations)
+		.add_property("surrogate_evaluations", &problem::surrogate::get_surrogate_evaluations);
+
 #ifdef PAGMO_ENABLE_KEP_TOOLBOX
 	// Asteroid Sample Return (also used fot human missions to asteroids)
 //	problem_wrapper<problem::sample_return>("sample_return","Asteroid sample return problem.")
@@ -575,7 +611,9 @@ BOOST_PYTHON_MODULE(_problem) {
 		.def("post_evaluate", &problem::spheres::post_evaluate)
 		.def("simulate", &problem::spheres::simulate)
 		.def("get_nn_weights", &problem::spheres::get_nn_weights)
-		.add_property("seed",&problem::spheres::get_seed,&problem::spheres::set_seed,"Random seed used in the objective function evaluation.");
+		.add_property("seed",&problem::spheres::get_seed,&problem::spheres::set_seed,"Random seed used in the objective function evaluation.")
+		.add_property("n_threads",&problem::spheres::get_n_threads,&problem::spheres::set_n_threads,"Number of threads simulating the initial conditions of one objective function evaluation.")
+		.add_property("fixed_step",&problem::spheres::get_fixed_step,&problem::spheres::set_fixed_step,"Step of the fixed step RK4 integrator (0 selects the adaptive rk8pd integrator).");
 
 
 	//problem_wrapper<problem::spheres_q>("spheres_q", "Spheres problem, a neurocontroller for the MIT test-bed (body-axis perception-action)")
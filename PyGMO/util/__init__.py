@@ -354,12 +354,14 @@ def _hv4d_ctor(self):
 hv4d._original_init = hv4d.__init__
 hv4d.__init__ = _hv4d_ctor
 
-def _hoy_ctor(self):
+def _hoy_ctor(self, n_threads = 1):
 	"""
 	Hypervolume algorithm: HOY.
 	Computational complexity: O(n*log(n) + n^(d/2))
 	Applicable to hypervolume computation problems of dimension in [2, ..]
 
+	With n_threads > 1, the partitions of the lower levels of the partition tree are streamed on n_threads threads.
+
 
 	REF: Nicola Beume and Guenter Rudolph, "Faster S-Metric Calculation by Considering Dominated Hypervolume as Klee's Measure Problem.",
 	In: B. Kovalerchuk (ed.): Proceedings of the Second IASTED Conference on Computational Intelligence (CI 2006), pp. 231-236.  ACTA Press: Anaheim, 2006. 
@@ -370,16 +372,20 @@ def _hoy_ctor(self):
 		hv.compute(r=refpoint, algorithm=hv_algorithm.hoy())
 		hv.exclusive(p_idx=13, r=refpoint, algorithm=hv_algorithm.hoy())
 		hv.least_contributor(r=refpoint, algorithm=hv_algorithm.hoy())
+		hv.compute(r=refpoint, algorithm=hv_algorithm.hoy(n_threads=4))
 	"""
-	return self._original_init()
+	self._original_init()
+	self.n_threads = n_threads
 hoy._original_init = hoy.__init__
 hoy.__init__ = _hoy_ctor
 
-def _wfg_ctor(self, stop_dimension = 2):
+def _wfg_ctor(self, stop_dimension = 2, n_threads = 1):
 	"""
 	Hypervolume algorithm: WFG.
 	Applicable to hypervolume computation problems of dimension in [2, ..]
 
+	With n_threads > 1, the top-level slices (and the exclusive contributions) are computed on n_threads threads.
+
 	REF: "A Fast Way of Calculating Exact Hypervolumes", Lyndon While, Lucas Bradstreet, Luigi Barone.
 	IEEE TRANSACXTIONS ON EVOLUTIONARY COMPUTATION, VOL. 16, NO. 1, FEBRURARY 2012
 
@@ -389,14 +395,16 @@ def _wfg_ctor(self, stop_dimension = 2):
 		hv.compute(r=refpoint, algorithm=hv_algorithm.wfg())
 		hv.exclusive(p_idx=13,r=refpoint, algorithm=hv_algorithm.wfg())
 		hv.least_contributor(r=refpoint, algorithm=hv_algorithm.wfg())
+		hv.compute(r=refpoint, algorithm=hv_algorithm.wfg(n_threads=4))
 	"""
 	args = []
 	args.append(stop_dimension)
-	return self._original_init(*args)
+	self._original_init(*args)
+	self.n_threads = n_threads
 wfg._original_init = wfg.__init__
 wfg.__init__ = _wfg_ctor
 
-def _bf_approx_ctor(self, use_exact = True, trivial_subcase_size = 1, eps = 1e-1, delta = 1e-4, gamma = 0.25, delta_multiplier = 0.775, initial_delta_coeff = 1e-1, alpha = 0.2):
+def _bf_approx_ctor(self, use_exact = True, trivial_subcase_size = 1, eps = 1e-1, delta = 1e-4, gamma = 0.25, delta_multiplier = 0.775, initial_delta_coeff = 1e-1, alpha = 0.2, n_threads = 1):
 	"""
 	Hypervolume algorithm: Bringmann-Friedrich approximation.
 
@@ -414,6 +422,7 @@ def _bf_approx_ctor(self, use_exact = True, trivial_subcase_size = 1, eps = 1e-1
 		* delta_multiplier - factor with which delta diminishes each round
 		* initial_delta_coeff - initial coefficient multiplied by the delta at round 0
 		* alpha - coefficicient stating how accurately current lowest contributor should be sampled
+		* n_threads - number of threads drawing the samples (the result does not depend on it)
 		hv = hypervolume(...) # see 'hypervolume?' for usage
 		refpoint = [1.0]*7
 		hv.least_contributor(r=refpoint, algorithm=hv_algorithm.bf_approx())
@@ -428,11 +437,12 @@ def _bf_approx_ctor(self, use_exact = True, trivial_subcase_size = 1, eps = 1e-1
 	args.append(alpha)
 	args.append(initial_delta_coeff)
 	args.append(gamma)
-	return self._original_init(*args)
+	self._original_init(*args)
+	self.n_threads = n_threads
 bf_approx._original_init = bf_approx.__init__
 bf_approx.__init__ = _bf_approx_ctor
 
-def _bf_fpras_ctor(self, eps = 1e-2, delta = 1e-2):
+def _bf_fpras_ctor(self, eps = 1e-2, delta = 1e-2, n_threads = 1, early_stop = False):
 	"""
 	Hypervolume algorithm: Bringmann-Friedrich approximation.
 
@@ -444,6 +454,8 @@ def _bf_fpras_ctor(self, eps = 1e-2, delta = 1e-2):
 	USAGE:
 		* eps - accuracy of approximation
 		* delta - confidence of approximation
+		* n_threads - number of threads drawing the samples (the result does not depend on it)
+		* early_stop - stop sampling as soon as the confidence interval of the estimate is within eps
 
 		hv = hypervolume(...) # see 'hypervolume?' for usage
 		refpoint = [1.0]*7
@@ -453,7 +465,9 @@ def _bf_fpras_ctor(self, eps = 1e-2, delta = 1e-2):
 	args = []
 	args.append(eps)
 	args.append(delta)
-	return self._original_init(*args)
+	self._original_init(*args)
+	self.n_threads = n_threads
+	self.early_stop = early_stop
 bf_fpras._original_init = bf_fpras.__init__
 bf_fpras.__init__ = _bf_fpras_ctor
 
@@ -578,7 +592,7 @@ def _race_pop_set_seed(self, seed):
 race_pop._orig_set_seed = race_pop.set_seed
 race_pop.set_seed = _race_pop_set_seed
 
-def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0):
+def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0, n_threads=1):
 	"""
 	Construct the racing object responsible for racing algorithms
 	
@@ -586,6 +600,7 @@ def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0):
 	* probs: Can be a single PyGMO problem or a list of them
 	* pop_size: All the algorithms will be evolving internally some random population of this size
 	* seed: Seed of the race
+	* n_threads: Number of threads used to evolve concurrently the algorithms in each racing iteration
 	"""
 	# We set the defaults or the kwargs
 	arg_list=[]
@@ -604,6 +619,7 @@ def _race_algo_ctor(self, algo_list, probs, pop_size=100, seed=0):
 
 	arg_list.append(pop_size)
 	arg_list.append(seed)
+	arg_list.append(n_threads)
 
 	self._orig_init(*arg_list)
 
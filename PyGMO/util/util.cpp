@@ -76,6 +76,16 @@ class __PAGMO_VISIBLE py_faure
 		pagmo::util::discrepancy::faure m_original_class;
 };
 
+class __PAGMO_VISIBLE py_sobol
+{
+	public:
+		py_sobol(unsigned int dim, unsigned int count) : m_original_class(dim,count) {}
+		std::vector<double> operator ()() {return m_original_class();}
+		std::vector<double> operator ()(unsigned int n) {return m_original_class(n);}
+	private:
+		pagmo::util::discrepancy::sobol m_original_class;
+};
+
 }}}
 
 template <class HVAlgorithm>
@@ -94,11 +104,16 @@ void expose_hv_algorithm()
 	algorithm_wrapper<util::hv_algorithm::hv2d>("hv2d","hv2d algorithm.");
 	algorithm_wrapper<util::hv_algorithm::hv3d>("hv3d","hv3d algorithm.");
 	algorithm_wrapper<util::hv_algorithm::hv4d>("hv4d","hv4d algorithm.");
-	algorithm_wrapper<util::hv_algorithm::hoy>("hoy","HOY algorithm.");
-	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int>());
+	algorithm_wrapper<util::hv_algorithm::hoy>("hoy","HOY algorithm.")
+		.add_property("n_threads",&util::hv_algorithm::hoy::get_n_threads,&util::hv_algorithm::hoy::set_n_threads);
+	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int>())
+		.add_property("n_threads",&util::hv_algorithm::wfg::get_n_threads,&util::hv_algorithm::wfg::set_n_threads);
 	class_<util::hv_algorithm::bf_approx, bases<util::hv_algorithm::base> >("bf_approx","Bringmann-Friedrich approximated algorithm.", 
-			init<const bool, const unsigned int, const double, const double, const double, const double, const double, const double>());
-	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double>());
+			init<const bool, const unsigned int, const double, const double, const double, const double, const double, const double>())
+		.add_property("n_threads",&util::hv_algorithm::bf_approx::get_n_threads,&util::hv_algorithm::bf_approx::set_n_threads);
+	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double>())
+		.add_property("n_threads",&util::hv_algorithm::bf_fpras::get_n_threads,&util::hv_algorithm::bf_fpras::set_n_threads)
+		.add_property("early_stop",&util::hv_algorithm::bf_fpras::get_early_stop,&util::hv_algorithm::bf_fpras::set_early_stop);
 }
 
 void expose_hypervolume()
@@ -135,7 +150,24 @@ void expose_hypervolume()
 		.def("get_copy_points", &util::hypervolume::get_copy_points)
 		.def("get_points", &util::hypervolume::get_points)
 		.def("set_verify", &util::hypervolume::set_verify)
-		.def("get_verify", &util::hypervolume::get_verify);
+		.def("get_verify", &util::hypervolume::get_verify)
+		.def("get_dynamic", &util::hypervolume::get_dynamic, "Get a structure keeping the hypervolume and the contributions up to date while points are inserted and erased.");
+
+	typedef util::dynamic_hypervolume::size_type (util::dynamic_hypervolume::*dynamic_insert_point)(const fitness_vector &);
+	typedef util::dynamic_hypervolume::size_type (util::dynamic_hypervolume::*dynamic_insert_points)(const std::vector<fitness_vector> &);
+
+	class_<util::dynamic_hypervolume, util::dynamic_hypervolume_ptr, boost::noncopyable>("dynamic_hypervolume","Dynamic hypervolume of 2 or 3-dimensional points.", no_init)
+		.def("__len__", &util::dynamic_hypervolume::size)
+		.def("insert", dynamic_insert_point(&util::dynamic_hypervolume::insert), "Insert a point and return its handle.")
+		.def("insert", dynamic_insert_points(&util::dynamic_hypervolume::insert), "Insert several points and return the handle of the first one.")
+		.def("erase", &util::dynamic_hypervolume::erase, "Erase the point with the given handle.")
+		.def("contains", &util::dynamic_hypervolume::contains, "Check if a handle is valid.")
+		.def("get_point", &util::dynamic_hypervolume::get_point, return_value_policy<copy_const_reference>())
+		.def("get_reference_point", &util::dynamic_hypervolume::get_reference_point, return_value_policy<copy_const_reference>())
+		.def("get_hypervolume", &util::dynamic_hypervolume::get_hypervolume, "Get the hypervolume of the points.")
+		.def("exclusive", &util::dynamic_hypervolume::exclusive, "Get the exclusive contribution of the point with the given handle.")
+		.def("least_contributor", &util::dynamic_hypervolume::least_contributor, "Get the handle of the least contributor.")
+		.def("greatest_contributor", &util::dynamic_hypervolume::greatest_contributor, "Get the handle of the greatest contributor.");
 }
 
 // Main method containing all the juice of race_pop
@@ -201,6 +233,12 @@ BOOST_PYTHON_MODULE(_util) {
 		.def("next", my_first_overload_f(&discrepancy::py_faure::operator()))
 		.def("next", my_second_overload_f(&discrepancy::py_faure::operator()));
 
+	typedef std::vector<double> (discrepancy::py_sobol::*my_first_overload_s)() ;
+	typedef std::vector<double> (discrepancy::py_sobol::*my_second_overload_s)(unsigned int) ;
+	class_<discrepancy::py_sobol>("sobol", init<unsigned int , unsigned int>())
+		.def("next", my_first_overload_s(&discrepancy::py_sobol::operator()))
+		.def("next", my_second_overload_s(&discrepancy::py_sobol::operator()));
+
 	// Racing
 	enum_<racing::race_pop::termination_condition>("_termination_condition")
 		.value("MAX_BUDGET", racing::race_pop::MAX_BUDGET)
@@ -213,7 +251,8 @@ BOOST_PYTHON_MODULE(_util) {
 		.def("register_pop", &racing::race_pop::register_population, "Load a population into the race environment")
 		.def("inherit_memory", &racing::race_pop::inherit_memory, "Transfer memory of identical decision vectors")
 		.def("get_mean_fitness", &racing::race_pop::get_mean_fitness, "Returns the mean fitness of the individuals resulted from previously run race")
-		.def("set_seed", &racing::race_pop::set_seed, "Set the ground seed of the race");
+		.def("set_seed", &racing::race_pop::set_seed, "Set the ground seed of the race")
+		.def("set_n_threads", &racing::race_pop::set_n_threads, "Set the number of threads used to evaluate the racers");
 
 	// Required by race_algo
 	class_<std::vector<pagmo::algorithm::base_ptr> >("vector_of_algorithm_base_ptr")
@@ -222,8 +261,8 @@ BOOST_PYTHON_MODULE(_util) {
 	class_<std::vector<pagmo::problem::base_ptr> >("vector_of_problem_base_ptr")
 		.def(vector_indexing_suite<std::vector<pagmo::problem::base_ptr>, true>());
 
-	class_<racing::race_algo>("race_algo", init<const std::vector<pagmo::algorithm::base_ptr> &, const pagmo::problem::base &, unsigned int, unsigned int>())
-	.def(init<const std::vector<pagmo::algorithm::base_ptr> &, const std::vector<pagmo::problem::base_ptr> &, unsigned int, unsigned int>())
+	class_<racing::race_algo>("race_algo", init<const std::vector<pagmo::algorithm::base_ptr> &, const pagmo::problem::base &, unsigned int, unsigned int, unsigned int>())
+	.def(init<const std::vector<pagmo::algorithm::base_ptr> &, const std::vector<pagmo::problem::base_ptr> &, unsigned int, unsigned int, unsigned int>())
 	.def("run", &race_algo_run_return_tuple, "Race the algorithms");
 	
 	// Hypervolumes
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../src/pagmo.h"
+
+/**
+DESCRITPION: This example measures the throughput (in thousands of evaluations per second) of stacks of meta-problems
+of the kind used to build CEC-style test functions (shifted, rotated and normalized versions of a base problem), of a
+decomposed multi-objective problem and of a constrained problem with death penalty. Each decision vector is evaluated
+once, so that the cache of the outermost problem never hits and the cost of the whole stack is measured.
+*/
+
+using namespace pagmo;
+
+const unsigned int n_points = 2000;
+const unsigned int n_repetitions = 50;
+
+// Prevents the compiler from optimising away the computed fitnesses.
+volatile double sink = 0.;
+
+void bench(const std::string &name, const problem::base &prob)
+{
+	population pop(prob, n_points, 42u);
+	std::vector<decision_vector> x(n_points);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x[i] = pop.get_individual(i).cur_x;
+	}
+	problem::base_ptr p = prob.clone();
+	fitness_vector f(prob.get_f_dimension());
+	double acc = 0.;
+	boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+	for (unsigned int r = 0; r < n_repetitions; ++r) {
+		// Make every decision vector different from the ones seen in the previous repetition.
+		for (unsigned int i = 0; i < n_points; ++i) {
+			x[i][0] = -x[i][0];
+			p->objfun(f, x[i]);
+			acc += f[0];
+		}
+	}
+	const double seconds = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1e-6;
+	std::cout << std::setw(55) << std::left << name << std::setw(10) << std::right << std::fixed << std::setprecision(1)
+		<< n_points * n_repetitions / seconds * 1e-3 << " k/s" << std::endl;
+	sink = acc;
+}
+
+int main()
+{
+	const unsigned int dim = 30;
+	srand(42);
+	problem::rastrigin rastrigin(dim);
+	problem::shifted shifted(rastrigin);
+	problem::rotated rotated(rastrigin);
+
+	bench("rastrigin", rastrigin);
+	bench("shifted(rastrigin)", shifted);
+	bench("normalized(rastrigin)", problem::normalized(rastrigin));
+	bench("rotated(rastrigin)", rotated);
+	bench("rotated(shifted(rastrigin))", problem::rotated(shifted));
+	bench("shifted(rotated(rastrigin))", problem::shifted(rotated));
+	bench("shifted(rotated(shifted(rastrigin)))", problem::shifted(problem::rotated(shifted)));
+	bench("normalized(rotated(shifted(rastrigin)))", problem::normalized(problem::rotated(shifted)));
+	bench("decompose(shifted(zdt1))", problem::decompose(problem::shifted(problem::zdt(1, dim), 0.)));
+	bench("death_penalty(shifted(cec2006 g7))", problem::death_penalty(problem::shifted(problem::cec2006(7), 0.)));
+	bench("con2mo(shifted(cec2006 g7))", problem::con2mo(problem::shifted(problem::cec2006(7), 0.)));
+	return 0;
+}
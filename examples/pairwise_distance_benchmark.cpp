@@ -0,0 +1,111 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/thread/thread.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/pairwise_distance.h"
+
+/**
+DESCRITPION: This example measures the time needed to find the largest pairwise distance in a population of NP points
+(the first step of an iteration of firefly), with the naive double loop and with util::pairwise_distance on one and on
+all the available threads. For the smaller populations the time needed to build the full distance matrix is reported too.
+*/
+
+using namespace pagmo;
+
+const unsigned int dim = 10;
+
+double seconds_since(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1e-6;
+}
+
+double naive_max(const std::vector<std::vector<double> > &X)
+{
+	double retval = 0.;
+	for (std::vector<double>::size_type i = 0; i < X.size(); ++i) {
+		for (std::vector<double>::size_type j = i + 1; j < X.size(); ++j) {
+			double tmp = 0.;
+			for (unsigned int k = 0; k < dim; ++k) {
+				tmp += (X[i][k] - X[j][k]) * (X[i][k] - X[j][k]);
+			}
+			retval = std::max(retval, tmp);
+		}
+	}
+	return retval;
+}
+
+int main()
+{
+	const unsigned int n_threads = std::max(boost::thread::hardware_concurrency(), 1u);
+	const unsigned int sizes[] = {100, 500, 1000, 2000, 5000, 10000};
+	rng_double drng(42);
+	boost::uniform_real<double> uniform(-1.0,1.0);
+	std::cout << "Dimension " << dim << ", " << n_threads << " threads (times in ms)" << std::endl;
+	std::cout << std::setw(8) << "NP" << std::setw(12) << "naive max" << std::setw(12) << "max" << std::setw(12) << "max (mt)"
+		<< std::setw(12) << "matrix" << std::setw(12) << "matrix (mt)" << std::endl;
+	for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		const unsigned int NP = sizes[s];
+		std::vector<std::vector<double> > X(NP, std::vector<double>(dim));
+		for (unsigned int i = 0; i < NP; ++i) {
+			for (unsigned int k = 0; k < dim; ++k) {
+				X[i][k] = uniform(drng);
+			}
+		}
+		boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+		const double max_naive = naive_max(X);
+		const double t_naive = seconds_since(start);
+		start = boost::posix_time::microsec_clock::local_time();
+		const util::pairwise_distance d(X);
+		const double max = d.max();
+		const double t_max = seconds_since(start);
+		start = boost::posix_time::microsec_clock::local_time();
+		const double max_mt = util::pairwise_distance(X).max(n_threads);
+		const double t_max_mt = seconds_since(start);
+		if (max != max_naive || max_mt != max_naive) {
+			std::cout << "Mismatch in the largest distance" << std::endl;
+			return 1;
+		}
+		std::cout << std::setw(8) << NP << std::fixed << std::setprecision(2) << std::setw(12) << t_naive * 1e3
+			<< std::setw(12) << t_max * 1e3 << std::setw(12) << t_max_mt * 1e3;
+		// The full matrix of the largest populations would take several hundreds of MB.
+		if (NP <= 5000) {
+			std::vector<std::vector<double> > matrix;
+			start = boost::posix_time::microsec_clock::local_time();
+			d.matrix(matrix);
+			const double t_matrix = seconds_since(start);
+			start = boost::posix_time::microsec_clock::local_time();
+			d.matrix(matrix, n_threads);
+			std::cout << std::setw(12) << t_matrix * 1e3 << std::setw(12) << seconds_since(start) * 1e3;
+		}
+		std::cout << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include "../src/rng.h"
+
+/**
+DESCRITPION: This example measures the throughput (in millions of numbers per second) of the random number generators
+of PaGMO: the Boost engines rng_uint32 and rng_double, and the counter-based rng_philox and rng_philox_double, both one
+number at a time and in batches. The cost of constructing (seeding) each generator is also measured, as it matters when
+streams are created on the fly (e.g. one per evaluation of a stochastic problem).
+*/
+
+using namespace pagmo;
+
+const unsigned int n_numbers = 1 << 24;
+const unsigned int n_constructions = 1 << 16;
+
+// Prevents the compiler from optimising away the generated numbers.
+volatile double sink = 0.;
+
+double elapsed(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1e-6;
+}
+
+void report(const std::string &name, double seconds, unsigned int n)
+{
+	std::cout << std::setw(45) << std::left << name << std::setw(10) << std::right << std::fixed << std::setprecision(1)
+		<< n / seconds * 1e-6 << " M/s" << std::endl;
+}
+
+template <class Rng>
+void bench_scalar(const std::string &name)
+{
+	Rng rng(42u);
+	double acc = 0.;
+	boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+	for (unsigned int i = 0; i < n_numbers; ++i) {
+		acc += rng();
+	}
+	report(name,elapsed(start),n_numbers);
+	sink = acc;
+}
+
+template <class Rng>
+void bench_normal(const std::string &name)
+{
+	Rng rng(42u);
+	boost::normal_distribution<double> normal(0.,1.);
+	boost::variate_generator<Rng &, boost::normal_distribution<double> > gen(rng,normal);
+	double acc = 0.;
+	boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+	for (unsigned int i = 0; i < n_numbers; ++i) {
+		acc += gen();
+	}
+	report(name,elapsed(start),n_numbers);
+	sink = acc;
+}
+
+template <class Rng>
+void bench_construction(const std::string &name)
+{
+	double acc = 0.;
+	boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+	for (unsigned int i = 0; i < n_constructions; ++i) {
+		Rng rng(i);
+		acc += rng();
+	}
+	report(name,elapsed(start),n_constructions);
+	sink = acc;
+}
+
+int main()
+{
+	std::vector<double> buffer(4096);
+	std::vector<boost::uint32_t> raw_buffer(4096);
+
+	std::cout << "Scalar generation:" << std::endl;
+	bench_scalar<rng_uint32>("rng_uint32 (mt19937)");
+	bench_scalar<rng_philox>("rng_philox");
+	bench_scalar<rng_double>("rng_double (lagged_fibonacci607)");
+	bench_scalar<rng_philox_double>("rng_philox_double");
+
+	std::cout << "Batch generation:" << std::endl;
+	{
+		rng_philox rng(42u);
+		boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+		for (unsigned int i = 0; i < n_numbers / raw_buffer.size(); ++i) {
+			rng.generate(raw_buffer.begin(),raw_buffer.end());
+			sink = raw_buffer[i % raw_buffer.size()];
+		}
+		report("rng_philox::generate",elapsed(start),n_numbers);
+	}
+	{
+		rng_philox rng(42u);
+		boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+		for (unsigned int i = 0; i < n_numbers / buffer.size(); ++i) {
+			rng.generate_uniform(buffer.begin(),buffer.end());
+			sink = buffer[i % buffer.size()];
+		}
+		report("rng_philox::generate_uniform",elapsed(start),n_numbers);
+	}
+	{
+		rng_philox_double rng(42u);
+		boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+		for (unsigned int i = 0; i < n_numbers / buffer.size(); ++i) {
+			rng.generate(buffer.begin(),buffer.end());
+			sink = buffer[i % buffer.size()];
+		}
+		report("rng_philox_double::generate",elapsed(start),n_numbers);
+	}
+
+	std::cout << "Normal numbers:" << std::endl;
+	bench_normal<rng_double>("boost::normal_distribution + rng_double");
+	bench_normal<rng_philox>("boost::normal_distribution + rng_philox");
+	{
+		rng_philox rng(42u);
+		boost::posix_time::ptime start(boost::posix_time::microsec_clock::local_time());
+		for (unsigned int i = 0; i < n_numbers / buffer.size(); ++i) {
+			rng.generate_normal(buffer.begin(),buffer.end());
+			sink = buffer[i % buffer.size()];
+		}
+		report("rng_philox::generate_normal",elapsed(start),n_numbers);
+	}
+
+	std::cout << "Construction and first number:" << std::endl;
+	bench_construction<rng_uint32>("rng_uint32 (mt19937)");
+	bench_construction<rng_double>("rng_double (lagged_fibonacci607)");
+	bench_construction<rng_philox>("rng_philox");
+	return 0;
+}
@@ -0,0 +1,520 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../problem/base_stochastic.h"
+#include "../types.h"
+#include "async_evolution.h"
+#include "base.h"
+
+namespace pagmo { namespace algorithm {
+
+namespace {
+
+// Parameters of the generators.
+const double de_f = 0.8;
+const double de_cr = 0.9;
+const double pso_chi = 0.7298;
+const double pso_eta = 2.05;
+const double pso_vcoeff = 0.5;
+const double sga_cr = 0.95;
+const double sga_m = 0.02;
+const double sga_width = 0.1;
+
+// Seconds elapsed since start.
+double seconds_since(const boost::posix_time::ptime &start)
+{
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1e-6;
+}
+
+// A candidate together with the result of its evaluation.
+struct job {
+	async_evolution::candidate	cand;
+	fitness_vector			f;
+	constraint_vector		c;
+};
+
+// Queues shared between the driver and the workers.
+struct job_queue {
+	job_queue():stop(false) {}
+	boost::mutex			mutex;
+	boost::condition_variable	pending_cv;
+	boost::condition_variable	done_cv;
+	std::deque<job>			pending;
+	std::deque<job>			done;
+	bool				stop;
+	std::string			error;
+};
+
+// Evaluates the pending jobs on its own clone of the problem, accounting for the time spent waiting for work.
+class worker {
+public:
+	worker(job_queue &q, const problem::base &prob, double &idle):m_q(q),m_prob(prob),m_idle(idle) {}
+	void operator()()
+	{
+		while (true) {
+			job j;
+			{
+				boost::unique_lock<boost::mutex> lock(m_q.mutex);
+				const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+				while (m_q.pending.empty() && !m_q.stop) {
+					m_q.pending_cv.wait(lock);
+				}
+				m_idle += seconds_since(start);
+				if (m_q.stop) {
+					return;
+				}
+				std::swap(j,m_q.pending.front());
+				m_q.pending.pop_front();
+			}
+			try {
+				j.f.resize(m_prob.get_f_dimension());
+				j.c.resize(m_prob.get_c_dimension());
+				m_prob.objfun(j.f,j.cand.x);
+				m_prob.compute_constraints(j.c,j.cand.x);
+			} catch (const std::exception &e) {
+				set_error(e.what());
+				return;
+			} catch (...) {
+				set_error("unknown exception caught in asynchronous evaluation");
+				return;
+			}
+			{
+				boost::lock_guard<boost::mutex> lock(m_q.mutex);
+				m_q.done.push_back(j);
+			}
+			m_q.done_cv.notify_one();
+		}
+	}
+private:
+	void set_error(const std::string &msg)
+	{
+		{
+			boost::lock_guard<boost::mutex> lock(m_q.mutex);
+			if (m_q.error.empty()) {
+				m_q.error = msg;
+			}
+		}
+		m_q.done_cv.notify_all();
+	}
+	job_queue		&m_q;
+	const problem::base	&m_prob;
+	double			&m_idle;
+};
+
+// Stops and joins the workers when the driver leaves, normally or because of an exception.
+class pool_guard {
+public:
+	pool_guard(job_queue &q, boost::thread_group &pool):m_q(q),m_pool(pool) {}
+	~pool_guard()
+	{
+		{
+			boost::lock_guard<boost::mutex> lock(m_q.mutex);
+			m_q.stop = true;
+		}
+		m_q.pending_cv.notify_all();
+		m_pool.join_all();
+	}
+private:
+	job_queue		&m_q;
+	boost::thread_group	&m_pool;
+};
+
+}
+
+/// Constructor.
+/**
+ * @param[in] n_eval number of evaluations performed by each call to evolve.
+ * @param[in] generator generator of the new candidates.
+ * @param[in] n_threads number of threads evaluating the candidates (if 1, the evaluations are performed in the calling thread).
+ * @param[in] n_in_flight number of candidates kept under evaluation (0 means twice the number of threads).
+ * @throws value_error if n_eval is negative, generator is not valid or n_threads is zero
+ */
+async_evolution::async_evolution(int n_eval, generator_type generator, unsigned int n_threads, unsigned int n_in_flight):
+	base(),m_n_eval(n_eval),m_generator(generator),m_n_threads(n_threads),m_n_in_flight(n_in_flight == 0 ? 2 * n_threads : n_in_flight),
+	m_evaluations_per_second(0),m_idle_fraction(0)
+{
+	if (n_eval < 0) {
+		pagmo_throw(value_error,"number of evaluations must be nonnegative");
+	}
+	if (generator != DE && generator != PSO && generator != SGA) {
+		pagmo_throw(value_error,"the generator must be one of DE, PSO or SGA");
+	}
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+}
+
+/// Clone method.
+base_ptr async_evolution::clone() const
+{
+	return base_ptr(new async_evolution(*this));
+}
+
+// Checks that the population can be evolved with the selected generator.
+void async_evolution::check_population(const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	if (prob.get_f_dimension() != 1) {
+		pagmo_throw(value_error,"The problem is not single objective and async_evolution is not suitable to solve it");
+	}
+	if (m_generator != SGA && prob.get_dimension() == prob.get_i_dimension()) {
+		pagmo_throw(value_error,"There is no continuous part in the problem decision vector for the DE and PSO generators to optimise");
+	}
+	if (m_generator == DE && pop.size() < 4) {
+		pagmo_throw(value_error,"for the DE generator at least 4 individuals in the population are needed");
+	}
+	if (pop.size() < 2) {
+		pagmo_throw(value_error,"for async_evolution at least 2 individuals in the population are needed");
+	}
+}
+
+/// Evolve implementation.
+/**
+ * Performs the number of evaluations specified in the constructor, keeping up to get_n_in_flight() candidates under
+ * evaluation at any time. Each completed evaluation is inserted in the population (see insert()) before the next
+ * candidate is generated (see generate()).
+ *
+ * @param[in,out] pop input/output pagmo::population to be evolved.
+ * @throws std::runtime_error if one of the evaluations failed in a worker thread
+ */
+void async_evolution::evolve(population &pop) const
+{
+	check_population(pop);
+	const problem::base &prob = pop.problem();
+	const population::size_type NP = pop.size();
+	m_evaluations_per_second = 0;
+	m_idle_fraction = 0;
+
+	// Get out if there is nothing to do.
+	if (m_n_eval == 0) {
+		return;
+	}
+	const std::size_t n_eval = static_cast<std::size_t>(m_n_eval);
+	const std::size_t n_in_flight = std::min<std::size_t>(m_n_in_flight,n_eval);
+	std::size_t n_dispatched = 0, n_completed = 0;
+	double idle = 0;
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+	if (m_n_threads == 1) {
+		// The evaluations are performed here, in the order of dispatch.
+		std::deque<job> in_flight;
+		for (; n_dispatched < n_in_flight; ++n_dispatched) {
+			in_flight.push_back(job());
+			generate(in_flight.back().cand,pop,n_dispatched);
+		}
+		while (!in_flight.empty()) {
+			job &j = in_flight.front();
+			j.f.resize(prob.get_f_dimension());
+			j.c.resize(prob.get_c_dimension());
+			prob.objfun(j.f,j.cand.x);
+			prob.compute_constraints(j.c,j.cand.x);
+			insert(pop,j.cand,j.f,j.c);
+			++n_completed;
+			if (n_dispatched < n_eval) {
+				generate(j.cand,pop,n_dispatched++);
+				in_flight.push_back(job());
+				std::swap(in_flight.back().cand,j.cand);
+			}
+			in_flight.pop_front();
+			if (m_screen_output && n_completed % NP == 0) {
+				std::cout << "Evaluations: " << n_completed << ", best fitness: " << pop.champion().f << std::endl;
+			}
+		}
+	} else {
+		// Each worker evaluates on its own clone, with the current seed of a stochastic problem.
+		std::vector<problem::base_ptr> probs;
+		const problem::base_stochastic *stochastic = dynamic_cast<const problem::base_stochastic *>(&prob);
+		for (unsigned int i = 0; i < m_n_threads; ++i) {
+			probs.push_back(prob.clone());
+			if (stochastic) {
+				dynamic_cast<const problem::base_stochastic &>(*probs.back()).set_seed(stochastic->get_seed());
+			}
+		}
+		std::vector<double> idle_times(m_n_threads,0.);
+		job_queue q;
+		boost::thread_group pool;
+		{
+			pool_guard guard(q,pool);
+			for (unsigned int i = 0; i < m_n_threads; ++i) {
+				pool.create_thread(worker(q,*probs[i],idle_times[i]));
+			}
+			for (; n_dispatched < n_in_flight; ++n_dispatched) {
+				job j;
+				generate(j.cand,pop,n_dispatched);
+				boost::lock_guard<boost::mutex> lock(q.mutex);
+				q.pending.push_back(j);
+			}
+			q.pending_cv.notify_all();
+			while (n_completed < n_eval) {
+				job j;
+				{
+					boost::unique_lock<boost::mutex> lock(q.mutex);
+					while (q.done.empty() && q.error.empty()) {
+						q.done_cv.wait(lock);
+					}
+					if (!q.error.empty()) {
+						pagmo_throw(std::runtime_error,q.error);
+					}
+					std::swap(j,q.done.front());
+					q.done.pop_front();
+				}
+				insert(pop,j.cand,j.f,j.c);
+				++n_completed;
+				if (n_dispatched < n_eval) {
+					generate(j.cand,pop,n_dispatched++);
+					{
+						boost::lock_guard<boost::mutex> lock(q.mutex);
+						q.pending.push_back(j);
+					}
+					q.pending_cv.notify_one();
+				}
+				if (m_screen_output && n_completed % NP == 0) {
+					std::cout << "Evaluations: " << n_completed << ", best fitness: " << pop.champion().f << std::endl;
+				}
+			}
+		}
+		for (unsigned int i = 0; i < m_n_threads; ++i) {
+			idle += idle_times[i];
+		}
+	}
+
+	const double elapsed = seconds_since(start);
+	if (elapsed > 0) {
+		m_evaluations_per_second = n_eval / elapsed;
+		m_idle_fraction = std::min(1.,idle / (elapsed * m_n_threads));
+	}
+	if (m_screen_output) {
+		std::cout << "Evaluations per second: " << m_evaluations_per_second << ", idle fraction: " << m_idle_fraction << std::endl;
+	}
+}
+
+/// Generates a new candidate.
+/**
+ * Builds the n-th candidate of the current call to evolve from the current state of the population, according to the
+ * selected generator. Can be reimplemented, together with insert(), to plug in a different generator.
+ *
+ * @param[out] cand the new candidate.
+ * @param[in] pop the population.
+ * @param[in] n the number of candidates generated before this one in the current call to evolve.
+ */
+void async_evolution::generate(candidate &cand, const population &pop, std::size_t n) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const population::size_type NP = pop.size();
+	cand.v.clear();
+
+	if (m_generator == DE) {
+		// DE/rand/1/bin trial vector for the targets in round-robin order.
+		cand.target = n % NP;
+		const decision_vector &x = pop.get_individual(cand.target).cur_x;
+		population::size_type r1, r2, r3;
+		do {
+			r1 = boost::uniform_int<int>(0,NP-1)(m_urng);
+		} while (r1 == cand.target);
+		do {
+			r2 = boost::uniform_int<int>(0,NP-1)(m_urng);
+		} while (r2 == cand.target || r2 == r1);
+		do {
+			r3 = boost::uniform_int<int>(0,NP-1)(m_urng);
+		} while (r3 == cand.target || r3 == r1 || r3 == r2);
+		const decision_vector &x1 = pop.get_individual(r1).cur_x, &x2 = pop.get_individual(r2).cur_x, &x3 = pop.get_individual(r3).cur_x;
+		cand.x = x;
+		problem::base::size_type j = boost::uniform_int<int>(0,Dc-1)(m_urng);
+		for (problem::base::size_type L = 0; L < Dc; ++L) {
+			if (m_drng() < de_cr || L + 1 == Dc) {
+				cand.x[j] = x1[j] + de_f * (x2[j] - x3[j]);
+			}
+			j = (j + 1) % Dc;
+		}
+		for (j = 0; j < Dc; ++j) {
+			if (cand.x[j] < lb[j] || cand.x[j] > ub[j]) {
+				cand.x[j] = boost::uniform_real<double>(lb[j],ub[j])(m_drng);
+			}
+		}
+		// The velocity is the displacement from the target, as in DE.
+		cand.v.resize(D);
+		std::transform(cand.x.begin(),cand.x.end(),x.begin(),cand.v.begin(),std::minus<double>());
+	} else if (m_generator == PSO) {
+		// Constricted move of the particles in round-robin order.
+		cand.target = n % NP;
+		const population::individual_type &ind = pop.get_individual(cand.target);
+		const decision_vector &gbest = pop.champion().x;
+		cand.x = ind.cur_x;
+		cand.v = ind.cur_v;
+		for (problem::base::size_type j = 0; j < Dc; ++j) {
+			const double vmax = pso_vcoeff * (ub[j] - lb[j]);
+			double v = pso_chi * (cand.v[j] + pso_eta * m_drng() * (ind.best_x[j] - cand.x[j])
+				+ pso_eta * m_drng() * (gbest[j] - cand.x[j]));
+			v = std::max(-vmax,std::min(vmax,v));
+			double x = cand.x[j] + v;
+			if (x < lb[j]) {
+				x = lb[j];
+				v = 0;
+			} else if (x > ub[j]) {
+				x = ub[j];
+				v = 0;
+			}
+			cand.x[j] = x;
+			cand.v[j] = v;
+		}
+	} else {
+		// Offspring of two binary tournaments, to replace the worst individual at insertion time.
+		cand.target = NP;
+		population::size_type parents[2];
+		for (int k = 0; k < 2; ++k) {
+			const population::size_type a = boost::uniform_int<int>(0,NP-1)(m_urng), b = boost::uniform_int<int>(0,NP-1)(m_urng);
+			const population::individual_type &ia = pop.get_individual(a), &ib = pop.get_individual(b);
+			parents[k] = prob.compare_fc(ib.cur_f,ib.cur_c,ia.cur_f,ia.cur_c) ? b : a;
+		}
+		cand.x = pop.get_individual(parents[0]).cur_x;
+		if (m_drng() < sga_cr) {
+			const decision_vector &other = pop.get_individual(parents[1]).cur_x;
+			for (problem::base::size_type j = 0; j < D; ++j) {
+				if (m_drng() < 0.5) {
+					cand.x[j] = other[j];
+				}
+			}
+		}
+		boost::normal_distribution<double> dist;
+		boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > delta(m_drng,dist);
+		for (problem::base::size_type j = 0; j < D; ++j) {
+			if (m_drng() >= sga_m) {
+				continue;
+			}
+			if (j < Dc) {
+				const double x = cand.x[j] + delta() * sga_width * (ub[j] - lb[j]);
+				cand.x[j] = std::max(lb[j],std::min(ub[j],x));
+			} else {
+				cand.x[j] = boost::uniform_int<int>(lb[j],ub[j])(m_urng);
+			}
+		}
+	}
+}
+
+/// Inserts an evaluated candidate in the population.
+/**
+ * The DE generator replaces the target if the candidate is better, the PSO generator always replaces the target and
+ * the SGA generator replaces the worst individual if the candidate is better. Can be reimplemented, together with
+ * generate(), to plug in a different generator.
+ *
+ * @param[in,out] pop the population.
+ * @param[in] cand the candidate.
+ * @param[in] f the fitness vector of the candidate.
+ * @param[in] c the constraint vector of the candidate.
+ *
+ * @return true if the candidate entered the population.
+ */
+bool async_evolution::insert(population &pop, const candidate &cand, const fitness_vector &f, const constraint_vector &c) const
+{
+	const problem::base &prob = pop.problem();
+	const population::size_type idx = (cand.target < pop.size()) ? cand.target : pop.get_worst_idx();
+	const population::individual_type &ind = pop.get_individual(idx);
+	if (m_generator != PSO && !prob.compare_fc(f,c,ind.cur_f,ind.cur_c)) {
+		return false;
+	}
+	pop.set_x(idx,cand.x,f,c);
+	if (!cand.v.empty()) {
+		pop.set_v(idx,cand.v);
+	}
+	return true;
+}
+
+/// Algorithm name
+std::string async_evolution::get_name() const
+{
+	return "Asynchronous steady-state evolution";
+}
+
+/// Generator of the new candidates
+async_evolution::generator_type async_evolution::get_generator() const
+{
+	return m_generator;
+}
+
+/// Number of threads evaluating the candidates
+unsigned int async_evolution::get_n_threads() const
+{
+	return m_n_threads;
+}
+
+/// Number of candidates kept under evaluation
+unsigned int async_evolution::get_n_in_flight() const
+{
+	return m_n_in_flight;
+}
+
+/// Evaluations per second achieved by the last call to evolve
+double async_evolution::get_evaluations_per_second() const
+{
+	return m_evaluations_per_second;
+}
+
+/// Fraction of the worker time spent waiting for a candidate in the last call to evolve
+double async_evolution::get_idle_fraction() const
+{
+	return m_idle_fraction;
+}
+
+/// Extra human readable algorithm info.
+/**
+ * @return a formatted string displaying the parameters of the algorithm.
+ */
+std::string async_evolution::human_readable_extra() const
+{
+	const char *names[] = {"DE", "PSO", "SGA"};
+	std::ostringstream s;
+	s << "evaluations:" << m_n_eval << ' ';
+	s << "generator:" << names[m_generator] << ' ';
+	s << "threads:" << m_n_threads << ' ';
+	s << "in flight:" << m_n_in_flight << std::endl;
+	return s.str();
+}
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::algorithm::async_evolution);
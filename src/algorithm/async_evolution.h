@@ -0,0 +1,129 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_ALGORITHM_ASYNC_EVOLUTION_H
+#define PAGMO_ALGORITHM_ASYNC_EVOLUTION_H
+
+#include <cstddef>
+#include <string>
+
+#include "../config.h"
+#include "../population.h"
+#include "../serialization.h"
+#include "../types.h"
+#include "base.h"
+
+namespace pagmo { namespace algorithm {
+
+/// Asynchronous steady-state evolution
+/**
+ * Steady-state driver meant for problems whose evaluation time varies a lot from one decision vector to the other
+ * (e.g., trajectory legs or ODE integrations), where a generational algorithm leaves its threads idle waiting for the
+ * slowest evaluation of each generation.
+ *
+ * A fixed number of candidates (the in-flight limit) is kept under evaluation on a pool of threads, each owning a clone
+ * of the problem. Each time an evaluation completes, its result is inserted in the population and a new candidate is
+ * generated from the current population and dispatched right away. The candidates are produced by one of the following
+ * generators:
+ *
+ * - DE: DE/rand/1/bin trial vector (F = 0.8, CR = 0.9) for the targets taken in round-robin order, replacing the
+ *   target if better,
+ * - PSO: constricted particle swarm move (omega = 0.7298, eta1 = eta2 = 2.05 * omega) of the particles taken in
+ *   round-robin order, always replacing the particle and its velocity,
+ * - SGA: binary tournament selection, uniform crossover (probability 0.95) and gaussian mutation (probability 0.02
+ *   per component, standard deviation 0.1 times the bounds width), replacing the worst individual if better.
+ *
+ * Other generators can be plugged in by deriving from this class and reimplementing generate() and insert().
+ *
+ * A call to evolve performs exactly the number of evaluations specified in the constructor. With one thread the
+ * evaluations are carried out in the calling thread, in the order of dispatch, so that the results are reproducible;
+ * with more threads the order of insertion follows the order of completion. The throughput of the last call to evolve
+ * is reported by get_evaluations_per_second() and get_idle_fraction().
+ *
+ * NOTE: the integer part of the decision vector is treated as fixed by the DE and PSO generators.
+ *
+ * NOTE2: when called on stochastic optimization problems, all the evaluations of a call to evolve are carried out
+ * with the seed the problem had at the beginning of the call.
+ */
+class __PAGMO_VISIBLE async_evolution: public base
+{
+public:
+	/// Generator of the new candidates
+	enum generator_type {
+		DE = 0, ///< Differential evolution, DE/rand/1/bin
+		PSO = 1, ///< Particle swarm optimization, constriction variant
+		SGA = 2 ///< Steady-state genetic algorithm
+	};
+	/// Candidate solution dispatched for evaluation
+	struct candidate {
+		/// Decision vector to be evaluated.
+		decision_vector x;
+		/// Velocity associated to the decision vector (may be empty).
+		decision_vector v;
+		/// Index of the individual the candidate was generated for.
+		population::size_type target;
+	};
+	async_evolution(int = 1000, generator_type = DE, unsigned int = 1, unsigned int = 0);
+	base_ptr clone() const;
+	void evolve(population &) const;
+	std::string get_name() const;
+	generator_type get_generator() const;
+	unsigned int get_n_threads() const;
+	unsigned int get_n_in_flight() const;
+	double get_evaluations_per_second() const;
+	double get_idle_fraction() const;
+protected:
+	std::string human_readable_extra() const;
+	virtual void generate(candidate &, const population &, std::size_t) const;
+	virtual bool insert(population &, const candidate &, const fitness_vector &, const constraint_vector &) const;
+private:
+	void check_population(const population &) const;
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & boost::serialization::base_object<base>(*this);
+		ar & const_cast<int &>(m_n_eval);
+		ar & const_cast<generator_type &>(m_generator);
+		ar & const_cast<unsigned int &>(m_n_threads);
+		ar & const_cast<unsigned int &>(m_n_in_flight);
+		ar & m_evaluations_per_second;
+		ar & m_idle_fraction;
+	}
+	// Number of evaluations per call to evolve.
+	const int m_n_eval;
+	const generator_type m_generator;
+	const unsigned int m_n_threads;
+	// Number of candidates kept under evaluation.
+	const unsigned int m_n_in_flight;
+	// Throughput of the last call to evolve.
+	mutable double m_evaluations_per_second;
+	mutable double m_idle_fraction;
+};
+
+}}
+
+BOOST_CLASS_EXPORT_KEY(pagmo::algorithm::async_evolution);
+
+#endif // PAGMO_ALGORITHM_ASYNC_EVOLUTION_H
@@ -26,6 +26,8 @@
 #include <sstream>
 #include <string>
 #include <typeinfo>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
 
 #include "../population.h"
 #include "../rng.h"
@@ -86,6 +88,66 @@ void base::reset_rngs(const unsigned int p) const {
 	m_drng = rng_double(p);
 }
 
+/// Sets the deadline
+/**
+ * Sets a wall-clock deadline, expressed in UTC, for the evolve() calls. The algorithms supporting it check the deadline
+ * between generations and, once it has passed, return early leaving the population in a consistent state.
+ * The deadline is transient: it is not serialized and it stays active until clear_deadline() is called.
+ *
+ * @param[in] t the deadline, e.g. boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(100).
+ */
+void base::set_deadline(const boost::posix_time::ptime &t) {m_deadline = t;}
+
+/// Clears the deadline
+/**
+ * After this call evolve() will run its full course again.
+ */
+void base::clear_deadline() {m_deadline = boost::posix_time::ptime();}
+
+/// Gets the deadline
+/**
+ * @return the deadline set with set_deadline(), or boost::posix_time::not_a_date_time if none is set.
+ */
+boost::posix_time::ptime base::get_deadline() const {return m_deadline;}
+
+/// Checks whether the evolution should stop
+/**
+ * To be called by the derived classes between generations. Cheap enough to be called at every generation.
+ *
+ * @return true if the deadline has passed or if an interruption of the current thread has been requested.
+ */
+bool base::deadline_reached() const
+{
+	if (boost::this_thread::interruption_requested()) {
+		return true;
+	}
+	return !m_deadline.is_not_a_date_time() && boost::posix_time::microsec_clock::universal_time() >= m_deadline;
+}
+
+/// Checks whether a fitness reaches a target
+/**
+ * Used by the algorithms that stop as soon as a target fitness is reached (e.g. pagmo::algorithm::ms and pagmo::algorithm::mbh).
+ *
+ * @param[in] prob problem the fitness and the constraints belong to.
+ * @param[in] f fitness vector.
+ * @param[in] c constraint vector.
+ * @param[in] target target fitness vector, empty if there is no target.
+ *
+ * @return true if the target is not empty, c is feasible for prob and f is not worse than the target in any objective.
+ */
+bool base::target_reached(const problem::base &prob, const fitness_vector &f, const constraint_vector &c, const fitness_vector &target)
+{
+	if (target.empty() || !prob.feasibility_c(c)) {
+		return false;
+	}
+	for (fitness_vector::size_type i = 0; i < f.size(); ++i) {
+		if (f[i] > target[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /// Return human readable representation of the algorithm.
 /**
  * Will return a formatted string containing the algorithm name from get_name().
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <string>
 #include <typeinfo>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "../config.h"
@@ -110,7 +111,15 @@ return base_ptr(new derived_algorithm(*this));
 
 		/// Resets the seed of the internal rngs using a user-provided seed
 		void reset_rngs(const unsigned int) const;
+
+		/// Setter-Getter for the wall-clock deadline of evolve()
+		void set_deadline(const boost::posix_time::ptime &);
+		void clear_deadline();
+		boost::posix_time::ptime get_deadline() const;
+
+		static bool target_reached(const problem::base &, const fitness_vector &, const constraint_vector &, const fitness_vector &);
 	protected:
+		bool deadline_reached() const;
 		/// Indicates to the derived class whether to print stuff on screen
 		bool m_screen_output;
 		/// Random number generator for double-precision floating point values.
@@ -118,6 +127,9 @@ return base_ptr(new derived_algorithm(*this));
 		/// Random number generator for unsigned integer values.
 		mutable rng_uint32	m_urng;
 	private:
+		// Deadline (UTC) after which evolve() returns at the next generation boundary. It is
+		// a transient, per-run setting and therefore it is neither serialized nor printed.
+		boost::posix_time::ptime m_deadline;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -39,6 +39,7 @@
 #include "../population.h"
 #include "../problem/base_stochastic.h"
 #include "../types.h"
+#include "../util/batch_evaluator.h"
 #include "../Eigen/Dense"
 
 namespace pagmo { namespace algorithm {
@@ -61,7 +62,7 @@ namespace pagmo { namespace algorithm {
  * */
 cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0, double ftol, double xtol, bool memory):
 		base(), m_gen(boost::numeric_cast<std::size_t>(gen)), m_cc(cc), m_cs(cs), m_c1(c1), 
-		m_cmu(cmu), m_sigma(sigma0), m_ftol(ftol), m_xtol(xtol), m_memory(memory) {
+		m_cmu(cmu), m_sigma(sigma0), m_ftol(ftol), m_xtol(xtol), m_memory(memory), m_n_threads(1), m_eigen_lag(-1), m_separable(false) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -81,9 +82,9 @@ cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0
 	//Initialize the algorithm memory
 	m_mean = Eigen::VectorXd::Zero(1);
 	m_variation = Eigen::VectorXd::Zero(1);
-	m_newpop = std::vector<Eigen::VectorXd>();
+	m_newpop = Eigen::MatrixXd();
 	m_B = Eigen::MatrixXd::Identity(1,1);
-	m_D = Eigen::MatrixXd::Identity(1,1);
+	m_D = Eigen::VectorXd::Ones(1);
 	m_C = Eigen::MatrixXd::Identity(1,1);
 	m_invsqrtC = Eigen::MatrixXd::Identity(1,1);
 	m_pc = Eigen::VectorXd::Zero(1);
@@ -181,9 +182,15 @@ void cmaes::evolve(population &pop) const
 	}
 	if (c1 == -1) {
 		c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);			// learning rate for rank-one update of C
+		if (m_separable) {
+			c1 *= (N+2) / 3.0;				// the diagonal can be learnt faster
+		}
 	}
 	if (cmu == -1) {
 		cmu = 2.0 * (mueff-2+1/mueff) / ((N+2)*(N+2)+mueff);	// and for rank-mu update
+		if (m_separable) {
+			cmu = std::min(1 - c1, cmu * (N+2) / 3.0);
+		}
 	}
 	
 	double damps = 1 + 2*std::max(0.0, std::sqrt((mueff-1)/(N+1))-1) + cs;	// damping for sigma
@@ -194,9 +201,9 @@ void cmaes::evolve(population &pop) const
 	// Algorithm's Memory. This allows the algorithm to start from its last "state"
 	VectorXd mean(m_mean);
 	VectorXd variation(m_variation);
-	std::vector<VectorXd> newpop(m_newpop);
+	MatrixXd newpop(m_newpop);
 	MatrixXd B(m_B);
-	MatrixXd D(m_D);
+	VectorXd D(m_D);
 	MatrixXd C(m_C);
 	MatrixXd invsqrtC(m_invsqrtC);
 	VectorXd pc(m_pc);
@@ -208,39 +215,52 @@ void cmaes::evolve(population &pop) const
 
 	// Some buffers
 	VectorXd meanold = VectorXd::Zero(N);
-	MatrixXd Dinv = MatrixXd::Identity(N,N);
-	MatrixXd Cold = MatrixXd::Identity(N,N);
-	VectorXd tmp = VectorXd::Zero(N);
-	std::vector<VectorXd> elite(mu,tmp);
-	decision_vector dumb(N,0);
-
-	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls
-	if ( (m_newpop.size() != lam) || ((unsigned int)(m_newpop[0].rows() ) != N) || (m_memory==false) ) {
+	MatrixXd Cold;
+	MatrixXd Z(N,lam);						// standard normal samples
+	MatrixXd elite(N,mu);
+	MatrixXd artmp(N,mu);
+	std::vector<decision_vector> x(lam, decision_vector(N));
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+
+	// If the algorithm is called for the first time on this problem dimension / pop size / variant or if m_memory is false we erease the memory of past calls
+	if ( ((population::size_type)m_newpop.cols() != lam) || ((unsigned int)(m_newpop.rows()) != N) || (m_B.size() == 0) != m_separable || (m_memory==false) ) {
 		mean.resize(N);
 		for (problem::base::size_type i=0;i<N;++i){
 			mean(i) = pop.champion().x[i];
 		}
-		newpop = std::vector<VectorXd>(lam,tmp);
+		newpop = MatrixXd::Zero(N,lam);
 		variation.resize(N);
 
 		//We define the satrting B,D,C
-		B.resize(N,N); B = MatrixXd::Identity(N,N);			//B defines the coordinate system
-		D.resize(N,N); D = MatrixXd::Identity(N,N);			//diagonal D defines the scaling. By default this is the witdh of the box. 
+		D.resize(N);							//D defines the scaling. By default this is the witdh of the box. 
 										//If this is too small... then 1e-6 is used
 		for (problem::base::size_type j=0; j<N; ++j){
-			D(j,j) = std::max((ub[j]-lb[j]),1e-6);
+			D(j) = std::max((ub[j]-lb[j]),1e-6);
 		}
-		C.resize(N,N); C = MatrixXd::Identity(N,N);			//covariance matrix C
-		C = D*D;						
-		invsqrtC.resize(N,N); invsqrtC = MatrixXd::Identity(N,N);	//inverse of sqrt(C)
-		for (problem::base::size_type j=0; j<N; ++j){
-			invsqrtC(j,j) = 1 / D(j,j);
+		if (m_separable) {
+			B.resize(0,0);						//the coordinate system is never rotated
+			C = D.cwiseProduct(D);					//diagonal of the covariance matrix C
+			invsqrtC = D.cwiseInverse();				//diagonal of the inverse of sqrt(C)
+		} else {
+			B = MatrixXd::Identity(N,N);				//B defines the coordinate system
+			C = D.cwiseProduct(D).asDiagonal();			//covariance matrix C
+			invsqrtC = D.cwiseInverse().asDiagonal();		//inverse of sqrt(C)
 		}
 		pc.resize(N); pc = VectorXd::Zero(N);
 		ps.resize(N); ps = VectorXd::Zero(N);
 		counteval = 0;
 		eigeneval = 0;
 	}
+
+	// B*D, the linear map applied to the standard normal samples
+	MatrixXd BD;
+	if (!m_separable) {
+		BD = B * D.asDiagonal();
+	}
+
+	// The offspring are evaluated on the population problem, or in parallel on clones of it
+	util::batch_evaluator evaluator(prob, m_n_threads);
 	
 	// ----------------------------------------------//
 	// HERE WE START THE REAL ALGORITHM              //
@@ -262,28 +282,41 @@ void cmaes::evolve(population &pop) const
 			<< " - chiN: " << chiN << std::endl;
 	}
 	
-	SelfAdjointEigenSolver<MatrixXd> es(N);
+	SelfAdjointEigenSolver<MatrixXd> es;
 	for (std::size_t g = 0; g < m_gen; ++g) {
+		// Stop at the generation boundary once the deadline has passed, still writing back the state below.
+		if (deadline_reached()) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- deadline reached" << std::endl;
+			}
+			break;
+		}
 		// 1 - We generate and evaluate lam new individuals
 
+		// 1a - we create lam randomly normal distributed vectors
 		for (population::size_type i = 0; i<lam; ++i ) {
-			// 1a - we create a randomly normal distributed vector
 			for (problem::base::size_type j=0; j<N; ++j){
-				tmp(j) = normally_distributed_number();
+				Z(j,i) = normally_distributed_number();
 			}
-			// 1b - and store its transformed value in the newpop
-			newpop[i] = mean + (sigma * B * D * tmp);
 		}
-		//This is evaluated here on the last generated tmp and will be used only as 
+		// 1b - and store their transformed values in the newpop (a single matrix product)
+		if (m_separable) {
+			newpop.noalias() = (sigma * D).asDiagonal() * Z;
+		} else {
+			newpop.noalias() = sigma * BD * Z;
+		}
+		//This is evaluated here on the last generated sample and will be used only as 
 		//a stopping criteria
-		var_norm = (sigma * B * D * tmp).norm();
+		var_norm = newpop.col(lam - 1).norm();
+		newpop.colwise() += mean;
 
 		// 1c - we fix the bounds 
 		for (population::size_type i = 0; i<lam; ++i ) {
 			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				if ( (newpop[i](j) < lb[j]) || (newpop[i](j) > ub[j]) ) {
-					newpop[i](j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+				if ( (newpop(j,i) < lb[j]) || (newpop(j,i) > ub[j]) ) {
+					newpop(j,i) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
 				}
+				x[i][j] = newpop(j,i);
 			}
 		}
 
@@ -292,23 +325,19 @@ void cmaes::evolve(population &pop) const
 		{	//TODO: check if it is really necessary to clear the pop, also
 			//would it make sense to use best_x also?
 			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
+			evaluator.evaluate(x, f, c);
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
 			for (population::size_type i = 0; i<lam; ++i ) {
-			  	for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.push_back(dumb);
+				pop.push_back(x[i], f[i], c[i]);
 			}
 			counteval += lam;
 		}
 		catch (const std::bad_cast& e)
 		{
 			// Reinsertion (original method)
+			evaluator.evaluate(x, f, c);
 			for (population::size_type i = 0; i<lam; ++i ) {
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.set_x(i,dumb);
+				pop.set_x(i, x[i], f[i], c[i]);
 			}
 			counteval += lam;
 		}
@@ -325,61 +354,67 @@ void cmaes::evolve(population &pop) const
 		best_idx.resize(mu);
 		for (population::size_type i = 0; i<mu; ++i ) {
 			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				elite[i](j) = pop.get_individual(best_idx[i]).cur_x[j];
+				elite(j,i) = pop.get_individual(best_idx[i]).cur_x[j];
 			}
 		}
 
 
 		// 3 - Compute the new elite mean storing the old one
 		meanold=mean;
-		mean = elite[0]*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			mean += elite[i]*weights(i);
-		}
+		mean.noalias() = elite * weights;
 
 		// 4 - Update evolution paths
-		ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
+		if (m_separable) {
+			ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC.col(0).cwiseProduct(mean-meanold) / sigma;
+		} else {
+			ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
+		}
 		double hsig = 0;
 		hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
 		pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
 
-		// 5 - Adapt Covariance Matrix
+		// 5 - Adapt Covariance Matrix (the rank-mu update is a single matrix product)
+		artmp = (elite.colwise() - meanold) / sigma;
 		Cold = C;
-		C = (elite[0]-meanold)*(elite[0]-meanold).transpose()*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			C += (elite[i]-meanold)*(elite[i]-meanold).transpose()*weights(i);
+		if (m_separable) {
+			C = (1-c1-cmu) * Cold +
+				cmu * artmp.cwiseProduct(artmp) * weights +
+				c1 * (pc.cwiseProduct(pc) + (1-hsig) * cc * (2-cc) * Cold);
+		} else {
+			C = (1-c1-cmu) * Cold +
+				cmu * artmp * weights.asDiagonal() * artmp.transpose() +
+				c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
 		}
-		C /= sigma*sigma;
-		C = (1-c1-cmu) * Cold +
-			cmu * C +
-			c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
 
 		//6 - Adapt sigma
 		sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
 		if ( (boost::math::isnan)(sigma) || (boost::math::isnan)(sigma) || (boost::math::isinf)(var_norm) || (boost::math::isnan)(var_norm) ) {
-			std::cout << "eigen: " << es.info() << std::endl;
 			std::cout << "B: " << B << std::endl;
 			std::cout << "D: " << D << std::endl;
-			std::cout << "Dinv: " << D << std::endl;
 			std::cout << "invsqrtC: " << invsqrtC << std::endl;
 			pagmo_throw(value_error,"NaN!!!!! in CMAES");
 		}
 
 		//7 - Perform eigen-decomposition of C
-		if ( (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
+		if (m_separable) {
+			// C is diagonal: its square root is immediate, O(N)
+			for (decision_vector::size_type j = 0; j<N; ++j ) {
+				D(j) = std::sqrt( std::max(1e-20,C(j,0)) );
+			}
+			invsqrtC = D.cwiseInverse();
+		} else if ( m_eigen_lag < 0 ? (counteval - eigeneval) > (lam/(c1+cmu)/N/10) :		//achieve O(N^2)
+				(counteval - eigeneval) >= m_eigen_lag * lam ) {
 			eigeneval = counteval;
 			C = (C+C.transpose())/2;				//enforce symmetry
 			es.compute(C);						//eigen decomposition
 			if (es.info()==Success) {
 				B = es.eigenvectors();
-				D = es.eigenvalues().asDiagonal();
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					D(j,j) = std::sqrt( std::max(1e-20,D(j,j)) );				//D contains standard deviations now
-				}
+				D = es.eigenvalues();
 				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					Dinv(j,j) = 1.0 / D(j,j);
+					D(j) = std::sqrt( std::max(1e-20,D(j)) );				//D contains standard deviations now
 				}
-				invsqrtC = B*Dinv*B.transpose();
+				invsqrtC = B * D.cwiseInverse().asDiagonal() * B.transpose();
+				BD = B * D.asDiagonal();
 			} //if eigendecomposition fails just skip it and keep pevious succesful one.
 		}
 		
@@ -408,7 +443,8 @@ void cmaes::evolve(population &pop) const
 
 		//9 - Check the exit conditions (every 40 generations)
 		if (g%40) {
-			if  ( (sigma*B*D*tmp).norm() < m_xtol ) {
+			const double step = m_separable ? (sigma * D.cwiseProduct(Z.col(lam - 1))).norm() : (sigma * BD * Z.col(lam - 1)).norm();
+			if  ( step < m_xtol ) {
 				if (m_screen_output) { 
 					std::cout << "Exit condition -- xtol < " <<  m_xtol << std::endl;
 				}
@@ -484,6 +520,53 @@ void cmaes::set_xtol(const double xtol) {m_xtol = xtol;}
 /// Getter for m_xtol
 double cmaes::get_xtol() const {return m_xtol;}
 
+/// Sets the maximum number of threads used to evaluate the offspring
+/**
+ * If larger than one, the lambda offspring of each generation are evaluated in parallel, each thread working on its
+ * own clone of the problem. The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void cmaes::set_n_threads(unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+/// Getter for m_n_threads
+unsigned int cmaes::get_n_threads() const {return m_n_threads;}
+
+/// Sets the lag of the eigendecomposition
+/**
+ * The eigendecomposition of the covariance matrix is recomputed once at least lag generations have passed since
+ * the previous one (every generation if lag is 0 or 1). If lag is -1 it is set automatically to 1/(c1+cmu)/N/10.
+ * Not used by the separable variant.
+ *
+ * @param[in] lag number of generations between two eigendecompositions, or -1
+ * @throws value_error if lag is negative and not -1
+ */
+void cmaes::set_eigen_lag(double lag)
+{
+	if (lag < 0 && lag != -1) {
+		pagmo_throw(value_error,"the eigendecomposition lag needs to be nonnegative or -1 for auto value");
+	}
+	m_eigen_lag = lag;
+}
+/// Getter for m_eigen_lag
+double cmaes::get_eigen_lag() const {return m_eigen_lag;}
+
+/// Selects the separable variant (sep-CMA-ES)
+/**
+ * Changing the variant resets the memory of the algorithm at the next call.
+ *
+ * @param[in] separable true to adapt only the diagonal of the covariance matrix
+ */
+void cmaes::set_separable(bool separable) {m_separable = separable;}
+/// Getter for m_separable
+bool cmaes::get_separable() const {return m_separable;}
+
 /// Algorithm name
 std::string cmaes::get_name() const
 {
@@ -506,7 +589,9 @@ std::string cmaes::human_readable_extra() const
 	  << "sigma0:" << m_sigma << ' '
 	  << "ftol:" << m_ftol << ' '
 	  << "xtol:" << m_xtol << ' ' 
-	  << "memory:" << m_memory;
+	  << "memory:" << m_memory << ' '
+	  << "eigen_lag:" << m_eigen_lag << ' '
+	  << "separable:" << m_separable;
 	return s.str();
 }
 
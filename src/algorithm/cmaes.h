@@ -42,7 +42,16 @@ namespace pagmo { namespace algorithm {
 
 /// Covariance Matrix Adaptation Evolutionary Startegy (CMAES)
 /**
-
+ * The lambda offspring of a generation are sampled at once (as a matrix product with the lambda standard normal
+ * vectors) and can be evaluated on a pool of threads (see set_n_threads()).
+ *
+ * The eigendecomposition of the covariance matrix is computed lazily, by default after a number of generations
+ * inversely proportional to the learning rates and to the dimension, so that its cost is O(N^2) per evaluation. The
+ * lag can be set with set_eigen_lag().
+ *
+ * For large dimensions (N in the thousands) the separable variant (sep-CMA-ES, see set_separable()) adapts only the
+ * diagonal of the covariance matrix, with learning rates increased by (N+2)/3: memory and time per sample are O(N) and
+ * no eigendecomposition is needed, at the price of ignoring the correlations among the variables.
  */
 
 class __PAGMO_VISIBLE cmaes: public base
@@ -78,6 +87,15 @@ public:
 	void   set_ftol(const double p);
 	double get_ftol() const;
 
+	void set_n_threads(unsigned int);
+	unsigned int get_n_threads() const;
+
+	void   set_eigen_lag(double);
+	double get_eigen_lag() const;
+
+	void set_separable(bool);
+	bool get_separable() const;
+
 protected:
 	std::string human_readable_extra() const;
 private:
@@ -95,6 +113,9 @@ private:
 		ar & m_xtol;
 		ar & m_ftol;
 		ar & m_memory;
+		ar & m_n_threads;
+		ar & m_eigen_lag;
+		ar & m_separable;
 		ar & m_mean;
 		ar & m_variation;
 		ar & m_newpop;
@@ -117,13 +138,17 @@ private:
 	double m_ftol;
 	double m_xtol;
 	bool m_memory;
+	unsigned int m_n_threads;
+	double m_eigen_lag;
+	bool m_separable;
 
 	// "Memory" data members (these are here as to enable control over each single generation)
+	// In the separable variant B is empty and C, D and invsqrtC are column vectors holding the diagonals.
 	mutable Eigen::VectorXd m_mean;
 	mutable Eigen::VectorXd m_variation;
-	mutable std::vector<Eigen::VectorXd> m_newpop;
+	mutable Eigen::MatrixXd m_newpop;
 	mutable Eigen::MatrixXd m_B;
-	mutable Eigen::MatrixXd m_D;
+	mutable Eigen::VectorXd m_D;
 	mutable Eigen::MatrixXd m_C;
 	mutable Eigen::MatrixXd m_invsqrtC;
 	mutable Eigen::VectorXd m_pc;
@@ -30,6 +30,7 @@
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/batch_evaluator.h"
 #include "base.h"
 #include "de.h"
 
@@ -47,7 +48,7 @@ namespace pagmo { namespace algorithm {
  * @param[in] xtol stopping criteria on the f tolerance
  * @throws value_error if f,cr are not in the [0,1] interval, strategy is not one of 1 .. 10, gen is negative
  */
-de::de(int gen, double f, double cr, int strategy, double ftol, double xtol):base(),m_gen(gen),m_f(f),m_cr(cr),m_strategy(strategy),m_ftol(ftol),m_xtol(xtol) {
+de::de(int gen, double f, double cr, int strategy, double ftol, double xtol):base(),m_gen(gen),m_f(f),m_cr(cr),m_strategy(strategy),m_ftol(ftol),m_xtol(xtol),m_n_threads(1) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -108,9 +109,12 @@ void de::evolve(population &pop) const
 	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
 	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
 	decision_vector gbX(D),gbIter(D);
-	fitness_vector newfitness(prob_f_dimension);	//new fitness of the mutaded candidate
+	std::vector<decision_vector> trials(NP,dummy);	//trial vectors of the generation
+	std::vector<fitness_vector> newfitness;	//new fitness of the mutaded candidates
+	std::vector<constraint_vector> newconstraints;
 	fitness_vector gbfit(prob_f_dimension);	//global best fitness
 	std::vector<fitness_vector> fit(NP,gbfit);
+	util::batch_evaluator evaluator(prob, m_n_threads);
 
 	//We extract from pop the chromosomes and fitness associated
 	for (std::vector<double>::size_type i = 0; i < NP; ++i) {
@@ -128,6 +132,13 @@ void de::evolve(population &pop) const
 	// Main DE iterations
 	size_t r1,r2,r3,r4,r5;	//indexes to the selected population members
 	for (int gen = 0; gen < m_gen; ++gen) {
+		// Stop at the generation boundary once the deadline has passed: the population is consistent here.
+		if (deadline_reached()) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- deadline reached" << std::endl;
+			}
+			return;
+		}
 		//Start of the loop through the deme
 		for (size_t i = 0; i < NP; ++i) {
 			do {                       /* Pick a random population member */
@@ -289,27 +300,30 @@ void de::evolve(population &pop) const
 				++i2;
 			}
 
-			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
-			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
-				fit[i]=newfitness;
-				popnew[i] = tmp;
+			trials[i] = tmp;
+		}//End of the loop through the deme
+
+		//b) how good? All the trial vectors are evaluated at once (possibly in parallel) and then selected
+		evaluator.evaluate(trials, newfitness, newconstraints);
+		for (size_t i = 0; i < NP; ++i) {
+			if ( pop.problem().compare_fitness(newfitness[i],fit[i]) ) {  /* improved objective function value ? */
+				fit[i]=newfitness[i];
+				popnew[i] = trials[i];
 				// As a fitness improvment occured we move the point
 				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				std::transform(trials[i].begin(), trials[i].end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+				//updates x and v (the fitness is known, no need to recompute the objective function)
+				pop.set_x(i,popnew[i],newfitness[i],newconstraints[i]);
 				pop.set_v(i,tmp);
-				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
+				if ( pop.problem().compare_fitness(newfitness[i],gbfit) ) {
 					/* if so...*/
-					gbfit=newfitness;          /* reset gbfit to new low...*/
+					gbfit=newfitness[i];          /* reset gbfit to new low...*/
 					gbX=popnew[i];
 				}
 			} else {
 				popnew[i] = popold[i];
 			}
-
-		}//End of the loop through the deme
+		}
 
 		/* Save best population member of current iteration */
 		gbIter = gbX;
@@ -412,6 +426,30 @@ double de::get_f() const {
 }
 
 
+/// Sets the maximum number of threads used to evaluate the trial vectors.
+/**
+ * If larger than one, the NP trial vectors of each generation are evaluated in parallel, each thread working on its
+ * own clone of the problem. The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void de::set_n_threads(unsigned int n_threads) {
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the maximum number of threads used to evaluate the trial vectors.
+/**
+ *
+ * @return the maximum number of threads
+ */
+unsigned int de::get_n_threads() const {
+	return m_n_threads;
+}
+
 /// Extra human readable algorithm info.
 /**
  * @return a formatted string displaying the parameters of the algorithm.
@@ -61,6 +61,10 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the velocity is also updated along DE whenever a new chromosome is accepted.
  *
+ * NOTE4: the evolution is generational: the trial vectors are built from the population of the previous generation
+ * (and from its best individual), then evaluated all together and selected. The evaluations of a generation can thus
+ * be distributed over several threads (see set_n_threads()), with the same results as in the serial case.
+ *
  * @see http://www.icsi.berkeley.edu/~storn/code.html for the official DE web site
  * @see http://www.springerlink.com/content/x555692233083677/ for the paper that introduces Differential Evolution
  *
@@ -78,6 +82,8 @@ public:
 	double get_cr() const;
 	void set_f(double cr);
 	double get_f() const;
+	void set_n_threads(unsigned int);
+	unsigned int get_n_threads() const;
 protected:
 	std::string human_readable_extra() const;
 private:
@@ -92,6 +98,7 @@ private:
 		ar & const_cast<double &>(m_ftol);
 		ar & const_cast<double &>(m_xtol);
 		ar & const_cast<int &>(m_strategy);
+		ar & m_n_threads;
 	}
 	// Number of generations.
 	const int m_gen;
@@ -103,7 +110,8 @@ private:
 	const int m_strategy;
 	const double m_ftol;
 	const double m_xtol;
-	
+	// Maximum number of threads evaluating the trial vectors
+	unsigned int m_n_threads;
 };
 
 }}
@@ -32,6 +32,7 @@
 #include "../population.h"
 #include "../problem/base.h"
 #include "../types.h"
+#include "../util/pairwise_distance.h"
 
 
 
@@ -124,19 +125,8 @@ void firefly::evolve(population &pop) const
 	// Main Firefly loop
 	for (int j = 0; j < m_iter; ++j) {
 
-		//Find maximum distance between individuals
-		double r_max_sqrd = 0;
-		for (population::size_type ii = 0; ii< NP; ++ii) {
-			for (population::size_type jj = ii+1; jj< NP; ++jj) {
-				double r_temp_sqrd = 0;
-				for(problem::base::size_type k=0; k < Dc; ++k) {
-					r_temp_sqrd += (X[ii][k] - X[jj][k])*(X[ii][k]-X[jj][k]);
-				}
-				if (r_temp_sqrd > r_max_sqrd) {
-					r_max_sqrd = r_temp_sqrd;
-				}
-			}
-		}
+		//Find maximum distance between individuals (continuous part only)
+		const double r_max_sqrd = util::pairwise_distance(X, Dc).max();
 
 		bool moveIItoJJ;
 		double r_sqrd;    //temp variable to store distances squared between fireflies
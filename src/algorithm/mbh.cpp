@@ -22,20 +22,98 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include "../exceptions.h"
 #include "../population.h"
 #include "../problem/base.h"
+#include "../rng.h"
 #include "../types.h"
+#include "../util/parallel.h"
 #include "base.h"
 #include "mbh.h"
 
 namespace pagmo { namespace algorithm {
 
+namespace {
+
+// Fill pert_pop with the perturbed best decision vectors of pop, and v with the perturbed velocities.
+void perturb_population(const population &pop, population &pert_pop, std::vector<decision_vector> &v, const std::vector<double> &perturb,
+	rng_double &drng, rng_uint32 &urng)
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension(), Dc = D - prob.get_i_dimension();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	decision_vector tmp_x(D);
+	double dummy, width;
+	pert_pop.clear();
+	v.resize(pop.size());
+	for (population::size_type j =0; j < pop.size(); ++j)
+	{
+		v[j].resize(D);
+		for (decision_vector::size_type k=0; k < Dc; ++k)
+		{
+			dummy = pop.get_individual(j).best_x[k];
+			width = perturb[k];
+			tmp_x[k] = boost::uniform_real<double>(std::max(dummy-width*(ub[k]-lb[k]),lb[k]),std::min(dummy+width*(ub[k]-lb[k]),ub[k]))(drng);
+			dummy = pop.get_individual(j).cur_v[k];
+			v[j][k] = boost::uniform_real<double>(dummy-width*(ub[k]-lb[k]),dummy+width*(ub[k]-lb[k]))(drng);
+		}
+
+		for (decision_vector::size_type k=Dc; k < D; ++k)
+		{
+			dummy = pop.get_individual(j).best_x[k];
+			width = perturb[k];
+			tmp_x[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(urng);
+			dummy = pop.get_individual(j).cur_v[k];
+			v[j][k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(urng);
+		}
+		pert_pop.push_back(tmp_x);
+	}
+}
+
+// Perturbs pop into pert_pop and evolves it with local, storing in v the perturbed velocities. These are meant for pop
+// (the perturbed individuals start from their default velocities), whether or not the trial is accepted.
+void run_trial(const population &pop, population &pert_pop, std::vector<decision_vector> &v, const std::vector<double> &perturb,
+	rng_double &drng, rng_uint32 &urng, const base &local)
+{
+	perturb_population(pop,pert_pop,v,perturb,drng,urng);
+	local.evolve(pert_pop);
+}
+
+// Runs trial t of an iteration, with generators and a copy of the local algorithm seeded with seeds[t].
+class trial_task
+{
+	public:
+		trial_task(const population &pop, const base &local, const std::vector<double> &perturb, const std::vector<boost::uint32_t> &seeds,
+			std::vector<boost::shared_ptr<population> > &trials, std::vector<std::vector<decision_vector> > &v):
+			m_pop(pop),m_local(local),m_perturb(perturb),m_seeds(seeds),m_trials(trials),m_v(v) {}
+		void operator()(const std::size_t &t, const unsigned int &)
+		{
+			rng_double drng(m_seeds[t]);
+			rng_uint32 urng(m_seeds[t]);
+			const base_ptr local = m_local.clone();
+			local->reset_rngs(m_seeds[t]);
+			run_trial(m_pop,*m_trials[t],m_v[t],m_perturb,drng,urng,*local);
+		}
+	private:
+		const population				&m_pop;
+		const base					&m_local;
+		const std::vector<double>			&m_perturb;
+		const std::vector<boost::uint32_t>		&m_seeds;
+		std::vector<boost::shared_ptr<population> >	&m_trials;
+		std::vector<std::vector<decision_vector> >	&m_v;
+};
+
+}
+
 /// Constructor.
 /**
  * Constructs an mbh algorithm with uniform neighbourhoods
@@ -47,7 +125,7 @@ namespace pagmo { namespace algorithm {
  * rounding to the floor
  * @throws value_error if stop is negative or perturb is not in [0,1]
  */
-mbh::mbh(const base & local, int stop, double perturb):base(),m_stop(stop),m_perturb(1,perturb)
+mbh::mbh(const base & local, int stop, double perturb):base(),m_stop(stop),m_perturb(1,perturb),m_n_trials(1),m_n_threads(1)
 {
 	m_local = local.clone();
 	if (stop < 0) {
@@ -69,7 +147,7 @@ mbh::mbh(const base & local, int stop, double perturb):base(),m_stop(stop),m_per
  * rounding to the floor
  * @throws value_error if stop is negative or perturb[i] is not in [0,1]
  */
-mbh::mbh(const base & local, int stop, const std::vector<double> &perturb):base(),m_stop(stop),m_perturb(perturb)
+mbh::mbh(const base & local, int stop, const std::vector<double> &perturb):base(),m_stop(stop),m_perturb(perturb),m_n_trials(1),m_n_threads(1)
 {
 	m_local = local.clone();
 	if (stop < 0) {
@@ -85,7 +163,8 @@ mbh::mbh(const base & local, int stop, const std::vector<double> &perturb):base(
 }
 
 /// Copy constructor.
-mbh::mbh(const mbh &algo):base(algo),m_local(algo.m_local->clone()),m_stop(algo.m_stop),m_perturb(algo.m_perturb)
+mbh::mbh(const mbh &algo):base(algo),m_local(algo.m_local->clone()),m_stop(algo.m_stop),m_perturb(algo.m_perturb),
+	m_n_trials(algo.m_n_trials),m_n_threads(algo.m_n_threads),m_target(algo.m_target)
 {}
 
 /// Clone method.
@@ -105,10 +184,8 @@ void mbh::evolve(population &pop) const
 {
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
-	const problem::base::size_type D = prob.get_dimension(), prob_i_dimension = prob.get_i_dimension();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	const problem::base::size_type D = prob.get_dimension();
 	const population::size_type NP = pop.size();
-	const problem::base::size_type Dc = D - prob_i_dimension;
 
 	//Check if the perturbation vector has size 1, in which case it fills up the whole vector with
 	//the same number
@@ -123,14 +200,20 @@ void mbh::evolve(population &pop) const
 		pagmo_throw(value_error,"perturbation vector size does not match the problem size");
 	}
 
+	if (!m_target.empty() && m_target.size() != prob.get_f_dimension()) {
+		pagmo_throw(value_error,"the dimension of the target does not match the fitness dimension of the problem");
+	}
+
 	// Get out if there is nothing to do.
-	if (m_stop == 0 || NP == 0) {
+	if (m_stop == 0 || NP == 0 || target_reached(prob,pop.champion().f,pop.champion().c,m_target)) {
 		return;
 	}
 
 	// Some dummies and temporary variables
-	decision_vector tmp_x(D), tmp_v(D);
-	double dummy, width;
+	std::vector<decision_vector> tmp_v;
+	std::vector<boost::uint32_t> seeds(m_n_trials);
+	std::vector<boost::shared_ptr<population> > trials(m_n_trials);
+	std::vector<std::vector<decision_vector> > trial_v(m_n_trials);
 
 	// Init the best fitness and constraint vector
 	population pert_pop(pop);
@@ -140,33 +223,34 @@ void mbh::evolve(population &pop) const
 	//mbh main loop
 	while (i<m_stop){
 
-		//1. Perturb the current population
-		pert_pop.clear();
-		for (population::size_type j =0; j < NP; ++j)
-		{
-			for (decision_vector::size_type k=0; k < Dc; ++k)
+		if (m_n_trials == 1) {
+			//1-2. Perturb the current population and evolve it with the selected algorithm
+			run_trial(pop,pert_pop,tmp_v,m_perturb,m_drng,m_urng,*m_local);
+		} else {
+			//1-2. Perturb and evolve the trials concurrently, then keep the best one (the first one in case of ties)
+			for (unsigned int t = 0; t < m_n_trials; ++t)
 			{
-				dummy = pop.get_individual(j).best_x[k];
-				width = m_perturb[k];
-				tmp_x[k] = boost::uniform_real<double>(std::max(dummy-width*(ub[k]-lb[k]),lb[k]),std::min(dummy+width*(ub[k]-lb[k]),ub[k]))(m_drng);
-				dummy = pop.get_individual(j).cur_v[k];
-				tmp_v[k] = boost::uniform_real<double>(dummy-width*(ub[k]-lb[k]),dummy+width*(ub[k]-lb[k]))(m_drng);
+				seeds[t] = m_urng();
+				trials[t].reset(new population(pop));
 			}
-
-			for (decision_vector::size_type k=Dc; k < D; ++k)
+			trial_task task(pop,*m_local,m_perturb,seeds,trials,trial_v);
+			util::parallel::for_each_index(m_n_trials,m_n_threads,task);
+			unsigned int best = 0;
+			for (unsigned int t = 1; t < m_n_trials; ++t)
 			{
-				dummy = pop.get_individual(j).best_x[k];
-				width = m_perturb[k];
-				tmp_x[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(m_urng);
-				dummy = pop.get_individual(j).cur_v[k];
-				tmp_v[k] = boost::uniform_int<int>(std::max(dummy-std::floor(width*(ub[k]-lb[k])),lb[k]),std::min(dummy+std::floor(width*(ub[k]-lb[k])),ub[k]))(m_urng);
+				if (prob.compare_fc(trials[t]->champion().f,trials[t]->champion().c,trials[best]->champion().f,trials[best]->champion().c)) {
+					best = t;
+				}
 			}
-			pert_pop.push_back(tmp_x);
-			pop.set_v(j,tmp_v);
+			pert_pop = *trials[best];
+			tmp_v.swap(trial_v[best]);
 		}
-
-		//2. Evolve population with selected algorithm
-		m_local->evolve(pert_pop); i++;
+		// The perturbed velocities go to the current population, as with a single trial
+		for (population::size_type j =0; j < NP; ++j)
+		{
+			pop.set_v(j,tmp_v[j]);
+		}
+		i++;
 		if (m_screen_output)
 		{
 			std::cout << i << ". " << "\tLocal solution: " << pert_pop.champion().f << "\tGlobal best: " << pop.champion().f;
@@ -189,6 +273,13 @@ void mbh::evolve(population &pop) const
 				pop.set_x(j,pert_pop.get_individual(j).best_x);
 				pop.set_v(j,pert_pop.get_individual(j).cur_v);
 			}
+			//4. Stop if the target has been reached
+			if (target_reached(prob,pop.champion().f,pop.champion().c,m_target)) {
+				if (m_screen_output) {
+					std::cout << "Target reached" << std::endl;
+				}
+				break;
+			}
 		}
 
 
@@ -221,6 +312,76 @@ void mbh::set_algorithm(const base &algo)
 	m_local = algo.clone();
 }
 
+/// Sets the number of perturbations tried at each iteration.
+/**
+ * With more than one trial, each iteration perturbs and evolves n_trials copies of the population, which can be run
+ * concurrently (see set_n_threads()), and the best of them is compared to the current population.
+ *
+ * @param[in] n_trials number of trials
+ * @throws value_error if n_trials is zero
+ */
+void mbh::set_n_trials(unsigned int n_trials)
+{
+	if (n_trials == 0) {
+		pagmo_throw(value_error,"the number of trials must be strictly positive");
+	}
+	m_n_trials = n_trials;
+}
+
+/// Gets the number of perturbations tried at each iteration.
+/**
+ * @return the number of trials
+ */
+unsigned int mbh::get_n_trials() const
+{
+	return m_n_trials;
+}
+
+/// Sets the maximum number of threads running the trials.
+/**
+ * The trials of an iteration are run concurrently, each on its own copy of the population and of the local algorithm.
+ * The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void mbh::set_n_threads(unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the maximum number of threads running the trials.
+/**
+ * @return the maximum number of threads
+ */
+unsigned int mbh::get_n_threads() const
+{
+	return m_n_threads;
+}
+
+/// Sets the target fitness.
+/**
+ * The iterations stop as soon as the champion is feasible and its fitness is not larger than the target in any objective.
+ *
+ * @param[in] target the target fitness, or an empty vector to stop only after the allowed non improving iterations
+ */
+void mbh::set_target(const fitness_vector &target)
+{
+	m_target = target;
+}
+
+/// Gets the target fitness.
+/**
+ * @return the target fitness (empty if there is none)
+ */
+fitness_vector mbh::get_target() const
+{
+	return m_target;
+}
+
 /// Extra human readable algorithm info.
 /**
  * @return a formatted string displaying the parameters of the algorithm.
@@ -231,6 +392,13 @@ std::string mbh::human_readable_extra() const
 	s << "algorithm: " << m_local->get_name() << ' ';
 	s << "stop:" << m_stop << ' ';
 	s << "perturb:" << m_perturb << ' ';
+	if (m_n_trials > 1) {
+		s << "trials:" << m_n_trials << ' ';
+		s << "threads:" << m_n_threads << ' ';
+	}
+	if (!m_target.empty()) {
+		s << "target:" << m_target << ' ';
+	}
 	return s.str();
 }
 
@@ -30,6 +30,7 @@
 #include "../config.h"
 #include "../population.h"
 #include "../serialization.h"
+#include "../types.h"
 #include "base.h"
 #include "cs.h"
 
@@ -66,6 +67,11 @@ namespace pagmo { namespace algorithm {
 
 @endverbatim
  *
+ * Several perturbations of the population can be tried at each iteration (see set_n_trials()), in which case the best
+ * of them is compared to the current population. The trials are independent and can be run concurrently (see
+ * set_n_threads()): each of them is perturbed and evolved with generators seeded from a sequence drawn at the beginning of
+ * the iteration, hence the results do not depend on the number of threads. Optionally, the iterations stop once a
+ * target fitness has been reached (see set_target()).
  *
  * @see http://arxiv.org/pdf/cond-mat/9803344 for the paper inroducing the basin hopping idea for a Lennard-Jones cluster optimization
  *
@@ -83,6 +89,12 @@ public:
 	std::string get_name() const;
 	base_ptr get_algorithm() const;
 	void set_algorithm(const base &);
+	void set_n_trials(unsigned int);
+	unsigned int get_n_trials() const;
+	void set_n_threads(unsigned int);
+	unsigned int get_n_threads() const;
+	void set_target(const fitness_vector &);
+	fitness_vector get_target() const;
 protected:
 	std::string human_readable_extra() const;
 private:
@@ -94,12 +106,21 @@ private:
 		ar & m_local;
 		ar & const_cast<int &>(m_stop);
 		ar & m_perturb;
+		ar & m_n_trials;
+		ar & m_n_threads;
+		ar & m_target;
 	}
 	base_ptr m_local;
 	// Consecutive non improving iterations
 	const int m_stop;
 	// Perturbation of the population
 	mutable std::vector<double> m_perturb;
+	// Perturbations tried at each iteration
+	unsigned int m_n_trials;
+	// Maximum number of threads running the trials
+	unsigned int m_n_threads;
+	// Fitness at which the iterations stop (no target if empty)
+	fitness_vector m_target;
 };
 
 }} //namespaces
@@ -22,8 +22,13 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -31,11 +36,68 @@
 #include "../population.h"
 #include "../problem/base.h"
 #include "../types.h"
+#include "../util/parallel.h"
 #include "base.h"
 #include "ms.h"
 
 namespace pagmo { namespace algorithm {
 
+namespace {
+
+// Best individual found by one restart.
+struct restart_result
+{
+	decision_vector		x;
+	decision_vector		v;
+	fitness_vector		f;
+	constraint_vector	c;
+};
+
+// Runs restart i on a fresh population and a fresh copy of the algorithm, both seeded with seeds[i]. Once a restart
+// has reached the target, the restarts following it are skipped: as the restarts are handed out in order, all those
+// preceding it have already started, and the merged result is the same as in the serial case.
+class restart_task
+{
+	public:
+		restart_task(const std::vector<problem::base_ptr> &probs, population::size_type np, const base &algo, const std::vector<boost::uint32_t> &seeds,
+			const fitness_vector &target, std::vector<restart_result> &results, std::size_t &n_merged):
+			m_probs(probs),m_np(np),m_algo(algo),m_seeds(seeds),m_target(target),m_results(results),m_n_merged(n_merged) {}
+		void operator()(const std::size_t &i, const unsigned int &worker)
+		{
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				if (i >= m_n_merged) {
+					return;
+				}
+			}
+			population working_pop(*m_probs[worker],static_cast<int>(m_np),m_seeds[i]);
+			const base_ptr algo = m_algo.clone();
+			algo->reset_rngs(m_seeds[i]);
+			algo->evolve(working_pop);
+			const population::individual_type &best = working_pop.get_individual(working_pop.get_best_idx());
+			restart_result &res = m_results[i];
+			res.x = best.cur_x;
+			res.v = best.cur_v;
+			res.f = best.cur_f;
+			res.c = best.cur_c;
+			if (base::target_reached(working_pop.problem(),res.f,res.c,m_target)) {
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				m_n_merged = std::min(m_n_merged,i + 1);
+			}
+		}
+	private:
+		const std::vector<problem::base_ptr>	&m_probs;
+		const population::size_type		m_np;
+		const base				&m_algo;
+		const std::vector<boost::uint32_t>	&m_seeds;
+		const fitness_vector			&m_target;
+		std::vector<restart_result>		&m_results;
+		std::size_t				&m_n_merged;
+		boost::mutex				m_mutex;
+};
+
+}
+
 /// Constructor.
 /**
  * Allows to specify in detail all the parameters of the algorithm.
@@ -44,7 +106,7 @@ namespace pagmo { namespace algorithm {
  * @param[in] starts number of multistarts
  * @throws value_error if starts is negative
  */
-ms::ms(const base &algorithm, int starts):base(),m_starts(starts)
+ms::ms(const base &algorithm, int starts):base(),m_starts(starts),m_n_threads(1)
 {
 	m_algorithm = algorithm.clone();
 	if (starts < 0) {
@@ -53,7 +115,7 @@ ms::ms(const base &algorithm, int starts):base(),m_starts(starts)
 }
 
 /// Copy constructor (deep copy).
-ms::ms(const ms &other):base(other),m_algorithm(other.m_algorithm->clone()),m_starts(other.m_starts) {}
+ms::ms(const ms &other):base(other),m_algorithm(other.m_algorithm->clone()),m_starts(other.m_starts),m_n_threads(other.m_n_threads),m_target(other.m_target) {}
 
 /// Clone method.
 base_ptr ms::clone() const
@@ -63,42 +125,69 @@ base_ptr ms::clone() const
 
 /// Evolve implementation.
 /**
- * Run the Multi-start algorithm
+ * Run the Multi-start algorithm. The restarts are run on up to get_n_threads() threads, and the best individual of
+ * each of them replaces the worst individual of pop if it is better.
  *
  * @param[in,out] pop input/output pagmo::population to be evolved.
+ *
+ * @throws value_error if the target and the fitness of the problem have different dimensions.
  */
 
 void ms::evolve(population &pop) const
 {
 	// Let's store some useful variables.
+	const problem::base &prob = pop.problem();
 	const population::size_type NP = pop.size();
 
+	if (!m_target.empty() && m_target.size() != prob.get_f_dimension()) {
+		pagmo_throw(value_error,"the dimension of the target does not match the fitness dimension of the problem");
+	}
+
 	// Get out if there is nothing to do.
 	if (m_starts == 0 || NP == 0) {
 		return;
 	}
 
-	// Local population used in the algorithm iterations.
-	population working_pop(pop);
+	// The seeds of the restarts, drawn in advance so that the results do not depend on the number of threads.
+	const std::size_t n_starts = static_cast<std::size_t>(m_starts);
+	std::vector<boost::uint32_t> seeds(n_starts);
+	for (std::size_t i = 0; i < n_starts; ++i) {
+		seeds[i] = m_urng();
+	}
+
+	// Each thread builds its populations from its own copy of the problem.
+	const unsigned int n_workers = static_cast<unsigned int>(std::min<std::size_t>(m_n_threads,n_starts));
+	std::vector<problem::base_ptr> probs;
+	for (unsigned int i = 0; i < n_workers; ++i) {
+		probs.push_back(prob.clone());
+	}
+
+	// ms main loop
+	std::vector<restart_result> results(n_starts);
+	std::size_t n_merged = n_starts;
+	restart_task task(probs,NP,*m_algorithm,seeds,m_target,results,n_merged);
+	util::parallel::for_each_index(n_starts,n_workers,task);
 
-	//ms main loop
-	for (int i=0; i< m_starts; ++i)
+	// Merge the best individuals in the restart order.
+	for (std::size_t i = 0; i < n_merged; ++i)
 	{
-		working_pop.reinit();
-		m_algorithm->evolve(working_pop);
-		if (working_pop.problem().compare_fc(working_pop.get_individual(working_pop.get_best_idx()).cur_f,working_pop.get_individual(working_pop.get_best_idx()).cur_c,
-			pop.get_individual(pop.get_worst_idx()).cur_f,pop.get_individual(pop.get_worst_idx()).cur_c
-		) )
+		const restart_result &res = results[i];
+		const population::size_type worst_idx = pop.get_worst_idx();
+		if (prob.compare_fc(res.f,res.c,pop.get_individual(worst_idx).cur_f,pop.get_individual(worst_idx).cur_c))
 		{
 			//update best population replacing its worst individual with the good one just produced.
-			pop.set_x(pop.get_worst_idx(),working_pop.get_individual(working_pop.get_best_idx()).cur_x);
-			pop.set_v(pop.get_worst_idx(),working_pop.get_individual(working_pop.get_best_idx()).cur_v);
+			pop.set_x(worst_idx,res.x);
+			pop.set_v(worst_idx,res.v);
 		}
 		if (m_screen_output)
 		{
-			std::cout << i << ". " << "\tCurrent iteration best: " << working_pop.get_individual(working_pop.get_best_idx()).cur_f << "\tOverall champion: " << pop.champion().f << std::endl;
+			std::cout << i << ". " << "\tCurrent iteration best: " << res.f << "\tOverall champion: " << pop.champion().f << std::endl;
 		}
 	}
+	if (m_screen_output && n_merged < n_starts)
+	{
+		std::cout << "Target reached after " << n_merged << " restarts" << std::endl;
+	}
 }
 
 
@@ -128,6 +217,52 @@ void ms::set_algorithm(const base &algo)
 	m_algorithm = algo.clone();
 }
 
+/// Sets the maximum number of threads running the restarts.
+/**
+ * If larger than one, the restarts are run concurrently, each on its own copy of the problem and of the algorithm.
+ * The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void ms::set_n_threads(unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the maximum number of threads running the restarts.
+/**
+ * @return the maximum number of threads
+ */
+unsigned int ms::get_n_threads() const
+{
+	return m_n_threads;
+}
+
+/// Sets the target fitness.
+/**
+ * The restarts stop as soon as one of them produces a feasible individual whose fitness is not larger than the
+ * target in any objective. The restarts following it are discarded, also those already running.
+ *
+ * @param[in] target the target fitness, or an empty vector to always run all the restarts
+ */
+void ms::set_target(const fitness_vector &target)
+{
+	m_target = target;
+}
+
+/// Gets the target fitness.
+/**
+ * @return the target fitness (empty if there is none)
+ */
+fitness_vector ms::get_target() const
+{
+	return m_target;
+}
+
 /// Extra human readable algorithm info.
 /**
  * @return a formatted string displaying the parameters of the algorithm.
@@ -137,6 +272,12 @@ std::string ms::human_readable_extra() const
 	std::ostringstream s;
 	s << "algorithm: " << m_algorithm->get_name() << ' ';
 	s << "iter:" << m_starts << ' ';
+	if (m_n_threads > 1) {
+		s << "threads:" << m_n_threads << ' ';
+	}
+	if (!m_target.empty()) {
+		s << "target:" << m_target << ' ';
+	}
 	return s.str();
 }
 
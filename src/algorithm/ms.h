@@ -30,6 +30,7 @@
 #include "../config.h"
 #include "../population.h"
 #include "../serialization.h"
+#include "../types.h"
 #include "base.h"
 #include "de.h"
 
@@ -52,6 +53,10 @@ namespace pagmo { namespace algorithm {
 > > evolve the population with the pagmo::algorithm
 @endverbatim
  *
+ * The restarts are independent and can be run concurrently (see set_n_threads()): restart i starts from a population
+ * and an algorithm seeded with the i-th of a sequence of seeds drawn at the beginning of evolve(), and the best individuals
+ * of the restarts are then merged in the restart order, hence the results do not depend on the number of threads.
+ * Optionally, the restarts stop once a target fitness has been reached (see set_target()).
  *
  * @author Dario Izzo (dario.izzo@googlemail.com)
  */
@@ -66,6 +71,10 @@ public:
 	std::string get_name() const;
 	base_ptr get_algorithm() const;
 	void set_algorithm(const base &);
+	void set_n_threads(unsigned int);
+	unsigned int get_n_threads() const;
+	void set_target(const fitness_vector &);
+	fitness_vector get_target() const;
 protected:
 	std::string human_readable_extra() const;
 private:
@@ -76,9 +85,15 @@ private:
 		ar & boost::serialization::base_object<base>(*this);
 		ar & m_algorithm;
 		ar & m_starts;
+		ar & m_n_threads;
+		ar & m_target;
 	}
 	base_ptr m_algorithm;
 	int m_starts;
+	// Maximum number of threads running the restarts
+	unsigned int m_n_threads;
+	// Fitness at which the restarts stop (no target if empty)
+	fitness_vector m_target;
 };
 
 }} //namespaces
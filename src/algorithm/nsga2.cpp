@@ -279,6 +279,13 @@ void nsga2::evolve(population &pop) const
 
 	// Main NSGA-II loop
 	for (int g = 0; g<m_gen; g++) {
+		// Stop at the generation boundary once the deadline has passed: the population is consistent here.
+		if (deadline_reached()) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- deadline reached" << std::endl;
+			}
+			return;
+		}
 		//At each generation we make a copy of the population into popnew
 		// We compute the crowding distance and the pareto rank of pop
 		pop.update_pareto_information();
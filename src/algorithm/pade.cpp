@@ -183,8 +183,11 @@ void pade::reksum(std::vector<std::vector<double> > &retval,
 	
 		} else if(m_weight_generation == LOW_DISCREPANCY) {
 			pagmo::util::discrepancy::simplex generator(n_f,1);
+			std::vector<double> points;
+			generator.generate(points,n_w);
+			retval.reserve(n_w);
 			for(unsigned int i = 0; i <n_w; ++i) {
-				retval.push_back(generator());
+				retval.push_back(fitness_vector(points.begin() + i*n_f, points.begin() + (i+1)*n_f));
 			}
 	
 		} else if(m_weight_generation == RANDOM) {
@@ -238,9 +241,9 @@ void pade::evolve(population &pop) const
 	// Generate the weights for the decomposed problems
 	std::vector<fitness_vector> weights = generate_weights(prob.get_f_dimension(), NP);
 	
-	// We then compute, for each weight vector, which ones are the closest ones (this will form the topology later on)
+	// We then compute, for each weight vector, which ones are the m_T closest ones (this will form the topology later on)
 	std::vector<std::vector<population::size_type> > indices;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(indices, weights);
+	pagmo::util::neighbourhood::euclidian::compute_neighbours(indices, weights, m_T + 1);
 
 	// Create the archipelago of NP islands:
 	// each island in the archipelago solves a different single-objective problem.
@@ -258,8 +261,12 @@ void pade::evolve(population &pop) const
 	// As m_T neighbours are connected, we replace m_T individuals on the island
 	const pagmo::migration::worst_r_policy replacement_policy(m_T);
 
+	// All the decomposed problems share the same instance of the original problem, and
+	// the fitnesses it computes (so that migrants are not evaluated again by every island)
+	const pagmo::problem::decompose::evaluation_store_ptr store(new pagmo::problem::decompose::evaluation_store(prob));
+
 	for(pagmo::population::size_type i=0; i<NP;++i) {
-		pagmo::problem::decompose decomposed_prob(prob, m_method,weights[i],m_z);
+		pagmo::problem::decompose decomposed_prob(store, m_method,weights[i],m_z);
 		pagmo::population decomposed_pop(decomposed_prob, 0, m_urng());
 
 		//Set the individuals of the new population as one individual of the original population plus m_T
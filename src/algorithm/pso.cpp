@@ -196,6 +196,13 @@ void pso::evolve(population &pop) const
 	 */
 	// For each generation
 	for( int g = 0; g < m_gen; ++g ){
+		// Stop at the generation boundary once the deadline has passed, still writing back the state below.
+		if (deadline_reached()) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- deadline reached" << std::endl;
+			}
+			break;
+		}
 		
 		best_fit_improved = false;
 		
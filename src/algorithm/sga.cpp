@@ -147,6 +147,13 @@ void sga::evolve(population &pop) const
 
 	// Main SGA loop
 	for (int j = 0; j<m_gen; j++) {
+		// Stop at the generation boundary once the deadline has passed: the population is consistent here.
+		if (deadline_reached()) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- deadline reached" << std::endl;
+			}
+			return;
+		}
 
 		switch (m_sel) {
 		case selection::BEST20: { //selects the best 20% and puts multiple copies in Xnew
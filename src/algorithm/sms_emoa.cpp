@@ -364,6 +364,13 @@ void sms_emoa::evolve(population &pop) const
 	
 	// Main SMS-EMOA loop
 	for (int g = 0; g < m_gen; g++) {
+		// Stop at the generation boundary once the deadline has passed: the population is consistent here.
+		if (deadline_reached()) {
+			if (m_screen_output) {
+				std::cout << "Exit condition -- deadline reached" << std::endl;
+			}
+			return;
+		}
 		// select two different parent indices from the population
 		parent1_idx = m_urng() % NP;
 		parent2_idx = ((m_urng() % (NP-1)) + parent1_idx) % NP;
@@ -37,6 +37,7 @@
 #include "../population.h"
 #include "../problem/base.h"
 #include "../population.h"
+#include "../util/knn.h"
 #include "../util/neighbourhood.h"
 #include "base.h"
 #include "spea2.h"
@@ -181,28 +182,30 @@ void spea2::evolve(population &pop) const
 
 			//computing K-NN distances for K=0,...,n_non_dominated
 			std::vector<std::vector<pagmo::population::size_type> > neighbours_nd;
-			pagmo::util::neighbourhood::euclidian::compute_neighbours(neighbours_nd, fit_nd);
+			std::vector<std::vector<double> > distances_nd;
+			pagmo::util::neighbourhood::knn(fit_nd).query_all(neighbours_nd, distances_nd, n_non_dominated);
 			std::vector<population::size_type> rv(n_non_dominated);
 			for(unsigned int i=0; i<n_non_dominated; ++i) rv[i] = i;
 
 			while(archive.size() > archive_size) {
 
 				//Calculate which is the worst element according to the distance sorter
-				pagmo::population::size_type idx_to_delete = *(std::max_element(rv.begin(), rv.end(), distance_sorter(neighbours_nd, fit_nd)));
+				pagmo::population::size_type idx_to_delete = *(std::max_element(rv.begin(), rv.end(), distance_sorter(distances_nd)));
 
-				//Remove the element from rv, archive and fit_nd
+				//Remove the element from rv and archive
 				rv.erase(rv.end()-1);
 				archive.erase(archive.begin() + idx_to_delete);
-				fit_nd.erase(fit_nd.begin() + idx_to_delete);
 
-				//Remove the row of neighbours_nd coresponding to idx_to_delete
+				//Remove the rows of neighbours_nd and distances_nd coresponding to idx_to_delete
 				neighbours_nd.erase(neighbours_nd.begin() + idx_to_delete);
+				distances_nd.erase(distances_nd.begin() + idx_to_delete);
 
 				for(unsigned int i=0; i < neighbours_nd.size(); ++i) {
 					for(unsigned int j=0; j < neighbours_nd[i].size(); ++j) {
 						//Remove all the occurencies of idx_to_delete
 						if (neighbours_nd[i][j] == idx_to_delete) {
 							neighbours_nd[i].erase(neighbours_nd[i].begin() + j);
+							distances_nd[i].erase(distances_nd[i].begin() + j);
 							j--;
 						//Adjust all the indexes after idx_to_delete
 						} else if (neighbours_nd[i][j] > idx_to_delete) {
@@ -349,8 +352,10 @@ void spea2::compute_spea2_fitness(std::vector<double> &F,
 		fit[i]	=	pop[i].f;
 		cons[i]	=	pop[i].c;
 	}
+	//Only the distance from the K-th neighbour is needed
 	std::vector<std::vector<pagmo::population::size_type> > neighbours;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(neighbours, fit);
+	std::vector<std::vector<double> > distances;
+	pagmo::util::neighbourhood::knn(fit).query_all(neighbours, distances, K + 1);
 
 	std::vector<std::vector<population::size_type> > domination_list = compute_domination_list(prob, fit,cons);
 
@@ -368,7 +373,7 @@ void spea2::compute_spea2_fitness(std::vector<double> &F,
 
 	for(unsigned int i=0; i<NP; ++i) {
 		F[i] = F[i] +
-				(1.0 / (pagmo::util::neighbourhood::euclidian::distance(fit[i], fit[neighbours[i][K]]) + 2));
+				(1.0 / (distances[i][K] + 2));
 	}
 }
 
@@ -34,32 +34,24 @@ namespace pagmo { namespace algorithm {
 
 class  distance_sorter {
 public:
-	distance_sorter(const std::vector<std::vector<pagmo::population::size_type>  > &neighbours,
-					const std::vector<fitness_vector> &fit):
-		m_neighbours(neighbours),
-		m_fit(fit) {}
+	distance_sorter(const std::vector<std::vector<double> > &distances):
+		m_distances(distances) {}
 	bool operator()(unsigned int a, unsigned int b) {
-		if(a>=m_fit.size() || a>=m_neighbours.size()){
-			pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-		}
-		if(b>=m_fit.size() || b>=m_neighbours.size()){
+		if(a>=m_distances.size() || b>=m_distances.size()){
 			pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
 		}
 		double delta_a, delta_b;
 		unsigned int i = 0;
 		do{
-			if(m_neighbours[b][i]>=m_fit.size() || m_neighbours[a][i]>=m_fit.size()){
-				pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-			}
-			delta_a = pagmo::util::neighbourhood::euclidian::distance(m_fit[a], m_fit[m_neighbours[a][i]]);
-			delta_b = pagmo::util::neighbourhood::euclidian::distance(m_fit[b], m_fit[m_neighbours[b][i]]);
+			delta_a = m_distances[a][i];
+			delta_b = m_distances[b][i];
 			i++;
-		} while (i<m_neighbours[0].size() && delta_a == delta_b);
+		} while (i<m_distances[0].size() && delta_a == delta_b);
 		return delta_a > delta_b;
 	}
 private:
-	const std::vector<std::vector<pagmo::population::size_type>  > &m_neighbours;
-	const std::vector<fitness_vector> &m_fit;
+	// distances[i][j] is the distance of the i-th individual from its j-th closest neighbour.
+	const std::vector<std::vector<double> > &m_distances;
 };
 
 /// "Strength Pareto Evolutionary Algorithm (SPEA2)"
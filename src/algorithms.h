@@ -59,6 +59,7 @@
 #include "algorithm/pade.h"
 #include "algorithm/nspso.h"
 #include "algorithm/spea2.h"
+#include "algorithm/async_evolution.h"
 
 // Hyper-heuristics
 #include "algorithm/mbh.h"
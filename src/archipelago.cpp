@@ -42,6 +42,7 @@
 #include "island.h"
 #include "population.h"
 #include "problem/base.h"
+#include "problem/base_stochastic.h"
 #include "rng.h"
 #include "topology/base.h"
 #include "topology/unconnected.h"
@@ -65,7 +66,8 @@ void archipelago::check_migr_attributes() const
  */
 archipelago::archipelago(distribution_type dt, migration_direction md):m_islands_sync_point(),m_topology(new topology::unconnected()),
 	m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),
+	m_saved_evals(0)
 {
 	check_migr_attributes();
 }
@@ -81,7 +83,8 @@ archipelago::archipelago(distribution_type dt, migration_direction md):m_islands
  */
 archipelago::archipelago(const topology::base &t, distribution_type dt, migration_direction md):
 	m_islands_sync_point(),m_topology(),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),
+	m_saved_evals(0)
 {
 	// NOTE: we cannot set the topology in the initialiser list directly,
 	// since we do not know if the topology is suitable. Set it here.
@@ -104,7 +107,8 @@ archipelago::archipelago(const topology::base &t, distribution_type dt, migratio
  */
 archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n, int m, const topology::base &t, distribution_type dt, migration_direction md):
 	m_islands_sync_point(),m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex(),
+	m_saved_evals(0)
 {
 	check_migr_attributes();
 	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
@@ -135,7 +139,8 @@ archipelago::archipelago(const archipelago &a)
 	m_migr_map = a.m_migr_map;
 	m_drng = a.m_drng;
 	m_urng = a.m_urng;
-	m_migr_hist = a.m_migr_hist;
+	m_migr_log = a.m_migr_log;
+	m_saved_evals = a.m_saved_evals;
 }
 
 /// Assignment operator.
@@ -163,7 +168,8 @@ archipelago &archipelago::operator=(const archipelago &a)
 		m_migr_map = a.m_migr_map;
 		m_drng = a.m_drng;
 		m_urng = a.m_urng;
-		m_migr_hist = a.m_migr_hist;
+		m_migr_log = a.m_migr_log;
+		m_saved_evals = a.m_saved_evals;
 	}
 	return *this;
 }
@@ -374,17 +380,27 @@ void archipelago::build_immigrants_vector(std::vector<std::pair<population::size
 	}
 }
 
-// Re-evaluate vector of immigrants before insertion into destination island.
-void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &immigrants, const base_island &isl) const
+// Re-evaluate vector of immigrants before insertion into destination island. Immigrants coming from an island
+// with an identical deterministic problem keep their fitness and constraints. Returns the number of immigrants
+// that were not re-evaluated.
+std::size_t archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &immigrants, const base_island &isl) const
 {
+	const size_type isl_idx = locate_island(isl);
+	std::size_t retval = 0;
 	individual_type tmp;
 	tmp.cur_v.resize(isl.m_pop.problem().get_dimension());
 	tmp.cur_f.resize(isl.m_pop.problem().get_f_dimension());
 	tmp.cur_c.resize(isl.m_pop.problem().get_c_dimension());
 	for (std::vector<std::pair<population::size_type, individual_type> >::iterator ind_it = immigrants.begin(); ind_it != immigrants.end(); ++ind_it) {
 		tmp.cur_x = (*ind_it).second.cur_x;
-		isl.m_pop.problem().objfun(tmp.cur_f,tmp.cur_x);
-		isl.m_pop.problem().compute_constraints(tmp.cur_c,tmp.cur_x);
+		if (m_prob_classes.size() == m_container.size() && m_prob_classes[(*ind_it).first] == m_prob_classes[isl_idx]) {
+			tmp.cur_f = (*ind_it).second.cur_f;
+			tmp.cur_c = (*ind_it).second.cur_c;
+			++retval;
+		} else {
+			isl.m_pop.problem().objfun(tmp.cur_f,tmp.cur_x);
+			isl.m_pop.problem().compute_constraints(tmp.cur_c,tmp.cur_x);
+		}
 		// Set the best properties to the current ones. (TODO: maybe here one could
 		// reevaluate the old best in the new environment and keep it if still better than the
 		// reevaluated current ...... discuss!! (Anche no, grazie!!)
@@ -393,6 +409,42 @@ void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_t
 		tmp.best_c = tmp.cur_c;
 		(*ind_it).second = tmp;
 	}
+	return retval;
+}
+
+// State of a problem, i.e., its serialization without the evaluation caches.
+static std::string problem_state(const problem::base &prob)
+{
+	std::ostringstream oss;
+	boost::archive::text_oarchive oa(oss,boost::archive::no_header | state_only_archive);
+	const problem::base *p = &prob;
+	oa << p;
+	return oss.str();
+}
+
+// Group the islands by problem. Islands whose problems are identical share the index of the first of them,
+// while stochastic problems are always in a class of their own, since the fitness of an individual depends
+// on the seed at the time of the evaluation. Must be called while the islands are not evolving.
+void archipelago::update_problem_classes()
+{
+	m_prob_classes.resize(m_container.size());
+	std::vector<std::string> states(m_container.size());
+	for (size_type i = 0; i < m_container.size(); ++i) {
+		m_prob_classes[i] = i;
+		const problem::base &prob = m_container[i]->m_pop.problem();
+		if (dynamic_cast<const problem::base_stochastic *>(&prob)) {
+			continue;
+		}
+		// NOTE: problem::base::operator==() only compares the parameters of the few problems overriding
+		// equality_operator_extra(), hence the comparison of the whole states.
+		states[i] = problem_state(prob);
+		for (size_type j = 0; j < i; ++j) {
+			if (m_prob_classes[j] == j && !states[j].empty() && prob == m_container[j]->m_pop.problem() && states[i] == states[j]) {
+				m_prob_classes[i] = j;
+				break;
+			}
+		}
+	}
 }
 
 /// Sets the seed of the random number generators of the archipelago
@@ -445,16 +497,18 @@ void archipelago::pre_evolution(base_island &isl)
 			// For destination migration direction, items in the migration map behave like "outboxes", i.e. each one is a
 			// "database of best individuals" seen in the islands of the archipelago.
 			// Get neighbours connecting into isl.
-			const std::vector<topology::base::vertices_size_type> inv_adj_islands(m_topology->get_v_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			// NOTE: the range points into the topology, it does not allocate.
+			const topology::base::vertices_range inv_adj_islands(m_topology->get_inv_adjacent_range(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			const std::size_t n_inv_adj_islands = boost::numeric_cast<std::size_t>(inv_adj_islands.second - inv_adj_islands.first);
 			// Do something only if there are adjacent islands.
-			if (inv_adj_islands.size()) {
+			if (n_inv_adj_islands) {
 				switch (m_dist_type) {
 					case point_to_point:
 					{
 						lock_type lock(m_migr_mutex);
 						// Get the index of a random island connecting into isl.
-						boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,inv_adj_islands.size() - 1);
-						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(m_urng)]);
+						boost::uniform_int<std::size_t> u_int(0,n_inv_adj_islands - 1);
+						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands.first[u_int(m_urng)]);
 						// Get the immigrants from the outbox of the random island. Note the redundant information in the last
 						// argument of the function.
 						pagmo_assert(m_migr_map[rn_isl_idx].size() <= 1);
@@ -465,8 +519,8 @@ void archipelago::pre_evolution(base_island &isl)
 					{
 						lock_type lock(m_migr_mutex);
 						// For broadcast migration fetch immigrants from all neighbour islands' databases.
-						for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < inv_adj_islands.size(); ++i) {
-							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[i]);
+						for (std::size_t i = 0; i < n_inv_adj_islands; ++i) {
+							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands.first[i]);
 							pagmo_assert(m_migr_map[src_isl_idx].size() <= 1);
 							build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,m_migr_map[src_isl_idx][src_isl_idx]);
 						}
@@ -483,20 +537,29 @@ void archipelago::pre_evolution(base_island &isl)
 		}
 		if (next_rng < isl.m_migr_prob) {
 			// We re-evaluate the incoming individuals according
-			// to destination island's problem. This will make sure that stochastic problems
-			// are correctly dealt with
-			reevaluate_immigrants(immigrants,isl);
-			// We then insert the incoming individuals into the population, storing how many from where
+			// to destination island's problem, unless it is identical to the one of the source island.
+			// This will make sure that stochastic problems are correctly dealt with
+			const std::size_t saved = reevaluate_immigrants(immigrants,isl);
+			if (saved) {
+				lock_type lock(m_migr_mutex);
+				m_saved_evals += saved;
+			}
+			// We then insert the incoming individuals into the population, storing how many from where and the fitness
+			// of the best individual accepted from each source island (according to the destination island's problem).
 			std::vector<std::pair<population::size_type, size_type> > rec_history;
-			rec_history = isl.accept_immigrants(immigrants);
-			lock_type lock(m_migr_mutex);
-			// Record the migration history.
+			std::vector<fitness_vector> best_f;
+			rec_history = isl.accept_immigrants(immigrants,best_f);
+			// Record the migration history (the log is thread-safe on its own).
+			const double timestamp = migration_log::now();
+			const size_type dst = locate_island(isl);
 			for (size_t i =0; i< rec_history.size(); ++i) {
-				m_migr_hist.push_back( boost::make_tuple(
-					rec_history[i].first,
-					rec_history[i].second,
-					locate_island(isl) )
-				);
+				migration_log::record r;
+				r.timestamp = timestamp;
+				r.src = boost::numeric_cast<boost::uint32_t>(rec_history[i].second);
+				r.dst = boost::numeric_cast<boost::uint32_t>(dst);
+				r.count = boost::numeric_cast<boost::uint32_t>(rec_history[i].first);
+				r.best_f = best_f[i][0];
+				m_migr_log.push_back(r);
 			}
 		}
 	}
@@ -520,8 +583,9 @@ void archipelago::post_evolution(base_island &isl)
 		case source:
 		{
 			// Get the islands to which isl connects.
-			const std::vector<topology::base::vertices_size_type> adj_islands(m_topology->get_v_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
-			if (adj_islands.size()) {
+			const topology::base::vertices_range adj_islands(m_topology->get_adjacent_range(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
+			const std::size_t n_adj_islands = boost::numeric_cast<std::size_t>(adj_islands.second - adj_islands.first);
+			if (n_adj_islands) {
 				emigrants = isl.get_emigrants();
 				// Do something only if we have emigrants.
 				if (emigrants.size()) {
@@ -531,8 +595,8 @@ void archipelago::post_evolution(base_island &isl)
 						{
 							lock_type lock(m_migr_mutex);
 							// For one-to-one migration choose a random neighbour island and put immigrants to its inbox.
-							boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,adj_islands.size() - 1);
-							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(m_urng)]);
+							boost::uniform_int<std::size_t> u_int(0,n_adj_islands - 1);
+							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands.first[u_int(m_urng)]);
 							m_migr_map[chosen_adj][isl_idx].insert(m_migr_map[chosen_adj][isl_idx].end(),emigrants.begin(),emigrants.end());
 							break;
 						}
@@ -540,9 +604,9 @@ void archipelago::post_evolution(base_island &isl)
 						{
 							lock_type lock(m_migr_mutex);
 							// For broadcast migration put immigrants to all neighbour islands' inboxes.
-							for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < adj_islands.size(); ++i) {
-								m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx]
-									.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx].end(),
+							for (std::size_t i = 0; i < n_adj_islands; ++i) {
+								m_migr_map[boost::numeric_cast<size_type>(adj_islands.first[i])][isl_idx]
+									.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands.first[i])][isl_idx].end(),
 									emigrants.begin(),emigrants.end());
 							}
 						}
@@ -571,6 +635,7 @@ void archipelago::post_evolution(base_island &isl)
 void archipelago::evolve(int n)
 {
 	join();
+	update_problem_classes();
 	const iterator it_f = m_container.end();
 	// Reset thread barrier.
 	reset_barrier(m_container.size());
@@ -592,6 +657,7 @@ void archipelago::evolve(int n)
 void archipelago::evolve_batch(int n, unsigned int b)
 {
 	join();
+	update_problem_classes();
 	for(size_type p = 0; p < m_container.size()/b + 1; ++p) {
 		if(p == m_container.size()/b) { //for the last batch of islands decrease the barrier
 			reset_barrier(m_container.size() - p*b);
@@ -616,6 +682,7 @@ void archipelago::evolve_batch(int n, unsigned int b)
 void archipelago::evolve_t(int t)
 {
 	join();
+	update_problem_classes();
 	const iterator it_f = m_container.end();
 	reset_barrier(m_container.size());
 	for (iterator it = m_container.begin(); it != it_f; ++it) {
@@ -717,17 +784,20 @@ void archipelago::sync_island_start() const
 
 /// Dumps the archipelago migration history
 /**
+ * Only the most recent migrations are kept in memory (see get_migr_log() and migration_log::set_capacity()).
+ *
  * @return A string formatted as follows: (x1,y1,z1)\n(x2,y2,z2)..... where x is the number of individuals
  * accepted in island z and coming from island y
  */
 std::string archipelago::dump_migr_history() const
 {
 	join();
+	const std::vector<migration_log::record> records(m_migr_log.get_records());
 	std::ostringstream oss;
-	for (migr_hist_type::const_iterator it = m_migr_hist.begin(); it != m_migr_hist.end(); ++it) {
-		oss << "(" << (*it).get<0>()
-			<< "," << (*it).get<1>()
-			<< "," << (*it).get<2>() << ")"
+	for (std::vector<migration_log::record>::const_iterator it = records.begin(); it != records.end(); ++it) {
+		oss << "(" << (*it).count
+			<< "," << (*it).src
+			<< "," << (*it).dst << ")"
 			<< '\n';
 	}
 	return oss.str();
@@ -741,7 +811,41 @@ std::string archipelago::dump_migr_history() const
 void archipelago::clear_migr_history()
 {
 	join();
-	m_migr_hist.clear();
+	m_migr_log.clear();
+}
+
+/// Migration log
+/**
+ * Gives access to the structured migration history, e.g. to change its capacity or to stream it to a file.
+ *
+ * @return reference to the migration log of the archipelago.
+ */
+migration_log &archipelago::get_migr_log()
+{
+	return m_migr_log;
+}
+
+/// Migration log
+/**
+ * @return const reference to the migration log of the archipelago.
+ */
+const migration_log &archipelago::get_migr_log() const
+{
+	return m_migr_log;
+}
+
+/// Number of saved function evaluations
+/**
+ * Immigrants coming from an island whose problem is identical to the one of the destination island (and not stochastic)
+ * keep their fitness and constraint vectors, instead of being re-evaluated. This counter reports how many such
+ * re-evaluations were avoided during the life of the archipelago.
+ *
+ * @return the number of immigrants inserted without re-evaluation.
+ */
+boost::uint64_t archipelago::get_saved_evaluations() const
+{
+	join();
+	return m_saved_evals;
 }
 
 /// Overload stream operator for pagmo::archipelago.
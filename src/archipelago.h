@@ -25,6 +25,7 @@
 #ifndef PAGMO_ARCHIPELAGO_H
 #define PAGMO_ARCHIPELAGO_H
 
+#include <boost/cstdint.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/thread/locks.hpp>
@@ -40,6 +41,7 @@
 #include "algorithm/base.h"
 #include "base_island.h"
 #include "config.h"
+#include "migration_log.h"
 #include "population.h"
 #include "problem/base.h"
 #include "rng.h"
@@ -116,10 +118,6 @@ class __PAGMO_VISIBLE archipelago
 		typedef boost::unordered_map<size_type,boost::unordered_map<size_type,std::vector<individual_type> > > migration_map_type;
 		// Lock type.
 		typedef boost::lock_guard<boost::mutex> lock_type;
-		// Migration history item: (n_individuals,orig_island,dest_island) tuple.
-		typedef boost::tuple<population::size_type,size_type,size_type> migr_hist_item;
-		// Container of migration history: vector of history items.
-		typedef std::vector<migr_hist_item> migr_hist_type;
 	public:
 		explicit archipelago(distribution_type = point_to_point, migration_direction = destination);
 		explicit archipelago(const topology::base &, distribution_type = point_to_point, migration_direction = destination);
@@ -143,6 +141,9 @@ class __PAGMO_VISIBLE archipelago
 		void interrupt();
 		std::string dump_migr_history() const;
 		void clear_migr_history();
+		migration_log &get_migr_log();
+		const migration_log &get_migr_log() const;
+		boost::uint64_t get_saved_evaluations() const;
 		void set_island(const size_type &, const base_island &);
 		std::vector<base_island_ptr> get_islands() const;
 		base_island_ptr get_island(const size_type &) const;
@@ -158,8 +159,9 @@ class __PAGMO_VISIBLE archipelago
 		void sync_island_start() const;
 		size_type locate_island(const base_island &) const;
 		bool destruction_checks() const;
-		void reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &,
+		std::size_t reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &,
 			const base_island &) const;
+		void update_problem_classes();
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -173,8 +175,6 @@ class __PAGMO_VISIBLE archipelago
 			ar & m_migr_map;
 			ar & m_drng;
 			ar & m_urng;
-			// NOTE: this would need tuple serialization...
-			//ar & m_migr_hist;
 			boost::serialization::split_member(ar, *this, version);
 		}
 
@@ -190,7 +190,10 @@ class __PAGMO_VISIBLE archipelago
 				m_container[i]->m_archi = this;
 			}
 			// NOTE: migr history is not saved, so upon loading we clear it.
-			m_migr_hist.clear();
+			m_migr_log.clear();
+			// Same for the problem classes and the evaluations counter.
+			m_prob_classes.clear();
+			m_saved_evals = 0;
 		}
 		// Container of islands.
 		container_type				m_container;
@@ -210,7 +213,11 @@ class __PAGMO_VISIBLE archipelago
 		// Migration mutex.
 		boost::mutex				m_migr_mutex;
 		// Migration history.
-		migr_hist_type				m_migr_hist;
+		migration_log				m_migr_log;
+		// For each island, index of the first island with an identical problem (see update_problem_classes()).
+		std::vector<size_type>			m_prob_classes;
+		// Number of function evaluations saved by not re-evaluating immigrants.
+		boost::uint64_t				m_saved_evals;
 
 };
 
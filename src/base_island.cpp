@@ -332,6 +332,20 @@ void base_island::evolve(int n)
 	}
 }
 
+// RAII class to bound the evolve() calls of an algorithm by a deadline.
+struct base_island::raii_deadline
+{
+	raii_deadline(algorithm::base &algo, const boost::posix_time::ptime &t):m_algo(algo)
+	{
+		m_algo.set_deadline(t);
+	}
+	~raii_deadline()
+	{
+		m_algo.clear_deadline();
+	}
+	algorithm::base &m_algo;
+};
+
 // Time-dependent evolver thread object. This is a callable helper object used to launch an evolution for a specified amount of time.
 struct base_island::t_evolver {
 	t_evolver(base_island *i, const std::size_t &t):m_i(i),m_t(t) {}
@@ -345,6 +359,9 @@ void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
 {
 	boost::posix_time::time_duration diff;
 	start = boost::posix_time::microsec_clock::local_time();
+	// The algorithm will return early from the evolution that crosses the time budget.
+	const raii_deadline deadline(*m_i->m_algo,boost::posix_time::microsec_clock::universal_time() +
+		boost::posix_time::milliseconds(boost::numeric_cast<long>(m_t)));
 	// Synchronise start.
 	if (m_i->m_archi) {
 		m_i->m_archi->sync_island_start();
@@ -398,6 +415,9 @@ void base_island::t_evolver::operator()()
  * Call the internal algorithm's algorithm::base::evolve() method on the population at least once, and keep calling it until at least t milliseconds
  * (in "wall clock" time) have elapsed. Will fail if t is negative.
  *
+ * For the whole duration of the call the algorithm is given a deadline (see algorithm::base::set_deadline()): the algorithms supporting it
+ * stop at the first generation boundary past t milliseconds, so that the last evolution does not overrun the time budget.
+ *
  * During evolution, the island is locked down and no actions on it are possible,
  * but the flow of the rest of the program might continue without waiting for all evolutions to finish. To explicitly block the program until all evolution runs
  * have been performed on the island, call the join() method.
@@ -579,10 +599,12 @@ struct unary_predicate {
 	std::pair<population::size_type, archipelago::size_type> m_pair;
 	
 };
-// Accept individuals incoming from a migration operation. Returns an std::vector containing the number of accepted individuals from each island
-std::vector<std::pair<population::size_type, archipelago::size_type> > base_island::accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &immigrant_pairs)
+// Accept individuals incoming from a migration operation. Returns an std::vector containing the number of accepted individuals from each island,
+// and stores in best_f the fitness of the best individual accepted from each of these islands.
+std::vector<std::pair<population::size_type, archipelago::size_type> > base_island::accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &immigrant_pairs, std::vector<fitness_vector> &best_f)
 {
 	std::vector<std::pair<population::size_type, archipelago::size_type> > retval;
+	best_f.clear();
 	// Make sure we are in an archipelago.
 	pagmo_assert(m_archi);
 	// We shuffle the immigrants as to make sure not to give preference to a particular island
@@ -608,11 +630,17 @@ std::vector<std::pair<population::size_type, archipelago::size_type> > base_isla
 		std::pair<population::size_type, archipelago::size_type> pair = std::make_pair(1.0, immigrant_pairs[(*rep_it).second].first);
 		std::vector<std::pair<population::size_type, archipelago::size_type> >::iterator where;
 		where = std::find_if(retval.begin(), retval.end(), unary_predicate(pair));
+		const fitness_vector &f = immigrants[(*rep_it).second].cur_f;
 		if (where == retval.end()) {
 			retval.push_back(pair);
+			best_f.push_back(f);
 		}
 		else {
 			(*where).first++;
+			fitness_vector &best = best_f[where - retval.begin()];
+			if (m_pop.problem().compare_fitness(f,best)) {
+				best = f;
+			}
 		}
 	}
 	return(retval);
@@ -148,7 +148,7 @@ class __PAGMO_VISIBLE base_island
 	private:
 		// NOTE: in the next code line, it should be std::vector<std::pair<population::size_type, archipelago::size_type> >,
 		// but this creates problems as at this point archipelago::siz_type is not defined and cannot be!!!
-		std::vector<std::pair<population::size_type, population::size_type> > accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &);
+		std::vector<std::pair<population::size_type, population::size_type> > accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &, std::vector<fitness_vector> &);
 		std::vector<population::individual_type> get_emigrants();
 		// Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
 		struct int_evolver;
@@ -157,6 +157,8 @@ class __PAGMO_VISIBLE base_island
 		// RAII threads hook object.
 		struct raii_thread_hook;
 		friend struct raii_thread_hook;
+		// RAII deadline object, bounding the evolutions performed by a t_evolver.
+		struct raii_deadline;
 	protected:
 		/// Algorithm.
 		algorithm::base_ptr			m_algo;
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "../population.h"
+#include "../problem/base.h"
 #include "base.h"
 #include "base_r_policy.h"
 #include "fair_r_policy.h"
@@ -66,6 +67,18 @@ struct indirect_individual_sorter
 	const population	&m_pop;
 };
 
+// Helper object used to sort arrays of indices of individuals by comparison of their current fitness and constraint vectors.
+struct cur_fc_sorter
+{
+	cur_fc_sorter(const std::vector<population::individual_type> &ind, const problem::base &prob):m_ind(ind),m_prob(prob) {}
+	bool operator()(const population::size_type &idx1, const population::size_type &idx2) const
+	{
+		return m_prob.compare_fc(m_ind[idx1].cur_f,m_ind[idx1].cur_c,m_ind[idx2].cur_f,m_ind[idx2].cur_c);
+	}
+	const std::vector<population::individual_type>	&m_ind;
+	const problem::base				&m_prob;
+};
+
 // Selection implementation.
 std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> >
 	fair_r_policy::select(const std::vector<population::individual_type> &immigrants, const population &dest) const
@@ -76,12 +89,35 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Defines the retvalue
 	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > result;
 
+	if (!rate_limit) {
+		return result;
+	}
+
+	if (dest.problem().get_f_dimension() == 1) {
+		// With a single objective, the ranking of the augmented population is the problem's comparison.
+		// The i-th best immigrant would replace the i-th worst native as long as it is better, so
+		// only the immigrants and the rate_limit worst natives need to be sorted.
+		std::vector<population::size_type> immigrants_idx(boost::numeric_cast<std::vector<population::size_type>::size_type>(rate_limit));
+		iota(immigrants_idx.begin(),immigrants_idx.end(),population::size_type(0));
+		std::sort(immigrants_idx.begin(),immigrants_idx.end(),cur_fc_sorter(immigrants,dest.problem()));
+		const std::vector<population::size_type> worst_idx(dest.get_worst_idx(rate_limit));
+		for (population::size_type i = 0; i < rate_limit; ++i) {
+			const population::individual_type &immigrant = immigrants[immigrants_idx[i]], &native = dest.get_individual(worst_idx[i]);
+			if (!dest.problem().compare_fc(immigrant.cur_f,immigrant.cur_c,native.cur_f,native.cur_c)) {
+				break;
+			}
+			result.push_back(std::make_pair(worst_idx[i],immigrants_idx[i]));
+		}
+		return result;
+	}
+
 	// Makes a copy of the destination population
 	population pop_copy(dest);
 	
-	// Creates a population combining all (INEFFICIENT: not-needed function evaluations are performed here)
+	// Creates a population combining all. The immigrants already carry their fitness and constraints
+	// in the destination problem, so no function evaluation is performed here.
 	for (population::size_type i  = 0; i < rate_limit; ++i) {
-		pop_copy.push_back(immigrants[i].cur_x);
+		pop_copy.push_back(immigrants[i].cur_x,immigrants[i].cur_f,immigrants[i].cur_c);
 	}
 	
 	// Extracts the best of the combined population
@@ -113,9 +113,9 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Makes a copy of the destination population
 	population pop_copy(dest);
 
-	// Merge the immigrants to the copy of the destination population
+	// Merge the immigrants to the copy of the destination population (without re-evaluating them)
 	for (population::size_type i  = 0; i < rate_limit; ++i) {
-		pop_copy.push_back(filtered_immigrants[i].cur_x);
+		pop_copy.push_back(filtered_immigrants[i].cur_x,filtered_immigrants[i].cur_f,filtered_immigrants[i].cur_c);
 	}
 
 	// Population fronts stored as indices of individuals.
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "../population.h"
+#include "../problem/base.h"
 #include "base.h"
 #include "base_r_policy.h"
 #include "worst_r_policy.h"
@@ -48,22 +49,33 @@ base_r_policy_ptr worst_r_policy::clone() const
 	return base_r_policy_ptr(new worst_r_policy(*this));
 }
 
-// Helper object used to sort arrays of indices of object placed in another container.
-template <class Container>
-struct indirect_individual_sorter
+// Helper object used to sort arrays of indices according to the number of dominated individuals,
+// computed once from the known fitness and constraint vectors.
+struct n_dominated_sorter
 {
-	indirect_individual_sorter(const Container &container, const population &pop):
-		m_container(container),m_pop(pop) {}
-	template <class Idx>
-	bool operator()(const Idx &idx1, const Idx &idx2) const
+	n_dominated_sorter(const std::vector<population::size_type> &n_dom, bool worst_first):m_n_dom(n_dom),m_worst_first(worst_first) {}
+	bool operator()(const population::size_type &idx1, const population::size_type &idx2) const
 	{
-		typedef typename Container::const_iterator::difference_type diff_type;
-		return m_pop.n_dominated(*(m_container.begin() + boost::numeric_cast<diff_type>(idx1))) >
-			m_pop.n_dominated(*(m_container.begin() + boost::numeric_cast<diff_type>(idx2)));
+		return m_worst_first ? m_n_dom[idx1] < m_n_dom[idx2] : m_n_dom[idx1] > m_n_dom[idx2];
 	}
-	// The original container.
-	const Container		&m_container;
-	const population	&m_pop;
+	// Number of individuals of the destination population dominated by each individual.
+	const std::vector<population::size_type>	&m_n_dom;
+	const bool					m_worst_first;
+};
+
+// Helper object used to sort arrays of indices by direct comparison of the best fitness and constraint vectors.
+struct best_fc_sorter
+{
+	best_fc_sorter(const std::vector<const population::individual_type *> &ind, const problem::base &prob, bool worst_first):
+		m_ind(ind),m_prob(prob),m_worst_first(worst_first) {}
+	bool operator()(const population::size_type &idx1, const population::size_type &idx2) const
+	{
+		const population::individual_type &i1 = *m_ind[m_worst_first ? idx2 : idx1], &i2 = *m_ind[m_worst_first ? idx1 : idx2];
+		return m_prob.compare_fc(i1.best_f,i1.best_c,i2.best_f,i2.best_c);
+	}
+	const std::vector<const population::individual_type *>	&m_ind;
+	const problem::base					&m_prob;
+	const bool						m_worst_first;
 };
 
 // Selection implementation.
@@ -77,12 +89,39 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Fill in the arrays of indices.
 	iota(immigrants_idx.begin(),immigrants_idx.end(),population::size_type(0));
 	iota(dest_idx.begin(),dest_idx.end(),population::size_type(0));
-	// Sort the arrays of indices.
-	// From best to worst.
-	std::sort(immigrants_idx.begin(),immigrants_idx.end(),indirect_individual_sorter<std::vector<population::individual_type> >(immigrants,dest));
-	// From worst to best.
-	std::sort(dest_idx.begin(),dest_idx.end(),indirect_individual_sorter<population>(dest,dest));
-	std::reverse(dest_idx.begin(),dest_idx.end());
+	// Only the first rate_limit positions are sorted: the best immigrants and the worst natives.
+	const std::vector<population::size_type>::iterator immigrants_mid = immigrants_idx.begin() + boost::numeric_cast<std::vector<population::size_type>::difference_type>(rate_limit),
+		dest_mid = dest_idx.begin() + boost::numeric_cast<std::vector<population::size_type>::difference_type>(rate_limit);
+	if (dest.problem().get_f_dimension() == 1) {
+		// With a single objective, ordering by number of dominated individuals is the same as ordering
+		// by direct comparison, which does not need to count them.
+		std::vector<const population::individual_type *> immigrants_ptr, dest_ptr;
+		immigrants_ptr.reserve(immigrants.size());
+		dest_ptr.reserve(dest.size());
+		for (std::vector<population::individual_type>::size_type i = 0; i < immigrants.size(); ++i) {
+			immigrants_ptr.push_back(&immigrants[i]);
+		}
+		for (population::const_iterator it = dest.begin(); it != dest.end(); ++it) {
+			dest_ptr.push_back(&*it);
+		}
+		// From best to worst.
+		std::partial_sort(immigrants_idx.begin(),immigrants_mid,immigrants_idx.end(),best_fc_sorter(immigrants_ptr,dest.problem(),false));
+		// From worst to best.
+		std::partial_sort(dest_idx.begin(),dest_mid,dest_idx.end(),best_fc_sorter(dest_ptr,dest.problem(),true));
+	} else {
+		// Count the individuals of the destination population dominated by each immigrant and native.
+		std::vector<population::size_type> immigrants_n_dom(immigrants_idx.size()), dest_n_dom(dest_idx.size());
+		for (std::vector<population::size_type>::size_type i = 0; i < immigrants_n_dom.size(); ++i) {
+			immigrants_n_dom[i] = dest.n_dominated(immigrants[i]);
+		}
+		for (std::vector<population::size_type>::size_type i = 0; i < dest_n_dom.size(); ++i) {
+			dest_n_dom[i] = dest.n_dominated(dest.get_individual(boost::numeric_cast<population::size_type>(i)));
+		}
+		// From best to worst.
+		std::partial_sort(immigrants_idx.begin(),immigrants_mid,immigrants_idx.end(),n_dominated_sorter(immigrants_n_dom,false));
+		// From worst to best.
+		std::partial_sort(dest_idx.begin(),dest_mid,dest_idx.end(),n_dominated_sorter(dest_n_dom,true));
+	}
 	// Create the result.
 	std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > result;
 	for (population::size_type i = 0; i < rate_limit; ++i) {
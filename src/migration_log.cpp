@@ -0,0 +1,312 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "exceptions.h"
+#include "migration_log.h"
+
+namespace pagmo {
+
+typedef boost::lock_guard<boost::mutex> lock_type;
+
+const std::size_t migration_log::record_size;
+
+/// Constructor.
+/**
+ * @param[in] capacity maximum number of records kept in memory.
+ *
+ * @throws value_error if capacity is zero.
+ */
+migration_log::migration_log(std::size_t capacity):m_capacity(capacity),m_start(0),m_n_recorded(0),m_n_dropped(0),m_stop(false)
+{
+	if (capacity == 0) {
+		pagmo_throw(value_error,"the capacity of the migration log must be strictly positive");
+	}
+}
+
+/// Copy constructor.
+/**
+ * Copies the records, but not the file sink.
+ *
+ * @param[in] l migration_log to be copied.
+ */
+migration_log::migration_log(const migration_log &l):m_n_dropped(0),m_stop(false)
+{
+	lock_type lock(l.m_mutex);
+	m_capacity = l.m_capacity;
+	m_ring = l.m_ring;
+	m_start = l.m_start;
+	m_n_recorded = l.m_n_recorded;
+}
+
+/// Assignment operator.
+/**
+ * Copies the records of l, but not its file sink. The file sink of this, if any, is kept open.
+ *
+ * @param[in] l migration_log used for assignment.
+ *
+ * @return reference to this.
+ */
+migration_log &migration_log::operator=(const migration_log &l)
+{
+	if (this != &l) {
+		const migration_log tmp(l);
+		lock_type lock(m_mutex);
+		m_capacity = tmp.m_capacity;
+		m_ring = tmp.m_ring;
+		m_start = tmp.m_start;
+		m_n_recorded = tmp.m_n_recorded;
+	}
+	return *this;
+}
+
+/// Destructor.
+/**
+ * Closes the file sink, if any.
+ */
+migration_log::~migration_log()
+{
+	close_sink();
+}
+
+/// Records a migration.
+/**
+ * @param[in] r the record.
+ */
+void migration_log::push_back(const record &r)
+{
+	lock_type lock(m_mutex);
+	if (m_ring.size() < m_capacity) {
+		m_ring.push_back(r);
+	} else {
+		m_ring[m_start] = r;
+		m_start = (m_start + 1) % m_capacity;
+	}
+	++m_n_recorded;
+	if (m_writer) {
+		if (m_pending.size() < m_capacity) {
+			m_pending.push_back(r);
+			m_pending_cv.notify_one();
+		} else {
+			++m_n_dropped;
+		}
+	}
+}
+
+/// Records in memory.
+/**
+ * @return the records currently kept in memory, oldest first.
+ */
+std::vector<migration_log::record> migration_log::get_records() const
+{
+	lock_type lock(m_mutex);
+	std::vector<record> retval(m_ring.begin() + m_start,m_ring.end());
+	retval.insert(retval.end(),m_ring.begin(),m_ring.begin() + m_start);
+	return retval;
+}
+
+/// Number of records in memory.
+std::size_t migration_log::size() const
+{
+	lock_type lock(m_mutex);
+	return m_ring.size();
+}
+
+/// Maximum number of records kept in memory.
+std::size_t migration_log::get_capacity() const
+{
+	lock_type lock(m_mutex);
+	return m_capacity;
+}
+
+/// Sets the maximum number of records kept in memory.
+/**
+ * If the new capacity is smaller than the number of records in memory, the oldest records are discarded.
+ *
+ * @param[in] capacity the new capacity.
+ *
+ * @throws value_error if capacity is zero.
+ */
+void migration_log::set_capacity(std::size_t capacity)
+{
+	if (capacity == 0) {
+		pagmo_throw(value_error,"the capacity of the migration log must be strictly positive");
+	}
+	std::vector<record> records(get_records());
+	if (records.size() > capacity) {
+		records.erase(records.begin(),records.end() - capacity);
+	}
+	lock_type lock(m_mutex);
+	m_ring.swap(records);
+	m_start = 0;
+	m_capacity = capacity;
+}
+
+/// Removes the records from memory.
+/**
+ * The file sink, if any, is not affected.
+ */
+void migration_log::clear()
+{
+	lock_type lock(m_mutex);
+	m_ring.clear();
+	m_start = 0;
+}
+
+/// Total number of migrations recorded (including the ones no longer in memory).
+boost::uint64_t migration_log::get_n_recorded() const
+{
+	lock_type lock(m_mutex);
+	return m_n_recorded;
+}
+
+/// Number of records dropped from the file sink because the writer could not keep up.
+boost::uint64_t migration_log::get_n_dropped() const
+{
+	lock_type lock(m_mutex);
+	return m_n_dropped;
+}
+
+/// Starts streaming the records to a file.
+/**
+ * The records pushed from now on are appended to the file by a background thread. An already open sink is closed first.
+ *
+ * @param[in] path path of the file.
+ *
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+void migration_log::open_sink(const std::string &path)
+{
+	close_sink();
+	m_sink.open(path.c_str(),std::ios::out | std::ios::binary | std::ios::app);
+	if (!m_sink) {
+		m_sink.clear();
+		pagmo_throw(std::runtime_error,"cannot open the migration log file " + path);
+	}
+	lock_type lock(m_mutex);
+	m_stop = false;
+	m_n_dropped = 0;
+	m_writer.reset(new boost::thread(&migration_log::write_loop,this));
+}
+
+/// Stops streaming the records to a file.
+/**
+ * Waits for the pending records to be written, then closes the file. Does nothing if no sink is open.
+ */
+void migration_log::close_sink()
+{
+	// The writer is detached from the log under the lock, so that the records pushed from now on are no longer
+	// queued: the writer drains the queue and nothing can be left over for the next sink.
+	boost::scoped_ptr<boost::thread> writer;
+	{
+		lock_type lock(m_mutex);
+		if (!m_writer) {
+			return;
+		}
+		m_stop = true;
+		writer.swap(m_writer);
+	}
+	m_pending_cv.notify_one();
+	writer->join();
+	m_sink.close();
+}
+
+// Body of the writer thread.
+void migration_log::write_loop()
+{
+	std::vector<record> batch;
+	while (true) {
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while (m_pending.empty() && !m_stop) {
+				m_pending_cv.wait(lock);
+			}
+			if (m_pending.empty()) {
+				return;
+			}
+			batch.swap(m_pending);
+		}
+		for (std::vector<record>::size_type i = 0; i < batch.size(); ++i) {
+			write_record(m_sink,batch[i]);
+		}
+		m_sink.flush();
+		batch.clear();
+	}
+}
+
+// Writes a record as timestamp, src, dst, count and best_f (record_size bytes).
+void migration_log::write_record(std::ostream &os, const record &r)
+{
+	os.write(reinterpret_cast<const char *>(&r.timestamp),sizeof(double));
+	os.write(reinterpret_cast<const char *>(&r.src),sizeof(boost::uint32_t));
+	os.write(reinterpret_cast<const char *>(&r.dst),sizeof(boost::uint32_t));
+	os.write(reinterpret_cast<const char *>(&r.count),sizeof(boost::uint32_t));
+	os.write(reinterpret_cast<const char *>(&r.best_f),sizeof(double));
+}
+
+/// Current time, in seconds since the UNIX epoch.
+double migration_log::now()
+{
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970,1,1));
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds() * 1e-6;
+}
+
+/// Reads the records streamed to a file.
+/**
+ * @param[in] path path of the file.
+ *
+ * @return the records in the file, in the order they were written.
+ *
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+std::vector<migration_log::record> migration_log::load(const std::string &path)
+{
+	std::ifstream is(path.c_str(),std::ios::in | std::ios::binary);
+	if (!is) {
+		pagmo_throw(std::runtime_error,"cannot open the migration log file " + path);
+	}
+	std::vector<record> retval;
+	record r;
+	while (is.read(reinterpret_cast<char *>(&r.timestamp),sizeof(double)) &&
+		is.read(reinterpret_cast<char *>(&r.src),sizeof(boost::uint32_t)) &&
+		is.read(reinterpret_cast<char *>(&r.dst),sizeof(boost::uint32_t)) &&
+		is.read(reinterpret_cast<char *>(&r.count),sizeof(boost::uint32_t)) &&
+		is.read(reinterpret_cast<char *>(&r.best_f),sizeof(double)))
+	{
+		retval.push_back(r);
+	}
+	return retval;
+}
+
+}
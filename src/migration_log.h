@@ -0,0 +1,108 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_MIGRATION_LOG_H
+#define PAGMO_MIGRATION_LOG_H
+
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+
+namespace pagmo {
+
+/// Migration log.
+/**
+ * Fixed-capacity ring buffer of binary migration records: once the capacity is reached, each new record overwrites the
+ * oldest one, so that the memory used does not grow over long runs. All methods are thread-safe, and recording a
+ * migration costs a copy of the record under a mutex.
+ *
+ * Optionally, the records can be streamed to a file sink, written by a background thread. Records waiting to be written
+ * are buffered up to the capacity of the log: if the writer falls further behind, the newest records are dropped from
+ * the stream (they are still recorded in the ring buffer) and counted. The file is a sequence of fixed-size records
+ * (see write_record()) in the native byte order, which can be read back with load().
+ */
+class __PAGMO_VISIBLE migration_log
+{
+	public:
+		/// Migration record.
+		struct record
+		{
+			/// Time of the migration, in seconds since the UNIX epoch.
+			double		timestamp;
+			/// Index of the source island.
+			boost::uint32_t	src;
+			/// Index of the destination island.
+			boost::uint32_t	dst;
+			/// Number of individuals accepted by the destination island.
+			boost::uint32_t	count;
+			/// First fitness component of the best individual from src accepted by dst.
+			double		best_f;
+		};
+		/// Size in bytes of a record in a file sink.
+		static const std::size_t record_size = 28;
+		explicit migration_log(std::size_t = 10000);
+		migration_log(const migration_log &);
+		migration_log &operator=(const migration_log &);
+		~migration_log();
+		void push_back(const record &);
+		std::vector<record> get_records() const;
+		std::size_t size() const;
+		std::size_t get_capacity() const;
+		void set_capacity(std::size_t);
+		void clear();
+		boost::uint64_t get_n_recorded() const;
+		boost::uint64_t get_n_dropped() const;
+		void open_sink(const std::string &);
+		void close_sink();
+		static double now();
+		static std::vector<record> load(const std::string &);
+	private:
+		static void write_record(std::ostream &, const record &);
+		void write_loop();
+		mutable boost::mutex			m_mutex;
+		std::size_t				m_capacity;
+		// Ring buffer: m_ring[m_start] is the oldest record once the buffer is full.
+		std::vector<record>			m_ring;
+		std::size_t				m_start;
+		boost::uint64_t				m_n_recorded;
+		// File sink: records waiting for the writer, writer thread and its state.
+		std::vector<record>			m_pending;
+		boost::uint64_t				m_n_dropped;
+		boost::condition_variable		m_pending_cv;
+		std::ofstream				m_sink;
+		boost::scoped_ptr<boost::thread>	m_writer;
+		bool					m_stop;
+};
+
+}
+
+#endif
@@ -28,6 +28,8 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <cmath>
+#include <fstream>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -40,6 +42,8 @@
 #include "population.h"
 #include "rng.h"
 #include "types.h"
+#include "util/batch_evaluator.h"
+#include "util/discrepancy.h"
 #include "util/racing.h"
 #include "util/race_pop.h"
 
@@ -58,7 +62,7 @@ problem::base_ptr &population_access::get_problem_ptr(population &pop)
 /// Constructor from problem::base and number of individuals.
 /**
  * Will store a copy of the problem and will initialise the population to n randomly-generated individuals.
- * Will fail if n is negative.
+ * Will fail if n is negative. Same as the constructor with the UNIFORM initialisation strategy and a single thread.
  *
  * @param[in] p problem::base that will be associated to the population.
  * @param[in] n integer number of individuals in the population.
@@ -67,31 +71,41 @@ problem::base_ptr &population_access::get_problem_ptr(population &pop)
  * @throw value_error if n is negative.
  */
 population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
+{
+	init(n,UNIFORM,1);
+}
+
+/// Constructor from problem::base, number of individuals and initialisation strategy.
+/**
+ * Will store a copy of the problem and will initialise the population to n decision vectors distributed according to type,
+ * evaluated as a single batch on up to n_threads threads (see reinit(init_type, unsigned int, const std::vector<decision_vector> &)).
+ * With the UNIFORM strategy, the population is the same as the one built by the constructor from problem and size with the same seed.
+ *
+ * @param[in] p problem::base that will be associated to the population.
+ * @param[in] n integer number of individuals in the population.
+ * @param[in] type initialisation strategy.
+ * @param[in] n_threads maximum number of threads used for the evaluations.
+ * @param[in] seed seed of the random number generators.
+ *
+ * @throws value_error if n is negative, or if n_threads is zero.
+ */
+population::population(const problem::base &p, int n, init_type type, unsigned int n_threads, const boost::uint32_t &seed):m_prob(p.clone()),
+	m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
+{
+	init(n,type,n_threads);
+}
+
+// Append n individuals and initialise them according to type (shared by the constructors).
+void population::init(int n, init_type type, unsigned int n_threads)
 {
 	if (n < 0) {
 		pagmo_throw(value_error,"number of individuals cannot be negative");
 	}
-	// Store sizes temporarily.
 	const size_type size = boost::numeric_cast<size_type>(n);
-	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
-	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
-	const decision_vector::size_type p_size = m_prob->get_dimension();
 	for (size_type i = 0; i < size; ++i) {
-		// Push back an empty individual.
-		m_container.push_back(individual_type());
-		m_dom_list.push_back(std::vector<size_type>());
-		m_dom_count.push_back(0);
-		// Resize individual's elements.
-		m_container.back().cur_x.resize(p_size);
-		m_container.back().cur_v.resize(p_size);
-		m_container.back().cur_c.resize(c_size);
-		m_container.back().cur_f.resize(f_size);
-		m_container.back().best_x.resize(p_size);
-		m_container.back().best_c.resize(c_size);
-		m_container.back().best_f.resize(f_size);
-		// Initialise randomly the individual.
-		reinit(i);
+		push_back_empty();
 	}
+	reinit(type,n_threads);
 }
 
 /// Copy constructor.
@@ -130,6 +144,25 @@ population &population::operator=(const population &p)
 	return *this;
 }
 
+// Rebuild the domination lists and the domination counts of all the individuals, in O(size()^2) comparisons.
+void population::update_dom()
+{
+	const size_type size = m_container.size();
+	pagmo_assert(m_dom_list.size() == size && m_dom_count.size() == size);
+	for (size_type i = 0; i < size; ++i) {
+		m_dom_list[i].clear();
+		m_dom_count[i] = 0;
+	}
+	for (size_type i = 0; i < size; ++i) {
+		for (size_type j = 0; j < size; ++j) {
+			if (i != j && m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[j].best_f,m_container[j].best_c)) {
+				m_dom_list[i].push_back(j);
+				++m_dom_count[j];
+			}
+		}
+	}
+}
+
 // Update the domination list and the domination count when the individual at position n has changed
 void population::update_dom(const size_type &n)
 {
@@ -223,6 +256,159 @@ void population::reinit()
 	}
 }
 
+/// Re-initialise all individuals with a given strategy.
+/**
+ * The first individuals take the decision vectors in seeds (e.g., known good solutions read with load_decision_vectors()),
+ * the others are distributed within the problem's bounds according to type. The integer part of the decision vectors
+ * is obtained by splitting the unit interval in as many slices as there are integers in the bounds. The low-discrepancy
+ * sequences always start from their first point, and the velocities are initialised randomly as in reinit(const size_type &).
+ *
+ * All the decision vectors are evaluated as a single batch on up to n_threads threads (see util::batch_evaluator),
+ * before the champion and the domination lists are updated.
+ *
+ * @param[in] type initialisation strategy.
+ * @param[in] n_threads maximum number of threads used for the evaluations.
+ * @param[in] seeds decision vectors of the first individuals.
+ *
+ * @throws value_error if there are more seeds than individuals, if a seed is not compatible with the problem,
+ * if n_threads is zero or if the dimension of the problem is too large for the low-discrepancy sequence.
+ */
+void population::reinit(init_type type, unsigned int n_threads, const std::vector<decision_vector> &seeds)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	if (seeds.size() > size()) {
+		pagmo_throw(value_error,"there are more seeds than individuals in the population");
+	}
+	for (std::vector<decision_vector>::size_type i = 0; i < seeds.size(); ++i) {
+		if (!m_prob->verify_x(seeds[i])) {
+			pagmo_throw(value_error,"seed decision vector is not compatible with problem");
+		}
+	}
+	const size_type n = size(), n_seeds = boost::numeric_cast<size_type>(seeds.size()), n_sampled = n - n_seeds;
+	const decision_vector::size_type p_size = m_prob->get_dimension(), i_size = m_prob->get_i_dimension();
+	const decision_vector &lb = m_prob->get_lb(), &ub = m_prob->get_ub();
+	std::vector<decision_vector> x(seeds);
+	x.resize(n,decision_vector(p_size));
+	// Points in the unit hypercube, for the strategies other than UNIFORM.
+	std::vector<double> u;
+	switch (type) {
+		case UNIFORM:
+			break;
+		case LATIN_HYPERCUBE:
+		{
+			u.resize(n_sampled * p_size);
+			std::vector<size_type> slices(n_sampled);
+			for (decision_vector::size_type j = 0; j < p_size; ++j) {
+				for (size_type i = 0; i < n_sampled; ++i) {
+					slices[i] = i;
+				}
+				for (size_type i = n_sampled; i > 1; --i) {
+					std::swap(slices[i - 1],slices[boost::uniform_int<size_type>(0,i - 1)(m_urng)]);
+				}
+				for (size_type i = 0; i < n_sampled; ++i) {
+					u[i * p_size + j] = (slices[i] + m_drng()) / n_sampled;
+				}
+			}
+			break;
+		}
+		case HALTON:
+			if (n_sampled) {
+				util::discrepancy::halton(boost::numeric_cast<unsigned int>(p_size)).generate(u,boost::numeric_cast<unsigned int>(n_sampled));
+			}
+			break;
+		case SOBOL:
+			if (n_sampled) {
+				util::discrepancy::sobol(boost::numeric_cast<unsigned int>(p_size)).generate(u,boost::numeric_cast<unsigned int>(n_sampled));
+			}
+			break;
+		default:
+			pagmo_throw(value_error,"unknown initialisation strategy");
+	}
+	for (size_type i = 0; i < n; ++i) {
+		decision_vector &xi = x[i];
+		if (i < n_seeds) {
+			// Seeds are taken as they are.
+		} else if (type == UNIFORM) {
+			// Same draws as reinit(const size_type &).
+			for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
+				xi[j] = boost::uniform_real<double>(lb[j],ub[j])(m_drng);
+			}
+			for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
+				xi[j] = boost::uniform_int<int>(lb[j],ub[j])(m_urng);
+			}
+		} else {
+			const double *ui = &u[(i - n_seeds) * p_size];
+			for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
+				xi[j] = std::min(lb[j] + ui[j] * (ub[j] - lb[j]),ub[j]);
+			}
+			for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
+				xi[j] = std::min(lb[j] + std::floor(ui[j] * (ub[j] - lb[j] + 1)),ub[j]);
+			}
+		}
+		m_container[i].cur_x = xi;
+		init_velocity(i);
+	}
+	// Evaluate everything at once.
+	std::vector<fitness_vector> f;
+	std::vector<constraint_vector> c;
+	util::batch_evaluator(*m_prob,n_threads).evaluate(x,f,c);
+	for (size_type i = 0; i < n; ++i) {
+		m_container[i].cur_f = f[i];
+		m_container[i].cur_c = c[i];
+		m_container[i].best_x = m_container[i].cur_x;
+		m_container[i].best_f = m_container[i].cur_f;
+		m_container[i].best_c = m_container[i].cur_c;
+		update_champion(i);
+	}
+	update_dom();
+}
+
+/// Read decision vectors from a text file
+/**
+ * Each non-empty line of the file contains the whitespace separated components of one decision vector.
+ * Lines starting with '#' are ignored.
+ *
+ * @param[in] path path of the file.
+ *
+ * @return the decision vectors, in the order of the file.
+ *
+ * @throws io_error if the file cannot be opened.
+ * @throws value_error if a line contains something else than numbers.
+ */
+std::vector<decision_vector> population::load_decision_vectors(const std::string &path)
+{
+	std::ifstream file(path.c_str());
+	if (!file.is_open()) {
+		pagmo_throw(io_error,std::string("Error: file not found. I was looking for (") + path + ")");
+	}
+	std::vector<decision_vector> retval;
+	std::string line;
+	for (std::size_t line_n = 1; std::getline(file,line); ++line_n) {
+		std::istringstream iss(line);
+		decision_vector x;
+		double tmp;
+		while (iss >> tmp) {
+			x.push_back(tmp);
+		}
+		iss.clear();
+		std::string rest;
+		if (iss >> rest) {
+			if (x.empty() && rest[0] == '#') {
+				continue;
+			}
+			std::ostringstream oss;
+			oss << "invalid number in line " << line_n << " of " << path;
+			pagmo_throw(value_error,oss.str());
+		}
+		if (!x.empty()) {
+			retval.push_back(x);
+		}
+	}
+	return retval;
+}
+
 /// Re-initialise individual at position idx.
 /**
  * The continuous and integer parts of the chromosome will be picked randomly within the problem's bounds, the velocities
@@ -768,12 +954,67 @@ std::vector<population::size_type> population::get_best_idx(const population::si
 	for (population::size_type i=0; i<size(); ++i){
 		retval.push_back(i);
 	}
+	// Only the first N positions are sorted, in O(size() log N) comparisons. The full sort is kept
+	// when all the positions are requested, as it is faster and it does not change the order of ties.
 	if (m_prob->get_f_dimension() == 1) {
-		std::sort(retval.begin(),retval.end(),trivial_comparison_operator(*this));
+		if (N == size()) {
+			std::sort(retval.begin(),retval.end(),trivial_comparison_operator(*this));
+		} else {
+			std::partial_sort(retval.begin(),retval.begin() + N,retval.end(),trivial_comparison_operator(*this));
+		}
 	}
 	else {
 		update_pareto_information();
-		std::sort(retval.begin(),retval.end(),crowded_comparison_operator(*this));
+		if (N == size()) {
+			std::sort(retval.begin(),retval.end(),crowded_comparison_operator(*this));
+		} else {
+			std::partial_sort(retval.begin(),retval.begin() + N,retval.end(),crowded_comparison_operator(*this));
+		}
+	}
+	retval.resize(N);
+	return retval;
+}
+
+// Comparison operator with swapped arguments, used to sort from worst to best.
+template <class Comparison>
+struct reverse_comparison_operator
+{
+	reverse_comparison_operator(const Comparison &comp):m_comp(comp) {}
+	bool operator()(const population::size_type &idx1, const population::size_type &idx2) const
+	{
+		return m_comp(idx2,idx1);
+	}
+	Comparison m_comp;
+};
+
+/// Get positions of N worst individuals.
+/**
+ * Same ordering criterion as population::get_best_idx(const size_type &), with the worst individual in first position.
+ *
+ * @return a std::vector of positional indexes of the worst N individuals, from worst to best.
+ * @throws value_error if N is larger than the population size or the population is empty
+ */
+std::vector<population::size_type> population::get_worst_idx(const population::size_type& N) const
+{
+	if (!size()) {
+		pagmo_throw(value_error,"empty population, cannot compute position of worst individual");
+	}
+	if (N > size()) {
+		pagmo_throw(value_error,"Worst N individuals requested, but population has size smaller than N");
+	}
+	std::vector<population::size_type> retval;
+	retval.reserve(size());
+	for (population::size_type i=0; i<size(); ++i){
+		retval.push_back(i);
+	}
+	if (m_prob->get_f_dimension() == 1) {
+		std::partial_sort(retval.begin(),retval.begin() + N,retval.end(),
+			reverse_comparison_operator<trivial_comparison_operator>(trivial_comparison_operator(*this)));
+	}
+	else {
+		update_pareto_information();
+		std::partial_sort(retval.begin(),retval.begin() + N,retval.end(),
+			reverse_comparison_operator<crowded_comparison_operator>(crowded_comparison_operator(*this)));
 	}
 	retval.resize(N);
 	return retval;
@@ -900,6 +1141,41 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	m_prob->objfun(m_container[idx].cur_f,x);
 	// Update current constraints vector.
 	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	update_individual(idx);
+}
+
+/// Set the decision vector of individual at position idx to x, with known fitness and constraints.
+/**
+ * Same as set_x(), but the problem is not evaluated: f and c must be the fitness and constraint vectors of x (e.g., as
+ * computed in parallel on clones of the problem). Will update best values of individual and champion if needed.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] x decision vector to be set for the individual at position idx.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ *
+ * @throws value_error if x is not compatible with the problem, or f and c do not have the dimensions of the problem.
+ */
+void population::set_x(const size_type &idx, const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension() || c.size() != m_prob->get_c_dimension()) {
+		pagmo_throw(value_error,"fitness or constraint vector is not compatible with problem");
+	}
+	m_container[idx].cur_x = x;
+	m_container[idx].cur_f = f;
+	m_container[idx].cur_c = c;
+	update_individual(idx);
+}
+
+// Update the bests of the individual at position idx (after its current values have changed), the champion and the domination lists.
+void population::update_individual(const size_type &idx)
+{
 	// If needed, update the best decision, fitness and constraint vectors for the individual.
 	// NOTE: we update the bests in two cases:
 	// - the bests are empty, meaning they are not defined and we are being called by push_back()
@@ -971,6 +1247,42 @@ void population::push_back(const decision_vector &x)
 		pagmo_throw(value_error,"decision vector is not compatible with problem");
 
 	}
+	push_back_empty();
+	// Set the individual.
+	set_x(m_container.size() - 1,x);
+	// Initialise randomly the velocity vector.
+	init_velocity(m_container.size() - 1);
+}
+
+/// Append individual with given decision vector, fitness and constraints.
+/**
+ * Same as push_back(), but the problem is not evaluated (see set_x()).
+ *
+ * @param[in] x decision vector of the individual to be appended.
+ * @param[in] f fitness vector of x.
+ * @param[in] c constraint vector of x.
+ */
+void population::push_back(const decision_vector &x, const fitness_vector &f, const constraint_vector &c)
+{
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	push_back_empty();
+	try {
+		set_x(m_container.size() - 1,x,f,c);
+	} catch (...) {
+		// Leave the population as it was.
+		m_container.pop_back();
+		m_dom_list.pop_back();
+		m_dom_count.pop_back();
+		throw;
+	}
+	init_velocity(m_container.size() - 1);
+}
+
+// Append an individual whose current values are not set yet.
+void population::push_back_empty()
+{
 	// Store sizes temporarily.
 	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
 	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
@@ -986,10 +1298,6 @@ void population::push_back(const decision_vector &x)
 	m_container.back().cur_f.resize(f_size);
 	// NOTE: do not allocate space for bests, as they are not defined yet. set_x will take
 	// care of it.
-	// Set the individual.
-	set_x(m_container.size() - 1,x);
-	// Initialise randomly the velocity vector.
-	init_velocity(m_container.size() - 1);
 }
 
 /// Set the velocity vector of individual at position idx.
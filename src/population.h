@@ -193,7 +193,19 @@ class __PAGMO_VISIBLE population
 
 		/// Const iterator.
 		typedef container_type::const_iterator const_iterator;
+		/// Initialisation strategies.
+		/**
+		* Distributions of the decision vectors of a newly initialised population, within the problem's bounds.
+		*/
+		enum init_type
+		{
+			UNIFORM = 0, ///< Independent uniformly distributed decision vectors
+			LATIN_HYPERCUBE = 1, ///< Latin hypercube sample: one decision vector in each of the n slices of each dimension
+			HALTON = 2, ///< Halton low-discrepancy sequence (up to 10 dimensions)
+			SOBOL = 3 ///< Sobol low-discrepancy sequence (up to 40 dimensions)
+		};
 		explicit population(const problem::base &, int = 0, const boost::uint32_t &seed = getSeed());
+		population(const problem::base &, int, init_type, unsigned int = 1, const boost::uint32_t &seed = getSeed());
 		static const boost::uint32_t getSeed(){
 			return rng_generator::get<rng_uint32>()();
 		}
@@ -219,9 +231,12 @@ class __PAGMO_VISIBLE population
 		size_type get_best_idx() const;
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
+		std::vector<size_type> get_worst_idx(const size_type & N) const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_x(const size_type &, const decision_vector &, const fitness_vector &, const constraint_vector &);
 		void set_v(const size_type &, const decision_vector &);
 		void push_back(const decision_vector &);
+		void push_back(const decision_vector &, const fitness_vector &, const constraint_vector &);
 		void erase(const size_type &);
 		size_type size() const;
 		const_iterator begin() const;
@@ -229,6 +244,8 @@ class __PAGMO_VISIBLE population
 
 		void reinit(const size_type &);
 		void reinit();
+		void reinit(init_type, unsigned int = 1, const std::vector<decision_vector> & = std::vector<decision_vector>());
+		static std::vector<decision_vector> load_decision_vectors(const std::string &);
 		void clear();
 		double mean_velocity() const;
 
@@ -259,12 +276,17 @@ class __PAGMO_VISIBLE population
 		};
 
 	private:
+		void init(int, init_type, unsigned int);
 		void init_velocity(const size_type &);
 		void update_champion(const size_type &);
+		void update_individual(const size_type &);
+		void push_back_empty();
 
 		// Multi-objective stuff
 		void update_crowding_d(std::vector<size_type>) const;
 
+		void update_dom();
+
 	protected:
 		void update_dom(const size_type &);
 
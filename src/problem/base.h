@@ -145,6 +145,7 @@ class __PAGMO_VISIBLE base
 {
 		// Meta problems need to be able to access protected virtual functions
 		friend class base_meta;
+		friend class base_stochastic;
 		// Underlying containers used for caching decision and fitness vectors.
 		typedef boost::circular_buffer<decision_vector> decision_vector_cache_type;
 		typedef boost::circular_buffer<fitness_vector> fitness_vector_cache_type;
@@ -503,14 +504,16 @@ return base_ptr(new derived_problem(*this));
 			ar & m_lb;
 			ar & m_ub;
 			ar & const_cast<std::vector<double> &>(m_c_tol);
-			ar & m_decision_vector_cache_f;
-			ar & m_fitness_vector_cache;
-			ar & m_decision_vector_cache_c;
-			ar & m_constraint_vector_cache;
-			ar & m_tmp_f1;
-			ar & m_tmp_f2;
-			ar & m_tmp_c1;
-			ar & m_tmp_c2;
+			if (!(ar.get_flags() & state_only_archive)) {
+				ar & m_decision_vector_cache_f;
+				ar & m_fitness_vector_cache;
+				ar & m_decision_vector_cache_c;
+				ar & m_constraint_vector_cache;
+				ar & m_tmp_f1;
+				ar & m_tmp_f2;
+				ar & m_tmp_c1;
+				ar & m_tmp_c2;
+			}
 			ar & m_best_x;
 			ar & m_best_f;
 			ar & m_best_c;
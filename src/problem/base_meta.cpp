@@ -0,0 +1,260 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread/once.hpp>
+#include <boost/thread/tss.hpp>
+#include <cstddef>
+#include <deque>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "base.h"
+#include "base_meta.h"
+
+namespace pagmo { namespace problem {
+
+/// Default constructor (empty transformation).
+base_meta::affine_map::affine_map():m_clip(false) {}
+
+/// Constructor from a diagonal matrix
+/**
+ * @param[in] diagonal diagonal of the matrix A
+ * @param[in] offset the vector b
+ *
+ * @throws value_error if the sizes of diagonal and offset differ
+ */
+base_meta::affine_map::affine_map(const Eigen::VectorXd &diagonal, const Eigen::VectorXd &offset):
+	m_diagonal(diagonal),m_offset(offset),m_clip(false)
+{
+	if (diagonal.size() != offset.size()) {
+		pagmo_throw(value_error,"the sizes of the diagonal and of the offset must be equal");
+	}
+}
+
+/// Constructor from a dense matrix
+/**
+ * @param[in] matrix the matrix A
+ * @param[in] offset the vector b
+ *
+ * @throws value_error if the matrix is not square or its size differs from the one of offset
+ */
+base_meta::affine_map::affine_map(const Eigen::MatrixXd &matrix, const Eigen::VectorXd &offset):
+	m_matrix(matrix),m_offset(offset),m_clip(false)
+{
+	if (matrix.rows() != matrix.cols() || matrix.rows() != offset.size()) {
+		pagmo_throw(value_error,"the matrix must be square, with the size of the offset");
+	}
+}
+
+/// Clips the transformed vectors to [lb, ub]
+void base_meta::affine_map::set_clipping(const decision_vector &lb, const decision_vector &ub)
+{
+	if (lb.size() != ub.size() || (int)lb.size() != m_offset.size()) {
+		pagmo_throw(value_error,"the sizes of the clipping bounds must be equal to the size of the offset");
+	}
+	m_clip = true;
+	m_lb = Eigen::Map<const Eigen::VectorXd>(&lb[0],lb.size());
+	m_ub = Eigen::Map<const Eigen::VectorXd>(&ub[0],ub.size());
+}
+
+/// Composition with a subsequent transformation
+/**
+ * Replaces this transformation with the application of this transformation followed by next. This is not
+ * possible if this transformation clips its result and next is not diagonal or clips its result too, in which
+ * case nothing is done.
+ *
+ * @param[in] next transformation to be applied after this one
+ *
+ * @return true if the transformations were composed
+ */
+bool base_meta::affine_map::then(const affine_map &next)
+{
+	const bool next_diagonal = next.m_matrix.size() == 0;
+	if (next.m_offset.size() != m_offset.size() || (m_clip && (!next_diagonal || next.m_clip))) {
+		return false;
+	}
+	// Clipping commutes with the diagonal transformation, if the box is transformed accordingly
+	// (with swapped bounds where the diagonal is negative).
+	if (m_clip) {
+		for (int i = 0; i < m_offset.size(); ++i) {
+			double lb = next.m_diagonal(i) * m_lb(i) + next.m_offset(i);
+			double ub = next.m_diagonal(i) * m_ub(i) + next.m_offset(i);
+			if (next.m_diagonal(i) < 0) {
+				std::swap(lb,ub);
+			}
+			m_lb(i) = lb;
+			m_ub(i) = ub;
+		}
+	}
+	if (next.m_clip) {
+		m_lb = next.m_lb;
+		m_ub = next.m_ub;
+		m_clip = true;
+	}
+	if (next_diagonal) {
+		if (m_matrix.size() == 0) {
+			m_diagonal = next.m_diagonal.cwiseProduct(m_diagonal);
+		} else {
+			m_matrix = next.m_diagonal.asDiagonal() * m_matrix;
+		}
+		m_offset = next.m_diagonal.cwiseProduct(m_offset) + next.m_offset;
+	} else {
+		if (m_matrix.size() == 0) {
+			m_matrix = next.m_matrix * m_diagonal.asDiagonal();
+			m_diagonal.resize(0);
+		} else {
+			m_matrix = next.m_matrix * m_matrix;
+		}
+		m_offset = next.m_matrix * m_offset + next.m_offset;
+	}
+	return true;
+}
+
+/// Applies the transformation
+/**
+ * @param[out] out the transformed vector (resized if needed)
+ * @param[in] in the vector to be transformed
+ */
+void base_meta::affine_map::apply(decision_vector &out, const decision_vector &in) const
+{
+	pagmo_assert((int)in.size() == m_offset.size());
+	const std::size_t n = in.size();
+	out.resize(n);
+	if (m_matrix.size() == 0) {
+		for (std::size_t i = 0; i < n; ++i) {
+			out[i] = m_diagonal(i) * in[i] + m_offset(i);
+		}
+	} else {
+		Eigen::Map<Eigen::VectorXd> out_vec(&out[0],n);
+		out_vec.noalias() = m_matrix * Eigen::Map<const Eigen::VectorXd>(&in[0],n);
+		out_vec += m_offset;
+	}
+	if (m_clip) {
+		for (std::size_t i = 0; i < n; ++i) {
+			out[i] = std::min(std::max(out[i],m_lb(i)),m_ub(i));
+		}
+	}
+}
+
+// Collapses the affine transformations of this problem, and of the chain of affine meta-problems below it, into the
+// transformation to the innermost problem of the chain. Called once, at the first evaluation.
+void base_meta::fuse() const
+{
+	affine_map map;
+	if (!get_affine_map(map)) {
+		pagmo_throw(value_error,"the meta-problem is not an affine transformation of its original problem");
+	}
+	const base *target = m_original_problem.get();
+	while (true) {
+		const base_meta *meta = dynamic_cast<const base_meta *>(target);
+		affine_map next;
+		if (!meta || !meta->get_affine_map(next) || !map.then(next)) {
+			break;
+		}
+		target = meta->m_original_problem.get();
+	}
+	m_fused->map = map;
+	m_fused->problem = target;
+}
+
+namespace {
+
+// Transformed decision vectors of the affine evaluations of a thread, one per nesting level (the innermost problem of a
+// chain can itself lead to another chain, below a non-affine meta-problem).
+struct affine_workspace
+{
+	affine_workspace():depth(0) {}
+	std::deque<decision_vector>	vectors;
+	std::size_t			depth;
+};
+
+boost::thread_specific_ptr<affine_workspace> affine_workspaces;
+
+// Hands out the vector of the next nesting level of the calling thread, for the scope of an evaluation.
+class workspace_guard
+{
+	public:
+		workspace_guard():m_workspace(affine_workspaces.get())
+		{
+			if (!m_workspace) {
+				m_workspace = new affine_workspace();
+				affine_workspaces.reset(m_workspace);
+			}
+			if (m_workspace->depth == m_workspace->vectors.size()) {
+				m_workspace->vectors.push_back(decision_vector());
+			}
+			m_vector = &m_workspace->vectors[m_workspace->depth++];
+		}
+		~workspace_guard()
+		{
+			--m_workspace->depth;
+		}
+		decision_vector &get()
+		{
+			return *m_vector;
+		}
+	private:
+		workspace_guard(const workspace_guard &);
+		workspace_guard &operator=(const workspace_guard &);
+		affine_workspace	*m_workspace;
+		decision_vector		*m_vector;
+};
+
+}
+
+/// Fitness of an affine meta-problem
+/**
+ * Evaluates the innermost problem of the chain of affine meta-problems on the transformed decision vector.
+ * Meta-problems defining get_affine_map() can implement objfun_impl() with this method.
+ *
+ * @param[out] f fitness vector
+ * @param[in] x decision vector
+ */
+void base_meta::objfun_affine(fitness_vector &f, const decision_vector &x) const
+{
+	boost::call_once(m_fused->once,boost::bind(&base_meta::fuse,this));
+	workspace_guard y;
+	m_fused->map.apply(y.get(),x);
+	m_fused->problem->objfun_impl(f,y.get());
+}
+
+/// Constraints of an affine meta-problem
+/**
+ * Evaluates the constraints of the innermost problem of the chain of affine meta-problems on the transformed
+ * decision vector. Meta-problems defining get_affine_map() can implement compute_constraints_impl() with this method.
+ *
+ * @param[out] c constraint vector
+ * @param[in] x decision vector
+ */
+void base_meta::compute_constraints_affine(constraint_vector &c, const decision_vector &x) const
+{
+	boost::call_once(m_fused->once,boost::bind(&base_meta::fuse,this));
+	workspace_guard y;
+	m_fused->map.apply(y.get(),x);
+	m_fused->problem->compute_constraints_impl(c,y.get());
+}
+
+}}
@@ -26,7 +26,11 @@
 #define PAGMO_PROBLEM_BASE_META_H
 
 #include <string>
+#include <vector>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/once.hpp>
 
+#include "../Eigen/Dense"
 #include "../serialization.h"
 #include "ackley.h"
 #include "../types.h"
@@ -40,6 +44,18 @@ namespace pagmo{ namespace problem {
  * to compare fitness and constraints vectors are thus passed to the meta-problem.
  * The copy constructor is also implemented as to provide a deep copy of the object.
  *
+ * Meta-problems evaluate their original problem through objfun_original() and compute_constraints_original(),
+ * which skip the caches of the original problem (the meta-problem has its own). Meta-problems that only apply an affine
+ * transformation to the decision vector (e.g. shifted, rotated, normalized) describe it in get_affine_map() and are
+ * evaluated via objfun_affine() and compute_constraints_affine(): chains of such meta-problems are then collapsed into
+ * a single transformation, and the innermost non-affine problem is evaluated directly.
+ *
+ * Apart from pagmo::problem::surrogate, which refines its model, the evaluation of the meta-problems does not modify
+ * them (the affine transformations are collapsed once, at the first evaluation, and the work spaces belong to the
+ * evaluating thread). A
+ * meta-problem can thus be evaluated concurrently through objfun_impl() (e.g. by
+ * pagmo::problem::base_stochastic::objfun_seeded()) as long as its original problem can.
+ *
  * NOTE: The original problem can also have the virtual function compare_fitness_impl implemented
  * the meta-problem will make use of it. The custom implementaion, in this case, is expected to work
  * for generic dimensions of the fitness vector as metaproblems may transform this dimension at will.
@@ -52,12 +68,25 @@ class __PAGMO_VISIBLE base_meta : public base
 	public:
 		/// Constructor
 		base_meta(const base &p = ackley(1), int n=1, int ni=0, int nf=1, int nc=0, int nic=0, const std::vector<double>&c_tol = std::vector<double>()):
-			 base(n,ni,nf,nc,nic,c_tol), m_original_problem(p.clone()) {
+			 base(n,ni,nf,nc,nic,c_tol), m_original_problem(p.clone()), m_fused(new fused_chain()) {
 			 	//Setting the bounds according to the original problem
 				set_bounds(m_original_problem->get_lb(),m_original_problem->get_ub());
 			 }
 		/// Copy constructor
-		base_meta(const base_meta &p):base(p), m_original_problem(p.m_original_problem->clone()) {}
+		base_meta(const base_meta &p):base(p), m_original_problem(p.m_original_problem->clone()), m_fused(new fused_chain()) {}
+	protected:
+		/// Constructor sharing the original problem
+		/**
+		 * The original problem is not cloned: p will be shared with the other meta-problems constructed from it,
+		 * hence the derived class must only call its thread-safe const methods.
+		 */
+		base_meta(const base_ptr &p, int n, int ni, int nf, int nc, int nic, const std::vector<double>&c_tol):
+			 base(n,ni,nf,nc,nic,c_tol), m_original_problem(p), m_fused(new fused_chain()) {
+			 	//Setting the bounds according to the original problem
+				set_bounds(m_original_problem->get_lb(),m_original_problem->get_ub());
+			 }
+		/// Copy constructor sharing the original problem (instead of cloning it)
+		base_meta(const base_meta &p, const base_ptr &original):base(p), m_original_problem(original), m_fused(new fused_chain()) {}
 	protected:
 		bool compare_fitness_impl(const fitness_vector &f1, const fitness_vector &f2) const 
 			{return m_original_problem->compare_fitness_impl(f1,f2);}
@@ -67,16 +96,75 @@ class __PAGMO_VISIBLE base_meta : public base
 			{return m_original_problem->compare_constraints_impl(c1,c2);}
 		bool compare_fc_impl(const fitness_vector &f1, const constraint_vector &c1, const fitness_vector &f2, const constraint_vector &c2) const
 			{return m_original_problem->compare_fc_impl(f1,c1,f2,c2);}
+		/// Fitness of the original problem (without looking into its cache)
+		void objfun_original(fitness_vector &f, const decision_vector &x) const
+			{m_original_problem->objfun_impl(f,x);}
+		/// Constraints of the original problem (without looking into its cache)
+		void compute_constraints_original(constraint_vector &c, const decision_vector &x) const
+			{m_original_problem->compute_constraints_impl(c,x);}
+
+		/// Affine transformation of a decision vector
+		/**
+		 * Maps x to A x + b, where A is either a diagonal or a dense matrix, and optionally clips the result to a box.
+		 */
+		class __PAGMO_VISIBLE affine_map
+		{
+			public:
+				affine_map();
+				affine_map(const Eigen::VectorXd &, const Eigen::VectorXd &);
+				affine_map(const Eigen::MatrixXd &, const Eigen::VectorXd &);
+				void set_clipping(const decision_vector &, const decision_vector &);
+				bool then(const affine_map &);
+				void apply(decision_vector &, const decision_vector &) const;
+			private:
+				// Dense matrix (empty if the matrix is diagonal).
+				Eigen::MatrixXd	m_matrix;
+				// Diagonal of the matrix (if it is diagonal).
+				Eigen::VectorXd	m_diagonal;
+				Eigen::VectorXd	m_offset;
+				bool		m_clip;
+				Eigen::VectorXd	m_lb;
+				Eigen::VectorXd	m_ub;
+		};
+		/// Affine transformation applied to the decision vector before evaluating the original problem
+		/**
+		 * Meta-problems whose fitness and constraints are those of the original problem on an affine transformation of
+		 * the decision vector should return true and write in map the transformation. The default implementation returns false.
+		 *
+		 * @param[out] map the transformation
+		 *
+		 * @return true if the meta-problem is an affine transformation of the original problem
+		 */
+		virtual bool get_affine_map(affine_map &map) const
+			{(void)map; return false;}
+		void objfun_affine(fitness_vector &, const decision_vector &) const;
+		void compute_constraints_affine(constraint_vector &, const decision_vector &) const;
 	private:
+		void fuse() const;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
 		{
 			ar & boost::serialization::base_object<base>(*this);
 			ar & m_original_problem;
+			if (Archive::is_loading::value) {
+				m_fused.reset(new fused_chain());
+			}
 		}
 	protected:
 		base_ptr m_original_problem;
+	private:
+		// Transformation from the decision vector to the one of the innermost problem reached through affine
+		// meta-problems, and that innermost problem. They are set up once, at the first evaluation, and only read
+		// afterwards.
+		struct fused_chain
+		{
+			fused_chain():once(),problem(0) {}
+			boost::once_flag	once;
+			affine_map		map;
+			const base		*problem;
+		};
+		boost::scoped_ptr<fused_chain>	m_fused;
 };
 
 }} //namespaces
@@ -23,7 +23,9 @@
  *****************************************************************************/
 
 #include "base_stochastic.h"
+#include "../exceptions.h"
 #include "../serialization.h"
+#include "../types.h"
 
 namespace pagmo { namespace problem {
 
@@ -90,6 +92,151 @@ unsigned int base_stochastic::get_seed() const {
 	return m_seed;
 }
 
+/// Return fitness of pagmo::decision_vector for a given seed.
+/**
+ * Equivalent to:
+@verbatim
+fitness_vector f(get_f_dimension());
+objfun_seeded(f,x,seed);
+return f;
+@endverbatim
+ *
+ * @param[in] x decision vector whose fitness will be calculated.
+ * @param[in] seed seed the fitness will be computed for.
+ *
+ * @return fitness vector of x for the given seed.
+ */
+fitness_vector base_stochastic::objfun_seeded(const decision_vector &x, unsigned int seed) const
+{
+	fitness_vector f(get_f_dimension());
+	objfun_seeded(f,x,seed);
+	return f;
+}
+
+/// Write fitness of pagmo::decision_vector for a given seed into pagmo::fitness_vector.
+/**
+ * Will call objfun_seeded_impl() internally. Contrary to objfun(), the seed of the problem is neither used
+ * nor modified and no caching takes place: the result is the one objfun() would return after a call to set_seed(seed).
+ *
+ * @param[out] f fitness vector to which x's fitness will be written.
+ * @param[in] x decision vector whose fitness will be calculated.
+ * @param[in] seed seed the fitness will be computed for.
+ *
+ * @throws value_error if f's and/or x's dimensions are different from the corresponding dimensions of the problem.
+ */
+void base_stochastic::objfun_seeded(fitness_vector &f, const decision_vector &x, unsigned int seed) const
+{
+	if (f.size() != get_f_dimension()) {
+		pagmo_throw(value_error,"wrong fitness vector size when calling objective function");
+	}
+	if (x.size() != get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when calling objective function");
+	}
+	objfun_seeded_impl(f,x,seed);
+	if (f.size() != get_f_dimension()) {
+		pagmo_throw(value_error,"fitness dimension was changed inside objfun_seeded_impl()");
+	}
+}
+
+/// Return constraint vector of pagmo::decision_vector for a given seed.
+/**
+ * @param[in] x decision vector whose constraints will be computed.
+ * @param[in] seed seed the constraints will be computed for.
+ *
+ * @return constraint vector of x for the given seed.
+ */
+constraint_vector base_stochastic::compute_constraints_seeded(const decision_vector &x, unsigned int seed) const
+{
+	constraint_vector c(get_c_dimension());
+	compute_constraints_seeded(c,x,seed);
+	return c;
+}
+
+/// Write constraint vector of pagmo::decision_vector for a given seed into pagmo::constraint_vector.
+/**
+ * Will call compute_constraints_seeded_impl() internally. See objfun_seeded().
+ *
+ * @param[out] c constraint vector to which x's constraints will be written.
+ * @param[in] x decision vector whose constraints will be computed.
+ * @param[in] seed seed the constraints will be computed for.
+ *
+ * @throws value_error if c's and/or x's dimensions are different from the corresponding dimensions of the problem.
+ */
+void base_stochastic::compute_constraints_seeded(constraint_vector &c, const decision_vector &x, unsigned int seed) const
+{
+	if (c.size() != get_c_dimension()) {
+		pagmo_throw(value_error,"wrong constraint vector size when calling constraints function");
+	}
+	if (x.size() != get_dimension()) {
+		pagmo_throw(value_error,"wrong decision vector size when calling constraints function");
+	}
+	compute_constraints_seeded_impl(c,x,seed);
+	if (c.size() != get_c_dimension()) {
+		pagmo_throw(value_error,"constraints dimension was changed inside compute_constraints_seeded_impl()");
+	}
+}
+
+/// Implementation of the objective function for a given seed.
+/**
+ * The default implementation evaluates a clone of the problem whose seed has been set to seed.
+ * Problems reimplementing this method without touching any mutable member (and calling it with m_seed from
+ * objfun_impl()) can be safely shared among threads.
+ *
+ * @param[out] f fitness vector into which x's fitness will be written.
+ * @param[in] x decision vector whose fitness will be calculated.
+ * @param[in] seed seed the fitness will be computed for.
+ */
+void base_stochastic::objfun_seeded_impl(fitness_vector &f, const decision_vector &x, unsigned int seed) const
+{
+	base_ptr tmp = clone();
+	base_stochastic &prob = dynamic_cast<base_stochastic &>(*tmp);
+	prob.set_seed(seed);
+	prob.objfun(f,x);
+}
+
+/// Implementation of the constraints computation for a given seed.
+/**
+ * The default implementation works on a clone of the problem whose seed has been set to seed.
+ *
+ * @param[out] c constraint vector into which x's constraints will be written.
+ * @param[in] x decision vector whose constraints will be computed.
+ * @param[in] seed seed the constraints will be computed for.
+ */
+void base_stochastic::compute_constraints_seeded_impl(constraint_vector &c, const decision_vector &x, unsigned int seed) const
+{
+	base_ptr tmp = clone();
+	base_stochastic &prob = dynamic_cast<base_stochastic &>(*tmp);
+	prob.set_seed(seed);
+	prob.compute_constraints(c,x);
+}
+
+/// Evaluate a problem bypassing its caches.
+/**
+ * Meant to be used by meta-problems on the problem they wrap: as no cache is touched, concurrent calls
+ * are safe as long as the objective function of p does not use mutable members.
+ *
+ * @param[in] p problem to be evaluated.
+ * @param[out] f fitness vector into which x's fitness will be written.
+ * @param[in] x decision vector whose fitness will be calculated.
+ */
+void base_stochastic::objfun_uncached(const base &p, fitness_vector &f, const decision_vector &x)
+{
+	p.objfun_impl(f,x);
+}
+
+/// Compute the constraints of a problem bypassing its caches.
+/**
+ * See objfun_uncached().
+ *
+ * @param[in] p problem whose constraints will be computed.
+ * @param[out] c constraint vector into which x's constraints will be written.
+ * @param[in] x decision vector whose constraints will be computed.
+ */
+void base_stochastic::compute_constraints_uncached(const base &p, constraint_vector &c, const decision_vector &x)
+{
+	p.compute_constraints_impl(c,x);
+}
+
 }} //namespaces
 
 //BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::base_stochastic);
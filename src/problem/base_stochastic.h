@@ -43,6 +43,16 @@ namespace pagmo{ namespace problem {
  *
  * Look at pagmo::problem::inventory and pagmo::problem::spheres for a typical example.
  *
+ * The methods objfun_seeded() and compute_constraints_seeded() evaluate the problem for a seed passed as an argument,
+ * leaving the problem (and its caches) untouched. The default implementations work on a clone of the problem.
+ * Problems that reimplement objfun_seeded_impl() (and compute_constraints_seeded_impl()) without using any mutable
+ * member, e.g. drawing their random numbers from a local pagmo::rng_philox stream, and evaluating the problems they
+ * wrap through objfun_uncached(), can be shared among threads evaluating different seeds, provided that the wrapped
+ * problems can be evaluated concurrently too. This is the case of pagmo::problem::noisy and pagmo::problem::robust
+ * wrapping most problems and meta-problems (see pagmo::problem::base_meta), but not of problems keeping work spaces in
+ * mutable members (e.g. pagmo::problem::cec2013, pagmo::problem::tsp, pagmo::problem::golomb_ruler, the trajectory
+ * problems or pagmo::problem::surrogate): each thread must then use its own clone of the problem.
+ *
  * Optimization techniques (pagmo::algorithm) that want to deal with these types of problems
  * need to take care to change appropriately the seed during the optimization 
  * process as to avoid overfitting (that is to avoid solving the problem only for one
@@ -62,6 +72,16 @@ class __PAGMO_VISIBLE base_stochastic : public base
 
 		unsigned int get_seed() const;
 		void set_seed(unsigned int) const; //This is marked const as m_seed is mutable (needs to be)
+
+		fitness_vector objfun_seeded(const decision_vector &, unsigned int) const;
+		void objfun_seeded(fitness_vector &, const decision_vector &, unsigned int) const;
+		constraint_vector compute_constraints_seeded(const decision_vector &, unsigned int) const;
+		void compute_constraints_seeded(constraint_vector &, const decision_vector &, unsigned int) const;
+	protected:
+		virtual void objfun_seeded_impl(fitness_vector &, const decision_vector &, unsigned int) const;
+		virtual void compute_constraints_seeded_impl(constraint_vector &, const decision_vector &, unsigned int) const;
+		static void objfun_uncached(const base &, fitness_vector &, const decision_vector &);
+		static void compute_constraints_uncached(const base &, constraint_vector &, const decision_vector &);
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
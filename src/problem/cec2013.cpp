@@ -27,13 +27,11 @@
 #include <cmath>
 #include <string>
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <iterator>
 
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/shared_data.h"
 #include "cec2013.h"
 
 #define INF 1.0e99
@@ -53,6 +51,8 @@ namespace pagmo { namespace problem {
  *
  * @see http://web.mysites.ntu.edu.sg/epnsugan/PublicSite/Shared%20Documents/CEC2013/cec13-c-code.zip to find
  * the files
+ * The files are parsed once: see util::shared_data::from_text_file() for the binary cache written alongside them.
+ *
  * @throws io_error if the files are not found
  */
 cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::string& dir):base(d),m_problem_number(fun_id), m_y(d), m_z(d)
@@ -62,39 +62,20 @@ cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const std::str
 		pagmo_throw(value_error, "Error: CEC2013 Test functions are only defined for dimensions 2,5,10,20,30,40,50,60,70,80,90,100.");
 	}
 
-	// We create the full file name for the rotation matrix
-	std::string data_file_name(dir);
-	data_file_name.append("M_D");
-	data_file_name.append(boost::lexical_cast<std::string>(d));
-	data_file_name.append(".txt");
-	// And we read all datas into m_rotation_matrix
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for (") + data_file_name.c_str() + ")");
-	}
-	std::istream_iterator<double> start(data_file), end;
-	m_rotation_matrix = std::vector<double>(start,end);
-	data_file.close();
-	}
-
-	// We create the full file name for the shift vector
-	data_file_name = dir;
-	data_file_name.append("shift_data.txt");
-	// And we read all data into m_origin_shift
-	{
-	std::ifstream data_file(data_file_name.c_str());
-	if (!data_file.is_open()) {
-		pagmo_throw(io_error, std::string("Error: file not found. I was looking for ").append(data_file_name.c_str()));
-	}
-	std::istream_iterator<double> start(data_file), end;
-	m_origin_shift = std::vector<double>(start,end);
-	data_file.close();
-	}
+	// We read the rotation matrix and the shift vector. The tables are shared with all the copies of the problem,
+	// and with any other cec2013 instance built from the same files.
+	m_rotation_matrix = util::shared_data::from_text_file(dir + "M_D" + boost::lexical_cast<std::string>(d) + ".txt");
+	m_origin_shift = util::shared_data::from_text_file(dir + "shift_data.txt");
 	// Set bounds. All CEC2013 problems have the same bounds
 	set_bounds(-100,100);
 }
 
+// Constructor used by serialization: the tables will be loaded from the archive.
+cec2013::cec2013(unsigned int fun_id, problem::base::size_type d, const serialization_tag &):base(d),m_problem_number(fun_id), m_y(d), m_z(d)
+{
+	set_bounds(-100,100);
+}
+
 /// Clone method.
 base_ptr cec2013::clone() const
 {
@@ -108,115 +89,115 @@ void cec2013::objfun_impl(fitness_vector &f, const decision_vector &x) const
 	switch(m_problem_number)
 	{
 	case 1:
-		sphere_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		sphere_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),0);
 		f[0]+=-1400.0;
 		break;
 	case 2:
-		ellips_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ellips_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-1300.0;
 		break;
 	case 3:
-		bent_cigar_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bent_cigar_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-1200.0;
 		break;
 	case 4:
-		discus_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		discus_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-1100.0;
 		break;
 	case 5:
-		dif_powers_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		dif_powers_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),0);
 		f[0]+=-1000.0;
 		break;
 	case 6:
-		rosenbrock_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rosenbrock_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-900.0;
 		break;
 	case 7:
-		schaffer_F7_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schaffer_F7_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-800.0;
 		break;
 	case 8:
-		ackley_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		ackley_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-700.0;
 		break;
 	case 9:
-		weierstrass_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		weierstrass_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-600.0;
 		break;
 	case 10:
-		griewank_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		griewank_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-500.0;
 		break;
 	case 11:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		rastrigin_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),0);
 		f[0]+=-400.0;
 		break;
 	case 12:
-		rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		rastrigin_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-300.0;
 		break;
 	case 13:
-		step_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		step_rastrigin_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=-200.0;
 		break;
 	case 14:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		schwefel_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),0);
 		f[0]+=-100.0;
 		break;
 	case 15:
-		schwefel_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		schwefel_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=100.0;
 		break;
 	case 16:
-		katsuura_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		katsuura_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=200.0;
 		break;
 	case 17:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		bi_rastrigin_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),0);
 		f[0]+=300.0;
 		break;
 	case 18:
-		bi_rastrigin_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		bi_rastrigin_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=400.0;
 		break;
 	case 19:
-		grie_rosen_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		grie_rosen_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=500.0;
 		break;
 	case 20:
-		escaffer6_func(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		escaffer6_func(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=600.0;
 		break;
 	case 21:
-		cf01(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf01(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=700.0;
 		break;
 	case 22:
-		cf02(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],0);
+		cf02(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),0);
 		f[0]+=800.0;
 		break;
 	case 23:
-		cf03(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf03(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=900.0;
 		break;
 	case 24:
-		cf04(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf04(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=1000.0;
 		break;
 	case 25:
-		cf05(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf05(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=1100.0;
 		break;
 	case 26:
-		cf06(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf06(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=1200.0;
 		break;
 	case 27:
-		cf07(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf07(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=1300.0;
 		break;
 	case 28:
-		cf08(&x[0],&f[0],nx,&m_origin_shift[0],&m_rotation_matrix[0],1);
+		cf08(&x[0],&f[0],nx,m_origin_shift.data(),m_rotation_matrix.data(),1);
 		f[0]+=1400.0;
 		break;
 	default:
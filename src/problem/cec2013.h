@@ -26,11 +26,25 @@
 #define PAGMO_PROBLEM_CEC2013_H
 
 #include <string>
+#include <vector>
 
 #include "../serialization.h"
 #include "../types.h"
+#include "../util/shared_data.h"
 #include "base.h"
 
+namespace pagmo{ namespace problem { class cec2013; }}
+
+namespace boost { namespace serialization {
+
+template <class Archive>
+void save_construct_data(Archive &, const pagmo::problem::cec2013 *, const unsigned int);
+
+template <class Archive>
+inline void load_construct_data(Archive &, pagmo::problem::cec2013 *, const unsigned int);
+
+}}
+
 namespace pagmo{ namespace problem {
 
 /// The CEC 2013 problems: Real-Parameter Single Objective Optimization Competition
@@ -65,7 +79,7 @@ class __PAGMO_VISIBLE cec2013 : public base
 		 * @returns the origin shift
 		 *
 		 */
-		std::vector<double> origin_shift() const {return m_origin_shift;}
+		std::vector<double> origin_shift() const {return m_origin_shift.get();}
 		//@}
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
@@ -101,6 +115,13 @@ class __PAGMO_VISIBLE cec2013 : public base
 		void oszfunc (const double *, double *, int) const;
 		void cf_cal(const double *, double *, int, const double *,double *,double *,double *,int) const;
 
+		// Construction without reading the input files, the tables being then loaded from an archive.
+		struct serialization_tag {};
+		cec2013(unsigned int, problem::base::size_type, const serialization_tag &);
+		template <class Archive>
+		friend void boost::serialization::save_construct_data(Archive &, const cec2013 *, const unsigned int);
+		template <class Archive>
+		friend void boost::serialization::load_construct_data(Archive &, cec2013 *, const unsigned int);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -111,8 +132,9 @@ class __PAGMO_VISIBLE cec2013 : public base
 			ar & m_origin_shift;
 		}
 	const unsigned int m_problem_number;
-	std::vector<double> m_rotation_matrix;
-	std::vector<double> m_origin_shift;
+	// Read-only tables, shared among the copies of the problem.
+	util::shared_data m_rotation_matrix;
+	util::shared_data m_origin_shift;
 
 	// These are pre-allocated for speed, need not to be serialized
 	mutable std::vector<double> m_y;
@@ -121,6 +143,32 @@ class __PAGMO_VISIBLE cec2013 : public base
 
 }} //namespaces
 
+namespace boost { namespace serialization {
+
+template <class Archive>
+inline void save_construct_data(Archive &ar, const pagmo::problem::cec2013 *prob, const unsigned int)
+{
+	// Save data required to construct instance.
+	const unsigned int fun_id = prob->m_problem_number;
+	const pagmo::problem::base::size_type d = prob->get_dimension();
+	ar << fun_id;
+	ar << d;
+}
+
+template <class Archive>
+inline void load_construct_data(Archive &ar, pagmo::problem::cec2013 *prob, const unsigned int)
+{
+	// Retrieve data from archive required to construct new instance.
+	unsigned int fun_id;
+	pagmo::problem::base::size_type d;
+	ar >> fun_id;
+	ar >> d;
+	// Invoke inplace constructor, which does not need the input files.
+	::new(prob)pagmo::problem::cec2013(fun_id,d,pagmo::problem::cec2013::serialization_tag());
+}
+
+}} //namespaces
+
 BOOST_CLASS_EXPORT_KEY(pagmo::problem::cec2013);
 
 #endif
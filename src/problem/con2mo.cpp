@@ -99,10 +99,10 @@ base_ptr con2mo::clone() const
 void con2mo::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	constraint_vector c(m_original_problem->get_c_dimension(),0.);
-	m_original_problem->compute_constraints(c,x);
+	compute_constraints_original(c,x);
 
-	decision_vector original_f(m_original_problem->get_f_dimension(),0.);
-	m_original_problem->objfun(original_f,x);
+	fitness_vector original_f(m_original_problem->get_f_dimension(),0.);
+	objfun_original(original_f,x);
 
 	f_size_type original_nbr_obj = original_f.size();
 	c_size_type number_of_constraints = c.size();
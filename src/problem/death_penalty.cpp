@@ -83,10 +83,10 @@ base_ptr death_penalty::clone() const
 void death_penalty::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	constraint_vector c(m_original_problem->get_c_dimension(),0);
-	m_original_problem->compute_constraints(c,x);
+	compute_constraints_original(c,x);
 
 	if(m_original_problem->feasibility_c(c)) {
-		m_original_problem->objfun(f, x);
+		objfun_original(f, x);
 	} else {
 		double high_value = boost::numeric::bounds<double>::highest();
 
@@ -116,7 +116,7 @@ void death_penalty::objfun_impl(fitness_vector &f, const decision_vector &x) con
 		}
 		case WEIGHTED:
 		{
-			m_original_problem->objfun(f, x);
+			objfun_original(f, x);
 			const std::vector<double> &c_tol = m_original_problem->get_c_tol();
 
 			// modify equality constraints to behave as inequality constraints:
@@ -23,6 +23,7 @@
  *****************************************************************************/
 
 #include <cmath>
+#include <utility>
 #include <boost/random/uniform_real.hpp>
 
 #include "../exceptions.h"
@@ -60,7 +61,63 @@ decompose::decompose(const base & p, method_type method, const std::vector<doubl
 		 m_weights(weights),
 		 m_z(z)
 {
+	check_and_init(p);
+}
+
+// Original problem of a non-null evaluation store.
+static const base_ptr &store_problem(const decompose::evaluation_store_ptr &store)
+{
+	if (!store) {
+		pagmo_throw(value_error,"the evaluation store cannot be null");
+	}
+	return store->get_problem();
+}
 
+/**
+ * Constructor sharing the original problem through an evaluation store
+ *
+ * The decomposed problem evaluates the original problem held by the store via
+ * pagmo::problem::decompose::evaluation_store::objfun(), and its copies share it instead of cloning it.
+ *
+ * @param[in] store pagmo::problem::decompose::evaluation_store holding the problem to be decomposed
+ * @param[in] method decomposition method (WEIGHTS, TCHEBYCHEFF, BI)
+ * @param[in] weights the weight vector (by default is set to random weights)
+ * @param[in] z reference point (used in Tchebycheff and Boundary Intersection (BI) methods, by default it is set to 0)
+ *
+ * @throws value_error if store is null
+ */
+decompose::decompose(const evaluation_store_ptr &store, method_type method, const std::vector<double> & weights, const std::vector<double> & z):
+	base_meta(
+		 store_problem(store),
+		 store_problem(store)->get_dimension(),
+		 store_problem(store)->get_i_dimension(),
+		 1, //it transforms the problem into a single-objective problem
+		 store_problem(store)->get_c_dimension(),
+		 store_problem(store)->get_ic_dimension(),
+		 store_problem(store)->get_c_tol()),
+		 m_method(method),
+		 m_weights(weights),
+		 m_z(z),
+		 m_store(store)
+{
+	check_and_init(*m_original_problem);
+}
+
+/// Copy constructor
+/**
+ * The original problem is cloned, unless it is shared through an evaluation store.
+ */
+decompose::decompose(const decompose &p):
+	base_meta(p, p.m_store ? p.m_original_problem : p.m_original_problem->clone()),
+	m_method(p.m_method),
+	m_weights(p.m_weights),
+	m_z(p.m_z),
+	m_store(p.m_store)
+{}
+
+// Checks the parameters of the decomposition and sets the default ones.
+void decompose::check_and_init(const base &p)
+{
 	//0 - Check whether method is implemented
 	if(m_method != WEIGHTED && m_method != TCHEBYCHEFF && m_method != BI) {
 		pagmo_throw(value_error,"non existing decomposition method");
@@ -125,7 +182,11 @@ base_ptr decompose::clone() const
 void decompose::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	fitness_vector fit(m_original_problem->get_f_dimension());
-	m_original_problem->objfun(fit, x);
+	if (m_store) {
+		m_store->objfun(fit, x);
+	} else {
+		objfun_original(fit, x);
+	}
 
 	if(m_method == WEIGHTED) {
 		f[0] = 0.0;
@@ -187,6 +248,103 @@ const std::vector<double>& decompose::get_weights() const
 {
 	return m_weights;
 }
+
+/**
+ * Get the evaluation store
+ *
+ * \return the evaluation store shared by the problem (null if the problem owns its original problem)
+ */
+const decompose::evaluation_store_ptr &decompose::get_evaluation_store() const
+{
+	return m_store;
+}
+
+/**
+ * Constructor
+ *
+ * @param[in] p problem whose fitnesses will be stored
+ * @param[in] capacity maximum number of fitnesses stored (the oldest ones are dropped first)
+ *
+ * @throws value_error if capacity is zero
+ */
+decompose::evaluation_store::evaluation_store(const base &p, std::size_t capacity):
+	m_problem(p.clone()), m_capacity(capacity), m_n_evaluations(0), m_n_hits(0)
+{
+	if (capacity == 0) {
+		pagmo_throw(value_error,"the capacity of the evaluation store must be positive");
+	}
+}
+
+/// Fitness of the original problem
+/**
+ * Returns the stored fitness of x, if any, otherwise evaluates it on a clone of the original problem
+ * and stores it. Can be called concurrently by several threads.
+ *
+ * @param[out] f fitness vector to which x's fitness will be written.
+ * @param[in] x decision vector whose fitness will be calculated.
+ */
+void decompose::evaluation_store::objfun(fitness_vector &f, const decision_vector &x)
+{
+	base_ptr prob;
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		map_type::const_iterator it = m_fitnesses.find(x);
+		if (it != m_fitnesses.end()) {
+			f = it->second;
+			++m_n_hits;
+			return;
+		}
+		if (m_pool.empty()) {
+			prob = m_problem->clone();
+		} else {
+			prob = m_pool.back();
+			m_pool.pop_back();
+		}
+	}
+	// Evaluate outside of the lock. If some other thread is doing the same with x,
+	// the first result to be stored wins.
+	prob->objfun(f, x);
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	m_pool.push_back(prob);
+	++m_n_evaluations;
+	std::pair<map_type::iterator,bool> ins = m_fitnesses.insert(std::make_pair(x,f));
+	if (ins.second) {
+		m_order.push_back(&ins.first->first);
+		if (m_order.size() > m_capacity) {
+			m_fitnesses.erase(m_fitnesses.find(*m_order.front()));
+			m_order.pop_front();
+		}
+	}
+}
+
+/// Get the original problem
+/**
+ * @return the original problem, that must not be evaluated directly if shared among threads.
+ */
+const base_ptr &decompose::evaluation_store::get_problem() const
+{
+	return m_problem;
+}
+
+/// Get the maximum number of stored fitnesses
+std::size_t decompose::evaluation_store::get_capacity() const
+{
+	return m_capacity;
+}
+
+/// Get the number of evaluations of the original problem performed by the store
+std::size_t decompose::evaluation_store::get_n_evaluations() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_n_evaluations;
+}
+
+/// Get the number of fitnesses served from the store without evaluation
+std::size_t decompose::evaluation_store::get_n_hits() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_n_hits;
+}
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::decompose);
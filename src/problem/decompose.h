@@ -25,7 +25,15 @@
 #ifndef PAGMO_PROBLEM_DECOMPOSE_H
 #define PAGMO_PROBLEM_DECOMPOSE_H
 
+#include <cstddef>
+#include <deque>
 #include <string>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -69,15 +77,54 @@ class __PAGMO_VISIBLE decompose : public base_meta
 		 BI=2 ///< The Boundary Intersection method is used to perform the decomposition
 		};
 
+		/// Thread-safe store of the fitnesses of the original problem
+		/**
+		 * Decomposed problems built on the same store share a single instance of the original problem,
+		 * and remember its fitness on the most recent decision vectors, so that a decision vector seen by
+		 * several decomposed problems (e.g. through migration) is evaluated only once. Evaluations are performed
+		 * outside of the lock, on clones of the original problem taken from a pool that grows with the number of
+		 * threads evaluating concurrently.
+		 */
+		class __PAGMO_VISIBLE evaluation_store
+		{
+			public:
+				evaluation_store(const base &, std::size_t = 10000);
+				void objfun(fitness_vector &, const decision_vector &);
+				const base_ptr &get_problem() const;
+				std::size_t get_capacity() const;
+				std::size_t get_n_evaluations() const;
+				std::size_t get_n_hits() const;
+			private:
+				evaluation_store(const evaluation_store &);
+				evaluation_store &operator=(const evaluation_store &);
+				typedef boost::unordered_map<decision_vector,fitness_vector,boost::hash<decision_vector> > map_type;
+				const base_ptr				m_problem;
+				const std::size_t			m_capacity;
+				// Fitnesses, and their keys in insertion order (used to drop the oldest ones).
+				map_type				m_fitnesses;
+				std::deque<const decision_vector *>	m_order;
+				// Clones of the problem not in use.
+				std::vector<base_ptr>			m_pool;
+				std::size_t				m_n_evaluations;
+				std::size_t				m_n_hits;
+				mutable boost::mutex			m_mutex;
+		};
+		/// Shared pointer to an evaluation store
+		typedef boost::shared_ptr<evaluation_store> evaluation_store_ptr;
+
 		decompose(const base & = zdt(1,2), method_type = WEIGHTED, const std::vector<double> & = std::vector<double>(), const std::vector<double> & = std::vector<double>());
+		decompose(const evaluation_store_ptr &, method_type = WEIGHTED, const std::vector<double> & = std::vector<double>(), const std::vector<double> & = std::vector<double>());
+		decompose(const decompose &);
 		base_ptr clone() const;
 		std::string get_name() const;
 		const std::vector<double>& get_weights() const;
+		const evaluation_store_ptr &get_evaluation_store() const;
 
 	protected:
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
+		void check_and_init(const base &);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -86,10 +133,16 @@ class __PAGMO_VISIBLE decompose : public base_meta
 			ar & m_method;
 			ar & m_weights;
 			ar & m_z;
+			// The original problem might have been shared through an evaluation store: give to
+			// the deserialized problem its own copy.
+			if (Archive::is_loading::value) {
+				m_original_problem = m_original_problem->clone();
+			}
 		}
 		method_type m_method;
 		fitness_vector m_weights;
 		fitness_vector m_z;
+		evaluation_store_ptr m_store;
 };
 
 }} //namespaces
@@ -47,8 +47,8 @@ static const double knapsack_default_max_weight = 100;
  * - max_weight: 100
  */
 knapsack::knapsack():base_aco(boost::numeric_cast<int>(5),1,1),
-	m_values(knapsack_default_values,knapsack_default_values + 5),
-	m_weights(knapsack_default_weights,knapsack_default_weights + 5),
+	m_values(std::vector<double>(knapsack_default_values,knapsack_default_values + 5)),
+	m_weights(std::vector<double>(knapsack_default_weights,knapsack_default_weights + 5)),
 	m_max_weight(knapsack_default_max_weight)
 {
 	verify_init();
@@ -128,8 +128,8 @@ bool knapsack::equality_operator_extra(const base &other) const
 std::string knapsack::human_readable_extra() const
 {
 	std::ostringstream oss;
-	oss << "\tValues: " << m_values << '\n';
-	oss << "\tWeights: " << m_weights << '\n';
+	oss << "\tValues: " << m_values.get() << '\n';
+	oss << "\tWeights: " << m_weights.get() << '\n';
 	oss << "\tMax weight: " << m_max_weight << '\n';
 	return oss.str();
 }
@@ -140,7 +140,7 @@ void knapsack::verify_init() const
 	if (m_values.size() != m_weights.size() || m_max_weight <= 0) {
 		pagmo_throw(value_error,"invalid value(s) in construction of the knapsack problem");
 	}
-	for (std::vector<double>::size_type i = 0; i < m_values.size(); ++i) {
+	for (util::shared_data::size_type i = 0; i < m_values.size(); ++i) {
 		if (m_values[i] <= 0 || m_weights[i] <=  0) {
 			pagmo_throw(value_error,"invalid value(s) in construction of the knapsack problem");
 		}
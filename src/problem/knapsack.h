@@ -33,6 +33,7 @@
 #include "../config.h"
 #include "../serialization.h"
 #include "../types.h"
+#include "../util/shared_data.h"
 #include "base_aco.h"
 
 namespace pagmo { namespace problem {
@@ -105,12 +106,13 @@ class __PAGMO_VISIBLE knapsack: public base_aco
 		void serialize(Archive &ar, const unsigned int)
 		{
 			ar & boost::serialization::base_object<base>(*this);
-			ar & const_cast<std::vector<double> &>(m_values);
-			ar & const_cast<std::vector<double> &>(m_weights);
+			ar & const_cast<util::shared_data &>(m_values);
+			ar & const_cast<util::shared_data &>(m_weights);
 			ar & const_cast<double &>(m_max_weight);
 		}
-		const std::vector<double>	m_values;
-		const std::vector<double>	m_weights;
+		// Read-only tables, shared among the copies of the problem.
+		const util::shared_data		m_values;
+		const util::shared_data		m_weights;
 		const double			m_max_weight;
 };
 
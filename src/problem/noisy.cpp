@@ -60,8 +60,6 @@ noisy::noisy(const base & p, unsigned int trials, const double param_first, cons
 		 p.get_c_tol(), seed),
 	m_original_problem(p.clone()),
 	m_trials(trials),
-	m_normal_dist(0.0,1.0),
-	m_uniform_dist(0.0,1.0),
 	m_decision_vector_hash(),
 	m_param_first(param_first),
 	m_param_second(param_second),
@@ -78,8 +76,6 @@ noisy::noisy(const noisy &prob):
 	base_stochastic(prob),
 	m_original_problem(prob.m_original_problem->clone()),
 	m_trials(prob.m_trials),
-	m_normal_dist(0.0,1.0),
-	m_uniform_dist(0.0,1.0),
 	m_decision_vector_hash(),
 	m_param_first(prob.m_param_first),
 	m_param_second(prob.m_param_second),
@@ -128,65 +124,79 @@ double noisy::get_param_second() const
 /// Implementation of the objective function.
 /// Add noises to the computed fitness vector.
 void noisy::objfun_impl(fitness_vector &f, const decision_vector &x) const
+{
+	objfun_seeded_impl(f, x, m_seed);
+}
+
+/// Implementation of the constraints computation.
+/// Add noises to the computed constraint vector.
+void noisy::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+{
+	compute_constraints_seeded_impl(c, x, m_seed);
+}
+
+/// Implementation of the objective function for a given seed.
+/// The noise is drawn from a local stream, so that the problem can be shared among threads (if the original problem can, see base_stochastic).
+void noisy::objfun_seeded_impl(fitness_vector &f, const decision_vector &x, unsigned int seed) const
 {
 	//1 - Initialize a temporary fitness vector storing one trial result
 	//and we use it also to init the return value 
 	fitness_vector tmp(f.size(),0.0);
 	f=tmp;
-	//2 - We set the seed
-	m_drng.seed(m_seed+m_decision_vector_hash(x));
+	//2 - We open the noise stream of x
+	rng_philox drng = noise_stream(x, seed);
 	//3 - We average upon multiple runs
 	for (unsigned int j=0; j< m_trials; ++j) {
-		m_original_problem->objfun(tmp, x);
-		inject_noise_f(tmp);
+		objfun_uncached(*m_original_problem, tmp, x);
+		inject_noise(tmp, drng);
 		for (fitness_vector::size_type i=0; i<f.size();++i) {
 			f[i] = f[i] + tmp[i] / (double)m_trials;
 		}
 	}
 }
 
-/// Implementation of the constraints computation.
-/// Add noises to the computed constraint vector.
-void noisy::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+/// Implementation of the constraints computation for a given seed.
+/// The noise is drawn from a local stream, so that the problem can be shared among threads (if the original problem can, see base_stochastic).
+void noisy::compute_constraints_seeded_impl(constraint_vector &c, const decision_vector &x, unsigned int seed) const
 {
 	//1 - Initialize a temporary constraint vector storing one trial result
 	//and we use it also to init the return value 
 	constraint_vector tmp(c.size(),0.0);
 	c=tmp;
-	//2 - We set the seed
-	m_drng.seed(m_seed+m_decision_vector_hash(x));
+	//2 - We open the noise stream of x
+	rng_philox drng = noise_stream(x, seed);
 	//3 - We average upon multiple runs
 	for (unsigned int j=0; j< m_trials; ++j) {
-		m_original_problem->compute_constraints(tmp, x);
-		inject_noise_c(tmp);
+		compute_constraints_uncached(*m_original_problem, tmp, x);
+		inject_noise(tmp, drng);
 		for (constraint_vector::size_type i=0; i<c.size();++i) {
 			c[i] = c[i] + tmp[i] / (double)m_trials;
 		}
 	}
 }
 
-/// Apply noise on a fitness vector
-void noisy::inject_noise_f(fitness_vector& f) const
+/// Noise stream of a decision vector
+/**
+ * The stream is identified by the seed and by the hash of x, so that the same decision vector always
+ * receives the same noise for a given seed.
+ */
+rng_philox noisy::noise_stream(const decision_vector &x, unsigned int seed) const
 {
-	for(f_size_type i = 0; i < f.size(); i++){
-		if(m_noise_type == NORMAL){
-			f[i] += m_normal_dist(m_drng)*m_param_second+m_param_first;
-		}
-		else if(m_noise_type == UNIFORM){
-			f[i] += m_uniform_dist(m_drng)*(m_param_second-m_param_first)+m_param_first;
-		}
-	}
+	const std::size_t hash = m_decision_vector_hash(x);
+	return rng_philox(seed, static_cast<boost::uint32_t>(hash ^ (static_cast<boost::uint64_t>(hash) >> 32)));
 }
 
-/// Apply noise on a constraint vector
-void noisy::inject_noise_c(constraint_vector& c) const
+/// Apply noise on a fitness or constraint vector
+void noisy::inject_noise(std::vector<double> &v, rng_philox &drng) const
 {
-	for(c_size_type i = 0; i < c.size(); i++){
+	boost::normal_distribution<double> normal_dist(0.0,1.0);
+	boost::random::uniform_real_distribution<double> uniform_dist(0.0,1.0);
+	for(std::vector<double>::size_type i = 0; i < v.size(); i++){
 		if(m_noise_type == NORMAL){
-			c[i] += m_normal_dist(m_drng)*m_param_second+m_param_first;
+			v[i] += normal_dist(drng)*m_param_second+m_param_first;
 		}
 		else if(m_noise_type == UNIFORM){
-			c[i] += m_uniform_dist(m_drng)*(m_param_second-m_param_first)+m_param_first;
+			v[i] += uniform_dist(drng)*(m_param_second-m_param_first)+m_param_first;
 		}
 	}
 }
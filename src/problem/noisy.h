@@ -33,6 +33,7 @@
 #include "../serialization.h"
 #include "ackley.h"
 #include "../types.h"
+#include "../rng.h"
 #include "base_stochastic.h"
 
 
@@ -82,10 +83,12 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		void objfun_seeded_impl(fitness_vector &, const decision_vector &, unsigned int) const;
+		void compute_constraints_seeded_impl(constraint_vector &, const decision_vector &, unsigned int) const;
 
 	private:
-		void inject_noise_f(fitness_vector&) const;
-		void inject_noise_c(constraint_vector&) const;
+		rng_philox noise_stream(const decision_vector &, unsigned int) const;
+		void inject_noise(std::vector<double> &, rng_philox &) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -94,8 +97,6 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 			ar & boost::serialization::base_object<base_stochastic>(*this);
 			ar & m_original_problem;
 			ar & const_cast<unsigned int &>(m_trials);
-			ar & m_normal_dist;
-			ar & m_uniform_dist;
 			ar & m_param_first;
 			ar & m_param_second;
 			ar & m_noise_type;
@@ -103,9 +104,7 @@ class __PAGMO_VISIBLE noisy : public base_stochastic
 
 		base_ptr m_original_problem;
 		const unsigned int m_trials;
-		mutable boost::normal_distribution<double> m_normal_dist;
-		mutable boost::random::uniform_real_distribution<double> m_uniform_dist;
-		mutable boost::hash<std::vector<double> > m_decision_vector_hash;
+		boost::hash<std::vector<double> > m_decision_vector_hash;
 		double m_param_first;
 		double m_param_second;
 		noise_type m_noise_type;
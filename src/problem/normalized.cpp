@@ -87,16 +87,22 @@ decision_vector normalized::denormalize(const decision_vector& x) const
 /// (Wraps over the original implementation with translated input x)
 void normalized::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	decision_vector x_original = denormalize(x);
-	m_original_problem->objfun(f, x_original);
+	objfun_affine(f, x);
 }
 
 /// Implementation of the constraints computation.
 /// (Wraps over the original implementation with translated input x)
 void normalized::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	decision_vector x_original = denormalize(x);
-	m_original_problem->compute_constraints(c, x_original);
+	compute_constraints_affine(c, x);
+}
+
+/// The de-normalization, as an affine map.
+bool normalized::get_affine_map(affine_map &map) const
+{
+	map = affine_map(Eigen::VectorXd(Eigen::Map<const Eigen::VectorXd>(&m_normalization_scale[0], m_normalization_scale.size())),
+		Eigen::VectorXd(Eigen::Map<const Eigen::VectorXd>(&m_normalization_center[0], m_normalization_center.size())));
+	return true;
 }
 
 
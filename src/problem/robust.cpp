@@ -54,8 +54,6 @@ robust::robust(const base & p, unsigned int trials, const double param_rho, unsi
 		 p.get_ic_dimension(),
 		 p.get_c_tol(), seed),
 	m_original_problem(p.clone()),
-	m_normal_dist(0, 1),
-	m_uniform_dist(0, 1),
 	m_trials(trials),
 	m_rho(param_rho)
 {
@@ -69,7 +67,6 @@ robust::robust(const base & p, unsigned int trials, const double param_rho, unsi
 robust::robust(const robust &prob):
 	 base_stochastic(prob),
 	 m_original_problem(prob.m_original_problem->clone()),
-	 m_uniform_dist(0, prob.m_rho),
 	 m_trials(prob.m_trials),
 	 m_rho(prob.m_rho) {}
 
@@ -101,61 +98,77 @@ double robust::get_rho() const
 /// Implementation of the objective function.
 /// Add noises to the decision vector before calling the actual objective function.
 void robust::objfun_impl(fitness_vector &f, const decision_vector &x) const
+{
+	objfun_seeded_impl(f, x, m_seed);
+}
+
+/// Implementation of the constraints computation.
+/// Add noises to the decision vector before calling the actual constraint function.
+void robust::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+{
+	compute_constraints_seeded_impl(c, x, m_seed);
+}
+
+/// Implementation of the objective function for a given seed.
+/// The perturbations are drawn from a local stream, so that the problem can be shared among threads (if the original problem can, see base_stochastic).
+void robust::objfun_seeded_impl(fitness_vector &f, const decision_vector &x, unsigned int seed) const
 {
 	// Temporary storage used for averaging
 	fitness_vector tmp(f.size(),0.0);
 	f = tmp;
 
-	// Set the seed
-	m_drng.seed(m_seed);
+	// Open the stream of the seed
+	rng_philox drng(seed);
 
 	// Perturb decision vector and evaluate
 	decision_vector x_perturbed(x);
 	for(unsigned int i = 0; i < m_trials; ++i){
-		inject_noise_x(x_perturbed);
-		m_original_problem->objfun(tmp, x_perturbed);
+		inject_noise_x(x_perturbed, drng);
+		objfun_uncached(*m_original_problem, tmp, x_perturbed);
 		for(fitness_vector::size_type j = 0; j < f.size(); ++j){
 			f[j] += tmp[j] / (double)m_trials;
 		}
 	}
 }
 
-/// Implementation of the constraints computation.
-/// Add noises to the decision vector before calling the actual constraint function.
-void robust::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+/// Implementation of the constraints computation for a given seed.
+/// The perturbations are drawn from a local stream, so that the problem can be shared among threads (if the original problem can, see base_stochastic).
+void robust::compute_constraints_seeded_impl(constraint_vector &c, const decision_vector &x, unsigned int seed) const
 {
 	// Temporary storage used for averaging
 	constraint_vector tmp(c.size(), 0.0);
 	c = tmp;
 
-	// Set the seed
-	m_drng.seed(m_seed);
+	// Open the stream of the seed
+	rng_philox drng(seed);
 
 	// Perturb decision vector and evaluate
 	decision_vector x_perturbed(x);
 	for(unsigned int i = 0; i < m_trials; ++i){
-		inject_noise_x(x_perturbed);
-		m_original_problem->compute_constraints(tmp, x_perturbed);
+		inject_noise_x(x_perturbed, drng);
+		compute_constraints_uncached(*m_original_problem, tmp, x_perturbed);
 		for(constraint_vector::size_type j = 0; j < c.size(); ++j){
-			c[j] = tmp[j] / (double)m_trials;
+			c[j] += tmp[j] / (double)m_trials;
 		}
 	}
 }
 
 /// Apply noise on the decision vector based on rho
-void robust::inject_noise_x(decision_vector &x) const
+void robust::inject_noise_x(decision_vector &x, rng_philox &drng) const
 {
 	// We follow the algorithm at
 	// http://math.stackexchange.com/questions/87230/picking-random-points-in-the-volume-of-sphere-with-uniform-probability
+	boost::normal_distribution<double> normal_dist(0, 1);
+	boost::random::uniform_real_distribution<double> uniform_dist(0, 1);
 
 	// 0. Define the radius
-	double radius = m_rho * pow(m_uniform_dist(m_drng),1.0/x.size());
+	double radius = m_rho * pow(uniform_dist(drng),1.0/x.size());
 
 	// 1. Sampling N(0,1) on each dimension
 	std::vector<double> perturbation(x.size(), 0.0);
 	double c2=0;
 	for(size_type i = 0; i < perturbation.size(); i++){
-		perturbation[i] = m_normal_dist(m_drng);
+		perturbation[i] = normal_dist(drng);
 		c2 += perturbation[i]*perturbation[i];
 	}
 
@@ -33,6 +33,7 @@
 #include "../serialization.h"
 #include "ackley.h"
 #include "../types.h"
+#include "../rng.h"
 #include "base_stochastic.h"
 
 namespace pagmo{ namespace problem {
@@ -70,9 +71,11 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		void objfun_seeded_impl(fitness_vector &, const decision_vector &, unsigned int) const;
+		void compute_constraints_seeded_impl(constraint_vector &, const decision_vector &, unsigned int) const;
 
 	private:
-		void inject_noise_x(decision_vector &) const;
+		void inject_noise_x(decision_vector &, rng_philox &) const;
 
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -80,15 +83,11 @@ class __PAGMO_VISIBLE robust : public base_stochastic
 		{
 			ar & boost::serialization::base_object<base_stochastic>(*this);
 			ar & m_original_problem;
-			ar & m_normal_dist;
-			ar & m_uniform_dist;
 			ar & m_trials;
 			ar & m_rho;
 		}
 
 		base_ptr m_original_problem;
-		mutable boost::normal_distribution<double> m_normal_dist;
-		mutable boost::random::uniform_real_distribution<double> m_uniform_dist;
 		unsigned int m_trials;
 		double m_rho;
 };
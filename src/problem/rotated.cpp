@@ -242,14 +242,24 @@ decision_vector rotated::derotate(const decision_vector& x_normed) const
 /// (Wraps over the original implementation with de-rotated input)
 void rotated::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	m_original_problem->objfun(f, derotate(x));
+	objfun_affine(f, x);
 }
 
 /// Implementation of the constraints computation.
 /// (Wraps over the original implementation with de-rotated input)
 void rotated::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	m_original_problem->compute_constraints(c, derotate(x));
+	compute_constraints_affine(c, x);
+}
+
+/// The de-rotation and de-normalization (followed by the projection to the original bounds), as an affine map.
+bool rotated::get_affine_map(affine_map &map) const
+{
+	const Eigen::VectorXd scale = Eigen::Map<const Eigen::VectorXd>(&m_normalize_scale[0], m_normalize_scale.size());
+	map = affine_map(Eigen::MatrixXd(scale.asDiagonal() * m_InvRotate),
+		Eigen::VectorXd(Eigen::Map<const Eigen::VectorXd>(&m_normalize_translation[0], m_normalize_translation.size())));
+	map.set_clipping(m_original_problem->get_lb(), m_original_problem->get_ub());
+	return true;
 }
 
 /// Extra human readable info for the problem.
@@ -61,6 +61,7 @@ class __PAGMO_VISIBLE rotated : public base_meta
 		std::string human_readable_extra() const;
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+		bool get_affine_map(affine_map &) const;
 
 	private:
 		void configure_new_bounds();
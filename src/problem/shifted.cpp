@@ -147,16 +147,22 @@ decision_vector shifted::deshift(const decision_vector& x) const
 /// (Wraps over the original implementation with translated input x)
 void shifted::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	decision_vector x_translated = deshift(x);
-	m_original_problem->objfun(f, x_translated);
+	objfun_affine(f, x);
 }
 
 /// Implementation of the constraints computation.
 /// (Wraps over the original implementation with translated input x)
 void shifted::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
 {
-	decision_vector x_translated = deshift(x);
-	m_original_problem->compute_constraints(c, x_translated);
+	compute_constraints_affine(c, x);
+}
+
+/// The translation, as an affine map.
+bool shifted::get_affine_map(affine_map &map) const
+{
+	const Eigen::VectorXd translation = Eigen::Map<const Eigen::VectorXd>(&m_translation[0], m_translation.size());
+	map = affine_map(Eigen::VectorXd(Eigen::VectorXd::Ones(translation.size())), Eigen::VectorXd(-translation));
+	return true;
 }
 
 /**
@@ -26,12 +26,14 @@
 #include<gsl/gsl_errno.h>
 #include<cmath>
 #include<algorithm>
+#include <boost/random/uniform_real_distribution.hpp>
 
 #include "../exceptions.h"
 #include "../types.h"
 #include "../population.h"
 #include "base_stochastic.h"
 #include "spheres.h"
+#include "../util/parallel.h"
 
 static const int nr_input = 8;
 static const int nr_output = 3;
@@ -42,6 +44,20 @@ static double norm2(double v[3]) {
 	return(v[0]*v[0] + v[1]*v[1] +v[2]*v[2]);
 }
 
+// Loads in context the data perceived by sphere i (as decoded from the world state y)
+static void perceive(const double y[], int i, double context[]) {
+	int k = 0;
+	for( int n = 1; n <= nr_spheres - 1; n++ ){		// consider the vector from each other sphere
+		for( int j = 0; j < 3; j++ ){			// consider each component from the vectors
+			context[k++] = y[i*3 + j] - y[ (i*3 + j + n*3) % 9 ];
+		}
+	}
+	// context now contains the relative position vectors (6 components) in the absolute frame
+	// we write, on the last two components of context, the norms of these relative positions
+	context[6] = context[0]*context[0] + context[1]*context[1] + context[2]*context[2];
+	context[7] = context[3]*context[3] + context[4]*context[4] + context[5]*context[5];
+}
+
 namespace pagmo { namespace problem {
 
 spheres::spheres(int n_evaluations, int n_hidden_neurons,
@@ -49,7 +65,7 @@ spheres::spheres(int n_evaluations, int n_hidden_neurons,
 	base_stochastic((nr_input/(int(symmetric)+1) + 1) * n_hidden_neurons + (n_hidden_neurons + 1) * nr_output, seed),
 	m_ffnn(nr_input,n_hidden_neurons,nr_output), m_n_evaluations(n_evaluations),
 	m_n_hidden_neurons(n_hidden_neurons), m_numerical_precision(numerical_precision),
-	m_ic(nr_eq), m_symm(symmetric), m_sim_time(sim_time), m_sides(sides) {
+	m_ic(nr_eq), m_symm(symmetric), m_sim_time(sim_time), m_sides(sides), m_n_threads(1), m_fixed_step(0.0) {
 	// Here we set the bounds for the problem decision vector, i.e. the nn weights
 	set_lb(-1);
 	set_ub(1);
@@ -66,7 +82,8 @@ spheres::spheres(const spheres &other):
 	base_stochastic(other),
 	m_ffnn(other.m_ffnn),
 	m_n_evaluations(other.m_n_evaluations),m_n_hidden_neurons(other.m_n_hidden_neurons),
-	m_numerical_precision(other.m_numerical_precision),m_ic(other.m_ic), m_symm(other.m_symm), m_sim_time(other.m_sim_time),m_sides(other.m_sides)
+	m_numerical_precision(other.m_numerical_precision),m_ic(other.m_ic), m_symm(other.m_symm), m_sim_time(other.m_sim_time),m_sides(other.m_sides),
+	m_n_threads(other.m_n_threads), m_fixed_step(other.m_fixed_step)
 {
 	// Here we set the bounds for the problem decision vector, i.e. the nn weights
 	gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_ffnn};
@@ -90,23 +107,11 @@ double spheres::single_fitness( const std::vector<double> &y, const ffnn& neural
 
 	double	fit = 0.0;
 	double	context[8], vel_f[3];
-	int	k;
 
 	// for each sphere
 	for( int i = 0; i < nr_spheres; i++ ){	// i - is the sphere counter 0 .. 1 .. 2 ..
-		k = 0;
-
 		// we now load in context the perceived data (as decoded from the world state y)
-		for( int n = 1; n <= nr_spheres - 1; n++ ){		// consider the vector from each other sphere
-			for( int j = 0; j < 3; j++ ){			// consider each component from the vectors
-				context[k++] = y[i*3 + j] - y[ (i*3 + j + n*3) % 9 ];
-			}
-		}
-
-		// context now contains the relative position vectors (6 components) in the absolute frame
-		// we write, on the last two components of context, the norms2 of these relative positions
-		context[6] = context[0]*context[0] + context[1]*context[1] + context[2]*context[2];
-		context[7] = context[3]*context[3] + context[4]*context[4] + context[5]*context[5];
+		perceive(&y[0], i, context);
 
 		//We evaluate the output from the neural net
 		neural_net.eval(vel_f, context);
@@ -148,36 +153,19 @@ int spheres::ode_func( double t, const double y[], double f[], void *params ) {
 
 	// The fixed-size vector context represent the sensory data perceived from each sphere. These are
 	// the body axis components of the relative positions of the other spheres, and their modules
-	double  context[nr_input];
-	double  out[nr_output];
-
-	// Here are some counters
-	int  k;
-
+	double  context[nr_spheres * nr_input];
+	double  out[nr_spheres * nr_output];
 
 	for( int i = 0; i < nr_spheres; i++ ){	// i - is the sphere counter 0 .. 1 .. 2 ..
-		k = 0;
-
-		// we now load in context the perceived data (as decoded from the world state y)
-		for( int n = 1; n <= nr_spheres - 1; n++ ){				// consider the vector from each other sphere
-			for( int j = 0; j < 3; j++ ){				// consider each component from the vectors
-				context[k++] = y[i*3 + j] - y[ (i*3 + j + n*3) % 9 ];
-			}
-		}
-
-		// context now contains the relative position vectors (6 components) in the absolute frame
-		// we write, on the last two components of context, the norms of these relative positions
-		context[6] = context[0]*context[0] + context[1]*context[1] + context[2]*context[2];
-		context[7] = context[3]*context[3] + context[4]*context[4] + context[5]*context[5];
-
-		//We evaluate the output from the neural net
-		ptr_ffnn->eval(out, context);
+		perceive(y, i, context + i * nr_input);
+	}
 
-		//Here we set the dynamics transforming the nn output [0,1] in desired velocities [-0/3,0.3]
-		f[i*3] = out[0] * 0.3 * 2 - 0.3;
-		f[i*3+1] = out[1] * 0.3 * 2 - 0.3;
-		f[i*3+2] = out[2] * 0.3 * 2 - 0.3;
+	//We evaluate the output from the neural net, for the three spheres at once
+	ptr_ffnn->eval_batch(out, context, nr_spheres);
 
+	//Here we set the dynamics transforming the nn output [0,1] in desired velocities [-0/3,0.3]
+	for( int i = 0; i < nr_spheres * nr_output; i++ ){
+		f[i] = out[i] * 0.3 * 2 - 0.3;
 	}
 	return GSL_SUCCESS;
 }
@@ -227,40 +215,241 @@ void spheres::ffnn::eval(double out[], const double in[]) const {
 	}
 }
 
+// Evaluates the network on n inputs at once (in and out store one input / output after the other).
+// Inputs and hidden activations are stored transposed, so that the innermost loops run over the batch
+// on contiguous memory and can be vectorised. The results are the same as n calls to eval().
+void spheres::ffnn::eval_batch(double out[], const double in[], unsigned int n) const {
+	m_in_batch.resize(m_n_inputs * n);
+	m_hidden_batch.resize(m_n_hidden * n);
+	m_out_batch.resize(n);
+	for( unsigned int b = 0; b < n; b++ ){
+		for( unsigned int j = 0; j < m_n_inputs; j++ ){
+			m_in_batch[j * n + b] = in[b * m_n_inputs + j];
+		}
+	}
+
+	// Offset for the weights to the output nodes
+	unsigned int offset = m_n_hidden * (m_n_inputs + 1);
+
+	// -- PROCESS CONTEXT USING THE NEURAL NETWORK --
+	for( unsigned int i = 0; i < m_n_hidden; i++ ){
+		double *hidden = &m_hidden_batch[i * n];
+		const double *w = &m_weights[i * (m_n_inputs + 1)];
+		// Set the bias (the first weight to the i'th hidden node)
+		for( unsigned int b = 0; b < n; b++ ){
+			hidden[b] = w[0];
+		}
+		// Add the weighted inputs
+		for( unsigned int j = 0; j < m_n_inputs; j++ ){
+			const double *input = &m_in_batch[j * n];
+			for( unsigned int b = 0; b < n; b++ ){
+				hidden[b] += w[j + 1] * input[b];
+			}
+		}
+		// Apply the transfer function (a sigmoid with output in [0,1])
+		for( unsigned int b = 0; b < n; b++ ){
+			hidden[b] = 1.0 / ( 1 + std::exp( -hidden[b] ));
+		}
+	}
+
+	// generate values for the output nodes
+	for( unsigned int i = 0; i < m_n_outputs; i++ ){
+		const double *w = &m_weights[offset + i * (m_n_hidden + 1)];
+		for( unsigned int b = 0; b < n; b++ ){
+			m_out_batch[b] = w[0];
+		}
+		for( unsigned int j = 0; j < m_n_hidden; j++ ){
+			const double *hidden = &m_hidden_batch[j * n];
+			for( unsigned int b = 0; b < n; b++ ){
+				m_out_batch[b] += w[j + 1] * hidden[b];
+			}
+		}
+		for( unsigned int b = 0; b < n; b++ ){
+			out[b * m_n_outputs + i] = 1.0 / ( 1 + std::exp( -m_out_batch[b] ));
+		}
+	}
+}
+
+// Simulates a set of initial conditions with the adaptive integrator, each worker thread
+// using its own neural net and ode driver.
+class spheres::rollout_task {
+	public:
+		rollout_task(const spheres &prob, const ffnn &neural_net, unsigned int n_workers, std::vector<std::vector<double> > &ics, std::vector<double> &fits, std::vector<char> &failed):
+			m_prob(prob), m_nets(n_workers, neural_net), m_systems(n_workers), m_drivers(n_workers, (gsl_odeiv2_driver *)0), m_ics(ics), m_fits(fits), m_failed(failed)
+		{
+			for (unsigned int w = 0; w < n_workers; ++w) {
+				gsl_odeiv2_system sys = {ode_func,NULL,nr_eq,&m_nets[w]};
+				m_systems[w] = sys;
+				m_drivers[w] = gsl_odeiv2_driver_alloc_y_new(&m_systems[w], gsl_odeiv2_step_rk8pd, 1e-6,prob.m_numerical_precision,0.0);
+			}
+		}
+		~rollout_task() {
+			for (unsigned int w = 0; w < m_drivers.size(); ++w) {
+				gsl_odeiv2_driver_free(m_drivers[w]);
+			}
+		}
+		void operator()(std::size_t i, unsigned int w) {
+			// Integrate the system
+			double t0 = 0.0;
+			double tf = m_prob.m_sim_time;
+			int status = gsl_odeiv2_driver_apply( m_drivers[w], &t0, tf, &m_ics[i][0] );
+			// Not sure if this help or what it does ....
+			gsl_odeiv2_driver_reset (m_drivers[w]);
+			if( status != GSL_SUCCESS ){
+				printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
+				m_failed[i] = 1;
+				return;
+			}
+			m_fits[i] = m_prob.single_fitness(m_ics[i],m_nets[w]);
+		}
+	private:
+		rollout_task(const rollout_task &);
+		rollout_task &operator=(const rollout_task &);
+		const spheres					&m_prob;
+		std::vector<ffnn>				m_nets;
+		std::vector<gsl_odeiv2_system>	m_systems;
+		std::vector<gsl_odeiv2_driver *>	m_drivers;
+		std::vector<std::vector<double> >	&m_ics;
+		std::vector<double>				&m_fits;
+		std::vector<char>				&m_failed;
+};
+
+// Simulates a set of initial conditions with the fixed step integrator, split in one chunk per worker thread.
+class spheres::fixed_step_task {
+	public:
+		fixed_step_task(const spheres &prob, const ffnn &neural_net, unsigned int n_chunks, std::vector<std::vector<double> > &ics, std::vector<double> &fits):
+			m_prob(prob), m_nets(n_chunks, neural_net), m_ics(ics), m_fits(fits) {}
+		void operator()(std::size_t chunk, unsigned int) {
+			const std::size_t begin = chunk * m_ics.size() / m_nets.size(), end = (chunk + 1) * m_ics.size() / m_nets.size();
+			std::vector<double> y;
+			y.reserve((end - begin) * nr_eq);
+			for (std::size_t i = begin; i < end; ++i) {
+				y.insert(y.end(), m_ics[i].begin(), m_ics[i].end());
+			}
+			m_prob.integrate_fixed_step(m_nets[chunk], y);
+			for (std::size_t i = begin; i < end; ++i) {
+				std::copy(y.begin() + (i - begin) * nr_eq, y.begin() + (i - begin + 1) * nr_eq, m_ics[i].begin());
+				m_fits[i] = m_prob.single_fitness(m_ics[i],m_nets[chunk]);
+			}
+		}
+	private:
+		const spheres					&m_prob;
+		std::vector<ffnn>				m_nets;
+		std::vector<std::vector<double> >	&m_ics;
+		std::vector<double>				&m_fits;
+};
+
+// Computes in dydt the derivatives of all the simulations stored one after the other in state, evaluating the
+// neural net at once on all the spheres. context and out are work space.
+inline void spheres::fixed_step_derivatives(const ffnn &neural_net, const std::vector<double> &state, std::vector<double> &dydt,
+	std::vector<double> &context, std::vector<double> &out) {
+	const std::size_t n_spheres = state.size() / nr_eq * nr_spheres;
+	context.resize(n_spheres * nr_input);
+	out.resize(n_spheres * nr_output);
+	for( std::size_t s = 0; s < n_spheres; s++ ){
+		perceive(&state[(s / nr_spheres) * nr_eq], s % nr_spheres, &context[s * nr_input]);
+	}
+	neural_net.eval_batch(&out[0], &context[0], n_spheres);
+	for( std::size_t i = 0; i < state.size(); i++ ){
+		dydt[i] = out[i] * 0.3 * 2 - 0.3;
+	}
+}
+
+// Integrates, in lockstep, the initial conditions stored one after the other in y with a fourth order Runge-Kutta scheme.
+void spheres::integrate_fixed_step(const ffnn &neural_net, std::vector<double> &y) const {
+	const std::size_t n = y.size();
+	const unsigned int n_steps = std::max(1u, static_cast<unsigned int>(std::ceil(m_sim_time / m_fixed_step)));
+	const double h = m_sim_time / n_steps;
+	std::vector<double> k1(n), k2(n), k3(n), k4(n), tmp(n), context, out;
+	for (unsigned int step = 0; step < n_steps; ++step) {
+		fixed_step_derivatives(neural_net, y, k1, context, out);
+		for (std::size_t i = 0; i < n; ++i) {
+			tmp[i] = y[i] + 0.5 * h * k1[i];
+		}
+		fixed_step_derivatives(neural_net, tmp, k2, context, out);
+		for (std::size_t i = 0; i < n; ++i) {
+			tmp[i] = y[i] + 0.5 * h * k2[i];
+		}
+		fixed_step_derivatives(neural_net, tmp, k3, context, out);
+		for (std::size_t i = 0; i < n; ++i) {
+			tmp[i] = y[i] + h * k3[i];
+		}
+		fixed_step_derivatives(neural_net, tmp, k4, context, out);
+		for (std::size_t i = 0; i < n; ++i) {
+			y[i] += h / 6.0 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+		}
+	}
+}
+
 void spheres::objfun_impl(fitness_vector &f, const decision_vector &x) const {
-	f[0]=0;
+	objfun_seeded_impl(f,x,m_seed);
+}
+
+// All the state used here (neural nets, ode drivers, initial conditions and random stream) is local, so that
+// the same problem can be evaluated concurrently by different threads.
+void spheres::objfun_seeded_impl(fitness_vector &f, const decision_vector &x, unsigned int seed) const {
 	// Make sure the pseudorandom sequence will always be the same
-	m_drng.seed(m_seed);
-	// Set the ffnn weights from x, by accounting for symmetries in neurons weights
-	set_nn_weights(x);
-	// Loop over the number of repetitions
+	rng_philox drng(seed);
+	boost::random::uniform_real_distribution<double> uniform_dist(0.0,1.0);
+	// Creates all the initial conditions at random, before any simulation, so that they do not
+	// depend on the number of threads
+	std::vector<std::vector<double> > ics(m_n_evaluations, std::vector<double>(nr_eq));
 	for (int count=0;count<m_n_evaluations;++count) {
-		// Creates the initial conditions at random
+		std::vector<double> &ic = ics[count];
 		// Positions starts in a [-1,1] box
 		for (int i=0; i<6; ++i) {
-			m_ic[i] = (m_drng()*2 - 1);
+			ic[i] = (uniform_dist(drng)*2 - 1);
 		}
-
 		// Centered around the origin
-		m_ic[6] = - (m_ic[0] + m_ic[3]);
-		m_ic[7] = - (m_ic[1] + m_ic[4]);
-		m_ic[8] = - (m_ic[2] + m_ic[5]);
+		ic[6] = - (ic[0] + ic[3]);
+		ic[7] = - (ic[1] + ic[4]);
+		ic[8] = - (ic[2] + ic[5]);
+	}
+	// Set the ffnn weights from x, by accounting for symmetries in neurons weights
+	ffnn neural_net(m_ffnn);
+	set_nn_weights(neural_net,x);
+	// Simulate all the initial conditions
+	std::vector<double> fits(m_n_evaluations, 0.0);
+	std::vector<char> failed(m_n_evaluations, 0);
+	const unsigned int n_workers = std::max(1u, std::min<unsigned int>(m_n_threads, m_n_evaluations));
+	if (m_fixed_step > 0) {
+		fixed_step_task task(*this, neural_net, n_workers, ics, fits);
+		util::parallel::for_each_index(n_workers, n_workers, task);
+	} else {
+		rollout_task task(*this, neural_net, n_workers, ics, fits, failed);
+		util::parallel::for_each_index(m_n_evaluations, n_workers, task);
+	}
+	// Average in a fixed order. As in the serial evaluation, the rollouts from the first failed integration onwards
+	// score zero.
+	f[0]=0;
+	for (int count=0;count<m_n_evaluations && !failed[count];++count) {
+		f[0] += fits[count];
+	}
+	f[0] /= m_n_evaluations;
+}
 
-		// Integrate the system
-		double t0 = 0.0;
-		double tf = m_sim_time;
-		//gsl_odeiv2_driver_set_hmin (m_gsl_drv_pntr, 1e-6);
-		int status = gsl_odeiv2_driver_apply( m_gsl_drv_pntr, &t0, tf, &m_ic[0] );
-		// Not sure if this help or what it does ....
-		gsl_odeiv2_driver_reset (m_gsl_drv_pntr);
-		if( status != GSL_SUCCESS ){
-			printf ("ERROR: gsl_odeiv2_driver_apply returned value = %d\n", status);
-			break;
-		}
-		f[0] += single_fitness(m_ic,m_ffnn);
+void spheres::set_n_threads(unsigned int n_threads) {
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be at least one");
+	}
+	m_n_threads = n_threads;
+}
+
+unsigned int spheres::get_n_threads() const {
+	return m_n_threads;
+}
 
+void spheres::set_fixed_step(double step) {
+	if (step < 0) {
+		pagmo_throw(value_error,"the integration step cannot be negative");
 	}
-	f[0] /= m_n_evaluations;
+	m_fixed_step = step;
+	// The fitness of a decision vector changes with the integrator
+	reset_caches();
+}
+
+double spheres::get_fixed_step() const {
+	return m_fixed_step;
 }
 
 static bool my_sort_function (std::vector<double> i,std::vector<double> j) { return (i[9] < j[9]); }
@@ -309,34 +498,38 @@ std::vector<std::vector<double> > spheres::post_evaluate(const decision_vector &
 }
 
 void spheres::set_nn_weights(const decision_vector &x) const {
+	set_nn_weights(m_ffnn,x);
+}
+
+void spheres::set_nn_weights(ffnn &neural_net, const decision_vector &x) const {
 	if (m_symm) { //symmetric weigths activated
 		int w = 0;
-		for(unsigned int h = 0; h < m_ffnn.m_n_hidden; h++)
+		for(unsigned int h = 0; h < neural_net.m_n_hidden; h++)
 		{
 			int start_index = h * 5; // (nr_input/2+1)
 			// bias, dx1, dy1, dz1
 			for(int j = 0; j < 4; j++)
 			{
-				m_ffnn.m_weights[w] = x[start_index+j]; w++;
+				neural_net.m_weights[w] = x[start_index+j]; w++;
 			}
 			// dx2, dy2, dz2
 			for(int j = 1; j <= 3; j++)
 			{
-				m_ffnn.m_weights[w] = x[start_index+j]; w++;
+				neural_net.m_weights[w] = x[start_index+j]; w++;
 			}
 			// distance 1
-			m_ffnn.m_weights[w] = x[start_index+4]; w++;
+			neural_net.m_weights[w] = x[start_index+4]; w++;
 			// distance 2
-			m_ffnn.m_weights[w] = x[start_index+4]; w++;
+			neural_net.m_weights[w] = x[start_index+4]; w++;
 		}
 		int ind = 0;
-		for(unsigned int ww = w; ww < m_ffnn.m_weights.size(); ww++)
+		for(unsigned int ww = w; ww < neural_net.m_weights.size(); ww++)
 		{
-			m_ffnn.m_weights[ww] = x[(nr_input/2+1)*m_ffnn.m_n_hidden+ind];
+			neural_net.m_weights[ww] = x[(nr_input/2+1)*neural_net.m_n_hidden+ind];
 			ind++;
 		}
 	} else {//no symmetric weights
-		m_ffnn.m_weights = x;
+		neural_net.m_weights = x;
 	}
 }
 
@@ -396,6 +589,13 @@ std::string spheres::human_readable_extra() const
 	oss << "\tSymmetric Weights: " << m_symm << '\n';
 	oss << "\tSimulation time: " << m_sim_time << '\n';
 	oss << "\tTriangle sides (squared): " << m_sides << '\n';
+	oss << "\tIntegrator: ";
+	if (m_fixed_step > 0) {
+		oss << "fixed step RK4 (step " << m_fixed_step << ")\n";
+	} else {
+		oss << "adaptive rk8pd\n";
+	}
+	oss << "\tThreads: " << m_n_threads << '\n';
 	return oss.str();
 }
 
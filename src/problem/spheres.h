@@ -127,8 +127,33 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 		/// Gets the weights of the neural network
 		std::vector<double> get_nn_weights(decision_vector x) const;
 
+		/// Sets the number of threads
+		/**
+		 * The simulations of the different initial conditions of one fitness evaluation are distributed over
+		 * the given number of threads. The fitness does not depend on the number of threads.
+		 *
+		 * @param[in] n_threads number of threads (must be at least one)
+		 */
+		void set_n_threads(unsigned int n_threads);
+		/// Gets the number of threads
+		unsigned int get_n_threads() const;
+		/// Sets the integration step
+		/**
+		 * When step is positive, the simulations used in the fitness evaluation are integrated with a fourth order
+		 * Runge-Kutta scheme of fixed step (rounded down so that it divides the simulation time). All the
+		 * initial conditions then advance in lockstep, and the neural network is evaluated on all of them in
+		 * a single batch. When step is zero (default), each simulation is integrated with the adaptive rk8pd scheme
+		 * of GSL at the precision requested in the constructor.
+		 *
+		 * @param[in] step integration step (zero selects the adaptive integrator)
+		 */
+		void set_fixed_step(double step);
+		/// Gets the integration step (zero for the adaptive integrator)
+		double get_fixed_step() const;
+
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void objfun_seeded_impl(fitness_vector &, const decision_vector &, unsigned int) const;
 		std::string human_readable_extra() const;
 	private:
 		// Class representing a feed forward neural network
@@ -137,6 +162,7 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 			public:
 				ffnn(const unsigned int, const unsigned int,const unsigned int);
 				void eval(double[], const double[]) const;
+				void eval_batch(double[], const double[], unsigned int) const;
 				void set_weights(const std::vector<double> &);
 			private:
 				friend class boost::serialization::access;
@@ -154,9 +180,20 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 				const unsigned int m_n_outputs;
 				std::vector<double> m_weights;
 				mutable std::vector<double> m_hidden;
+				// Work space of eval_batch()
+				mutable std::vector<double> m_in_batch;
+				mutable std::vector<double> m_hidden_batch;
+				mutable std::vector<double> m_out_batch;
 		};
+		class rollout_task;
+		friend class rollout_task;
+		class fixed_step_task;
+		friend class fixed_step_task;
 		void set_nn_weights(const decision_vector& x) const;
+		void set_nn_weights(ffnn &, const decision_vector& x) const;
 		double single_fitness( const std::vector<double> &, const ffnn& ) const;
+		void integrate_fixed_step(const ffnn &, std::vector<double> &) const;
+		static void fixed_step_derivatives(const ffnn &, const std::vector<double> &, std::vector<double> &, std::vector<double> &, std::vector<double> &);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -170,6 +207,8 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 			ar & m_symm;
 			ar & m_sim_time;
 			ar & m_sides;
+			ar & m_n_threads;
+			ar & m_fixed_step;
 		}
 		gsl_odeiv2_driver*				m_gsl_drv_pntr;
 		gsl_odeiv2_system				m_sys;
@@ -181,6 +220,8 @@ class __PAGMO_VISIBLE spheres: public base_stochastic
 		bool							m_symm;
 		double							m_sim_time;
 		std::vector<double>				m_sides;
+		unsigned int					m_n_threads;
+		double							m_fixed_step;
 };
 
 }} //namespaces
@@ -0,0 +1,254 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../types.h"
+#include "base.h"
+#include "surrogate.h"
+
+namespace pagmo { namespace problem {
+
+/**
+ * Constructor
+ *
+ * @param[in] p pagmo::problem::base to be assisted by the surrogate
+ * @param[in] max_samples maximum number of samples kept in the model (the oldest are forgotten first)
+ * @param[in] length_scale length scale of the kernel, relative to the diagonal of the box
+ * @param[in] nugget regularization added to the diagonal of the kernel matrix
+ *
+ * @see util::gaussian_process constructor.
+ */
+surrogate::surrogate(const base &p, unsigned int max_samples, double length_scale, double nugget):
+	base_meta(
+		 p,
+		 p.get_dimension(),
+		 p.get_i_dimension(),
+		 p.get_f_dimension(),
+		 p.get_c_dimension(),
+		 p.get_ic_dimension(),
+		 p.get_c_tol()),
+		m_model(p.get_dimension(),p.get_f_dimension(),max_samples,length_scale,nugget),
+		m_true_evaluations(0),
+		m_surrogate_evaluations(0)
+{}
+
+/// Copy constructor.
+surrogate::surrogate(const surrogate &p):base_meta(p)
+{
+	boost::lock_guard<boost::mutex> lock(p.m_mutex);
+	m_model = p.m_model;
+	m_true_evaluations = p.m_true_evaluations;
+	m_surrogate_evaluations = p.m_surrogate_evaluations;
+}
+
+/// Clone method.
+base_ptr surrogate::clone() const
+{
+	return base_ptr(new surrogate(*this));
+}
+
+// Scales the decision vector to the unit hypercube.
+void surrogate::scale(decision_vector &u, const decision_vector &x) const
+{
+	const decision_vector &lb = get_lb(), &ub = get_ub();
+	u.resize(x.size());
+	for (decision_vector::size_type i = 0; i < x.size(); ++i) {
+		u[i] = (ub[i] > lb[i]) ? (x[i] - lb[i]) / (ub[i] - lb[i]) : 0.;
+	}
+}
+
+/// Implementation of the objective function.
+/// (Evaluates the original problem and adds the result to the model)
+void surrogate::objfun_impl(fitness_vector &f, const decision_vector &x) const
+{
+	objfun_original(f, x);
+	decision_vector u;
+	scale(u, x);
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	++m_true_evaluations;
+	m_model.add(u, f);
+}
+
+/// Implementation of the constraints computation.
+/// (Wraps over the original implementation)
+void surrogate::compute_constraints_impl(constraint_vector &c, const decision_vector &x) const
+{
+	compute_constraints_original(c, x);
+}
+
+/// Surrogate prediction of the fitness
+/**
+ * @param[out] f predicted fitness vector
+ * @param[out] stddev standard deviation of the prediction
+ * @param[in] x decision vector
+ *
+ * @throws value_error if x is not compatible with the problem
+ */
+void surrogate::predict(fitness_vector &f, fitness_vector &stddev, const decision_vector &x) const
+{
+	if (!verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	decision_vector u;
+	scale(u, x);
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	m_model.predict(f, stddev, u);
+	++m_surrogate_evaluations;
+}
+
+/// Pre-screening of a batch of candidates
+/**
+ * Ranks the candidates according to their predicted fitness lowered by kappa times its standard deviation (i.e., a
+ * lower confidence bound, kappa = 0 ranking on the predicted fitness alone), counting for each candidate how many other
+ * candidates are predicted better (see base::compare_fitness()). Ties are broken by index.
+ *
+ * @param[in] x the candidates
+ * @param[in] n number of candidates to be returned
+ * @param[in] kappa weight of the standard deviation
+ *
+ * @return the indices of the (at most) n most promising candidates, most promising first
+ */
+std::vector<population::size_type> surrogate::pre_screen(const std::vector<decision_vector> &x, population::size_type n, double kappa) const
+{
+	const std::vector<decision_vector>::size_type N = x.size();
+	std::vector<fitness_vector> bound(N);
+	fitness_vector stddev;
+	for (std::vector<decision_vector>::size_type i = 0; i < N; ++i) {
+		predict(bound[i], stddev, x[i]);
+		for (fitness_vector::size_type j = 0; j < bound[i].size(); ++j) {
+			bound[i][j] -= kappa * stddev[j];
+		}
+	}
+	// Number of candidates predicted better than each candidate, and index.
+	std::vector<std::pair<population::size_type,population::size_type> > rank(N);
+	for (std::vector<decision_vector>::size_type i = 0; i < N; ++i) {
+		rank[i].first = 0;
+		rank[i].second = i;
+		for (std::vector<decision_vector>::size_type j = 0; j < N; ++j) {
+			if (j != i && compare_fitness(bound[j], bound[i])) {
+				++rank[i].first;
+			}
+		}
+	}
+	std::sort(rank.begin(), rank.end());
+	std::vector<population::size_type> retval;
+	for (std::vector<decision_vector>::size_type i = 0; i < std::min<population::size_type>(n, N); ++i) {
+		retval.push_back(rank[i].second);
+	}
+	return retval;
+}
+
+/// Adds a sample to the model
+/**
+ * The model is updated incrementally, without a full refit.
+ *
+ * @param[in] x decision vector
+ * @param[in] f its fitness vector, computed elsewhere (e.g., by a clone of this problem)
+ *
+ * @return false if the sample was discarded (e.g., because already in the model)
+ * @throws value_error if x or f are not compatible with the problem
+ */
+bool surrogate::add_sample(const decision_vector &x, const fitness_vector &f) const
+{
+	if (!verify_x(x) || f.size() != get_f_dimension()) {
+		pagmo_throw(value_error,"sample is not compatible with problem");
+	}
+	decision_vector u;
+	scale(u, x);
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_model.add(u, f);
+}
+
+/// Adds the current decision vectors of a population to the model
+/**
+ * @param[in] pop the population, whose fitness vectors are assumed to be those of the original problem
+ */
+void surrogate::train(const population &pop) const
+{
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		add_sample(pop.get_individual(i).cur_x, pop.get_individual(i).cur_f);
+	}
+}
+
+/// Number of samples in the model
+unsigned int surrogate::get_n_samples() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_model.size();
+}
+
+/// Number of evaluations of the original problem
+unsigned long surrogate::get_true_evaluations() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_true_evaluations;
+}
+
+/// Number of predictions made by the model
+unsigned long surrogate::get_surrogate_evaluations() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	return m_surrogate_evaluations;
+}
+
+/// Resets the evaluation counters
+void surrogate::reset_counters() const
+{
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	m_true_evaluations = 0;
+	m_surrogate_evaluations = 0;
+}
+
+std::string surrogate::get_name() const
+{
+	return m_original_problem->get_name() + " [Surrogate]";
+}
+
+/// Extra human readable info for the problem.
+/**
+ * Will return a formatted string containing the state of the model and the counters
+ */
+std::string surrogate::human_readable_extra() const
+{
+	std::ostringstream oss;
+	oss << m_original_problem->human_readable_extra() << std::endl;
+	boost::lock_guard<boost::mutex> lock(m_mutex);
+	oss << "\tSamples: " << m_model.size() << " (at most " << m_model.get_max_size() << ")";
+	oss << "\n\tLength scale: " << m_model.get_length_scale();
+	oss << "\n\tTrue evaluations: " << m_true_evaluations;
+	oss << "\n\tSurrogate evaluations: " << m_surrogate_evaluations << std::endl;
+	return oss.str();
+}
+
+}}
+
+BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::surrogate);
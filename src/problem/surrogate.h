@@ -0,0 +1,103 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_PROBLEM_SURROGATE_H
+#define PAGMO_PROBLEM_SURROGATE_H
+
+#include <string>
+#include <vector>
+#include <boost/thread/mutex.hpp>
+
+#include "../population.h"
+#include "../serialization.h"
+#include "../types.h"
+#include "../util/gaussian_process.h"
+#include "ackley.h"
+#include "base_meta.h"
+
+namespace pagmo{ namespace problem {
+
+/// Surrogate-assisted meta-problem
+/**
+ * Wraps an (expensive) problem and learns a surrogate of its objective functions online: each true evaluation of the
+ * meta-problem is also added to a gaussian process model (pagmo::util::gaussian_process) of the fitness over the
+ * decision vector scaled to the unit hypercube. The fitness and the constraints of the meta-problem are those of the
+ * original problem.
+ *
+ * Algorithms can query the model with predict() and pre-screen a batch of candidates with pre_screen(), so that only the
+ * most promising ones are sent to the true objective function. The numbers of true and surrogate evaluations are
+ * counted.
+ *
+ * The model and the counters are guarded by a lock, so that the same object can be evaluated and queried concurrently
+ * (the original problem is evaluated outside of the lock).
+ *
+ * NOTE: the model is trained by the evaluations of this very object. Clones (e.g., the ones made by algorithms
+ * evaluating in parallel) train their own copy of the model: the evaluated individuals can be fed back with
+ * add_sample() or train().
+ */
+class __PAGMO_VISIBLE surrogate : public base_meta
+{
+	public:
+		surrogate(const base & = ackley(1), unsigned int = 500, double = 0.2, double = 1e-6);
+		surrogate(const surrogate &);
+		base_ptr clone() const;
+		std::string get_name() const;
+
+		void predict(fitness_vector &, fitness_vector &, const decision_vector &) const;
+		std::vector<population::size_type> pre_screen(const std::vector<decision_vector> &, population::size_type, double = 0) const;
+		bool add_sample(const decision_vector &, const fitness_vector &) const;
+		void train(const population &) const;
+		unsigned int get_n_samples() const;
+		unsigned long get_true_evaluations() const;
+		unsigned long get_surrogate_evaluations() const;
+		void reset_counters() const;
+
+	protected:
+		std::string human_readable_extra() const;
+		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void compute_constraints_impl(constraint_vector &, const decision_vector &) const;
+	private:
+		void scale(decision_vector &, const decision_vector &) const;
+		surrogate &operator=(const surrogate &);
+
+		friend class boost::serialization::access;
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			ar & boost::serialization::base_object<base_meta>(*this);
+			ar & m_model;
+			ar & m_true_evaluations;
+			ar & m_surrogate_evaluations;
+		}
+		mutable util::gaussian_process	m_model;
+		mutable unsigned long		m_true_evaluations;
+		mutable unsigned long		m_surrogate_evaluations;
+		mutable boost::mutex		m_mutex;
+};
+
+}} //namespaces
+
+BOOST_CLASS_EXPORT_KEY(pagmo::problem::surrogate);
+
+#endif // PAGMO_PROBLEM_SURROGATE_H
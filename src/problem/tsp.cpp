@@ -31,6 +31,7 @@
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/shared_data.h"
 #include "base.h"
 #include "tsp.h"
 
@@ -54,20 +55,23 @@ static const double default_weights[5][5] = {
  * - city 4: (-3,0)
  * - city 5: (0,-4)
  */
-tsp::tsp():base_aco(5,1,0)
+tsp::tsp():base_aco(5,1,0),m_weights(std::vector<double>(&default_weights[0][0],&default_weights[0][0] + 25))
 {
-	m_weights.resize(5);
-	for (int i = 0; i < 5; ++i) {
-		m_weights[i].resize(5);
-		for (int j = 0; j < 5; ++j) {
-			m_weights[i][j] = default_weights[i][j];
-		}
-	}
 	set_lb(0);
 	set_ub(4); //number of nodes in the graph -1 (we count from 0)
 	set_heuristic_information_matrix();
 }
 
+// Row-major copy of a square matrix.
+static std::vector<double> flatten(const std::vector<std::vector<double> > &m)
+{
+	std::vector<double> retval;
+	for (std::vector<std::vector<double> >::size_type i = 0; i < m.size(); ++i) {
+		retval.insert(retval.end(),m[i].begin(),m[i].end());
+	}
+	return retval;
+}
+
 /// Constructor from vectors and maximum weight.
 /**
  * Initialize weights of the edges (city distances) from the matrix.
@@ -75,22 +79,23 @@ tsp::tsp():base_aco(5,1,0)
  * @param[in] weights matrix of distances between cities.
  */
 tsp::tsp(const std::vector<std::vector<double> > &weights):
-	base_aco(boost::numeric_cast<int>(weights[0].size()),1,0), m_weights(weights) {
+	base_aco(boost::numeric_cast<int>(weights[0].size()),1,0) {
 	
 	//Check weights matrix
-	for(problem::base_aco::size_type i = 0; i < m_weights.size(); ++i) {
-		if (m_weights[i].size() != m_weights.size()) {
+	for(problem::base_aco::size_type i = 0; i < weights.size(); ++i) {
+		if (weights[i].size() != weights.size()) {
 			pagmo_throw(value_error,"Weights matrix must be a square matrix!");		
 		}
-		if(m_weights[i][i] != 0) {
+		if(weights[i][i] != 0) {
 			pagmo_throw(value_error,"Weights matrix must have 0's on the diagonal!");
 		}
-		for (problem::base_aco::size_type j = 0; j < m_weights[i].size(); ++j) {
-			if(m_weights[i][j] != m_weights[j][i]) {
+		for (problem::base_aco::size_type j = 0; j < weights[i].size(); ++j) {
+			if(weights[i][j] != weights[j][i]) {
 				pagmo_throw(value_error,"Weights matrix must be a simmetric matrix!");	
 			}
 		}
 	}
+	m_weights = util::shared_data(flatten(weights));
 
 	set_lb(0);
 	set_ub(weights[0].size()-1); //number of nodes in the graph -1 (we count from 0)
@@ -108,7 +113,7 @@ void tsp::set_heuristic_information_matrix() {
 	for(std::vector<std::vector<std::vector<fitness_vector> > >::size_type k = 0; k < m_eta.size(); ++k) {
 		for(std::vector<std::vector<fitness_vector> >::size_type i=0; i < m_eta[0].size(); ++i) {
 			for(std::vector<fitness_vector>::size_type  j = 0; j < m_eta[0][0].size(); ++j) {
-					m_eta[k][i][j][0] = m_weights[i][j];
+					m_eta[k][i][j][0] = weight(i,j);
 			}
 		}
 	}
@@ -140,12 +145,12 @@ base_ptr tsp::clone() const
 void tsp::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	pagmo_assert(x.size() == get_dimension() && x.size() == m_weights[0].size());
+	pagmo_assert(x.size() == get_dimension() && x.size() * x.size() == m_weights.size());
 	f[0] = 0;
 	for (size_type i = 1; i < get_dimension(); ++i) {
-			f[0] += m_weights[boost::numeric_cast<int>(x[i-1])][boost::numeric_cast<int>(x[i])];
+			f[0] += weight(boost::numeric_cast<size_type>(x[i-1]),boost::numeric_cast<size_type>(x[i]));
 	}
-	f[0] += m_weights[boost::numeric_cast<int>(x[get_dimension()-1])][boost::numeric_cast<int>(x[0])];
+	f[0] += weight(boost::numeric_cast<size_type>(x[get_dimension()-1]),boost::numeric_cast<size_type>(x[0]));
 }
 
 /// Re-implement constraint computation,
@@ -170,8 +175,9 @@ std::string tsp::human_readable_extra() const
 {
 	std::ostringstream oss;
 	oss << "\nWeights Matrix: " << std::endl;
-	for(problem::base::size_type i=0; i < m_weights[0].size(); ++i) {
-		oss << "\t\t" << m_weights[i] << std::endl;
+	const size_type n = get_dimension();
+	for(problem::base::size_type i=0; i < n; ++i) {
+		oss << "\t\t" << std::vector<double>(m_weights.data() + i * n,m_weights.data() + (i + 1) * n) << std::endl;
 	}
 	return oss.str();
 }
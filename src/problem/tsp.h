@@ -33,6 +33,7 @@
 #include "../config.h"
 #include "../serialization.h"
 #include "../types.h"
+#include "../util/shared_data.h"
 #include "base_aco.h"
 
 namespace pagmo { namespace problem {
@@ -81,7 +82,13 @@ class __PAGMO_VISIBLE tsp: public base_aco
 			ar & m_weights;
 			ar & m_tmpDecisionVector;
 		}
-		std::vector<std::vector<double> > m_weights;
+		// Weight of the edge between cities i and j.
+		double weight(size_type i, size_type j) const
+		{
+			return m_weights[i * get_dimension() + j];
+		}
+		// Row-major weights matrix, shared among the copies of the problem.
+		util::shared_data m_weights;
 		mutable decision_vector m_tmpDecisionVector;
 };
 
@@ -76,6 +76,7 @@
 #include "problem/decompose.h"
 #include "problem/noisy.h"
 #include "problem/robust.h"
+#include "problem/surrogate.h"
 #include "problem/con2uncon.h"
 
 // GSL problems.
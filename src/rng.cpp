@@ -60,5 +60,7 @@ Rng rng_generator::get()
 
 template __PAGMO_VISIBLE rng_double rng_generator::get<rng_double>();
 template __PAGMO_VISIBLE rng_uint32 rng_generator::get<rng_uint32>();
+template __PAGMO_VISIBLE rng_philox rng_generator::get<rng_philox>();
+template __PAGMO_VISIBLE rng_philox_double rng_generator::get<rng_philox_double>();
 
 }
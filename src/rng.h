@@ -27,11 +27,15 @@
 #ifndef PAGMO_RNG_H
 #define PAGMO_RNG_H
 
+#include <algorithm>
 #include <boost/cstdint.hpp>
 #include <boost/random/lagged_fibonacci.hpp>
 #include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <cstddef>
+#include <iterator>
 #include <sstream>
 #include <string>
 
@@ -120,6 +124,443 @@ class __PAGMO_VISIBLE rng_double: public boost::lagged_fibonacci607 {
 		BOOST_SERIALIZATION_SPLIT_MEMBER();
 };
 
+/// Counter-based rng returning an unsigned integer in the [0,2**32-1] range.
+/**
+ * Implementation of the Philox4x32-10 generator of Salmon et al. The whole sequence is a pure function
+ * of a key (seed and stream identifier) and of a 128 bit counter, so that:
+ * - the state is tiny and the generator is cheap to construct, copy and serialize;
+ * - independent streams can be created on the fly, either from a (seed, stream) pair or by splitting an existing generator (split());
+ * - jumping ahead in the sequence costs O(1) (discard());
+ * - numbers can be generated in batches (generate(), generate_uniform(), generate_normal()): the counters of a batch are
+ *   encrypted together, in loops the compiler can vectorise.
+ *
+ * The class follows the Boost engine interface, and can be used wherever pagmo::rng_uint32 is used.
+ *
+ * @see J. K. Salmon, M. A. Moraes, R. O. Dror, D. E. Shaw, "Parallel random numbers: as easy as 1, 2, 3", SC11.
+ */
+class __PAGMO_VISIBLE rng_philox {
+		friend class boost::serialization::access;
+	public:
+		/// Return value of the generator.
+		typedef boost::uint32_t result_type;
+		/// The generator has a non fixed range (required by the Boost engine interface).
+		static const bool has_fixed_range = false;
+		/// Constructor from seed and stream identifier.
+		/**
+		 * Different (seed, stream) pairs give statistically independent sequences.
+		 *
+		 * @param[in] s seed.
+		 * @param[in] stream identifier of the stream.
+		 */
+		explicit rng_philox(const result_type &s = 0u, const result_type &stream = 0u)
+		{
+			seed(s,stream);
+		}
+		// Default generated copy ctor and assignment are fine.
+		/// Re-seed the generator.
+		/**
+		 * @param[in] s seed.
+		 * @param[in] stream identifier of the stream.
+		 */
+		void seed(const result_type &s = 0u, const result_type &stream = 0u)
+		{
+			m_key[0] = s;
+			m_key[1] = stream;
+			m_counter[0] = m_counter[1] = m_counter[2] = m_counter[3] = 0u;
+			m_idx = 4u;
+		}
+		/// Minimum value returned by the generator.
+		static result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0u;}
+		/// Maximum value returned by the generator.
+		static result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0xFFFFFFFFu;}
+		/// Return the next number in the sequence.
+		result_type operator()()
+		{
+			if (m_idx == 4u) {
+				encrypt(m_counter,m_key,m_block);
+				increment_counter(m_counter,1u);
+				m_idx = 0u;
+			}
+			return m_block[m_idx++];
+		}
+		/// Jump ahead in the sequence.
+		/**
+		 * Equivalent to n calls to operator()(), but in constant time.
+		 *
+		 * @param[in] n number of values to be skipped.
+		 */
+		void discard(boost::uint64_t n)
+		{
+			const boost::uint64_t buffered = 4u - m_idx;
+			if (n <= buffered) {
+				m_idx += static_cast<unsigned int>(n);
+				return;
+			}
+			n -= buffered;
+			increment_counter(m_counter,n / 4u);
+			m_idx = 4u;
+			if (n % 4u) {
+				(*this)();
+				m_idx = static_cast<unsigned int>(n % 4u);
+			}
+		}
+		/// Split the generator.
+		/**
+		 * Returns a generator whose sequence is statistically independent from the sequence of this generator
+		 * and from the sequences of the generators returned by split() with a different index. Splitting
+		 * depends only on the key of this generator (not on its position in the sequence) and does not modify it:
+		 * the stream of each thread can thus be derived from the master generator of a run independently
+		 * of the scheduling of the threads.
+		 *
+		 * @param[in] i index of the child.
+		 *
+		 * @return the i-th child of this generator.
+		 */
+		rng_philox split(const result_type &i) const
+		{
+			// The key of the child is obtained encrypting the index under the key of the parent,
+			// in the upper half of the counter space.
+			const boost::uint32_t ctr[4] = {i, 0u, 0u, 0x80000000u};
+			boost::uint32_t out[4];
+			encrypt(ctr,m_key,out);
+			rng_philox retval(out[0],out[1]);
+			return retval;
+		}
+		/// Fill a range with the next numbers of the sequence.
+		/**
+		 * Equivalent to assigning operator()() to each element of the range, but computed in batches.
+		 *
+		 * @param[in] begin beginning of the range.
+		 * @param[in] end end of the range.
+		 */
+		template <class Iterator>
+		void generate(Iterator begin, Iterator end)
+		{
+			generate_impl(begin,end,raw_transform());
+		}
+		/// Fill a range with uniformly distributed numbers in [0,1[.
+		/**
+		 * Each number consumes one value of the sequence and has 32 bits of resolution.
+		 *
+		 * @param[in] begin beginning of the range.
+		 * @param[in] end end of the range.
+		 */
+		template <class Iterator>
+		void generate_uniform(Iterator begin, Iterator end)
+		{
+			generate_impl(begin,end,uniform_transform());
+		}
+		/// Fill a range with normally distributed numbers.
+		/**
+		 * Numbers are obtained with boost::normal_distribution (ziggurat method) drawing from a buffer of values of
+		 * the sequence generated in batches. As the ziggurat method rejects a small, random, fraction of the values, the number
+		 * of values of the sequence consumed by the call is deterministic but not known in advance.
+		 *
+		 * @param[in] begin beginning of the range.
+		 * @param[in] end end of the range.
+		 * @param[in] mean mean of the distribution.
+		 * @param[in] sigma standard deviation of the distribution.
+		 */
+		template <class Iterator>
+		void generate_normal(Iterator begin, Iterator end, const double &mean = 0., const double &sigma = 1.)
+		{
+			buffered_engine<rng_philox> engine(*this);
+			boost::normal_distribution<double> normal(mean,sigma);
+			for (; begin != end; ++begin) {
+				*begin = normal(engine);
+			}
+			engine.release();
+		}
+		/// Equality operator.
+		/**
+		 * @param[in] other generator to be compared to.
+		 *
+		 * @return true if the two generators will produce the same sequence.
+		 */
+		bool operator==(const rng_philox &other) const
+		{
+			return std::equal(m_key,m_key + 2,other.m_key) && std::equal(m_counter,m_counter + 4,other.m_counter) &&
+				m_idx == other.m_idx && std::equal(m_block + m_idx,m_block + 4,other.m_block + m_idx);
+		}
+		/// Inequality operator.
+		/**
+		 * @param[in] other generator to be compared to.
+		 *
+		 * @return !(*this == other).
+		 */
+		bool operator!=(const rng_philox &other) const
+		{
+			return !(*this == other);
+		}
+	private:
+		// Number of counters encrypted together by the batch functions.
+		static const std::size_t batch_size = 16;
+		struct raw_transform
+		{
+			result_type operator()(const boost::uint32_t &n) const {return n;}
+		};
+		struct uniform_transform
+		{
+			double operator()(const boost::uint32_t &n) const {return n * 2.3283064365386962890625e-10;}
+		};
+		// Boost engine reading from a buffer of values of a rng_philox filled in batches. The values left
+		// in the buffer are given back to the generator by release(). It is a template only because
+		// rng_philox is incomplete at this point.
+		template <class Rng>
+		class buffered_engine
+		{
+			public:
+				typedef boost::uint32_t result_type;
+				static const bool has_fixed_range = false;
+				explicit buffered_engine(Rng &rng):m_rng(rng),m_idx(buffer_size),m_filled_from(rng) {}
+				static result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0u;}
+				static result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0xFFFFFFFFu;}
+				result_type operator()()
+				{
+					if (m_idx == buffer_size) {
+						m_filled_from = m_rng;
+						m_rng.generate(m_buffer,m_buffer + buffer_size);
+						m_idx = 0u;
+					}
+					return m_buffer[m_idx++];
+				}
+				void release()
+				{
+					if (m_idx != buffer_size) {
+						m_rng = m_filled_from;
+						m_rng.discard(m_idx);
+					}
+				}
+			private:
+				static const std::size_t buffer_size = 4 * batch_size;
+				Rng		&m_rng;
+				std::size_t	m_idx;
+				Rng		m_filled_from;
+				result_type	m_buffer[buffer_size];
+		};
+		template <class Iterator, class Transform>
+		void generate_impl(Iterator begin, Iterator end, const Transform &t)
+		{
+			// Consume the current block first.
+			for (; m_idx < 4u && begin != end; ++begin) {
+				*begin = t(m_block[m_idx++]);
+			}
+			// Then encrypt batch_size counters at a time. The state is laid out as a structure of arrays
+			// so that each round is a simple loop over the batch.
+			boost::uint32_t x[4][batch_size];
+			while (begin != end) {
+				const boost::uint32_t start[4] = {m_counter[0], m_counter[1], m_counter[2], m_counter[3]};
+				for (std::size_t j = 0; j < batch_size; ++j) {
+					x[0][j] = m_counter[0];
+					x[1][j] = m_counter[1];
+					x[2][j] = m_counter[2];
+					x[3][j] = m_counter[3];
+					increment_counter(m_counter,1u);
+				}
+				encrypt_batch(x,m_key);
+				for (std::size_t j = 0; j < batch_size && begin != end; ++j) {
+					unsigned int k = 0u;
+					for (; k < 4u && begin != end; ++k, ++begin) {
+						*begin = t(x[k][j]);
+					}
+					if (begin == end) {
+						// Rewind the counter after the last block used, keeping it as the current block.
+						std::copy(start,start + 4,m_counter);
+						increment_counter(m_counter,j + 1u);
+						for (unsigned int i = 0u; i < 4u; ++i) {
+							m_block[i] = x[i][j];
+						}
+						m_idx = k;
+					}
+				}
+			}
+		}
+		static void mulhilo(const boost::uint32_t &a, const boost::uint32_t &b, boost::uint32_t &hi, boost::uint32_t &lo)
+		{
+			const boost::uint64_t product = static_cast<boost::uint64_t>(a) * b;
+			hi = static_cast<boost::uint32_t>(product >> 32);
+			lo = static_cast<boost::uint32_t>(product);
+		}
+		// Philox4x32-10 bijection of the counter ctr under the key key.
+		static void encrypt(const boost::uint32_t ctr[4], const boost::uint32_t key[2], boost::uint32_t out[4])
+		{
+			boost::uint32_t k[2] = {key[0], key[1]};
+			boost::uint32_t hi0, lo0, hi1, lo1;
+			std::copy(ctr,ctr + 4,out);
+			for (int round = 0; round < 10; ++round) {
+				if (round) {
+					k[0] += 0x9E3779B9u;
+					k[1] += 0xBB67AE85u;
+				}
+				mulhilo(0xD2511F53u, out[0], hi0, lo0);
+				mulhilo(0xCD9E8D57u, out[2], hi1, lo1);
+				out[0] = hi1 ^ out[1] ^ k[0];
+				out[1] = lo1;
+				out[2] = hi0 ^ out[3] ^ k[1];
+				out[3] = lo0;
+			}
+		}
+		// Same as encrypt(), in place on batch_size counters.
+		static void encrypt_batch(boost::uint32_t x[4][batch_size], const boost::uint32_t key[2])
+		{
+			boost::uint32_t k0 = key[0], k1 = key[1];
+			for (int round = 0; round < 10; ++round) {
+				if (round) {
+					k0 += 0x9E3779B9u;
+					k1 += 0xBB67AE85u;
+				}
+				for (std::size_t j = 0; j < batch_size; ++j) {
+					const boost::uint64_t p0 = static_cast<boost::uint64_t>(0xD2511F53u) * x[0][j];
+					const boost::uint64_t p1 = static_cast<boost::uint64_t>(0xCD9E8D57u) * x[2][j];
+					x[0][j] = static_cast<boost::uint32_t>(p1 >> 32) ^ x[1][j] ^ k0;
+					x[1][j] = static_cast<boost::uint32_t>(p1);
+					x[2][j] = static_cast<boost::uint32_t>(p0 >> 32) ^ x[3][j] ^ k1;
+					x[3][j] = static_cast<boost::uint32_t>(p0);
+				}
+			}
+		}
+		// Add n to the 128 bit counter ctr (modulo 2**128).
+		static void increment_counter(boost::uint32_t ctr[4], const boost::uint64_t &n)
+		{
+			const boost::uint64_t low = (static_cast<boost::uint64_t>(ctr[1]) << 32) + ctr[0];
+			const boost::uint64_t sum = low + n;
+			ctr[0] = static_cast<boost::uint32_t>(sum);
+			ctr[1] = static_cast<boost::uint32_t>(sum >> 32);
+			if (sum < low) {
+				for (int i = 2; i < 4 && ++ctr[i] == 0u; ++i) {}
+			}
+		}
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			ar & m_key;
+			ar & m_counter;
+			ar & m_block;
+			ar & m_idx;
+		}
+		boost::uint32_t	m_key[2];
+		boost::uint32_t	m_counter[4];
+		boost::uint32_t	m_block[4];
+		unsigned int	m_idx;
+};
+
+/// Counter-based rng returning a double in the [0,1[ range.
+/**
+ * Double precision counterpart of pagmo::rng_philox, following the Boost engine interface: it can be used wherever
+ * pagmo::rng_double is used. Each number is built from two values of the underlying pagmo::rng_philox sequence
+ * and has 53 bits of resolution.
+ */
+class __PAGMO_VISIBLE rng_philox_double {
+		friend class boost::serialization::access;
+	public:
+		/// Return value of the generator.
+		typedef double result_type;
+		/// The generator has a non fixed range (required by the Boost engine interface).
+		static const bool has_fixed_range = false;
+		/// Constructor from seed and stream identifier.
+		/**
+		 * @param[in] s seed.
+		 * @param[in] stream identifier of the stream.
+		 */
+		explicit rng_philox_double(const boost::uint32_t &s = 0u, const boost::uint32_t &stream = 0u):m_engine(s,stream) {}
+		// Default generated copy ctor and assignment are fine.
+		/// Re-seed the generator.
+		/**
+		 * @param[in] s seed.
+		 * @param[in] stream identifier of the stream.
+		 */
+		void seed(const boost::uint32_t &s = 0u, const boost::uint32_t &stream = 0u)
+		{
+			m_engine.seed(s,stream);
+		}
+		/// Minimum value returned by the generator.
+		static result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0.;}
+		/// Maximum value returned by the generator.
+		static result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () {return 1.;}
+		/// Return the next number in the sequence.
+		result_type operator()()
+		{
+			const boost::uint32_t a = m_engine() >> 5, b = m_engine() >> 6;
+			return to_double(a,b);
+		}
+		/// Jump ahead in the sequence.
+		/**
+		 * Equivalent to n calls to operator()(), but in constant time.
+		 *
+		 * @param[in] n number of values to be skipped.
+		 */
+		void discard(const boost::uint64_t &n)
+		{
+			m_engine.discard(2u * n);
+		}
+		/// Split the generator.
+		/**
+		 * @see rng_philox::split().
+		 *
+		 * @param[in] i index of the child.
+		 *
+		 * @return the i-th child of this generator.
+		 */
+		rng_philox_double split(const boost::uint32_t &i) const
+		{
+			rng_philox_double retval;
+			retval.m_engine = m_engine.split(i);
+			return retval;
+		}
+		/// Fill a range with the next numbers of the sequence.
+		/**
+		 * Equivalent to assigning operator()() to each element of the range, but computed in batches.
+		 *
+		 * @param[in] begin beginning of the range.
+		 * @param[in] end end of the range.
+		 */
+		template <class Iterator>
+		void generate(Iterator begin, Iterator end)
+		{
+			boost::uint32_t buffer[2 * 64];
+			std::size_t n = std::distance(begin,end);
+			while (n) {
+				const std::size_t chunk = std::min<std::size_t>(64u,n);
+				m_engine.generate(buffer,buffer + 2 * chunk);
+				for (std::size_t i = 0; i < chunk; ++i, ++begin) {
+					*begin = to_double(buffer[2 * i] >> 5,buffer[2 * i + 1] >> 6);
+				}
+				n -= chunk;
+			}
+		}
+		/// Equality operator.
+		/**
+		 * @param[in] other generator to be compared to.
+		 *
+		 * @return true if the two generators will produce the same sequence.
+		 */
+		bool operator==(const rng_philox_double &other) const
+		{
+			return m_engine == other.m_engine;
+		}
+		/// Inequality operator.
+		/**
+		 * @param[in] other generator to be compared to.
+		 *
+		 * @return !(*this == other).
+		 */
+		bool operator!=(const rng_philox_double &other) const
+		{
+			return !(*this == other);
+		}
+	private:
+		static double to_double(const boost::uint32_t &a, const boost::uint32_t &b)
+		{
+			return (a * 67108864. + b) * (1. / 9007199254740992.);
+		}
+		template <class Archive>
+		void serialize(Archive &ar, const unsigned int)
+		{
+			ar & m_engine;
+		}
+		rng_philox m_engine;
+};
+
 /// Generic thread-safe generator of pseudo-random number generators.
 /**
  * To use, call the static member get() to get a pseudo-random number generator seeded with an initial pseudo-random value.
@@ -109,6 +109,13 @@ void custom_vector_double_load(Archive &ar, std::vector<double> &v, const unsign
 	}
 }
 
+/// Archive flag for the serialization of the state of an object.
+/**
+ * When added to the flags of a boost archive, the data that does not affect the behaviour of an object (e.g., the
+ * evaluation caches of the problems) is skipped, so that objects in the same state produce the same archive.
+ */
+const unsigned int state_only_archive = boost::archive::flags_last << 1;
+
 }
 
 namespace boost { namespace serialization {
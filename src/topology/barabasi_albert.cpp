@@ -29,6 +29,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 
 #include "../exceptions.h"
@@ -79,8 +80,7 @@ void barabasi_albert::connect(const vertices_size_type &idx)
 				if (m_drng() < prob) {
 					connection_added = true;
 					// Add the connections
-					add_edge(*vertices.first,idx);
-					add_edge(idx,*vertices.first);
+					add_link(*vertices.first,idx);
 				}
 			}
 		}
@@ -95,52 +95,40 @@ void barabasi_albert::connect(const vertices_size_type &idx)
 				rnd = uni_int(m_urng);
 			} while (rnd == idx);
 			// Add connections to the random vertex.
-			add_edge(rnd,idx);
-			add_edge(idx,rnd);
+			add_link(rnd,idx);
 		}
 	} else {
 		// Now we need to add m edges, choosing the nodes with a probability
-		// proportional to their number of connections. We keep track of the
-		// connection established in order to avoid connecting twice to the same
-		// node.
+		// proportional to their number of connections. Picking a random entry of the
+		// list of the edges' source vertices is equivalent to selecting a random edge
+		// among all the existing edges and connecting to the vertex from which the
+		// selected edge departs. We keep track of the connection established in order
+		// to avoid connecting twice to the same node.
+		pagmo_assert(m_sources.size() == get_number_of_edges() && m_sources.size() > 0);
+		// Draw only among the edges existing before the insertion of idx.
+		boost::uniform_int<std::vector<vertices_size_type>::size_type> uni_int(0,m_sources.size() - 1);
 		std::size_t i = 0;
-		std::pair<v_iterator,v_iterator> vertices;
-		std::pair<a_iterator,a_iterator> adj_vertices;
-                while (i < m_m) {
-                        // Let's find the current total number of edges.
-                        const edges_size_type n_edges = get_number_of_edges();
-                        pagmo_assert(n_edges > 0);
-                        boost::uniform_int<edges_size_type> uni_int(0,n_edges - 1 - i);
-                        // Here we choose a random number between 0 and n_edges - 1 - i.
-			const edges_size_type rn = uni_int(m_urng);
-			edges_size_type n = 0;
-			// Iterate over all vertices and accumulate the number of edges for each of them. Stop when the accumulated number of edges is greater
-			// than rn. This is equivalent to giving a chance of connection to vertex v directly proportional to the number of edges departing from v.
-			// You can think of this process as selecting a random edge among all the existing edges and connecting to the vertex from which the
-			// selected edge departs.
-			vertices = get_vertices();
-                        for (; vertices.first != vertices.second; ++vertices.first) {
-				// Do not consider it_n.
-                                if (*vertices.first != idx) {
-					adj_vertices = get_adjacent_vertices(*vertices.first);
-					n += boost::numeric_cast<edges_size_type>(std::distance(adj_vertices.first,adj_vertices.second));
-                                        //std::cout << "vertex " << *vertices.first << "rn is " << rn << " and n is " << n << std::endl;
-                                        if (n > rn) {
-						break;
-					}
-                                }
-			}
-			pagmo_assert(vertices.first != vertices.second);
+		while (i < m_m) {
+			const vertices_size_type candidate = m_sources[uni_int(m_urng)];
 			// If the candidate was not already connected, then add it.
-			if (!are_adjacent(idx,*vertices.first)) {
-				add_edge(*vertices.first,idx);
-				add_edge(idx,*vertices.first);
+			if (!are_adjacent(idx,candidate)) {
+				add_link(candidate,idx);
 				++i;
 			}
 		}
 	}
 }
 
+// Connect bidirectionally two vertices, the second one being the newly-inserted vertex.
+void barabasi_albert::add_link(const vertices_size_type &n, const vertices_size_type &idx)
+{
+	// The edges are new, as idx has just been inserted and n is not yet adjacent to it.
+	add_new_edge(n,idx);
+	add_new_edge(idx,n);
+	m_sources.push_back(n);
+	m_sources.push_back(idx);
+}
+
 /// Topology-specific human readable info.
 /**
  * Will return a formatted string containing the size of the kernel and the number of connections for newly-inserted nodes.
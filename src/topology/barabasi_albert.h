@@ -27,6 +27,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../rng.h"
@@ -61,6 +62,7 @@ class __PAGMO_VISIBLE barabasi_albert: public base
 		void connect(const vertices_size_type &);
 		std::string human_readable_extra() const;
 	private:
+		void add_link(const vertices_size_type &, const vertices_size_type &);
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
@@ -70,6 +72,7 @@ class __PAGMO_VISIBLE barabasi_albert: public base
 			ar & const_cast<std::size_t &>(m_m);
 			ar & m_drng;
 			ar & m_urng;
+			ar & m_sources;
 		}  
 		// Size of the kernel - the starting number of nodes.
 		const std::size_t	m_m0;
@@ -79,6 +82,8 @@ class __PAGMO_VISIBLE barabasi_albert: public base
 		rng_double		m_drng;
 		// Integer random number generator.
 		rng_uint32		m_urng;
+		// Source vertex of each edge, in order of insertion: each vertex appears as many times as its number of connections.
+		std::vector<vertices_size_type>	m_sources;
 };
 
 }}
@@ -26,6 +26,8 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/johnson_all_pairs_shortest.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <iostream>
 #include <iterator>
 #include <sstream>
@@ -43,19 +45,19 @@ namespace pagmo { namespace topology {
 /**
  * Will build an empty topology.
  */
-base::base():m_graph() {};
+base::base():m_graph(),m_snapshot_valid(false) {};
 
 /// Copy constructor.
 /**
- * Will deep-copy all members.
+ * Will deep-copy the graph.
  *
  * @param[in] t topology::base to be copied.
  */
-base::base(const base &t):m_graph(t.m_graph) {}
+base::base(const base &t):m_graph(t.m_graph),m_snapshot_valid(false) {}
 
 /// Assignment operator.
 /**
- * Will perform a deep copy of all members.
+ * Will perform a deep copy of the graph.
  *
  * @param[in] t topology::base which will be copied into this.
  *
@@ -65,6 +67,7 @@ base &base::operator=(const base &t)
 {
 	if (this != &t) {
 		m_graph = t.m_graph;
+		m_snapshot_valid = false;
 	}
 	return *this;
 }
@@ -163,6 +166,7 @@ std::string base::human_readable_extra() const
 void base::add_vertex()
 {
 	boost::add_vertex(m_graph);
+	m_snapshot_valid = false;
 }
 
 // Check that a vertex number does not overflow the number of vertices in the graph.
@@ -197,10 +201,30 @@ std::pair<base::a_iterator,base::a_iterator> base::get_adjacent_vertices(const v
  */
 std::vector<base::vertices_size_type> base::get_v_adjacent_vertices(const vertices_size_type &idx) const
 {
-	const std::pair<base::a_iterator,base::a_iterator> tmp = get_adjacent_vertices(idx);
+	const vertices_range tmp = get_adjacent_range(idx);
 	return std::vector<base::vertices_size_type>(tmp.first,tmp.second);
 }
 
+/// Return range of adjacent vertices.
+/**
+ * Adjacent vertices are those connected from the interested index. Contrary to get_v_adjacent_vertices(), no memory is allocated:
+ * the range points into a compressed snapshot of the graph, built at the first query following a change in the topology. The range
+ * is invalidated by the next change in the topology.
+ *
+ * This method is thread-safe with respect to other const methods.
+ *
+ * @param[in] idx interested index.
+ *
+ * @return range of adjacent indices.
+ */
+base::vertices_range base::get_adjacent_range(const vertices_size_type &idx) const
+{
+	check_vertex_index(idx);
+	update_snapshot();
+	const vertices_size_type *targets = m_out_targets.empty() ? 0 : &m_out_targets[0];
+	return vertices_range(targets + m_out_offsets[idx],targets + m_out_offsets[idx + 1]);
+}
+
 /// Return true if two vertices are adjacent.
 /**
  * The direction of the edge must be n -> m. Will fail if either n or m are not in the topology.
@@ -275,10 +299,51 @@ std::pair<base::ia_iterator,base::ia_iterator> base::get_inv_adjacent_vertices(c
  */
 std::vector<base::vertices_size_type> base::get_v_inv_adjacent_vertices(const vertices_size_type &idx) const
 {
-	const std::pair<base::ia_iterator,base::ia_iterator> tmp = get_inv_adjacent_vertices(idx);
+	const vertices_range tmp = get_inv_adjacent_range(idx);
 	return std::vector<base::vertices_size_type>(tmp.first,tmp.second);
 }
 
+/// Return range of inversely adjacent vertices.
+/**
+ * Inversely adjacent vertices are those connected to the interested index. See get_adjacent_range() for the validity of the range.
+ *
+ * @param[in] idx index of the interested vertex.
+ *
+ * @return range of inversely adjacent indices.
+ */
+base::vertices_range base::get_inv_adjacent_range(const vertices_size_type &idx) const
+{
+	check_vertex_index(idx);
+	update_snapshot();
+	const vertices_size_type *sources = m_in_sources.empty() ? 0 : &m_in_sources[0];
+	return vertices_range(sources + m_in_offsets[idx],sources + m_in_offsets[idx + 1]);
+}
+
+// Rebuild the compressed snapshot of the graph, if the graph changed since the last rebuild.
+void base::update_snapshot() const
+{
+	boost::lock_guard<boost::mutex> lock(m_snapshot_mutex);
+	if (m_snapshot_valid) {
+		return;
+	}
+	const vertices_size_type n_vertices = boost::num_vertices(m_graph);
+	const edges_size_type n_edges = boost::num_edges(m_graph);
+	m_out_offsets.resize(n_vertices + 1);
+	m_in_offsets.resize(n_vertices + 1);
+	m_out_targets.resize(boost::numeric_cast<std::vector<vertices_size_type>::size_type>(n_edges));
+	m_in_sources.resize(boost::numeric_cast<std::vector<vertices_size_type>::size_type>(n_edges));
+	m_out_offsets[0] = 0;
+	m_in_offsets[0] = 0;
+	for (vertices_size_type i = 0; i < n_vertices; ++i) {
+		const std::pair<a_iterator,a_iterator> a_vertices = boost::adjacent_vertices(boost::vertex(i,m_graph),m_graph);
+		const std::pair<ia_iterator,ia_iterator> ia_vertices = boost::inv_adjacent_vertices(boost::vertex(i,m_graph),m_graph);
+		m_out_offsets[i + 1] = std::copy(a_vertices.first,a_vertices.second,m_out_targets.begin() + m_out_offsets[i]) - m_out_targets.begin();
+		m_in_offsets[i + 1] = std::copy(ia_vertices.first,ia_vertices.second,m_in_sources.begin() + m_in_offsets[i]) - m_in_sources.begin();
+	}
+	pagmo_assert(m_out_offsets.back() == n_edges && m_in_offsets.back() == n_edges);
+	m_snapshot_valid = true;
+}
+
 /// Return the number of inversely adjacent vertices.
 /**
  * @return number of inversely adjacent vertices.
@@ -301,11 +366,26 @@ void base::add_edge(const vertices_size_type &n, const vertices_size_type &m)
 	if (are_adjacent(n,m)) {
 		pagmo_throw(value_error,"cannot add edge, vertices are already connected");
 	}
+	add_new_edge(n,m);
+}
+
+/// Add an edge known not to exist.
+/**
+ * Add an edge connecting n to m, without checking whether the vertices are already connected (which is checked only in debug mode).
+ * To be used by topologies which know that the edge is new, to build large graphs in a time proportional to the number of edges.
+ *
+ * @param[in] n index of the first vertex.
+ * @param[in] m index of the second vertex.
+ */
+void base::add_new_edge(const vertices_size_type &n, const vertices_size_type &m)
+{
+	pagmo_assert(!are_adjacent(n,m));
 	const std::pair<e_descriptor,bool> result = boost::add_edge(boost::vertex(n,m_graph),boost::vertex(m,m_graph),m_graph);
 	pagmo_assert(result.second);
 	// Assign weight 1 to the edge.
 	boost::property_map<graph_type,boost::edge_weight_t>::type w = boost::get(boost::edge_weight,m_graph);
 	w[result.first] = 1;
+	m_snapshot_valid = false;
 }
 
 /// Remove an edge.
@@ -321,6 +401,7 @@ void base::remove_edge(const vertices_size_type &n, const vertices_size_type &m)
 		pagmo_throw(value_error,"cannot remove edge, vertices are not connected");
 	}
 	boost::remove_edge(boost::vertex(n,m_graph),boost::vertex(m,m_graph),m_graph);
+	m_snapshot_valid = false;
 }
 
 /// Remove all edges.
@@ -332,6 +413,7 @@ void base::remove_all_edges()
 	for (std::pair<v_iterator,v_iterator> vertices = get_vertices(); vertices.first != vertices.second; ++vertices.first) {
 		boost::clear_vertex(*vertices.first,m_graph);
 	}
+	m_snapshot_valid = false;
 }
 
 /// Return iterator range to vertices.
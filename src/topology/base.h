@@ -27,6 +27,7 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -97,6 +98,8 @@ class __PAGMO_VISIBLE base
 		typedef graph_type::vertices_size_type vertices_size_type;
 		/// Edges size type.
 		typedef graph_type::edges_size_type edges_size_type;
+		/// Contiguous range of vertex indices, as a pair of pointers.
+		typedef std::pair<const vertices_size_type *,const vertices_size_type *> vertices_range;
 		base();
 		base(const base &);
 		base &operator=(const base &);
@@ -127,6 +130,8 @@ class __PAGMO_VISIBLE base
 		bool are_inv_adjacent(const vertices_size_type &,const vertices_size_type &) const;
 		std::vector<vertices_size_type> get_v_adjacent_vertices(const vertices_size_type &) const;
 		std::vector<vertices_size_type> get_v_inv_adjacent_vertices(const vertices_size_type &) const;
+		vertices_range get_adjacent_range(const vertices_size_type &) const;
+		vertices_range get_inv_adjacent_range(const vertices_size_type &) const;
 		edges_size_type get_num_adjacent_vertices(const vertices_size_type &) const;
 		edges_size_type get_num_inv_adjacent_vertices(const vertices_size_type &) const;
 		//@}
@@ -137,6 +142,7 @@ class __PAGMO_VISIBLE base
 		std::pair<a_iterator,a_iterator> get_adjacent_vertices(const vertices_size_type &) const;
 		std::pair<ia_iterator,ia_iterator> get_inv_adjacent_vertices(const vertices_size_type &) const;
 		void add_edge(const vertices_size_type &, const vertices_size_type &);
+		void add_new_edge(const vertices_size_type &, const vertices_size_type &);
 		void remove_edge(const vertices_size_type &, const vertices_size_type &);
 		void remove_all_edges();
 		std::pair<v_iterator,v_iterator> get_vertices() const;
@@ -152,14 +158,25 @@ class __PAGMO_VISIBLE base
 		virtual std::string human_readable_extra() const;
 	private:
 		void check_vertex_index(const vertices_size_type &) const;
+		void update_snapshot() const;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int)
 		{
 			ar & m_graph;
+			m_snapshot_valid = false;
 		}
 	private:
 		graph_type m_graph;
+		// Compressed sparse row snapshot of the graph: the adjacent (resp. inversely adjacent) vertices of vertex i
+		// are m_out_targets[m_out_offsets[i]..m_out_offsets[i + 1]) (resp. the same in m_in_sources). It is rebuilt
+		// lazily, under m_snapshot_mutex, at the first query following a change in the graph.
+		mutable std::vector<vertices_size_type>	m_out_offsets;
+		mutable std::vector<vertices_size_type>	m_out_targets;
+		mutable std::vector<vertices_size_type>	m_in_offsets;
+		mutable std::vector<vertices_size_type>	m_in_sources;
+		mutable bool				m_snapshot_valid;
+		mutable boost::mutex			m_snapshot_mutex;
 };
 
 std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
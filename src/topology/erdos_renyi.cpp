@@ -22,6 +22,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <cmath>
 #include <sstream>
 #include <string>
 
@@ -54,12 +55,28 @@ base_ptr erdos_renyi::clone() const
 
 void erdos_renyi::connect(const vertices_size_type &n)
 {
-	for (std::pair<v_iterator,v_iterator> vertices = get_vertices(); vertices.first != vertices.second; ++vertices.first) {
-		// Connect n bidirectionally to the other nodes with probability m_prob. Also, avoid to connect n with itself.
-		if (*vertices.first != n && m_drng() < m_prob) {
-			add_edge(n,*vertices.first);
-			add_edge(*vertices.first,n);
+	// Connect n bidirectionally to the other nodes with probability m_prob. Instead of drawing a random number for each node,
+	// we draw the gaps between the connected nodes, which are geometrically distributed, so that the cost is proportional to
+	// the number of edges added rather than to the number of nodes.
+	if (m_prob == 0) {
+		return;
+	}
+	// Candidates are the nodes other than n, in order: candidate c is node c if c < n, node c + 1 otherwise.
+	const vertices_size_type n_candidates = get_number_of_vertices() - 1;
+	const double log_q = std::log(1 - m_prob);
+	for (vertices_size_type c = 0; c < n_candidates; ++c) {
+		if (m_prob < 1) {
+			// Number of candidates skipped before the next connection.
+			const double skip = std::floor(std::log(1 - m_drng()) / log_q);
+			if (skip >= static_cast<double>(n_candidates - c)) {
+				break;
+			}
+			c += static_cast<vertices_size_type>(skip);
 		}
+		const vertices_size_type v = c < n ? c : c + 1;
+		// The edges are new, as n has just been added.
+		add_new_edge(n,v);
+		add_new_edge(v,n);
 	}
 }
 
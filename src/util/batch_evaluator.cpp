@@ -0,0 +1,91 @@
+#include <vector>
+
+#include "../exceptions.h"
+#include "../problem/base_stochastic.h"
+#include "batch_evaluator.h"
+#include "parallel.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Evaluates one decision vector on the clone of the worker.
+class evaluation_task {
+public:
+	evaluation_task(const std::vector<problem::base_ptr> &probs, const std::vector<decision_vector> &x,
+		std::vector<fitness_vector> &f, std::vector<constraint_vector> &c):
+		m_probs(probs), m_x(x), m_f(f), m_c(c) {}
+	void operator()(std::size_t i, unsigned int worker_idx)
+	{
+		m_probs[worker_idx]->objfun(m_f[i], m_x[i]);
+		m_probs[worker_idx]->compute_constraints(m_c[i], m_x[i]);
+	}
+private:
+	const std::vector<problem::base_ptr> &m_probs;
+	const std::vector<decision_vector> &m_x;
+	std::vector<fitness_vector> &m_f;
+	std::vector<constraint_vector> &m_c;
+};
+
+}
+
+/// Constructor
+/**
+ * @param[in] prob the problem
+ * @param[in] n_threads maximum number of threads to be used (if 1, the problem itself is used)
+ *
+ * @throws value_error if n_threads is zero
+ */
+batch_evaluator::batch_evaluator(const problem::base &prob, unsigned int n_threads):m_prob(prob),m_n_threads(n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	if (n_threads > 1) {
+		for (unsigned int i = 0; i < n_threads; ++i) {
+			m_probs.push_back(prob.clone());
+		}
+	}
+}
+
+/// Evaluates a batch
+/**
+ * @param[in] x the decision vectors
+ * @param[out] f f[i] will contain the fitness vector of x[i]
+ * @param[out] c c[i] will contain the constraint vector of x[i]
+ *
+ * @throws std::runtime_error if the evaluation failed in one of the threads
+ */
+void batch_evaluator::evaluate(const std::vector<decision_vector> &x, std::vector<fitness_vector> &f, std::vector<constraint_vector> &c) const
+{
+	f.resize(x.size());
+	c.resize(x.size());
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		f[i].resize(m_prob.get_f_dimension());
+		c[i].resize(m_prob.get_c_dimension());
+	}
+	if (m_probs.empty() || x.size() <= 1) {
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			m_prob.objfun(f[i], x[i]);
+			m_prob.compute_constraints(c[i], x[i]);
+		}
+		return;
+	}
+	// The clones must see the current seed of a stochastic problem.
+	const problem::base_stochastic *stochastic = dynamic_cast<const problem::base_stochastic *>(&m_prob);
+	if (stochastic) {
+		for (unsigned int i = 0; i < m_probs.size(); ++i) {
+			dynamic_cast<const problem::base_stochastic &>(*m_probs[i]).set_seed(stochastic->get_seed());
+		}
+	}
+	evaluation_task task(m_probs, x, f, c);
+	parallel::for_each_index(x.size(), m_n_threads, task);
+}
+
+/// Maximum number of threads used
+unsigned int batch_evaluator::get_n_threads() const
+{
+	return m_n_threads;
+}
+
+}}
@@ -0,0 +1,59 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_BATCH_EVALUATOR_H
+#define PAGMO_UTIL_BATCH_EVALUATOR_H
+
+#include <vector>
+
+#include "../config.h"
+#include "../problem/base.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Evaluation of batches of decision vectors
+/**
+ * Evaluates the fitness and the constraints of a batch of decision vectors, either in the calling thread on the problem
+ * itself (so that its caches are filled as usual) or on a pool of threads, each owning a clone of the problem. Stochastic
+ * problems are evaluated by the clones with the current seed of the problem, hence the results never depend on the
+ * number of threads.
+ *
+ * The clones are made once, at construction, so that a batch_evaluator can be reused across the generations of an
+ * algorithm. The problem must outlive the batch_evaluator.
+ */
+class __PAGMO_VISIBLE batch_evaluator {
+public:
+	batch_evaluator(const problem::base &, unsigned int = 1);
+	void evaluate(const std::vector<decision_vector> &, std::vector<fitness_vector> &, std::vector<constraint_vector> &) const;
+	unsigned int get_n_threads() const;
+private:
+	const problem::base		&m_prob;
+	const unsigned int		m_n_threads;
+	std::vector<problem::base_ptr>	m_probs;
+};
+
+}}
+
+#endif
@@ -13,6 +13,78 @@ namespace pagmo{ namespace util {namespace discrepancy {
 
 base::~base() {}
 
+/// Generate a batch of points
+/**
+ * Writes the next n points of the sequence, one after the other, in a buffer of n * get_dimension() elements,
+ * as if operator()() was called n times, but without allocations.
+ *
+ * @param[out] out buffer receiving the points
+ * @param[in] n number of points to generate
+ */
+void base::generate(double *out, unsigned int n)
+{
+	generate_impl(out,n);
+}
+
+/// Generate a batch of points
+/**
+ * Same as generate(double *, unsigned int), resizing out to n * get_dimension() elements.
+ *
+ * @param[out] out vector receiving the points
+ * @param[in] n number of points to generate
+ */
+void base::generate(std::vector<double> &out, unsigned int n)
+{
+	out.resize(static_cast<std::vector<double>::size_type>(n) * m_dim);
+	if (n) {
+		generate_impl(&out[0],n);
+	}
+}
+
+/// Jump to a position in the sequence
+/**
+ * The next point returned by operator()() or generate() will be the n-th point of the sequence.
+ *
+ * @param[in] n the position
+ */
+void base::set_count(unsigned int n)
+{
+	m_count = n;
+}
+
+/// Position in the sequence
+/**
+ * @return the position of the next point to be generated
+ */
+unsigned int base::get_count() const
+{
+	return m_count;
+}
+
+/// Dimension
+/**
+ * @return the dimension of the points
+ */
+unsigned int base::get_dimension() const
+{
+	return m_dim;
+}
+
+/// Batch generation implementation
+/**
+ * Calls operator()() n times. Derived classes can override it to avoid the temporary vectors.
+ *
+ * @param[out] out buffer receiving the points
+ * @param[in] n number of points to generate
+ */
+void base::generate_impl(double *out, unsigned int n)
+{
+	for (unsigned int i = 0; i < n; ++i) {
+		const std::vector<double> tmp = (*this)();
+		std::copy(tmp.begin(),tmp.end(),out + static_cast<std::size_t>(i) * m_dim);
+	}
+}
+
 
 
 /// Van Der Corput sequence
@@ -31,7 +103,7 @@ double van_der_corput(unsigned int n, unsigned int base) {
 	unsigned int i = n;
 	while (i > 0) {
 		retval += f * (i % base);
-		i = floor(i / base);
+		i /= base;
 		f = f / base;
 	}
 	return retval;
@@ -261,13 +333,14 @@ unsigned int prime_ge ( unsigned int n )
 
 //****************************************************************************80
 
-int *faure::binomial_table ( int qs, int m, int n )
+void faure::binomial_table ( int qs, int m, int n )
 
 //****************************************************************************80
 //
 //  Purpose:
 //
-//    BINOMIAL_TABLE computes a table of bionomial coefficients MOD QS.
+//    BINOMIAL_TABLE computes a table of bionomial coefficients MOD QS,
+//    stored in m_coef.
 //
 //  Discussion:
 //
@@ -292,23 +365,15 @@ int *faure::binomial_table ( int qs, int m, int n )
 //
 //    Input, int M, N, the limits of the binomial table.
 //
-//    Output, int BINOMIAL_TABLE[(M+1)*(N+1)], the table of binomial
+//    Output, M_COEF[(M+1)*(N+1)], the table of binomial
 //    coefficients modulo QS.
 //
 {
-  int *coef;
+  std::vector<int> &coef = m_coef;
   int i;
   int j;
 
-  coef = new int[(m+1)*(n+1)];
-
-  for ( j = 0; j <= n; j++ )
-  {
-	for ( i = 0; i <= m; i++ )
-	{
-	  coef[i+j*(m+1)] = 0;
-	}
-  }
+  coef.assign((m+1)*(n+1),0);
 
   coef[0] = 1;
 
@@ -331,8 +396,6 @@ int *faure::binomial_table ( int qs, int m, int n )
 	  coef[i+j*(m+1)] = ( coef[i-1+j*(m+1)] + coef[i-1+(j-1)*(m+1)] ) % qs;
 	}
   }
-
-  return coef;
 }
 //****************************************************************************80
 
@@ -434,21 +497,11 @@ void faure::faure_orig ( unsigned int dim_num, unsigned int *seed, double quasi[
 //
   if ( m_hisum_save != hisum )
   {
-	if ( m_coef != NULL )
-	{
-	  delete [] m_coef;
-	}
-
-	if ( m_ytemp != NULL )
-	{
-	  delete [] m_ytemp;
-	}
-
 	m_hisum_save = hisum;
 
-	m_coef = binomial_table ( m_qs, hisum, hisum );
+	binomial_table ( m_qs, hisum, hisum );
 
-	m_ytemp = new int[hisum+1];
+	m_ytemp.resize(hisum+1);
   }
 //
 //  Find QUASI(1) using the method of Faure.
@@ -782,6 +835,28 @@ std::vector<double> halton::operator()(unsigned int n) {
 	return retval;
 }
 
+/// Jump to a position in the sequence
+/**
+ * @param[in] n the position of the next point (the first point has index 1)
+ *
+ * @throws value_error if n is 0
+ */
+void halton::set_count(unsigned int n) {
+	if (n == 0) {
+		pagmo_throw(value_error,"Halton sequence first point id is 1");
+	}
+	m_count = n;
+}
+
+/// Batch generation implementation
+void halton::generate_impl(double *out, unsigned int n) {
+	for (unsigned int i = 0; i < n; ++i, ++m_count) {
+		for (unsigned int j = 0; j < m_dim; ++j) {
+			*out++ = van_der_corput(m_count,m_primes[j]);
+		}
+	}
+}
+
 
 
 /// Constructor
@@ -791,7 +866,7 @@ std::vector<double> halton::operator()(unsigned int n) {
  *
  * @throws value_error if dim not in [2,23]
 */
-faure::faure(unsigned int dim, unsigned int count) : base(dim, count), m_coef(NULL), m_hisum_save(-1), m_qs(-1), m_ytemp(NULL) {
+faure::faure(unsigned int dim, unsigned int count) : base(dim, count), m_coef(), m_hisum_save(-1), m_qs(-1), m_ytemp() {
 		if (dim >23 || dim <2) {
 			pagmo_throw(value_error,"Faure sequences can have dimension [2,23]");
 		}
@@ -826,6 +901,13 @@ std::vector<double> faure::operator()(unsigned int n) {
 	return retval;
 }
 
+/// Batch generation implementation
+void faure::generate_impl(double *out, unsigned int n) {
+	for (unsigned int i = 0; i < n; ++i) {
+		faure_orig(m_dim, &m_count, out + static_cast<std::size_t>(i) * m_dim);
+	}
+}
+
 /// Constructor
 /**
  * @param[in] dim dimension of the hypercube
@@ -833,7 +915,7 @@ std::vector<double> faure::operator()(unsigned int n) {
  *
  * @throws value_error if dim not in [1..10] or count ==0
 */
-simplex::simplex(unsigned int dim, unsigned int count) : base(dim,count), m_generator(dim-1), m_projector(dim) {
+simplex::simplex(unsigned int dim, unsigned int count) : base(dim,count), m_generator(dim-1,count), m_projector(dim) {
 	if (dim >10 || dim==0) {
 		pagmo_throw(value_error,"Halton sequences should not be used in dimension >10");
 	}
@@ -855,8 +937,8 @@ base_ptr simplex::clone() const
  */
 std::vector<double> simplex::operator()() {
 	std::vector<double> tmp = m_generator();
-//std::cout << tmp[0] << " " << tmp[1] << " " << std::endl;
 	std::vector<double> retval = m_projector(tmp);
+	m_count++;
 	return retval;
 }
 /// Operator (unsigned int n)
@@ -868,7 +950,213 @@ std::vector<double> simplex::operator()() {
  */
 std::vector<double> simplex::operator()(unsigned int n) {
 	std::vector<double> retval = m_projector(m_generator(n));
+	m_count = n+1;
 	return retval;
 }
 
+/// Jump to a position in the sequence
+/**
+ * @param[in] n the position of the next point (the first point has index 1)
+ *
+ * @throws value_error if n is 0
+ */
+void simplex::set_count(unsigned int n) {
+	m_generator.set_count(n);
+	m_count = n;
+}
+
+/// Batch generation implementation
+/**
+ * Same projection as project_2_simplex, done in place.
+ */
+void simplex::generate_impl(double *out, unsigned int n) {
+	// Points of the Halton sequence, framed by 0 and 1.
+	std::vector<double> tmp(m_dim + 1);
+	tmp[0] = 0.;
+	tmp[m_dim] = 1.;
+	for (unsigned int i = 0; i < n; ++i, out += m_dim) {
+		m_generator.generate(&tmp[1],1);
+		std::sort(tmp.begin() + 1,tmp.end() - 1);
+		double cumsum = 0;
+		for (unsigned int j = 0; j < m_dim; ++j) {
+			out[j] = tmp[j+1] - tmp[j];
+			cumsum += out[j];
+		}
+		for (unsigned int j = 0; j < m_dim; ++j) {
+			out[j] /= cumsum;
+		}
+	}
+	m_count += n;
+}
+
+// Primitive polynomials and initial direction numbers of Joe and Kuo (new-joe-kuo-6.21201), for the dimensions 2 to 40:
+// degree s, coefficients a (without the leading and trailing ones) and the s initial numbers m.
+namespace {
+
+struct sobol_init
+{
+	unsigned int s;
+	unsigned int a;
+	unsigned int m[8];
+};
+
+const sobol_init sobol_table[] = {
+	{1,0,{1}},
+	{2,1,{1,3}},
+	{3,1,{1,3,1}},
+	{3,2,{1,1,1}},
+	{4,1,{1,1,3,3}},
+	{4,4,{1,3,5,13}},
+	{5,2,{1,1,5,5,17}},
+	{5,4,{1,1,5,5,5}},
+	{5,7,{1,1,7,11,19}},
+	{5,11,{1,1,5,1,1}},
+	{5,13,{1,1,1,3,11}},
+	{5,14,{1,3,5,5,31}},
+	{6,1,{1,3,3,9,7,49}},
+	{6,13,{1,1,1,15,21,21}},
+	{6,16,{1,3,1,13,27,49}},
+	{6,19,{1,1,1,15,7,5}},
+	{6,22,{1,3,1,15,13,25}},
+	{6,25,{1,1,5,5,19,61}},
+	{7,1,{1,3,7,11,23,15,103}},
+	{7,4,{1,3,7,13,13,15,69}},
+	{7,7,{1,1,3,13,7,35,63}},
+	{7,8,{1,3,5,9,1,25,53}},
+	{7,14,{1,3,1,13,9,35,107}},
+	{7,19,{1,3,1,5,27,61,31}},
+	{7,21,{1,1,5,11,19,41,61}},
+	{7,28,{1,3,5,3,3,13,69}},
+	{7,31,{1,1,7,13,1,19,1}},
+	{7,32,{1,3,7,5,13,19,59}},
+	{7,37,{1,1,3,9,25,29,41}},
+	{7,41,{1,3,5,13,23,1,55}},
+	{7,42,{1,3,7,3,13,59,17}},
+	{7,50,{1,3,1,3,5,53,69}},
+	{7,55,{1,1,5,5,23,33,13}},
+	{7,56,{1,1,7,7,1,61,123}},
+	{7,59,{1,1,7,9,13,61,49}},
+	{7,62,{1,3,3,5,3,55,33}},
+	{8,14,{1,3,1,15,31,13,49,245}},
+	{8,21,{1,3,5,15,31,59,63,97}},
+	{8,22,{1,3,1,11,11,11,77,249}}
+};
+
+const unsigned int sobol_max_dim = sizeof(sobol_table) / sizeof(sobol_init) + 1;
+
+}
+
+/// Constructor
+/**
+ * @param[in] dim dimension of the hypercube
+ * @param[in] count starting point of the sequence (the point 0 is the origin, the first point is [0.5,0.5, ....])
+ *
+ * @throws value_error if dim not in [1,40]
+*/
+sobol::sobol(unsigned int dim, unsigned int count) : base(dim,count), m_directions(), m_state() {
+	if (dim > sobol_max_dim || dim == 0) {
+		pagmo_throw(value_error,"Sobol sequences can have dimension [1,40]");
+	}
+	m_directions.resize(32u * dim);
+	// The first dimension is the van der Corput sequence in base 2.
+	for (unsigned int k = 0; k < 32u; ++k) {
+		m_directions[k] = boost::uint32_t(1) << (31u - k);
+	}
+	for (unsigned int d = 1; d < dim; ++d) {
+		const sobol_init &init = sobol_table[d - 1];
+		boost::uint32_t *v = &m_directions[32u * d];
+		for (unsigned int k = 0; k < 32u; ++k) {
+			if (k < init.s) {
+				v[k] = boost::uint32_t(init.m[k]) << (31u - k);
+			} else {
+				v[k] = v[k - init.s] ^ (v[k - init.s] >> init.s);
+				for (unsigned int i = 1; i < init.s; ++i) {
+					if ((init.a >> (init.s - 1u - i)) & 1u) {
+						v[k] ^= v[k - i];
+					}
+				}
+			}
+		}
+	}
+	set_count(count);
+}
+
+/// Clone method.
+base_ptr sobol::clone() const
+{
+	return base_ptr(new sobol(*this));
+}
+
+/// Operator ()
+/**
+ * Returns the next point in the sequence
+ *
+ * @return an std::vector<double> containing the next point
+ */
+std::vector<double> sobol::operator()() {
+	std::vector<double> retval(m_dim);
+	next(&retval[0]);
+	return retval;
+}
+
+/// Operator (unsigned int n)
+/**
+ * Returns the n-th point in the sequence
+ *
+ * @param[in] n the point along the sequence to be returned
+ * @return an std::vector<double> containing the n-th point
+ */
+std::vector<double> sobol::operator()(unsigned int n) {
+	set_count(n);
+	return (*this)();
+}
+
+/// Jump to a position in the sequence
+/**
+ * The integer coordinates of the n-th point are the xor of the direction numbers selected by
+ * the bits of the Gray code of n.
+ *
+ * @param[in] n the position of the next point
+ */
+void sobol::set_count(unsigned int n) {
+	m_count = n;
+	m_state.assign(m_dim,0u);
+	const boost::uint32_t gray = n ^ (n >> 1);
+	for (unsigned int k = 0; k < 32u; ++k) {
+		if ((gray >> k) & 1u) {
+			for (unsigned int d = 0; d < m_dim; ++d) {
+				m_state[d] ^= m_directions[32u * d + k];
+			}
+		}
+	}
+}
+
+/// Batch generation implementation
+void sobol::generate_impl(double *out, unsigned int n) {
+	for (unsigned int i = 0; i < n; ++i) {
+		next(out + static_cast<std::size_t>(i) * m_dim);
+	}
+}
+
+// Write the point at position m_count and move to the next one, which differs in the direction
+// numbers of the lowest set bit of m_count + 1.
+void sobol::next(double *out) {
+	for (unsigned int d = 0; d < m_dim; ++d) {
+		out[d] = m_state[d] * (1. / 4294967296.);
+	}
+	++m_count;
+	unsigned int k = 0;
+	for (unsigned int c = m_count; c && !(c & 1u); c >>= 1) {
+		++k;
+	}
+	if (m_count) {
+		for (unsigned int d = 0; d < m_dim; ++d) {
+			m_state[d] ^= m_directions[32u * d + k];
+		}
+	} else {
+		// The counter wrapped around.
+		set_count(0);
+	}
+}
+
 }}} //namespaces
@@ -29,6 +29,7 @@
 #include <vector>
 #include <math.h>
 #include <algorithm>
+#include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "../config.h"
@@ -90,6 +91,10 @@ typedef boost::shared_ptr<base> base_ptr;
 /**
  * This class cannot be instantiated as it contains pure virtual members. All classes
  * that generate quasi-random sequences with low-discrepancy must inherit from this class. 
+ *
+ * Besides returning one point at a time, the sequences can fill a caller-provided buffer with
+ * many consecutive points (see generate()) and jump to any position (see set_count()). To generate
+ * a sequence in parallel, each thread can work on a clone() positioned at the start of its own chunk.
  * 
  * @author Dario Izzo (dario.izzo@gmail.com)
  */
@@ -121,7 +126,13 @@ public:
 	virtual base_ptr clone() const = 0;
 	/// Virtual destructor. Required as the class contains pure virtual methods
 	virtual~base();
+	void generate(double *, unsigned int);
+	void generate(std::vector<double> &, unsigned int);
+	virtual void set_count(unsigned int);
+	unsigned int get_count() const;
+	unsigned int get_dimension() const;
 protected:
+	virtual void generate_impl(double *, unsigned int);
 	/// Hypercube dimension where sampling with low-discrepancy
 	unsigned int m_dim;
 	/// Starting point of the sequence (can be used to skip initial values)
@@ -147,6 +158,9 @@ class __PAGMO_VISIBLE halton : public base
 		base_ptr clone() const;
 		std::vector<double> operator()();
 		std::vector<double> operator()(unsigned int n);
+		void set_count(unsigned int);
+	protected:
+		void generate_impl(double *, unsigned int);
 	private:
 		std::vector<unsigned int> m_primes;
 };
@@ -167,18 +181,19 @@ class __PAGMO_VISIBLE faure : public base
 	base_ptr clone() const;
 	std::vector<double> operator()();
 	std::vector<double> operator()(unsigned int n);
+	protected:
+		void generate_impl(double *, unsigned int);
 	private:
-		int *binomial_table ( int qs, int m, int n );
+		void binomial_table ( int qs, int m, int n );
 		void faure_orig ( unsigned int dim_num, unsigned int *seed, double quasi[] );
-		double *faure_generate ( int dim_num, int n, int skip );
 		int i4_log_i4 ( int i4, int j4 );
 		int i4_min ( int i1, int i2 );
 		int i4_power ( int i, int j );
 	private:
-		int *m_coef;
+		std::vector<int> m_coef;
 		int m_hisum_save;
 		int m_qs;
-		int *m_ytemp;
+		std::vector<int> m_ytemp;
 
 };
 
@@ -198,11 +213,43 @@ public:
 	base_ptr clone() const;
 	std::vector<double> operator()();
 	std::vector<double> operator()(unsigned int n);
+	void set_count(unsigned int);
+protected:
+	void generate_impl(double *, unsigned int);
 private:
 	halton m_generator;
 	project_2_simplex m_projector;
 };
 
+/// Sobol quasi-random point sequence
+/**
+ * Class that generates a quasi-random sequence of
+ * points in the unit hyper-cube using the Sobol sequence in base 2, with the
+ * direction numbers of Joe and Kuo. Consecutive points are obtained in Gray code order,
+ * with one xor per coordinate, and any point can be reached directly.
+ *
+ * @see http://en.wikipedia.org/wiki/Sobol_sequence
+ * @see S. Joe and F. Y. Kuo, "Constructing Sobol sequences with better two-dimensional projections",
+ * SIAM J. Sci. Comput. 30, 2635-2654 (2008)
+*/
+class __PAGMO_VISIBLE sobol : public base
+{
+public:
+	sobol(unsigned int dim, unsigned int count = 1);
+	base_ptr clone() const;
+	std::vector<double> operator()();
+	std::vector<double> operator()(unsigned int n);
+	void set_count(unsigned int);
+protected:
+	void generate_impl(double *, unsigned int);
+private:
+	void next(double *);
+	// Direction numbers, 32 per dimension.
+	std::vector<boost::uint32_t> m_directions;
+	// Integer coordinates of the point at position m_count.
+	std::vector<boost::uint32_t> m_state;
+};
+
 }}} //namespace discrepancy
 
 #endif
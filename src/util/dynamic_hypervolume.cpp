@@ -0,0 +1,761 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "dynamic_hypervolume.h"
+#include "hv_algorithm/base.h"
+#include "hv_algorithm/hv3d.h"
+
+namespace pagmo { namespace util {
+
+/// Constructor
+/**
+ * Builds an empty set of points.
+ *
+ * @param[in] r_point reference point
+ */
+dynamic_hypervolume::dynamic_hypervolume(const fitness_vector &r_point):m_r_point(r_point),m_hv(0),m_next_handle(0) {}
+
+/// Trivial destructor.
+dynamic_hypervolume::~dynamic_hypervolume() {}
+
+/// Insert a point
+/**
+ * @param[in] point the point
+ *
+ * @return the handle of the point
+ *
+ * @throws value_error if the point and the reference point have different dimensions, or if the point exceeds the reference point
+ */
+dynamic_hypervolume::size_type dynamic_hypervolume::insert(const fitness_vector &point)
+{
+	return insert(std::vector<fitness_vector>(1,point));
+}
+
+/// Insert several points
+/**
+ * The points get consecutive handles.
+ *
+ * @param[in] points the points
+ *
+ * @return the handle of the first point
+ *
+ * @throws value_error if a point and the reference point have different dimensions, or if a point exceeds the reference point
+ */
+dynamic_hypervolume::size_type dynamic_hypervolume::insert(const std::vector<fitness_vector> &points)
+{
+	for (std::vector<fitness_vector>::size_type i = 0; i < points.size(); ++i) {
+		if (points[i].size() != m_r_point.size()) {
+			pagmo_throw(value_error,"Point and reference point dimensions must be equal.");
+		}
+		for (fitness_vector::size_type j = 0; j < m_r_point.size(); ++j) {
+			if (points[i][j] > m_r_point[j]) {
+				pagmo_throw(value_error,"Reference point is invalid: a point is outside the reference point boundary.");
+			}
+		}
+	}
+	const size_type first = m_next_handle;
+	for (std::vector<fitness_vector>::size_type i = 0; i < points.size(); ++i) {
+		m_points.insert(std::make_pair(m_next_handle++,points[i]));
+	}
+	if (!points.empty()) {
+		insert_impl(first,m_next_handle);
+	}
+	return first;
+}
+
+/// Erase a point
+/**
+ * @param[in] handle handle of the point
+ *
+ * @throws index_error if there is no point with the given handle
+ */
+void dynamic_hypervolume::erase(const size_type &handle)
+{
+	check_handle(handle);
+	erase_impl(handle);
+	m_points.erase(handle);
+}
+
+/// Check if a handle is valid
+/**
+ * @param[in] handle handle of the point
+ *
+ * @return true if the point with the given handle has been inserted and not erased
+ */
+bool dynamic_hypervolume::contains(const size_type &handle) const
+{
+	return m_points.find(handle) != m_points.end();
+}
+
+/// Number of points
+dynamic_hypervolume::size_type dynamic_hypervolume::size() const
+{
+	return static_cast<size_type>(m_points.size());
+}
+
+/// Get a point
+/**
+ * @param[in] handle handle of the point
+ *
+ * @return const reference to the point
+ *
+ * @throws index_error if there is no point with the given handle
+ */
+const fitness_vector &dynamic_hypervolume::get_point(const size_type &handle) const
+{
+	check_handle(handle);
+	return m_points.find(handle)->second;
+}
+
+/// Get the reference point
+const fitness_vector &dynamic_hypervolume::get_reference_point() const
+{
+	return m_r_point;
+}
+
+/// Hypervolume of the points
+/**
+ * @return the hypervolume, kept up to date at each insertion and erasure
+ */
+double dynamic_hypervolume::get_hypervolume() const
+{
+	return m_hv;
+}
+
+/// Throw if there is no point with the given handle.
+void dynamic_hypervolume::check_handle(const size_type &handle) const
+{
+	if (!contains(handle)) {
+		pagmo_throw(index_error,"invalid point handle");
+	}
+}
+
+/// Exclusive contribution of a point
+/**
+ * @param[in] handle handle of the point
+ *
+ * @return the hypervolume contributed by the point alone (zero for a dominated point)
+ *
+ * @throws index_error if there is no point with the given handle
+ */
+double dynamic_hypervolume::exclusive(const size_type &handle) const
+{
+	check_handle(handle);
+	return m_contributions.find(handle)->second;
+}
+
+/// Least contributor
+/**
+ * @return the handle of the point with the smallest contribution (the smallest handle among ties)
+ *
+ * @throws value_error if there are no points
+ */
+dynamic_hypervolume::size_type dynamic_hypervolume::least_contributor() const
+{
+	if (m_ranking.empty()) {
+		pagmo_throw(value_error,"Point set cannot be empty.");
+	}
+	return m_ranking.begin()->second;
+}
+
+/// Greatest contributor
+/**
+ * @return the handle of the point with the largest contribution (the smallest handle among ties)
+ *
+ * @throws value_error if there are no points
+ */
+dynamic_hypervolume::size_type dynamic_hypervolume::greatest_contributor() const
+{
+	if (m_ranking.empty()) {
+		pagmo_throw(value_error,"Point set cannot be empty.");
+	}
+	return m_ranking.lower_bound(std::make_pair(m_ranking.rbegin()->first,size_type(0)))->second;
+}
+
+/// Set the contribution of a point.
+void dynamic_hypervolume::set_contribution(const size_type &handle, double c)
+{
+	std::map<size_type,double>::iterator it = m_contributions.find(handle);
+	if (it == m_contributions.end()) {
+		m_contributions.insert(std::make_pair(handle,c));
+	} else {
+		m_ranking.erase(std::make_pair(it->second,handle));
+		it->second = c;
+	}
+	m_ranking.insert(std::make_pair(c,handle));
+}
+
+/// Forget the contribution of a point.
+void dynamic_hypervolume::erase_contribution(const size_type &handle)
+{
+	std::map<size_type,double>::iterator it = m_contributions.find(handle);
+	m_ranking.erase(std::make_pair(it->second,handle));
+	m_contributions.erase(it);
+}
+
+/// Constructor
+/**
+ * @param[in] r_point reference point
+ *
+ * @throws value_error if the reference point is not 2-dimensional
+ */
+dynamic_hv2d::dynamic_hv2d(const fitness_vector &r_point):dynamic_hypervolume(r_point)
+{
+	if (r_point.size() != 2) {
+		pagmo_throw(value_error,"dynamic_hv2d works only with 2-dimensional points");
+	}
+}
+
+/// Clone method.
+dynamic_hypervolume_ptr dynamic_hv2d::clone() const
+{
+	return dynamic_hypervolume_ptr(new dynamic_hv2d(*this));
+}
+
+// Lexicographic order on the objectives, then on the handles.
+bool dynamic_hv2d::node::operator<(const node &other) const
+{
+	if (x != other.x) {
+		return x < other.x;
+	}
+	if (y != other.y) {
+		return y < other.y;
+	}
+	return handle < other.handle;
+}
+
+dynamic_hv2d::node dynamic_hv2d::make_node(const size_type &handle) const
+{
+	const fitness_vector &p = m_points.find(handle)->second;
+	return node(p[0],p[1],handle);
+}
+
+// The contribution of a non-dominated point is the part of the rectangle between it, the next point along the first
+// objective and the previous point along the second one (or the reference point) which is not covered by the dominated
+// points. Those lie in the same slab along the first objective, where they are visited in order.
+double dynamic_hv2d::exclusive_area(const tree_type::const_iterator &it) const
+{
+	double x_to = m_r_point[0], h = m_r_point[1];
+	tree_type::const_iterator other(it);
+	if (++other != m_front.end()) {
+		x_to = other->x;
+	}
+	if (it != m_front.begin()) {
+		other = it;
+		h = (--other)->y;
+	}
+	double x_from = it->x, area = 0;
+	for (tree_type::const_iterator c = m_dominated.lower_bound(node(it->x,-std::numeric_limits<double>::infinity(),0));
+		c != m_dominated.end() && c->x < x_to; ++c)
+	{
+		if (c->y < h) {
+			area += (c->x - x_from) * (h - it->y);
+			x_from = c->x;
+			h = c->y;
+		}
+	}
+	return area + (x_to - x_from) * (h - it->y);
+}
+
+void dynamic_hv2d::update_contribution(const tree_type::const_iterator &it)
+{
+	set_contribution(it->handle,exclusive_area(it));
+}
+
+// Non-dominated point whose slab contains the given point, if any.
+dynamic_hv2d::tree_type::const_iterator dynamic_hv2d::covering_slab(const node &n) const
+{
+	tree_type::const_iterator it = m_front.upper_bound(node(n.x,std::numeric_limits<double>::infinity(),0));
+	return (it == m_front.begin()) ? m_front.end() : --it;
+}
+
+void dynamic_hv2d::insert_impl(const size_type &first, const size_type &last)
+{
+	for (size_type handle = first; handle != last; ++handle) {
+		insert_point(handle);
+	}
+}
+
+void dynamic_hv2d::insert_point(const size_type &handle)
+{
+	const node n = make_node(handle);
+	// First non-dominated point not preceding n along the first objective, and the one before it.
+	tree_type::iterator it = m_front.lower_bound(node(n.x,-std::numeric_limits<double>::infinity(),0));
+	tree_type::iterator left = m_front.end();
+	if (it != m_front.begin()) {
+		left = it;
+		--left;
+	}
+	// The point is covered by a non-dominated one: it contributes nothing, and it may reduce the contribution
+	// of the point whose slab contains it.
+	if ((it != m_front.end() && it->x == n.x && it->y <= n.y) || (left != m_front.end() && left->y <= n.y)) {
+		m_dominated.insert(n);
+		set_contribution(handle,0);
+		update_contribution(covering_slab(n));
+		return;
+	}
+	// Move the points covered by n to the dominated ones.
+	while (it != m_front.end() && it->y >= n.y) {
+		m_dominated.insert(*it);
+		set_contribution(it->handle,0);
+		m_front.erase(it++);
+	}
+	// The hypervolume grows by the contribution of n. Only the contributions of n and of its neighbours change.
+	const tree_type::iterator pos = m_front.insert(it,n);
+	update_contribution(pos);
+	m_hv += m_contributions[handle];
+	if (left != m_front.end()) {
+		update_contribution(left);
+	}
+	if (it != m_front.end()) {
+		update_contribution(it);
+	}
+}
+
+void dynamic_hv2d::erase_impl(const size_type &handle)
+{
+	const node n = make_node(handle);
+	const double c = m_contributions.find(handle)->second;
+	erase_contribution(handle);
+	if (m_dominated.erase(n)) {
+		const tree_type::const_iterator it = covering_slab(n);
+		if (it != m_front.end()) {
+			update_contribution(it);
+		}
+		return;
+	}
+	// The hypervolume shrinks by the contribution of n.
+	m_hv -= c;
+	tree_type::iterator it = m_front.find(n);
+	pagmo_assert(it != m_front.end());
+	tree_type::iterator left = m_front.end(), right(it);
+	++right;
+	if (it != m_front.begin()) {
+		left = it;
+		--left;
+	}
+	m_front.erase(it);
+	// The dominated points in the slab of n which are not covered by the left neighbour or by each other become
+	// non-dominated.
+	double h = (left == m_front.end()) ? m_r_point[1] : left->y;
+	tree_type::iterator d = m_dominated.lower_bound(node(n.x,-std::numeric_limits<double>::infinity(),0));
+	while (d != m_dominated.end() && (right == m_front.end() || d->x < right->x)) {
+		if (d->y < h) {
+			h = d->y;
+			m_front.insert(right,*d);
+			m_dominated.erase(d++);
+		} else {
+			++d;
+		}
+	}
+	// Update the contributions from the left neighbour to the right one.
+	tree_type::iterator from = (left == m_front.end()) ? m_front.begin() : left, to(right);
+	if (to != m_front.end()) {
+		++to;
+	}
+	for (; from != to; ++from) {
+		update_contribution(from);
+	}
+}
+
+namespace {
+
+typedef dynamic_hypervolume::size_type size_type;
+
+// Sweep of the box between a point and the reference point along the third objective. The sections of the other points,
+// clipped to the box, are added by increasing level: those not covered by any other section form the front, and each
+// point of the front keeps the staircase of the sections covered by it alone (its shadow). As sections are only added,
+// a section covered by two others never matters again and is forgotten.
+class box_sweep
+{
+	public:
+		box_sweep(const fitness_vector &, const fitness_vector &, std::map<size_type,double> &);
+		bool add(double, double, double, size_type);
+		double finish();
+	private:
+		// Shadow, from the first objective to the second one.
+		typedef std::map<double,double> staircase_type;
+		struct front_point
+		{
+			front_point(double y_, size_type handle_):y(y_),handle(handle_),g(0),area(0),since(0) {}
+			double		y;
+			size_type	handle;
+			staircase_type	shadow;
+			// Sum of (x_next - x) * y over the shadow, which gives its area for any upper right corner in O(1).
+			double		g;
+			// Area covered by this section alone, since the level since.
+			double		area;
+			double		since;
+		};
+		// Front, from the first objective to the point.
+		typedef std::map<double,front_point> front_type;
+		void shadow_insert(front_point &, double, double);
+		staircase_type::iterator shadow_erase(front_point &, staircase_type::iterator);
+		double alone_area(const front_type::iterator &) const;
+		void settle(const front_type::iterator &);
+		void update(const front_type::iterator &);
+		bool covered_twice() const;
+
+		const double			m_x;
+		const double			m_y;
+		const fitness_vector		&m_r_point;
+		const double			m_section;
+		std::map<size_type,double>	&m_alone;
+		front_type			m_front;
+		// Area of the union of the front, current level and volume not covered so far.
+		double				m_covered;
+		double				m_z;
+		double				m_volume;
+};
+
+box_sweep::box_sweep(const fitness_vector &p, const fitness_vector &r_point, std::map<size_type,double> &alone):
+	m_x(p[0]),m_y(p[1]),m_r_point(r_point),m_section((r_point[0] - p[0]) * (r_point[1] - p[1])),m_alone(alone),
+	m_covered(0),m_z(p[2]),m_volume(0) {}
+
+void box_sweep::shadow_insert(front_point &s, double x, double y)
+{
+	const staircase_type::iterator it = s.shadow.insert(std::make_pair(x,y)).first;
+	staircase_type::iterator left(it), right(it);
+	++right;
+	if (it != s.shadow.begin()) {
+		--left;
+		if (right != s.shadow.end()) {
+			s.g -= (right->first - left->first) * left->second;
+		}
+		s.g += (x - left->first) * left->second;
+	}
+	if (right != s.shadow.end()) {
+		s.g += (right->first - x) * y;
+	}
+}
+
+box_sweep::staircase_type::iterator box_sweep::shadow_erase(front_point &s, staircase_type::iterator it)
+{
+	staircase_type::iterator left(it), right(it);
+	++right;
+	if (it != s.shadow.begin()) {
+		--left;
+		s.g -= (it->first - left->first) * left->second;
+		if (right != s.shadow.end()) {
+			s.g += (right->first - left->first) * left->second;
+		}
+	}
+	if (right != s.shadow.end()) {
+		s.g -= (right->first - it->first) * it->second;
+	}
+	s.shadow.erase(it);
+	if (s.shadow.empty()) {
+		s.g = 0;
+	}
+	return right;
+}
+
+// The section of a front point covers alone the rectangle up to the next point along the first objective and up to the
+// previous one along the second, minus its shadow.
+double box_sweep::alone_area(const front_type::iterator &it) const
+{
+	front_type::iterator other(it);
+	const double x_to = (++other == m_front.end()) ? m_r_point[0] : other->first;
+	double h = m_r_point[1];
+	if (it != m_front.begin()) {
+		other = it;
+		h = (--other)->second.y;
+	}
+	const front_point &s = it->second;
+	double area = (x_to - it->first) * (h - s.y);
+	if (!s.shadow.empty()) {
+		staircase_type::const_iterator last = s.shadow.end();
+		--last;
+		area -= h * (x_to - s.shadow.begin()->first) - s.g - (x_to - last->first) * last->second;
+	}
+	return area;
+}
+
+// Account for the area covered alone by a front point up to the current level.
+void box_sweep::settle(const front_type::iterator &it)
+{
+	front_point &s = it->second;
+	m_alone[s.handle] += s.area * (m_z - s.since);
+	s.since = m_z;
+}
+
+void box_sweep::update(const front_type::iterator &it)
+{
+	it->second.area = alone_area(it);
+}
+
+// True if the whole section is covered by two points: nothing can change anymore.
+bool box_sweep::covered_twice() const
+{
+	if (m_front.size() != 1 || m_front.begin()->first != m_x || m_front.begin()->second.y != m_y) {
+		return false;
+	}
+	const staircase_type &shadow = m_front.begin()->second.shadow;
+	return !shadow.empty() && shadow.begin()->first == m_x && shadow.begin()->second == m_y;
+}
+
+// Add the clipped section (x,y) of a point at level z (not decreasing from call to call). Returns false once the section
+// of the box is covered twice.
+bool box_sweep::add(double x, double y, double z, size_type handle)
+{
+	if (x >= m_r_point[0] || y >= m_r_point[1]) {
+		return true;
+	}
+	m_volume += (m_section - m_covered) * (z - m_z);
+	m_z = z;
+	// Last front point not following the section along the first objective.
+	front_type::iterator s = m_front.upper_bound(x);
+	if (s != m_front.begin() && (--s)->second.y <= y) {
+		// The section is covered by s: it joins the shadow of s, unless it is covered by another point too.
+		front_type::iterator left(s);
+		if (s != m_front.begin() && (--left)->second.y <= y) {
+			return true;
+		}
+		front_point &f = s->second;
+		staircase_type::iterator b = f.shadow.upper_bound(x);
+		if (b != f.shadow.begin() && (--b)->second <= y) {
+			return true;
+		}
+		settle(s);
+		// The shadow points covered by the section are now covered twice.
+		b = f.shadow.lower_bound(x);
+		while (b != f.shadow.end() && b->second >= y) {
+			b = shadow_erase(f,b);
+		}
+		shadow_insert(f,x,y);
+		update(s);
+		return !covered_twice();
+	}
+	// The section joins the front, and the front points it covers become its shadow, while their own shadows are now
+	// covered twice.
+	std::vector<std::pair<double,double> > shadow;
+	front_type::iterator right = m_front.lower_bound(x);
+	while (right != m_front.end() && right->second.y >= y) {
+		settle(right);
+		shadow.push_back(std::make_pair(right->first,right->second.y));
+		m_front.erase(right++);
+	}
+	// The shadow of the right neighbour above the section, and that of the left neighbour beyond it, are covered twice
+	// too.
+	if (right != m_front.end()) {
+		settle(right);
+		front_point &f = right->second;
+		while (!f.shadow.empty() && f.shadow.begin()->second >= y) {
+			shadow_erase(f,f.shadow.begin());
+		}
+	}
+	front_type::iterator left(right);
+	const bool has_left = (left != m_front.begin());
+	if (has_left) {
+		settle(--left);
+		front_point &f = left->second;
+		staircase_type::iterator b = f.shadow.lower_bound(x);
+		while (b != f.shadow.end()) {
+			b = shadow_erase(f,b);
+		}
+	}
+	const front_type::iterator it = m_front.insert(right,std::make_pair(x,front_point(y,handle)));
+	it->second.since = m_z;
+	for (std::vector<std::pair<double,double> >::size_type i = 0; i < shadow.size(); ++i) {
+		shadow_insert(it->second,shadow[i].first,shadow[i].second);
+	}
+	update(it);
+	m_covered += it->second.area;
+	if (has_left) {
+		update(left);
+	}
+	if (right != m_front.end()) {
+		update(right);
+	}
+	return !covered_twice();
+}
+
+// Complete the sweep up to the reference point, returning the volume of the box covered by no point.
+double box_sweep::finish()
+{
+	if (!covered_twice()) {
+		m_volume += (m_section - m_covered) * (m_r_point[2] - m_z);
+		m_z = m_r_point[2];
+	}
+	for (front_type::iterator it = m_front.begin(); it != m_front.end(); ++it) {
+		settle(it);
+	}
+	return m_volume;
+}
+
+// True if no two points share a coordinate.
+bool distinct_coordinates(const std::vector<fitness_vector> &points)
+{
+	std::vector<double> v(points.size());
+	for (fitness_vector::size_type j = 0; j < 3; ++j) {
+		for (std::vector<fitness_vector>::size_type i = 0; i < points.size(); ++i) {
+			v[i] = points[i][j];
+		}
+		std::sort(v.begin(),v.end());
+		if (std::adjacent_find(v.begin(),v.end()) != v.end()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+/// Constructor
+/**
+ * @param[in] r_point reference point
+ *
+ * @throws value_error if the reference point is not 3-dimensional
+ */
+dynamic_hv3d::dynamic_hv3d(const fitness_vector &r_point):dynamic_hypervolume(r_point)
+{
+	if (r_point.size() != 3) {
+		pagmo_throw(value_error,"dynamic_hv3d works only with 3-dimensional points");
+	}
+}
+
+/// Clone method.
+dynamic_hypervolume_ptr dynamic_hv3d::clone() const
+{
+	return dynamic_hypervolume_ptr(new dynamic_hv3d(*this));
+}
+
+// Order along the third objective, then on the other objectives and on the handles.
+bool dynamic_hv3d::node::operator<(const node &other) const
+{
+	if (z != other.z) {
+		return z < other.z;
+	}
+	if (x != other.x) {
+		return x < other.x;
+	}
+	if (y != other.y) {
+		return y < other.y;
+	}
+	return handle < other.handle;
+}
+
+dynamic_hv3d::node dynamic_hv3d::make_node(const size_type &handle) const
+{
+	const fitness_vector &p = m_points.find(handle)->second;
+	return node(p[0],p[1],p[2],handle);
+}
+
+// Sweep the box between the point n and the reference point: returns the volume of the box covered by no other point,
+// and adds to alone the volume of the box covered by each other point alone.
+double dynamic_hv3d::sweep(const node &n, std::map<size_type,double> &alone) const
+{
+	if (n.x >= m_r_point[0] || n.y >= m_r_point[1] || n.z >= m_r_point[2]) {
+		return 0;
+	}
+	fitness_vector p(3);
+	p[0] = n.x;
+	p[1] = n.y;
+	p[2] = n.z;
+	box_sweep s(p,m_r_point,alone);
+	for (std::set<node>::const_iterator it = m_sorted.begin(); it != m_sorted.end() && it->z < m_r_point[2]; ++it) {
+		if (it->handle != n.handle && !s.add(std::max(n.x,it->x),std::max(n.y,it->y),std::max(n.z,it->z),it->handle)) {
+			break;
+		}
+	}
+	return s.finish();
+}
+
+// The box of an inserted point covers the part of the contribution of each other point it sweeps alone. When several
+// points are inserted at once, everything is computed again from scratch instead.
+void dynamic_hv3d::insert_impl(const size_type &first, const size_type &last)
+{
+	for (size_type handle = first; handle != last; ++handle) {
+		m_sorted.insert(make_node(handle));
+	}
+	if (last - first > 1) {
+		// The points on the boundary of the reference box contribute nothing, and hv3d does not handle them.
+		std::vector<fitness_vector> points;
+		std::vector<size_type> handles;
+		m_hv = 0;
+		for (std::map<size_type,fitness_vector>::const_iterator it = m_points.begin(); it != m_points.end(); ++it) {
+			set_contribution(it->first,0);
+			if (it->second[0] < m_r_point[0] && it->second[1] < m_r_point[1] && it->second[2] < m_r_point[2]) {
+				points.push_back(it->second);
+				handles.push_back(it->first);
+			}
+		}
+		if (points.size() == 1) {
+			m_hv = hv_algorithm::base::volume_between(points[0],m_r_point);
+			set_contribution(handles[0],m_hv);
+		} else if (points.size() > 1) {
+			// NOTE: the computation of the hypervolume sorts the points.
+			std::vector<fitness_vector> sorted(points);
+			m_hv = hv_algorithm::hv3d().compute(sorted,m_r_point);
+			// HyCon3D is exact only if no two points share a coordinate, otherwise the points are swept one at a time.
+			if (distinct_coordinates(points)) {
+				const std::vector<double> c = hv_algorithm::hv3d().contributions(points,m_r_point);
+				for (std::vector<size_type>::size_type i = 0; i < handles.size(); ++i) {
+					set_contribution(handles[i],c[i]);
+				}
+			} else {
+				for (std::vector<size_type>::size_type i = 0; i < handles.size(); ++i) {
+					std::map<size_type,double> alone;
+					set_contribution(handles[i],sweep(make_node(handles[i]),alone));
+				}
+			}
+		}
+		return;
+	}
+	std::map<size_type,double> alone;
+	const double c = sweep(make_node(first),alone);
+	m_hv += c;
+	for (std::map<size_type,double>::const_iterator it = alone.begin(); it != alone.end(); ++it) {
+		set_contribution(it->first,std::max(0.,m_contributions.find(it->first)->second - it->second));
+	}
+	set_contribution(first,c);
+}
+
+// Symmetrically, the part of the box of the erased point swept by one other point alone is added to its contribution.
+void dynamic_hv3d::erase_impl(const size_type &handle)
+{
+	const node n = make_node(handle);
+	std::map<size_type,double> alone;
+	m_hv -= sweep(n,alone);
+	erase_contribution(handle);
+	m_sorted.erase(n);
+	for (std::map<size_type,double>::const_iterator it = alone.begin(); it != alone.end(); ++it) {
+		set_contribution(it->first,m_contributions.find(it->first)->second + it->second);
+	}
+	if (m_sorted.empty()) {
+		// Avoid leaving round-off errors in an empty set.
+		m_hv = 0;
+	}
+}
+
+}}
@@ -0,0 +1,183 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_DYNAMIC_HYPERVOLUME_H
+#define PAGMO_UTIL_DYNAMIC_HYPERVOLUME_H
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "../config.h"
+#include "../types.h"
+
+namespace pagmo { namespace util {
+
+class dynamic_hypervolume;
+
+/// Alias for the shared pointer to a pagmo::util::dynamic_hypervolume.
+typedef boost::shared_ptr<dynamic_hypervolume> dynamic_hypervolume_ptr;
+
+/// Dynamic hypervolume base class.
+/**
+ * Keeps the hypervolume of a set of points, and the exclusive contribution of each point, up to date while points are
+ * inserted and erased one at a time, as in steady-state selection (e.g., in algorithm::sms_emoa) or when migrants
+ * replace the members of a front. Points are minimised and must not exceed the reference point, which is fixed at
+ * construction. Each point is addressed by the handle returned by insert(), which stays valid until the point is erased.
+ *
+ * Dominated and duplicate points can be inserted: they contribute nothing until the points covering them are erased.
+ *
+ * The derived classes keep the hypervolume and the contributions up to date in insert_impl() and erase_impl().
+ *
+ * Use hypervolume::get_dynamic() to build the structure fitting the dimension of a point set.
+ */
+class __PAGMO_VISIBLE dynamic_hypervolume
+{
+public:
+	/// Handle of a point.
+	typedef unsigned int size_type;
+	dynamic_hypervolume(const fitness_vector &);
+	virtual ~dynamic_hypervolume();
+	/// Clone method.
+	virtual dynamic_hypervolume_ptr clone() const = 0;
+
+	size_type insert(const fitness_vector &);
+	size_type insert(const std::vector<fitness_vector> &);
+	void erase(const size_type &);
+	bool contains(const size_type &) const;
+	size_type size() const;
+	const fitness_vector &get_point(const size_type &) const;
+	const fitness_vector &get_reference_point() const;
+
+	double get_hypervolume() const;
+	double exclusive(const size_type &) const;
+	size_type least_contributor() const;
+	size_type greatest_contributor() const;
+
+protected:
+	/// Update the structure after the insertion of the points with the handles in [first, last).
+	virtual void insert_impl(const size_type &first, const size_type &last) = 0;
+	/// Update the structure before the point with the given handle is erased.
+	virtual void erase_impl(const size_type &) = 0;
+	void check_handle(const size_type &) const;
+	void set_contribution(const size_type &, double);
+	void erase_contribution(const size_type &);
+
+	/// Reference point.
+	const fitness_vector			m_r_point;
+	/// Points, by handle.
+	std::map<size_type,fitness_vector>	m_points;
+	/// Current hypervolume.
+	double					m_hv;
+	/// Current contributions, by handle.
+	std::map<size_type,double>		m_contributions;
+	/// Contributions and handles, by increasing contribution.
+	std::set<std::pair<double,size_type> >	m_ranking;
+private:
+	size_type				m_next_handle;
+};
+
+/// Dynamic hypervolume in 2 dimensions
+/**
+ * The non-dominated points are kept in a balanced binary search tree ordered along the first objective, so that the
+ * contribution of each of them only depends on its two neighbours (and on the dominated points lying between it and the
+ * next one, which it alone covers). Inserting or erasing a point takes O(log n) time, plus O(log n) for each point that
+ * becomes dominated or non-dominated, plus a scan of the dominated points lying in the slabs of the non-dominated points
+ * whose contribution is updated: for a set of mutually non-dominated points all updates are logarithmic, while many
+ * dominated points in the same slab make them linear. The total hypervolume and all the contributions are kept up to
+ * date, and the extreme contributors are found in O(log n).
+ */
+class __PAGMO_VISIBLE dynamic_hv2d: public dynamic_hypervolume
+{
+public:
+	dynamic_hv2d(const fitness_vector &);
+	dynamic_hypervolume_ptr clone() const;
+protected:
+	void insert_impl(const size_type &, const size_type &);
+	void erase_impl(const size_type &);
+private:
+	struct node
+	{
+		node(double x_, double y_, size_type handle_):x(x_),y(y_),handle(handle_) {}
+		bool operator<(const node &other) const;
+		double		x;
+		double		y;
+		size_type	handle;
+	};
+	typedef std::set<node> tree_type;
+	node make_node(const size_type &) const;
+	void insert_point(const size_type &);
+	double exclusive_area(const tree_type::const_iterator &) const;
+	tree_type::const_iterator covering_slab(const node &) const;
+	void update_contribution(const tree_type::const_iterator &);
+
+	// Non-dominated points, by increasing first (and decreasing second) objective.
+	tree_type				m_front;
+	// Dominated points, in the same order.
+	tree_type				m_dominated;
+};
+
+/// Dynamic hypervolume in 3 dimensions
+/**
+ * No exact 3-dimensional structure with logarithmic updates is known. Here the points are kept sorted along the third
+ * objective, and inserting or erasing a point p is a single sweep, along that objective, of the box between p and the
+ * reference point. The sections of the other points clipped to the box form a 2-dimensional front, each point of which
+ * keeps the staircase of the sections covered by it alone: the sweep yields both the volume of the box covered by no
+ * other point (the exclusive contribution of p) and the volume covered by each other point alone (the change of its
+ * contribution), so that the total hypervolume and all the contributions are updated together, without computing
+ * anything again from scratch. The sweep stops as soon as the section is covered twice, and takes O(k log k) time
+ * for the k points it visits (at most n). When several points are inserted at once, the hypervolume and the
+ * contributions are computed from scratch instead (see hv_algorithm::hv3d). The extreme contributors are found in
+ * O(log n).
+ */
+class __PAGMO_VISIBLE dynamic_hv3d: public dynamic_hypervolume
+{
+public:
+	dynamic_hv3d(const fitness_vector &);
+	dynamic_hypervolume_ptr clone() const;
+protected:
+	void insert_impl(const size_type &, const size_type &);
+	void erase_impl(const size_type &);
+private:
+	struct node
+	{
+		node(double x_, double y_, double z_, size_type handle_):x(x_),y(y_),z(z_),handle(handle_) {}
+		bool operator<(const node &other) const;
+		double		x;
+		double		y;
+		double		z;
+		size_type	handle;
+	};
+	node make_node(const size_type &) const;
+	double sweep(const node &, std::map<size_type,double> &) const;
+
+	// Points, by increasing third objective.
+	std::set<node>				m_sorted;
+};
+
+}}
+
+#endif
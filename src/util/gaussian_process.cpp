@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../exceptions.h"
+#include "gaussian_process.h"
+
+namespace pagmo{ namespace util {
+
+/// Constructor
+/**
+ * @param[in] dim dimension of the inputs
+ * @param[in] n_outputs number of outputs
+ * @param[in] max_size maximum number of samples kept in the model
+ * @param[in] length_scale length scale of the kernel, relative to the square root of the dimension (i.e., to the
+ * diagonal of the unit hypercube)
+ * @param[in] nugget value added to the diagonal of the kernel matrix
+ *
+ * @throws value_error if dim, n_outputs or max_size are zero, or length_scale and nugget are not positive
+ */
+gaussian_process::gaussian_process(unsigned int dim, unsigned int n_outputs, unsigned int max_size, double length_scale, double nugget):
+	m_dim(dim),m_n_outputs(n_outputs),m_max_size(max_size),m_length_scale(length_scale),m_nugget(nugget),
+	m_X(dim,0),m_Y(0,n_outputs),m_L(0,0),m_dirty(true)
+{
+	if (dim == 0 || n_outputs == 0 || max_size == 0) {
+		pagmo_throw(value_error,"the dimension, the number of outputs and the maximum size must be strictly positive");
+	}
+	if (!(length_scale > 0) || !(nugget > 0)) {
+		pagmo_throw(value_error,"the length scale and the nugget must be strictly positive");
+	}
+}
+
+// Squared exponential kernel.
+double gaussian_process::kernel(const Eigen::VectorXd &x1, const Eigen::VectorXd &x2) const
+{
+	const double l = m_length_scale * std::sqrt(static_cast<double>(m_dim));
+	return std::exp(-(x1 - x2).squaredNorm() / (2 * l * l));
+}
+
+/// Adds a sample to the model
+/**
+ * The Cholesky factor is extended by one row. If the model is full, the oldest sample is removed once the new one has
+ * been accepted.
+ *
+ * @param[in] x input of the sample
+ * @param[in] y outputs of the sample
+ *
+ * @return false if the sample was discarded because too close to the ones in the model
+ * @throws value_error if the sizes of x and y are not consistent with the model
+ */
+bool gaussian_process::add(const std::vector<double> &x, const std::vector<double> &y)
+{
+	if (x.size() != m_dim || y.size() != m_n_outputs) {
+		pagmo_throw(value_error,"the sample is not consistent with the dimensions of the model");
+	}
+	const Eigen::VectorXd xe = Eigen::Map<const Eigen::VectorXd>(&x[0],m_dim);
+	Eigen::VectorXd l;
+	double d2 = new_row(xe,l);
+	if (!(d2 > 4 * m_nugget)) {
+		return false;
+	}
+	if (m_X.cols() == static_cast<int>(m_max_size)) {
+		// Removing a sample can only increase d2, so the new one is still accepted.
+		remove_oldest();
+		d2 = new_row(xe,l);
+	}
+	const int n = m_X.cols();
+	m_X.conservativeResize(Eigen::NoChange,n + 1);
+	m_X.col(n) = xe;
+	m_Y.conservativeResize(n + 1,Eigen::NoChange);
+	m_Y.row(n) = Eigen::Map<const Eigen::VectorXd>(&y[0],m_n_outputs).transpose();
+	m_L.conservativeResize(n + 1,n + 1);
+	m_L.row(n).head(n) = l.transpose();
+	m_L.col(n).setZero();
+	m_L(n,n) = std::sqrt(d2);
+	m_dirty = true;
+	return true;
+}
+
+// New row of the factor for the input x: l = L^-1 k, returning d^2 = k(x,x) + nugget - l.l.
+double gaussian_process::new_row(const Eigen::VectorXd &x, Eigen::VectorXd &l) const
+{
+	const int n = m_X.cols();
+	l.resize(n);
+	for (int i = 0; i < n; ++i) {
+		l(i) = kernel(m_X.col(i),x);
+	}
+	if (n > 0) {
+		m_L.triangularView<Eigen::Lower>().solveInPlace(l);
+	}
+	return 1 + m_nugget - l.squaredNorm();
+}
+
+// Removes the oldest sample: if L = [l11 0; l21 L22], the factor of the remaining kernel matrix is the rank-one update
+// of L22 by l21.
+void gaussian_process::remove_oldest()
+{
+	const int n = m_X.cols() - 1;
+	Eigen::VectorXd v = m_L.col(0).tail(n);
+	Eigen::MatrixXd L = m_L.bottomRightCorner(n,n);
+	for (int k = 0; k < n; ++k) {
+		const double r = std::sqrt(L(k,k) * L(k,k) + v(k) * v(k)), c = r / L(k,k), s = v(k) / L(k,k);
+		L(k,k) = r;
+		for (int i = k + 1; i < n; ++i) {
+			L(i,k) = (L(i,k) + s * v(i)) / c;
+			v(i) = c * v(i) - s * L(i,k);
+		}
+	}
+	m_L.swap(L);
+	m_X = m_X.rightCols(n).eval();
+	m_Y = m_Y.bottomRows(n).eval();
+	m_dirty = true;
+}
+
+// Prior means, standard deviations and weights alpha = K^-1 (Y - mean), by two triangular solves.
+void gaussian_process::update_weights() const
+{
+	const int n = m_X.cols();
+	m_mean = Eigen::VectorXd::Zero(m_n_outputs);
+	m_sigma = Eigen::VectorXd::Ones(m_n_outputs);
+	if (n > 0) {
+		m_mean = m_Y.colwise().mean().transpose();
+	}
+	if (n > 1) {
+		for (unsigned int j = 0; j < m_n_outputs; ++j) {
+			const double var = (m_Y.col(j).array() - m_mean(j)).square().sum() / (n - 1);
+			m_sigma(j) = var > 0 ? std::sqrt(var) : 1.;
+		}
+	}
+	m_alpha = m_Y.rowwise() - m_mean.transpose();
+	if (n > 0) {
+		m_L.triangularView<Eigen::Lower>().solveInPlace(m_alpha);
+		m_L.triangularView<Eigen::Lower>().transpose().solveInPlace(m_alpha);
+	}
+	m_dirty = false;
+}
+
+/// Prediction
+/**
+ * With no samples in the model, the prediction is zero with unit standard deviation.
+ *
+ * @param[out] mean predicted outputs
+ * @param[out] stddev standard deviation of the predicted outputs
+ * @param[in] x input
+ *
+ * @throws value_error if the size of x is not the dimension of the model
+ */
+void gaussian_process::predict(std::vector<double> &mean, std::vector<double> &stddev, const std::vector<double> &x) const
+{
+	if (x.size() != m_dim) {
+		pagmo_throw(value_error,"the input is not consistent with the dimension of the model");
+	}
+	if (m_dirty) {
+		update_weights();
+	}
+	const Eigen::VectorXd xe = Eigen::Map<const Eigen::VectorXd>(&x[0],m_dim);
+	const int n = m_X.cols();
+	Eigen::VectorXd k(n);
+	for (int i = 0; i < n; ++i) {
+		k(i) = kernel(m_X.col(i),xe);
+	}
+	const Eigen::VectorXd mu = m_mean + m_alpha.transpose() * k;
+	if (n > 0) {
+		m_L.triangularView<Eigen::Lower>().solveInPlace(k);
+	}
+	const double s = std::sqrt(std::max(0.,1 + m_nugget - k.squaredNorm()));
+	mean.resize(m_n_outputs);
+	stddev.resize(m_n_outputs);
+	for (unsigned int j = 0; j < m_n_outputs; ++j) {
+		mean[j] = mu(j);
+		stddev[j] = s * m_sigma(j);
+	}
+}
+
+/// Removes all the samples
+void gaussian_process::clear()
+{
+	m_X.resize(m_dim,0);
+	m_Y.resize(0,m_n_outputs);
+	m_L.resize(0,0);
+	m_dirty = true;
+}
+
+/// Number of samples in the model
+unsigned int gaussian_process::size() const
+{
+	return m_X.cols();
+}
+
+/// Maximum number of samples kept in the model
+unsigned int gaussian_process::get_max_size() const
+{
+	return m_max_size;
+}
+
+/// Length scale of the kernel
+double gaussian_process::get_length_scale() const
+{
+	return m_length_scale;
+}
+
+}}
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_GAUSSIAN_PROCESS_H
+#define PAGMO_UTIL_GAUSSIAN_PROCESS_H
+
+#include <vector>
+
+#include "../Eigen/Dense"
+#include "../config.h"
+#include "../serialization.h"
+
+namespace pagmo{ namespace util {
+
+/// Gaussian process regression model
+/**
+ * Regression of one or more outputs over the same inputs, with a squared exponential kernel (i.e., a gaussian radial
+ * basis function network whose weights are fitted by interpolation), a small nugget added to the diagonal and, for
+ * each output, a constant prior mean equal to the average of the training outputs. The prediction comes with its
+ * standard deviation, scaled by the standard deviation of the training outputs.
+ *
+ * The model is trained online: the Cholesky factor of the kernel matrix is extended by one row at each new sample, and
+ * when the maximum number of samples is reached the oldest one is removed by a rank-one update of the factor, so that
+ * adding a sample costs O(n^2) operations instead of the O(n^3) of a full refit. Samples that are numerically
+ * indistinguishable from the ones already in the model are discarded.
+ *
+ * NOTE: the weights of the model are recomputed lazily by predict(), hence the model is not thread-safe, not even for
+ * concurrent predictions: callers sharing a model among threads must serialise the accesses (as
+ * pagmo::problem::surrogate does).
+ */
+class __PAGMO_VISIBLE gaussian_process {
+public:
+	gaussian_process(unsigned int = 1, unsigned int = 1, unsigned int = 500, double = 0.2, double = 1e-6);
+	bool add(const std::vector<double> &, const std::vector<double> &);
+	void predict(std::vector<double> &, std::vector<double> &, const std::vector<double> &) const;
+	void clear();
+	unsigned int size() const;
+	unsigned int get_max_size() const;
+	double get_length_scale() const;
+private:
+	double kernel(const Eigen::VectorXd &, const Eigen::VectorXd &) const;
+	double new_row(const Eigen::VectorXd &, Eigen::VectorXd &) const;
+	void remove_oldest();
+	void update_weights() const;
+	friend class boost::serialization::access;
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & m_dim;
+		ar & m_n_outputs;
+		ar & m_max_size;
+		ar & m_length_scale;
+		ar & m_nugget;
+		ar & m_X;
+		ar & m_Y;
+		ar & m_L;
+		m_dirty = true;
+	}
+	unsigned int		m_dim;
+	unsigned int		m_n_outputs;
+	unsigned int		m_max_size;
+	double			m_length_scale;
+	double			m_nugget;
+	// Inputs (one per column, oldest first), outputs (one per row) and lower Cholesky factor of the kernel matrix.
+	Eigen::MatrixXd		m_X;
+	Eigen::MatrixXd		m_Y;
+	Eigen::MatrixXd		m_L;
+	// Prior means, standard deviations and weights of the outputs, recomputed lazily after the samples change.
+	mutable Eigen::VectorXd	m_mean;
+	mutable Eigen::VectorXd	m_sigma;
+	mutable Eigen::MatrixXd	m_alpha;
+	mutable bool		m_dirty;
+};
+
+}}
+
+#endif
@@ -24,9 +24,45 @@
 
 
 #include "bf_approx.h"
+#include "../parallel.h"
+#include <numeric>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+namespace {
+
+// Draws the samples [first, first + n) of a box, in chunks of at most block_size samples, and counts those which are
+// not dominated by any of the points of the sampler, as well as the dominance tests done. The chunk starting at sample i
+// is drawn from the stream i of rng.
+class box_task
+{
+	public:
+		box_task(const fitness_vector &lb, const fitness_vector &ub, const mc_sampler &sampler, const rng_philox &rng,
+			const unsigned long long first, const unsigned long long n, std::vector<unsigned long long> &n_succ, std::vector<unsigned long long> &n_tests):
+			m_lb(lb),m_ub(ub),m_sampler(sampler),m_rng(rng),m_first(first),m_n(n),m_n_succ(n_succ),m_n_tests(n_tests) {}
+		void operator()(const std::size_t &c, const unsigned int &) const
+		{
+			const unsigned long long begin = m_first + c * mc_sampler::block_size;
+			const unsigned int n_samples = static_cast<unsigned int>(std::min<unsigned long long>(mc_sampler::block_size, m_first + m_n - begin));
+			rng_philox rng(m_rng.split(static_cast<boost::uint32_t>(begin)));
+
+			std::vector<double> samples(mc_sampler::block_size * m_lb.size());
+			mc_sampler::sample_box(rng, m_lb, m_ub, n_samples, &samples[0]);
+			m_n_succ[c] = m_sampler.count_non_dominated(&samples[0], n_samples, m_n_tests[c]);
+		}
+	private:
+		const fitness_vector			&m_lb;
+		const fitness_vector			&m_ub;
+		const mc_sampler			&m_sampler;
+		const rng_philox			m_rng;
+		const unsigned long long		m_first;
+		const unsigned long long		m_n;
+		std::vector<unsigned long long>		&m_n_succ;
+		std::vector<unsigned long long>		&m_n_tests;
+};
+
+}
+
 /// Constructor
 /**
  * Constructs an instance of the algorithm
@@ -41,7 +77,7 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * @param[in] alpha coefficicient stating how accurately current lowest contributor should be sampled
  */
 bf_approx::bf_approx(const bool use_exact, const unsigned int trivial_subcase_size, const double eps, const double delta, const double delta_multiplier, const double alpha, const double initial_delta_coeff, const double gamma)
-	: m_use_exact(use_exact), m_trivial_subcase_size(trivial_subcase_size), m_eps(eps), m_delta(delta), m_delta_multiplier(delta_multiplier), m_alpha(alpha), m_initial_delta_coeff(initial_delta_coeff), m_gamma(gamma) { }
+	: m_use_exact(use_exact), m_trivial_subcase_size(trivial_subcase_size), m_eps(eps), m_delta(delta), m_delta_multiplier(delta_multiplier), m_alpha(alpha), m_initial_delta_coeff(initial_delta_coeff), m_gamma(gamma), m_n_threads(1) { }
 
 double bf_approx::lc_end_condition(unsigned int idx, unsigned int LC, std::vector<double> &approx_volume, std::vector<double> &point_delta)
 {
@@ -122,6 +158,8 @@ unsigned int bf_approx::approx_extreme_contributor(std::vector<fitness_vector> &
 	m_point_delta = std::vector<double>(points.size(), 0.0);
 	m_boxes = std::vector<fitness_vector>(points.size());
 	m_box_points = std::vector<std::vector<unsigned int> >(points.size());
+	m_samplers = std::vector<boost::shared_ptr<mc_sampler> >(points.size());
+	m_seed = static_cast<boost::uint32_t>(m_drng() * 4294967296.);
 
 	// precomputed log factor for the point delta computation
 	const double log_factor = log (2. * points.size() * (1. + m_gamma) / (m_delta * m_gamma) );
@@ -275,49 +313,37 @@ void bf_approx::sampling_round(const std::vector<fitness_vector> &points, const
 	double tmp = m_box_volume[idx] / delta;
 	double required_no_samples = 0.5 * ( (1. + m_gamma) * log( round ) + log_factor ) * tmp * tmp;
 
-	while(m_no_samples[idx] < required_no_samples) {
-		++m_no_samples[idx];
-		if (sample_successful(points, idx)) {
-			++m_no_succ_samples[idx];
-		}
+	if (m_no_samples[idx] < required_no_samples) {
+		const unsigned long long n_new = static_cast<unsigned long long>(std::ceil(required_no_samples)) - m_no_samples[idx];
+		m_no_succ_samples[idx] += count_successful(points, idx, n_new);
+		m_no_samples[idx] += n_new;
 	}
 
 	m_approx_volume[idx] = static_cast<double>(m_no_succ_samples[idx]) / static_cast<double>(m_no_samples[idx]) * m_box_volume[idx];
 	m_point_delta[idx] = compute_point_delta(round, idx, log_factor) * m_box_volume[idx];
 }
 
-/// samples the bounding box and returns true if it fell into the exclusive hypervolume
-bool bf_approx::sample_successful(const std::vector<fitness_vector> &points, const unsigned int idx) const
+/// samples the bounding box 'n' more times and returns the number of samples that fell into the exclusive hypervolume
+/**
+ * The samples are drawn in blocks, from streams identified by the index of the point and the number of the first sample
+ * of the block, and each block is tested at once against the points overlapping the box (see pagmo::util::hv_algorithm::mc_sampler).
+ * The blocks are processed by up to m_n_threads threads, the result not depending on the number of threads.
+ */
+unsigned long long bf_approx::count_successful(const std::vector<fitness_vector> &points, const unsigned int idx, const unsigned long long n) const
 {
-	const fitness_vector &lb = points[idx];
-	const fitness_vector &ub = m_boxes[idx];
-	fitness_vector rnd_p(lb.size(), 0.0);
-	for(unsigned int i = 0 ; i < lb.size() ; ++ i) {
-		rnd_p[i] = lb[i] + m_drng()*(ub[i]-lb[i]);
+	if (!m_samplers[idx]) {
+		m_samplers[idx].reset(new mc_sampler(points, m_box_points[idx]));
 	}
 
-	for(unsigned int i = 0 ; i < m_box_points[idx].size() ; ++i) {
-
-		// box_p is a point overlapping the bounding box volume
-		const fitness_vector &box_p = points[m_box_points[idx][i]];
+	const std::size_t n_chunks = static_cast<std::size_t>((n + mc_sampler::block_size - 1) / mc_sampler::block_size);
+	std::vector<unsigned long long> n_succ(n_chunks, 0), n_tests(n_chunks, 0);
+	const box_task task(points[idx], m_boxes[idx], *m_samplers[idx], rng_philox(m_seed, idx), m_no_samples[idx], n, n_succ, n_tests);
+	parallel::for_each_index(n_chunks, m_n_threads, task);
 
-		// assume that box_p DOMINATES the random point and try to prove it otherwise below
-		bool dominates = true;
+	// each dominance test costs the dimension size (plus one)
+	m_no_ops[idx] += std::accumulate(n_tests.begin(), n_tests.end(), 0ULL) * (points[idx].size() + 1);
 
-		// increase the number of operations by the dimension size
-		m_no_ops[idx] += box_p.size() + 1;
-		for(unsigned int d_idx = 0 ; d_idx < box_p.size() ; ++d_idx) {
-			if(rnd_p[d_idx] < box_p[d_idx]) { // box_p does not dominate rnd_p
-				dominates=false;
-				break;
-			}
-		}
-		// if the box_p dominated the rnd_p return the sample as false
-		if (dominates) {
-			return false;
-		}
-	}
-	return true;
+	return std::accumulate(n_succ.begin(), n_succ.end(), 0ULL);
 }
 
 /// Compute delta for given point
@@ -440,6 +466,30 @@ std::string bf_approx::get_name() const
 	return "Bringmann-Friedrich approximation method";
 }
 
+/// Sets the number of threads
+/**
+ * If larger than one, the blocks of samples of each box are drawn and tested concurrently. The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void bf_approx::set_n_threads(const unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error, "the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the number of threads
+/**
+ * @return the maximum number of threads
+ */
+unsigned int bf_approx::get_n_threads() const
+{
+	return m_n_threads;
+}
+
 } } }
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hv_algorithm::bf_approx);
@@ -30,9 +30,12 @@
 #include <cmath>
 #include <algorithm>
 #include <iterator>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
 #include "../../rng.h"
 
 #include "base.h"
+#include "mc_sampler.h"
 
 #include "../hypervolume.h"
 
@@ -57,13 +60,15 @@ public:
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
 	std::string get_name() const;
+	void set_n_threads(const unsigned int);
+	unsigned int get_n_threads() const;
 
 private:
 	inline double compute_point_delta(const unsigned int, const unsigned int, const double) const;
 	inline fitness_vector compute_bounding_box(const std::vector<fitness_vector> &, const fitness_vector &, const unsigned int) const;
 	inline int point_in_box(const fitness_vector &p, const fitness_vector &a, const fitness_vector &b) const;
 	inline void sampling_round(const std::vector<fitness_vector>&, const double, const unsigned int, const unsigned int, const double) const;
-	inline bool sample_successful(const std::vector<fitness_vector> &, const unsigned int) const;
+	unsigned long long count_successful(const std::vector<fitness_vector> &, const unsigned int, const unsigned long long) const;
 
 	enum extreme_contrib_type {
 		LEAST = 1,
@@ -105,6 +110,9 @@ private:
 
 	mutable rng_double	m_drng;
 
+	// number of threads sampling the boxes
+	unsigned int		m_n_threads;
+
 	/**
 	 * 'least_contributor' method variables section
 	 *
@@ -138,13 +146,19 @@ private:
 	// list of indices of points that overlap the bounding box of each point
 	// during monte carlo sampling it suffices to check only these points when deciding whether the sampling was "successful"
 	mutable std::vector<std::vector<unsigned int> > m_box_points;
+
+	// sampling engines of the boxes, built the first time a box is sampled
+	mutable std::vector<boost::shared_ptr<mc_sampler> > m_samplers;
+
+	// seed of the streams from which the samples are drawn
+	mutable boost::uint32_t m_seed;
 	/**
 	 * End of 'least_contributor' method variables section
 	 */
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<bool &>(m_use_exact);
@@ -156,11 +170,18 @@ private:
 		ar & const_cast<double &>(m_initial_delta_coeff);
 		ar & const_cast<double &>(m_gamma);
 		ar & m_drng;
+		// The number of threads was added in version 1: older archives are loaded as serial.
+		if (version > 0) {
+			ar & m_n_threads;
+		} else {
+			m_n_threads = 1;
+		}
 	}
 };
 
 } } }
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::bf_approx);
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::bf_approx, 1);
 
 #endif
@@ -24,10 +24,116 @@
 
 
 #include "bf_fpras.h"
+#include "mc_sampler.h"
+#include "../parallel.h"
 #include <algorithm>
+#include <limits>
+#include <boost/cstdint.hpp>
+#include <boost/math/distributions/normal.hpp>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+namespace {
+
+// Number of independent sampling chains, which does not depend on the number of threads so that neither do the results.
+const std::size_t n_chains = 64;
+
+// Number of waves in which the budget of draws is spent (the early stopping being checked after each of them).
+const boost::uint64_t n_waves = 16;
+
+// Number of rounds after which the size of the batches of a chain is updated.
+const boost::uint64_t batch_update = 64;
+
+// State of a sampling chain: a sequence of rounds as in the original algorithm, drawn from its own generator.
+struct fpras_chain
+{
+	rng_double		rng;
+	// Sample of the current round, if any
+	fitness_vector		x;
+	bool			has_sample;
+	// Draws of the current round so far
+	boost::uint64_t		round_draws;
+	// Total number of draws and number of completed rounds
+	boost::uint64_t		draws;
+	boost::uint64_t		rounds;
+	// Size of the batches of draws, the mean length of the rounds rounded up
+	unsigned int		batch;
+	// Sums of the lengths (in draws) of the completed rounds, and of their squares
+	double			sum_l;
+	double			sum_l2;
+};
+
+// Advances each chain by n_draws draws or, if finish is true, until the end of its round in progress (if any). A round
+// draws a point in the union of the boxes, then draws boxes until one of them contains the point. The draws of a round
+// are tested in batches (of about the mean length of the rounds of the chain), the draws of a batch past the first
+// success being discarded.
+class fpras_task
+{
+	public:
+		fpras_task(const std::vector<fitness_vector> &points, const fitness_vector &r_point, const std::vector<double> &sums, const mc_sampler &sampler,
+			std::vector<fpras_chain> &chains, const boost::uint64_t n_draws, const bool finish = false):
+			m_points(points),m_r_point(r_point),m_sums(sums),m_sampler(sampler),m_chains(chains),
+			m_n_draws(finish ? std::numeric_limits<boost::uint64_t>::max() : n_draws),m_finish(finish) {}
+		void operator()(const std::size_t &c, const unsigned int &) const
+		{
+			fpras_chain &ch = m_chains[c];
+			if (m_finish && !ch.has_sample) {
+				return;
+			}
+			const fitness_vector::size_type dim = m_r_point.size();
+			const unsigned int n = static_cast<unsigned int>(m_points.size());
+			std::vector<unsigned int> idx(mc_sampler::block_size);
+
+			for (boost::uint64_t remaining = m_n_draws; remaining > 0;) {
+				if (!ch.has_sample) {
+					// Choose the box with probability proportional to its volume, then sample a point inside it.
+					const std::vector<double>::size_type i = std::min<std::vector<double>::size_type>(
+						std::lower_bound(m_sums.begin(), m_sums.end(), ch.rng() * m_sums.back()) - m_sums.begin(), n - 1);
+					for (fitness_vector::size_type d = 0; d < dim; ++d) {
+						ch.x[d] = m_points[i][d] + ch.rng() * (m_r_point[d] - m_points[i][d]);
+					}
+					ch.has_sample = true;
+				}
+				const unsigned int k = static_cast<unsigned int>(std::min<boost::uint64_t>(remaining, ch.batch));
+				for (unsigned int s = 0; s < k; ++s) {
+					idx[s] = std::min(n - 1, static_cast<unsigned int>(ch.rng() * n));
+				}
+				const unsigned int first = m_sampler.first_dominating(&ch.x[0], &idx[0], k);
+				if (first < k) {
+					const double l = static_cast<double>(ch.round_draws + first + 1);
+					ch.draws += first + 1;
+					remaining -= first + 1;
+					ch.sum_l += l;
+					ch.sum_l2 += l * l;
+					++ch.rounds;
+					if (!(ch.rounds % batch_update)) {
+						ch.batch = static_cast<unsigned int>(std::min(static_cast<double>(mc_sampler::block_size),
+							std::ceil(ch.sum_l / static_cast<double>(ch.rounds))));
+					}
+					ch.round_draws = 0;
+					ch.has_sample = false;
+					if (m_finish) {
+						return;
+					}
+				} else {
+					ch.draws += k;
+					remaining -= k;
+					ch.round_draws += k;
+				}
+			}
+		}
+	private:
+		const std::vector<fitness_vector>	&m_points;
+		const fitness_vector			&m_r_point;
+		const std::vector<double>		&m_sums;
+		const mc_sampler			&m_sampler;
+		std::vector<fpras_chain>		&m_chains;
+		const boost::uint64_t			m_n_draws;
+		const bool				m_finish;
+};
+
+}
+
 /// Constructor
 /**
  * Constructs an instance of the algorithm
@@ -35,7 +141,7 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * @param[in] eps accuracy of the approximation
  * @param[in] delta confidence of the approximation
  */
-bf_fpras::bf_fpras(const double eps, const double delta) : m_eps(eps), m_delta(delta) { }
+bf_fpras::bf_fpras(const double eps, const double delta) : m_eps(eps), m_delta(delta), m_n_threads(1), m_early_stop(false) { }
 
 /// Verify before compute
 /**
@@ -55,6 +161,14 @@ void bf_fpras::verify_before_compute(const std::vector<fitness_vector> &points,
 /**
  * Compute the hypervolume using FPRAS.
  *
+ * The budget of T draws of the original algorithm is shared among independent sampling chains, drawn from their own
+ * streams and advanced by up to get_n_threads() threads. In each chain, the boxes drawn during a round are tested against
+ * the sampled point in batches (see pagmo::util::hv_algorithm::mc_sampler). The result does not depend on the number
+ * of threads.
+ *
+ * If the early stopping is enabled, the sampling stops before the end of the budget as soon as the confidence interval
+ * (at level 1 - delta, from the normal approximation) of the mean length of the rounds is within a relative error eps.
+ *
  * @see "Approximating the volume of unions and intersections of high-dimensional geometric objects", Karl Bringmann, Tobias Friedrich.
  *
  * @param[in] points vector of fitness_vectors for which the hypervolume is computed
@@ -74,9 +188,6 @@ double bf_fpras::compute(std::vector<fitness_vector> &points, const fitness_vect
 	// points iterator
 	std::vector<fitness_vector>::iterator it_p;
 
-	// volume iterator - used for finding the contributor using std::lower_bound
-	std::vector<double>::iterator it_sums;
-
 	unsigned int i = 0;
 
 	// Total sum of every box
@@ -85,35 +196,60 @@ double bf_fpras::compute(std::vector<fitness_vector> &points, const fitness_vect
 		V = (sums[i++] = V + base::volume_between(*it_p, r_point));
 	}
 
-	unsigned long long M = 0; // Round counter
-	unsigned long long M_sum = 0; // Total number of samples over every round so far
+	// The generators of the chains are seeded from the streams of a seed drawn from the generator of the algorithm
+	// (the draws themselves use the faster rng_double, as they are needed one at a time).
+	const boost::uint32_t seed = static_cast<boost::uint32_t>(m_drng() * 4294967296.);
+	std::vector<fpras_chain> chains(n_chains);
+	for(std::size_t c = 0 ; c < n_chains ; ++c) {
+		chains[c].rng = rng_double(rng_philox(seed, static_cast<boost::uint32_t>(c))());
+		chains[c].x.resize(dim);
+		chains[c].has_sample = false;
+		chains[c].batch = 16;
+		chains[c].round_draws = chains[c].draws = chains[c].rounds = 0;
+		chains[c].sum_l = chains[c].sum_l2 = 0.0;
+	}
 
-	// Container for the random point
-	fitness_vector rnd_point(dim, 0.0);
+	const mc_sampler sampler(points);
+	const double z = boost::math::quantile(boost::math::complement(boost::math::normal(), m_delta / 2.));
 
-	while(true) {
-		// Get the random volume in-between [0, V] range, in order to choose the box with probability sums[i] / V
-		double r = m_drng() * V;
+	// Draws of each chain per wave
+	const boost::uint64_t wave_draws = std::max<boost::uint64_t>(1, T / (n_chains * n_waves));
 
-		// Find the contributor using binary search
-		it_sums = std::lower_bound(sums.begin(), sums.end(), r);
-		i = std::distance(sums.begin(), it_sums);
+	boost::uint64_t M_sum = 0; // Total number of draws over every chain so far
+	boost::uint64_t M = 0; // Round counter
+	while (M_sum < T || M == 0) {
+		const fpras_task task(points, r_point, sums, sampler, chains, wave_draws);
+		parallel::for_each_index(n_chains, m_n_threads, task);
 
-		// Sample a point inside the 'box' (r_point, points[i])
-		for(unsigned int d_idx = 0 ; d_idx < dim ; ++d_idx) {
-			rnd_point[d_idx] = (points[i][d_idx] + m_drng() * (r_point[d_idx] - points[i][d_idx]));
+		// Merge the chains, in order.
+		double sum_l = 0.0, sum_l2 = 0.0;
+		M_sum = M = 0;
+		for(std::size_t c = 0 ; c < n_chains ; ++c) {
+			M_sum += chains[c].draws;
+			M += chains[c].rounds;
+			sum_l += chains[c].sum_l;
+			sum_l2 += chains[c].sum_l2;
 		}
 
-		unsigned int j = 0;
-		do {
-			if ( M_sum >= T ) {
-				return (T * V) / static_cast<double>(n * M);
+		if (m_early_stop && M > 1) {
+			const double mean = sum_l / static_cast<double>(M);
+			const double var = std::max(0., (sum_l2 - mean * sum_l) / static_cast<double>(M - 1));
+			if (z * std::sqrt(var / static_cast<double>(M)) <= m_eps * mean) {
+				break;
 			}
-			j = static_cast<unsigned int>(n * m_drng());
-			++M_sum;
-		} while (!(base::dom_cmp(rnd_point, points[j]) == base::DOM_CMP_B_DOMINATES_A));
-		++M;
+		}
+	}
+	// As in the original algorithm, the sampling ends with complete rounds: the draws of the rounds in progress would
+	// bias the estimate upwards, and discarding them would bias it downwards (the longer rounds being the more likely
+	// to be in progress).
+	const fpras_task finish(points, r_point, sums, sampler, chains, 0, true);
+	parallel::for_each_index(n_chains, m_n_threads, finish);
+	M_sum = M = 0;
+	for(std::size_t c = 0 ; c < n_chains ; ++c) {
+		M_sum += chains[c].draws;
+		M += chains[c].rounds;
 	}
+	return (M_sum * V) / static_cast<double>(n * M);
 }
 
 /// Exclusive method
@@ -173,6 +309,51 @@ std::string bf_fpras::get_name() const
 	return "Hypervolume algorithm based on FPRAS";
 }
 
+/// Sets the early stopping
+/**
+ * If true, the sampling stops as soon as the confidence interval of the estimation is within the required accuracy,
+ * instead of using the whole worst-case budget of draws.
+ *
+ * @param[in] early_stop true to enable the early stopping
+ */
+void bf_fpras::set_early_stop(const bool early_stop)
+{
+	m_early_stop = early_stop;
+}
+
+/// Gets the early stopping
+/**
+ * @return true if the early stopping is enabled
+ */
+bool bf_fpras::get_early_stop() const
+{
+	return m_early_stop;
+}
+
+/// Sets the number of threads
+/**
+ * If larger than one, the sampling chains are advanced concurrently. The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void bf_fpras::set_n_threads(const unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error, "the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the number of threads
+/**
+ * @return the maximum number of threads
+ */
+unsigned int bf_fpras::get_n_threads() const
+{
+	return m_n_threads;
+}
+
 } } }
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hv_algorithm::bf_fpras);
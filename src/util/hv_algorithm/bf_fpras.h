@@ -60,28 +60,46 @@ public:
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
 	std::string get_name() const;
+	void set_n_threads(const unsigned int);
+	unsigned int get_n_threads() const;
+	void set_early_stop(const bool);
+	bool get_early_stop() const;
 
 private:
 	// error of the approximation
 	const double m_eps;
 	// probabiltiy of error
 	const double m_delta;
+	// number of threads advancing the sampling chains
+	unsigned int m_n_threads;
+	// stop as soon as the confidence interval is narrow enough
+	bool m_early_stop;
 
 	mutable rng_double m_drng;
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<double &>(m_eps);
 		ar & const_cast<double &>(m_delta);
 		ar & m_drng;
+		// The number of threads and the early stop were added in version 1: older archives are loaded as serial and
+		// without early stop.
+		if (version > 0) {
+			ar & m_n_threads;
+			ar & m_early_stop;
+		} else {
+			m_n_threads = 1;
+			m_early_stop = false;
+		}
 	}
 };
 
 } } }
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::bf_fpras);
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::bf_fpras, 1);
 
 #endif
@@ -25,16 +25,63 @@
 
 #include "hoy.h"
 #include "base.h"
+#include "../parallel.h"
 #include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <limits>
+#include <boost/noncopyable.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+// Depth of the partition tree at which the nodes are handed to the threads (at most 2^7 partitions).
+static const unsigned int hoy_partition_level = 7;
+
+/// Task of the parallel mode
+/**
+ * Streams the partitions collected by the master on per-worker HOY states, whose buffers are allocated once
+ * and reused for all the partitions a worker processes.
+ */
+class hoy::partition_task : private boost::noncopyable
+{
+	public:
+		partition_task(const hoy &master, std::vector<partition> &partitions, std::vector<double> &volumes):
+			m_master(master),m_partitions(partitions),m_volumes(volumes),m_workers(master.m_n_threads) {}
+		~partition_task()
+		{
+			for (std::vector<boost::shared_ptr<hoy> >::size_type i = 0; i < m_workers.size(); ++i) {
+				if (m_workers[i]) {
+					m_workers[i]->free_buffers();
+				}
+			}
+		}
+		void operator()(const std::size_t &i, const unsigned int &worker)
+		{
+			if (!m_workers[worker]) {
+				boost::shared_ptr<hoy> w(new hoy());
+				w->m_dimension = m_master.m_dimension;
+				w->m_total_size = m_master.m_total_size;
+				w->m_sqrt_size = m_master.m_sqrt_size;
+				w->allocate_buffers();
+				m_workers[worker] = w;
+			}
+			const hoy &w = *m_workers[worker];
+			partition &p = m_partitions[i];
+			w.m_volume = 0.0;
+			w.stream(&p.region_low[0], &p.region_up[0], &p.points[0], p.points.size(), p.split, p.cover, 0);
+			m_volumes[i] = w.m_volume;
+		}
+	private:
+		const hoy				&m_master;
+		std::vector<partition>			&m_partitions;
+		std::vector<double>			&m_volumes;
+		std::vector<boost::shared_ptr<hoy> >	m_workers;
+};
+
 /// Constructor
-hoy::hoy() { }
+hoy::hoy() : m_partitions(0), m_partition_level(0), m_n_threads(1) { }
 
 /// Compute hypervolume
 /**
@@ -54,10 +101,7 @@ double hoy::compute(std::vector<fitness_vector> &points, const fitness_vector &r
 
 	m_region_low = new double[m_dimension - 1];
 	m_region_up = new double[m_dimension - 1];
-	m_boundaries = new double[m_total_size];
-	m_no_boundaries = new double[m_total_size];
-	m_piles = new int[m_total_size];
-	m_trellis = new double[m_dimension - 1];
+	allocate_buffers();
 
 	// initialize the D-1 dimensional region vectors and D-dimensional reference point
 	for (int i = 0 ; i < m_dimension - 1 ; ++i) {
@@ -65,9 +109,11 @@ double hoy::compute(std::vector<fitness_vector> &points, const fitness_vector &r
 		m_region_low[i] = std::numeric_limits<double>::max();
 	}
 
+	// The coordinates of the initial points are stored in a single block.
+	double* initial_block = new double[m_total_size * m_dimension];
 	double** initial_points = new double*[m_total_size];
 	for (int n = 0 ; n < m_total_size ; ++n) {
-		initial_points[n] = new double[m_dimension];
+		initial_points[n] = initial_block + n * m_dimension;
 
 		initial_points[n][m_dimension - 1] = points[n][m_dimension - 1];
 		for (int i = 0 ; i < m_dimension - 1 ; ++i) {
@@ -78,30 +124,63 @@ double hoy::compute(std::vector<fitness_vector> &points, const fitness_vector &r
 		}
 	}
 
-	// call stream initially
-	stream(m_region_low, m_region_up, initial_points, m_total_size, 0, r_point[m_dimension - 1], 0);
-
-	// free the memory for child node points
-	for (unsigned int n = 0; n < m_child_points.size() ; ++n) {
-		delete[] m_child_points[n];
+	if (m_n_threads > 1) {
+		// Stream the top of the partition tree, collecting its nodes at m_partition_level, then stream these
+		// independently. The volumes are summed in the order of the partitions, so that the result does not depend
+		// on the number of threads (it may differ from the serial one in the last bits, due to the order of the sums).
+		std::vector<partition> partitions;
+		m_partitions = &partitions;
+		m_partition_level = hoy_partition_level;
+		stream(m_region_low, m_region_up, initial_points, m_total_size, 0, r_point[m_dimension - 1], 0);
+		m_partitions = 0;
+
+		std::vector<double> volumes(partitions.size());
+		{
+			partition_task task(*this, partitions, volumes);
+			parallel::for_each_index(partitions.size(), m_n_threads, task);
+		}
+		for (std::vector<double>::size_type i = 0; i < volumes.size(); ++i) {
+			m_volume += volumes[i];
+		}
+	} else {
+		// call stream initially
+		stream(m_region_low, m_region_up, initial_points, m_total_size, 0, r_point[m_dimension - 1], 0);
 	}
-	m_child_points.clear();
 
 	// free the memory of the initial points
-	for (int n = 0; n < m_total_size ; ++n) {
-		delete[] initial_points[n];
-	}
+	delete[] initial_block;
 	delete[] initial_points;
 
 	// free the member variables
 	delete[] m_region_low;
 	delete[] m_region_up;
+	free_buffers();
+
+	return m_volume;
+}
+
+/// Allocate the buffers used by 'stream', for m_total_size points of dimension m_dimension
+void hoy::allocate_buffers() const
+{
+	m_boundaries = new double[m_total_size];
+	m_no_boundaries = new double[m_total_size];
+	m_piles = new int[m_total_size];
+	m_trellis = new double[m_dimension - 1];
+}
+
+/// Free the buffers used by 'stream'
+void hoy::free_buffers() const
+{
+	// free the memory for child node points
+	for (unsigned int n = 0; n < m_child_points.size() ; ++n) {
+		delete[] m_child_points[n];
+	}
+	m_child_points.clear();
+
 	delete[] m_boundaries;
 	delete[] m_no_boundaries;
 	delete[] m_piles;
 	delete[] m_trellis;
-
-	return m_volume;
 }
 
 bool hoy::covers(const double cub[], const double reg_low[]) const
@@ -204,6 +283,18 @@ double hoy::get_median(double* bounds, unsigned int n) const
 /// Recursive calculation of the hypervolume.
 void hoy::stream(double m_region_low[], double m_region_up[], double** points, const unsigned int n_points, int split, double cover, unsigned int rec_level) const
 {
+	// In the parallel mode, the nodes at the partition level are only recorded, and streamed later by the workers.
+	if (m_partitions && rec_level == m_partition_level) {
+		m_partitions->push_back(partition());
+		partition &p = m_partitions->back();
+		p.region_low.assign(m_region_low, m_region_low + m_dimension - 1);
+		p.region_up.assign(m_region_up, m_region_up + m_dimension - 1);
+		p.points.assign(points, points + n_points);
+		p.split = split;
+		p.cover = cover;
+		return;
+	}
+
 	double cover_old = cover;
 	unsigned int cover_index = 0;
 		
@@ -377,6 +468,31 @@ std::string hoy::get_name() const
 	return "HOY algorithm";
 }
 
+/// Sets the number of threads
+/**
+ * If larger than one, the upper levels of the partition tree are streamed serially, and the partitions below them
+ * are distributed among the threads, each with its own buffers.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void hoy::set_n_threads(const unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error, "the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the number of threads
+/**
+ * @return the maximum number of threads
+ */
+unsigned int hoy::get_n_threads() const
+{
+	return m_n_threads;
+}
+
 } } }
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hv_algorithm::hoy);
@@ -61,8 +61,24 @@ public:
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
 	std::string get_name() const;
+	void set_n_threads(const unsigned int);
+	unsigned int get_n_threads() const;
 
 private:
+	// Node of the partition tree, processed on its own in the parallel mode.
+	struct partition
+	{
+		std::vector<double>	region_low;
+		std::vector<double>	region_up;
+		std::vector<double*>	points;
+		int			split;
+		double			cover;
+	};
+	class partition_task;
+	friend class partition_task;
+
+	void allocate_buffers() const;
+	void free_buffers() const;
 	inline bool covers(const double cub[], const double reg_low[]) const;
 	inline bool part_covers(const double cub[], const double reg_up[]) const;
 	inline int contains_boundary(const double cub[], const double reg_low[], const int split) const;
@@ -87,17 +103,30 @@ private:
 	mutable double	*m_boundaries;
 	mutable double	*m_no_boundaries;
 	mutable std::vector<double**> m_child_points;
+	// Nodes collected by 'stream' at level m_partition_level, or null in the serial mode.
+	mutable std::vector<partition> *m_partitions;
+	mutable unsigned int m_partition_level;
+
+	// Number of threads processing the partitions
+	unsigned int m_n_threads;
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
+		// The number of threads was added in version 1: older archives are loaded as serial.
+		if (version > 0) {
+			ar & m_n_threads;
+		} else {
+			m_n_threads = 1;
+		}
 	}
 };
 
 } } }
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::hoy);
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::hoy, 1);
 
 #endif
@@ -0,0 +1,171 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "mc_sampler.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+/// Constructor from a set of points
+/**
+ * @param[in] points points against which the samples are tested
+ */
+mc_sampler::mc_sampler(const std::vector<fitness_vector> &points) : m_dim(points.empty() ? 0 : points[0].size()), m_n_points(points.size())
+{
+	m_coords.reserve(m_n_points * m_dim);
+	for (std::size_t j = 0; j < m_n_points; ++j) {
+		m_coords.insert(m_coords.end(), points[j].begin(), points[j].end());
+	}
+}
+
+/// Constructor from a subset of points
+/**
+ * @param[in] points vector of points
+ * @param[in] idx indices of the points against which the samples are tested
+ */
+mc_sampler::mc_sampler(const std::vector<fitness_vector> &points, const std::vector<unsigned int> &idx) : m_dim(points.empty() ? 0 : points[0].size()), m_n_points(idx.size())
+{
+	m_coords.reserve(m_n_points * m_dim);
+	for (std::size_t j = 0; j < m_n_points; ++j) {
+		m_coords.insert(m_coords.end(), points[idx[j]].begin(), points[idx[j]].end());
+	}
+}
+
+/// Count the non-dominated samples of a block
+/**
+ * Counts the samples that are not weakly dominated by any of the points (i.e., for which no point is lower or equal in
+ * every objective). The points are tested in order against the samples of the block not dominated so far, until there
+ * are none left. The block is compacted (and thus overwritten) whenever at least half of the tested samples are found to
+ * be dominated.
+ *
+ * @param[in,out] samples block of samples, coordinate d of sample s being at index d * block_size + s
+ * @param[in] n_samples number of samples in the block (at most block_size)
+ * @param[out] n_tests number of dominance tests done between a sample and a point
+ *
+ * @return the number of non-dominated samples
+ */
+unsigned int mc_sampler::count_non_dominated(double *samples, const unsigned int n_samples, unsigned long long &n_tests) const
+{
+	unsigned int mask[block_size], free[block_size];
+	std::fill(free, free + n_samples, 1u);
+	// Number of samples at the front of the block which are still tested, and number of those which are not dominated
+	unsigned int n_active = n_samples, n_free = n_samples;
+	n_tests = 0;
+	for (std::size_t j = 0; j < m_n_points && n_free > 0; ++j) {
+		const double *p = &m_coords[j * m_dim];
+		std::fill(mask, mask + n_active, 1u);
+		// All the samples are tested against the point one coordinate at a time, without early exit, so that the
+		// inner loops run over contiguous memory.
+		for (unsigned int d = 0; d < m_dim; ++d) {
+			const double p_d = p[d];
+			const double *x_d = samples + d * block_size;
+			for (unsigned int s = 0; s < n_active; ++s) {
+				mask[s] &= static_cast<unsigned int>(p_d <= x_d[s]);
+			}
+		}
+		n_tests += n_active;
+		n_free = 0;
+		for (unsigned int s = 0; s < n_active; ++s) {
+			free[s] &= mask[s] ^ 1u;
+			n_free += free[s];
+		}
+		if (n_free <= n_active / 2) {
+			for (unsigned int d = 0; d < m_dim; ++d) {
+				double *x_d = samples + d * block_size;
+				unsigned int k = 0;
+				for (unsigned int s = 0; s < n_active; ++s) {
+					x_d[k] = x_d[s];
+					k += free[s];
+				}
+			}
+			n_active = n_free;
+			std::fill(free, free + n_active, 1u);
+		}
+	}
+	return n_free;
+}
+
+/// Find the first dominating point of a batch
+/**
+ * Tests a sample against a batch of points, all at once. Short batches, for which the overhead of the masks is not
+ * worth it, are instead tested point after point, stopping at the first coordinate that is not dominated.
+ *
+ * @param[in] x the sample
+ * @param[in] idx indices of the points of the batch (possibly repeated)
+ * @param[in] n_idx size of the batch (at most block_size)
+ *
+ * @return the position in idx of the first point weakly dominating x, or n_idx if there is none
+ */
+unsigned int mc_sampler::first_dominating(const double *x, const unsigned int *idx, const unsigned int n_idx) const
+{
+	if (n_idx <= short_batch_size) {
+		for (unsigned int k = 0; k < n_idx; ++k) {
+			const double *p = &m_coords[idx[k] * m_dim];
+			unsigned int d = 0;
+			while (d < m_dim && p[d] <= x[d]) {
+				++d;
+			}
+			if (d == m_dim) {
+				return k;
+			}
+		}
+		return n_idx;
+	}
+	unsigned int mask[block_size];
+	std::fill(mask, mask + n_idx, 1u);
+	for (unsigned int d = 0; d < m_dim; ++d) {
+		const double x_d = x[d];
+		const double *coords_d = &m_coords[d];
+		for (unsigned int k = 0; k < n_idx; ++k) {
+			mask[k] &= static_cast<unsigned int>(coords_d[idx[k] * m_dim] <= x_d);
+		}
+	}
+	return static_cast<unsigned int>(std::find(mask, mask + n_idx, 1u) - mask);
+}
+
+/// Sample a box uniformly
+/**
+ * Consumes n_samples * lb.size() values of the stream.
+ *
+ * @param[in,out] rng stream of the block
+ * @param[in] lb lower corner of the box
+ * @param[in] ub upper corner of the box
+ * @param[in] n_samples number of samples (at most block_size)
+ * @param[out] samples block of samples, coordinate d of sample s being written at index d * block_size + s
+ */
+void mc_sampler::sample_box(rng_philox &rng, const fitness_vector &lb, const fitness_vector &ub, const unsigned int n_samples, double *samples)
+{
+	for (fitness_vector::size_type d = 0; d < lb.size(); ++d) {
+		double *x_d = samples + d * block_size;
+		rng.generate_uniform(x_d, x_d + n_samples);
+		const double width = ub[d] - lb[d];
+		for (unsigned int s = 0; s < n_samples; ++s) {
+			x_d[s] = lb[d] + x_d[s] * width;
+		}
+	}
+}
+
+} } }
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_HV_ALGORITHM_MC_SAMPLER_H
+#define PAGMO_UTIL_HV_ALGORITHM_MC_SAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../../config.h"
+#include "../../rng.h"
+#include "../../types.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+/// Batched Monte Carlo sampling engine
+/**
+ * Sampling engine shared by the approximated hypervolume algorithms (pagmo::util::hv_algorithm::bf_approx and
+ * pagmo::util::hv_algorithm::bf_fpras). The dominance tests are done in batches, in branch-free loops without early
+ * exit which the compiler vectorises: either a block of at most block_size samples, stored column-wise (coordinate d of
+ * sample s at index d * block_size + s), against one point after the other, or a single sample against a batch of at
+ * most block_size points.
+ *
+ * The blocks are meant to be drawn from independent streams of pagmo::rng_philox, identified by the index of the
+ * block, so that they can be processed by several threads with results independent of the number of threads.
+ */
+class __PAGMO_VISIBLE mc_sampler
+{
+public:
+	/// Maximum number of samples in a block.
+	static const unsigned int block_size = 256;
+	/// Size of the batches up to which first_dominating() tests the points one by one.
+	static const unsigned int short_batch_size = 8;
+
+	explicit mc_sampler(const std::vector<fitness_vector> &);
+	mc_sampler(const std::vector<fitness_vector> &, const std::vector<unsigned int> &);
+
+	unsigned int count_non_dominated(double *, const unsigned int, unsigned long long &) const;
+	unsigned int first_dominating(const double *, const unsigned int *, const unsigned int) const;
+	static void sample_box(rng_philox &, const fitness_vector &, const fitness_vector &, const unsigned int, double *);
+
+private:
+	// Dimension of the points
+	unsigned int		m_dim;
+	// Number of points
+	std::size_t		m_n_points;
+	// Coordinates of the points, point after point
+	std::vector<double>	m_coords;
+};
+
+} } }
+
+#endif
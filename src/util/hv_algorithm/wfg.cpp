@@ -25,11 +25,58 @@
 
 #include "wfg.h"
 #include "base.h"
+#include "../parallel.h"
 #include <algorithm>
 #include <boost/bind.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+/// Task of the parallel mode
+/**
+ * Processes the top-level slices of the master object (or, for the contributions, its points) on per-worker WFG states.
+ * The workers only read the first frame of the master, and recurse in their own frames, which are allocated once and
+ * reused for all the slices they process.
+ */
+class wfg::slice_task : private boost::noncopyable
+{
+	public:
+		slice_task(const wfg &master, const bool contributions, std::vector<double> &results):
+			m_master(master),m_contributions(contributions),m_results(results),m_workers(master.m_n_threads) {}
+		~slice_task()
+		{
+			for (std::vector<boost::shared_ptr<wfg> >::size_type i = 0; i < m_workers.size(); ++i) {
+				if (m_workers[i]) {
+					m_workers[i]->free_wfg_members();
+				}
+			}
+		}
+		void operator()(const std::size_t &p, const unsigned int &worker)
+		{
+			if (!m_workers[worker]) {
+				boost::shared_ptr<wfg> w(new wfg(m_master.m_stop_dimension));
+				w->attach_worker(m_master);
+				m_workers[worker] = w;
+			}
+			const wfg &w = *m_workers[worker];
+			const unsigned int p_idx = static_cast<unsigned int>(p);
+			if (m_contributions) {
+				w.limitset(0, p_idx, 1);
+				m_results[p] = w.exclusive_hv(p_idx, 1);
+			} else {
+				const unsigned int slice = w.m_current_slice;
+				w.limitset(p_idx + 1, p_idx, 1);
+				m_results[p] = fabs((m_master.m_frames[0][p_idx][slice] - m_master.m_refpoint[slice]) * w.exclusive_hv(p_idx, 1));
+			}
+		}
+	private:
+		const wfg				&m_master;
+		const bool				m_contributions;
+		std::vector<double>			&m_results;
+		std::vector<boost::shared_ptr<wfg> >	m_workers;
+};
+
 /// Comparator function for sorting
 /**
  * Comparison function for WFG. Can't be static in order to have access to member variable m_current_slice.
@@ -47,7 +94,7 @@ bool wfg::cmp_points(double* a, double* b) const
 }
 
 /// Constructor
-wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_stop_dimension(stop_dimension)
+wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_shared_first_frame(false), m_stop_dimension(stop_dimension), m_n_threads(1)
 {
 	if (stop_dimension < 2 ) {
 		pagmo_throw(value_error, "Stop dimension for WFG must be greater than or equal to 2");
@@ -66,11 +113,41 @@ wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_stop_dimensi
 double wfg::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
 	allocate_wfg_members(points, r_point);
-	double hv = compute_hv(1);
+	double hv = (m_n_threads > 1) ? compute_parallel() : compute_hv(1);
 	free_wfg_members();
 	return hv;
 }
 
+/// Parallel version of the first level of compute_hv
+/**
+ * The slices of the first level are distributed among the threads, and summed in the same order as in the serial version,
+ * so that the result does not depend on the number of threads.
+ */
+double wfg::compute_parallel() const
+{
+	double **points = m_frames[0];
+	const unsigned int n_points = m_frames_size[0];
+
+	if (n_points <= 2 || m_current_slice == m_stop_dimension) {
+		return compute_hv(1);
+	}
+	std::sort(points, points + n_points, boost::bind(&wfg::cmp_points, this, _1, _2));
+
+	--m_current_slice;
+	std::vector<double> slices(n_points);
+	{
+		slice_task task(*this, false, slices);
+		parallel::for_each_index(n_points, m_n_threads, task);
+	}
+	++m_current_slice;
+
+	double H = 0.0;
+	for(unsigned int p_idx = 0 ; p_idx < n_points ; ++p_idx) {
+		H += slices[p_idx];
+	}
+	return H;
+}
+
 /// Contributions method
 /**
  * This method employs a slightly modified version of the original WFG algorithm to suit the computation of the exclusive contributions.
@@ -92,18 +169,19 @@ std::vector<double> wfg::contributions(std::vector<fitness_vector> &points, cons
 	// Allocate the same members as for 'compute' method
 	allocate_wfg_members(points, r_point);
 
-	// Prepare the memory for first front
-	double** fr = new double*[m_max_points];
-	for(unsigned int i = 0 ; i < m_max_points ; ++i) {
-		fr[i]=new double[m_current_slice];
-	}
-	m_frames[m_n_frames] = fr;
-	m_frames_size[m_n_frames] = 0;
-	++m_n_frames;
+	if (m_n_threads > 1) {
+		// The exclusive contributions are independent, each worker computes them in its own frames.
+		c.resize(m_max_points);
+		slice_task task(*this, true, c);
+		parallel::for_each_index(m_max_points, m_n_threads, task);
+	} else {
+		// Prepare the memory for first front
+		allocate_frame(m_current_slice);
 
-	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
-		limitset(0, p_idx, 1);
-		c.push_back(exclusive_hv(p_idx, 1));
+		for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
+			limitset(0, p_idx, 1);
+			c.push_back(exclusive_hv(p_idx, 1));
+		}
 	}
 
 	// Free the contributions and the remaining WFG members
@@ -126,37 +204,82 @@ void wfg::allocate_wfg_members(std::vector<fitness_vector> &points, const fitnes
 	// Reserve the space beforehand for each level or recursion.
 	// WFG with slicing feature will not go recursively deeper than the dimension size.
 	m_frames = new double**[m_max_dim];
+	m_frame_blocks = new double*[m_max_dim];
 	m_frames_size = new unsigned int[m_max_dim];
+	m_n_frames = 0;
+	m_shared_first_frame = false;
+	m_cmp_results.resize(m_max_points);
 
 	// Copy the initial set into the frame at index 0.
-	double** fr = new double*[m_max_points];
+	allocate_frame(m_max_dim);
 	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
-		fr[p_idx] = new double[m_max_dim];
 		for(unsigned int d_idx = 0 ; d_idx < m_max_dim ; ++d_idx) {
-			fr[p_idx][d_idx] = points[p_idx][d_idx];
+			m_frames[0][p_idx][d_idx] = points[p_idx][d_idx];
 		}
 	}
-	m_frames[0] = fr;
 	m_frames_size[0] = m_max_points;
-	m_n_frames = 1;
 
 	// Variable holding the current "depth" of dimension slicing. We progress by slicing dimensions from the end.
 	m_current_slice = m_max_dim;
 }
 
+/// Prepare a worker of the parallel mode
+/**
+ * The worker shares the (read-only) frame at index 0 of the master, and owns the frames of the deeper levels.
+ */
+void wfg::attach_worker(const wfg &master) const
+{
+	m_max_points = master.m_max_points;
+	m_max_dim = master.m_max_dim;
+
+	m_refpoint = new double[m_max_dim];
+	std::copy(master.m_refpoint, master.m_refpoint + m_max_dim, m_refpoint);
+
+	m_frames = new double**[m_max_dim];
+	m_frame_blocks = new double*[m_max_dim];
+	m_frames_size = new unsigned int[m_max_dim];
+	m_frames[0] = master.m_frames[0];
+	m_frame_blocks[0] = 0;
+	m_frames_size[0] = master.m_frames_size[0];
+	m_n_frames = 1;
+	m_shared_first_frame = true;
+	m_cmp_results.resize(m_max_points);
+
+	m_current_slice = master.m_current_slice;
+	allocate_frame(m_current_slice);
+}
+
+/// Allocate the next frame
+/**
+ * The coordinates of the points of a frame are stored in a single block, so that a frame costs two allocations
+ * regardless of the number of points.
+ */
+void wfg::allocate_frame(const unsigned int dim) const
+{
+	double* block = new double[std::max(m_max_points * dim, 1u)];
+	double** fr = new double*[std::max(m_max_points, 1u)];
+	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
+		fr[p_idx] = block + p_idx * dim;
+	}
+	m_frame_blocks[m_n_frames] = block;
+	m_frames[m_n_frames] = fr;
+	m_frames_size[m_n_frames] = 0;
+	++m_n_frames;
+}
+
 /// Free the previously allocated memory
 void wfg::free_wfg_members() const
 {
 	// Free the memory.
 	delete[] m_refpoint;
 
-	for(unsigned int fr_idx = 0 ; fr_idx < m_n_frames ; ++fr_idx) {
-		for(unsigned int p_idx = 0; p_idx < m_max_points ; ++p_idx) {
-			delete[] m_frames[fr_idx][p_idx];
-		}
+	// The frames may have been sorted, so their blocks are freed through m_frame_blocks.
+	for(unsigned int fr_idx = (m_shared_first_frame ? 1 : 0) ; fr_idx < m_n_frames ; ++fr_idx) {
+		delete[] m_frame_blocks[fr_idx];
 		delete[] m_frames[fr_idx];
 	}
 	delete[] m_frames;
+	delete[] m_frame_blocks;
 	delete[] m_frames_size;
 }
 
@@ -180,8 +303,7 @@ void wfg::limitset(const unsigned int begin_idx, const unsigned int p_idx, const
 			frame[no_points][f_idx] = std::max(points[idx][f_idx], p[f_idx]);
 		}
 
-		std::vector<int> cmp_results;
-		cmp_results.resize(no_points);
+		std::vector<int> &cmp_results = m_cmp_results;
 		double* s = frame[no_points];
 
 		bool keep_s = true;
@@ -272,13 +394,7 @@ double wfg::compute_hv(const unsigned int rec_level) const
 	--m_current_slice;
 
 	if(rec_level >= m_n_frames) {
-		double** fr = new double*[m_max_points];
-		for(unsigned int i = 0 ; i < m_max_points ; ++i) {
-			fr[i]=new double[m_current_slice];
-		}
-		m_frames[m_n_frames] = fr;
-		m_frames_size[m_n_frames] = 0;
-		++m_n_frames;
+		allocate_frame(m_current_slice);
 	}
 
 	for(unsigned int p_idx = 0 ; p_idx < n_points ; ++p_idx) {
@@ -331,6 +447,31 @@ std::string wfg::get_name() const
 	return "WFG algorithm";
 }
 
+/// Sets the number of threads
+/**
+ * If larger than one, the slices of the first recursion level (and, in 'contributions', the exclusive contributions) are
+ * distributed among the threads, each with its own frames. The results do not depend on the number of threads.
+ *
+ * @param[in] n_threads maximum number of threads
+ * @throws value_error if n_threads is zero
+ */
+void wfg::set_n_threads(const unsigned int n_threads)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error, "the number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Gets the number of threads
+/**
+ * @return the maximum number of threads
+ */
+unsigned int wfg::get_n_threads() const
+{
+	return m_n_threads;
+}
+
 } } }
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hv_algorithm::wfg);
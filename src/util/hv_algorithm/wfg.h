@@ -54,8 +54,16 @@ public:
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
 	std::string get_name() const;
+	void set_n_threads(const unsigned int);
+	unsigned int get_n_threads() const;
 
 private:
+	class slice_task;
+	friend class slice_task;
+
+	double compute_parallel() const;
+	void attach_worker(const wfg &) const;
+
 	void limitset(const unsigned int, const unsigned int, const unsigned int) const;
 	double exclusive_hv(const unsigned int, const unsigned int) const;
 	double compute_hv(const unsigned int) const;
@@ -63,6 +71,7 @@ private:
 	bool cmp_points(double* a, double* b) const;
 
 	void allocate_wfg_members(std::vector<fitness_vector> &, const fitness_vector &) const;
+	void allocate_frame(const unsigned int) const;
 	void free_wfg_members() const;
 
 	/**
@@ -79,6 +88,9 @@ private:
 	// Array of point sets for each recursive level.
 	mutable double*** m_frames;
 
+	// Contiguous storage of the coordinates of the points of each frame.
+	mutable double** m_frame_blocks;
+
 	// Maintains the number of points at given recursion level.
 	mutable unsigned int* m_frames_size;
 
@@ -93,6 +105,12 @@ private:
 
 	// Size of the dimension
 	mutable unsigned int m_max_dim;
+
+	// Scratch space for the dominance comparisons in 'limitset'.
+	mutable std::vector<int> m_cmp_results;
+
+	// True for the workers of the parallel mode, which do not own the frame at index 0.
+	mutable bool m_shared_first_frame;
 	/**
 	 * End of 'compute' method variables section.
 	 */
@@ -100,17 +118,27 @@ private:
 	// Dimension at which WFG stops the slicing
 	const unsigned int m_stop_dimension;
 
+	// Number of threads processing the top-level slices
+	unsigned int m_n_threads;
+
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<unsigned int &>(m_stop_dimension);
+		// The number of threads was added in version 1: older archives are loaded as serial.
+		if (version > 0) {
+			ar & m_n_threads;
+		} else {
+			m_n_threads = 1;
+		}
 	}
 };
 
 } } }
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hv_algorithm::wfg);
+BOOST_CLASS_VERSION(pagmo::util::hv_algorithm::wfg, 1);
 
 #endif
@@ -460,6 +460,35 @@ const std::vector<fitness_vector> hypervolume::get_points() const
 	return m_points;
 }
 
+/// Dynamic hypervolume of the points
+/**
+ * Builds a structure keeping the hypervolume and the exclusive contributions up to date while points are inserted and
+ * erased one at a time (see dynamic_hypervolume). The points of this object are inserted first, so that the handle of
+ * each of them is its index.
+ *
+ * @param[in] r_point fitness vector describing the reference point
+ *
+ * @return shared pointer to a dynamic_hv2d or dynamic_hv3d object, according to the dimension of the reference point
+ *
+ * @throws value_error if the dimension is not 2 or 3, or if the points do not fit the reference point
+ */
+dynamic_hypervolume_ptr hypervolume::get_dynamic(const fitness_vector &r_point) const
+{
+	dynamic_hypervolume_ptr retval;
+	switch(r_point.size()) {
+		case 2:
+			retval.reset(new dynamic_hv2d(r_point));
+			break;
+		case 3:
+			retval.reset(new dynamic_hv3d(r_point));
+			break;
+		default:
+			pagmo_throw(value_error, "Dynamic hypervolume is available only for 2 and 3 dimensions.");
+	}
+	retval->insert(m_points);
+	return retval;
+}
+
 /// Clone method.
 /**
  * Returns a clone of the object instance.
@@ -29,6 +29,7 @@
 #include <vector>
 #include <cmath>
 #include "../population.h"
+#include "dynamic_hypervolume.h"
 #include "hv_algorithm/base.h"
 #include "hv_algorithm/hv2d.h"
 #include "hv_algorithm/hv3d.h"
@@ -75,6 +76,8 @@ public:
 	std::vector<double> contributions(const fitness_vector &, const hv_algorithm::base_ptr) const;
 	std::vector<double> contributions(const fitness_vector &) const;
 
+	dynamic_hypervolume_ptr get_dynamic(const fitness_vector &) const;
+
 	static unsigned long long get_expected_operations(const unsigned int n, const unsigned int d);
 
 	void set_copy_points(const bool);
@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <cmath>
+
+#include "../exceptions.h"
+#include "knn.h"
+
+namespace pagmo{ namespace util {namespace neighbourhood {
+
+// Maximum number of points in a leaf of the kd-tree.
+static const population::size_type leaf_size = 16;
+// Above this dimension the kd-tree does not prune enough, and AUTO selects the brute-force search.
+static const population::size_type max_kd_tree_dimension = 10;
+
+static inline double squared_distance(const double *a, const double *b, population::size_type dim)
+{
+	double retval = 0.;
+	for (population::size_type i = 0; i < dim; ++i) {
+		const double tmp = a[i] - b[i];
+		retval += tmp * tmp;
+	}
+	return retval;
+}
+
+// Orders point indices by one of their coordinates.
+class coordinate_sorter {
+public:
+	coordinate_sorter(const std::vector<double> &data, population::size_type dim, population::size_type coord):
+		m_data(data), m_dim(dim), m_coord(coord) {}
+	bool operator()(population::size_type a, population::size_type b) const {
+		return m_data[a * m_dim + m_coord] < m_data[b * m_dim + m_coord];
+	}
+private:
+	const std::vector<double> &m_data;
+	const population::size_type m_dim;
+	const population::size_type m_coord;
+};
+
+/**
+ * Builds the index.
+ *
+ * @param[in] points the points (all of the same dimension)
+ * @param[in] method the search method
+ *
+ * @throws value_error if the points have different dimensions or the method does not exist
+ */
+knn::knn(const std::vector<std::vector<double> > &points, method_type method):
+	m_n(points.size()), m_dim(points.empty() ? 0 : points[0].size()), m_method(method), m_data(m_n * m_dim), m_index(m_n)
+{
+	if (method != AUTO && method != KD_TREE && method != BRUTE_FORCE) {
+		pagmo_throw(value_error,"non existing search method");
+	}
+	for (population::size_type i = 0; i < m_n; ++i) {
+		if (points[i].size() != m_dim) {
+			pagmo_throw(value_error,"all the points must have the same dimension");
+		}
+		std::copy(points[i].begin(), points[i].end(), m_data.begin() + i * m_dim);
+		m_index[i] = i;
+	}
+	if (m_method == AUTO) {
+		m_method = (m_dim > 0 && m_dim <= max_kd_tree_dimension && m_n > 4 * leaf_size) ? KD_TREE : BRUTE_FORCE;
+	}
+	if (m_method == KD_TREE && m_n > 0) {
+		build(0, m_n);
+		// Store the points in the order of the leaves.
+		std::vector<double> sorted(m_data.size());
+		for (population::size_type i = 0; i < m_n; ++i) {
+			std::copy(m_data.begin() + m_index[i] * m_dim, m_data.begin() + (m_index[i] + 1) * m_dim, sorted.begin() + i * m_dim);
+		}
+		m_data.swap(sorted);
+	}
+}
+
+// Builds the subtree of the points m_index[begin, end), splitting at the median of the coordinate of largest spread.
+population::size_type knn::build(population::size_type begin, population::size_type end)
+{
+	const population::size_type id = m_nodes.size();
+	node nd;
+	nd.begin = begin;
+	nd.end = end;
+	nd.split_dim = 0;
+	nd.split_value = 0.;
+	nd.left = 0;
+	nd.right = 0;
+	m_nodes.push_back(nd);
+	if (end - begin <= leaf_size) {
+		return id;
+	}
+	double max_spread = 0.;
+	for (population::size_type j = 0; j < m_dim; ++j) {
+		double min = m_data[m_index[begin] * m_dim + j], max = min;
+		for (population::size_type i = begin + 1; i < end; ++i) {
+			min = std::min(min, m_data[m_index[i] * m_dim + j]);
+			max = std::max(max, m_data[m_index[i] * m_dim + j]);
+		}
+		if (max - min > max_spread) {
+			max_spread = max - min;
+			nd.split_dim = j;
+		}
+	}
+	// All the points are equal.
+	if (max_spread == 0.) {
+		return id;
+	}
+	const population::size_type mid = begin + (end - begin) / 2;
+	std::nth_element(m_index.begin() + begin, m_index.begin() + mid, m_index.begin() + end, coordinate_sorter(m_data, m_dim, nd.split_dim));
+	nd.split_value = m_data[m_index[mid] * m_dim + nd.split_dim];
+	nd.left = build(begin, mid);
+	nd.right = build(mid, end);
+	m_nodes[id] = nd;
+	return id;
+}
+
+// Adds to the max-heap of the k best candidates the ones of the subtree id.
+void knn::search(std::vector<candidate> &heap, const double *x, population::size_type k, population::size_type id) const
+{
+	const node &nd = m_nodes[id];
+	if (!nd.left) {
+		for (population::size_type i = nd.begin; i < nd.end; ++i) {
+			const candidate c(squared_distance(x, &m_data[i * m_dim], m_dim), m_index[i]);
+			if (heap.size() < k) {
+				heap.push_back(c);
+				std::push_heap(heap.begin(), heap.end());
+			} else if (c < heap.front()) {
+				std::pop_heap(heap.begin(), heap.end());
+				heap.back() = c;
+				std::push_heap(heap.begin(), heap.end());
+			}
+		}
+		return;
+	}
+	const double diff = x[nd.split_dim] - nd.split_value;
+	search(heap, x, k, diff <= 0. ? nd.left : nd.right);
+	// The points on the other side are at least |diff| away (ties must be visited, as they could have lower indices).
+	if (heap.size() < k || diff * diff <= heap.front().first) {
+		search(heap, x, k, diff <= 0. ? nd.right : nd.left);
+	}
+}
+
+void knn::query_kd_tree(std::vector<candidate> &retval, const double *x, population::size_type k) const
+{
+	retval.clear();
+	search(retval, x, k, 0);
+	std::sort(retval.begin(), retval.end());
+}
+
+// Selects the k best candidates of each query, as the rows of the distance matrix are completed.
+class knn::selector {
+public:
+	selector(std::vector<std::vector<candidate> > &retval, const std::vector<population::size_type> &index, population::size_type k):
+		m_retval(retval), m_index(index), m_k(k) {}
+	void operator()(const pairwise_distance::tile &t, unsigned int)
+	{
+		const population::size_type n = m_index.size();
+		m_rows.resize((t.row_end - t.row_begin) * n);
+		for (population::size_type i = t.row_begin; i < t.row_end; ++i) {
+			std::vector<candidate>::iterator row = m_rows.begin() + (i - t.row_begin) * n;
+			for (population::size_type j = t.col_begin; j < t.col_end; ++j) {
+				row[j] = candidate(t(i,j), m_index[j]);
+			}
+		}
+		// The tiles of a row block come by increasing columns.
+		if (t.col_end < n) {
+			return;
+		}
+		for (population::size_type i = t.row_begin; i < t.row_end; ++i) {
+			std::vector<candidate>::iterator row = m_rows.begin() + (i - t.row_begin) * n;
+			if (m_k < n) {
+				std::nth_element(row, row + m_k - 1, row + n);
+			}
+			std::sort(row, row + m_k);
+			m_retval[i].assign(row, row + m_k);
+		}
+	}
+private:
+	std::vector<std::vector<candidate> > &m_retval;
+	const std::vector<population::size_type> &m_index;
+	const population::size_type m_k;
+	std::vector<candidate> m_rows;
+};
+
+// Streams the distances from the queries to the points, and selects the k best candidates of each query.
+void knn::query_brute_force(std::vector<std::vector<candidate> > &retval, const double *queries, population::size_type n_queries, population::size_type k) const
+{
+	retval.resize(n_queries);
+	selector sel(retval, m_index, k);
+	pairwise_distance(queries, n_queries, m_data.empty() ? 0 : &m_data[0], m_n, m_dim).for_each_tile(sel);
+}
+
+void knn::output(std::vector<population::size_type> &idx, std::vector<double> &dist, std::vector<candidate> &candidates)
+{
+	idx.resize(candidates.size());
+	dist.resize(candidates.size());
+	for (population::size_type i = 0; i < candidates.size(); ++i) {
+		idx[i] = candidates[i].second;
+		dist[i] = std::sqrt(candidates[i].first);
+	}
+}
+
+/// Nearest neighbours of a point
+/**
+ * @param[out] idx indices of the k points closest to x, by increasing distance (and increasing index)
+ * @param[out] dist distances of those points from x
+ * @param[in] x the point
+ * @param[in] k number of neighbours (all the points if larger than their number)
+ *
+ * @throws value_error if the dimension of x is not the one of the points
+ */
+void knn::query(std::vector<population::size_type> &idx, std::vector<double> &dist, const std::vector<double> &x, population::size_type k) const
+{
+	if (x.size() != m_dim) {
+		pagmo_throw(value_error,"the query point must have the dimension of the points");
+	}
+	k = std::min(k, m_n);
+	std::vector<candidate> candidates;
+	if (k == 0) {
+	} else if (m_method == KD_TREE && 4 * k <= m_n) {
+		query_kd_tree(candidates, &x[0], k);
+	} else {
+		std::vector<std::vector<candidate> > rows;
+		query_brute_force(rows, x.empty() ? 0 : &x[0], 1, k);
+		candidates.swap(rows[0]);
+	}
+	output(idx, dist, candidates);
+}
+
+/// Nearest neighbours of all the points
+/**
+ * The neighbours of a point include the point itself.
+ *
+ * @param[out] idx idx[i] will contain the indices of the k points closest to the i-th point, by increasing distance (and increasing index)
+ * @param[out] dist dist[i] will contain the distances of those points from the i-th point
+ * @param[in] k number of neighbours (all the points if larger than their number)
+ */
+void knn::query_all(std::vector<std::vector<population::size_type> > &idx, std::vector<std::vector<double> > &dist, population::size_type k) const
+{
+	k = std::min(k, m_n);
+	idx.resize(m_n);
+	dist.resize(m_n);
+	if (k == 0) {
+		for (population::size_type i = 0; i < m_n; ++i) {
+			idx[i].clear();
+			dist[i].clear();
+		}
+	} else if (m_method == KD_TREE && 4 * k <= m_n) {
+		std::vector<candidate> candidates;
+		for (population::size_type i = 0; i < m_n; ++i) {
+			query_kd_tree(candidates, &m_data[i * m_dim], k);
+			output(idx[m_index[i]], dist[m_index[i]], candidates);
+		}
+	} else {
+		std::vector<std::vector<candidate> > rows;
+		query_brute_force(rows, m_data.empty() ? 0 : &m_data[0], m_n, k);
+		for (population::size_type i = 0; i < m_n; ++i) {
+			output(idx[m_index[i]], dist[m_index[i]], rows[i]);
+		}
+	}
+}
+
+/// Search method (never AUTO, which is resolved at construction)
+knn::method_type knn::get_method() const
+{
+	return m_method;
+}
+
+/// Number of points
+population::size_type knn::size() const
+{
+	return m_n;
+}
+
+/// Dimension of the points
+population::size_type knn::dimension() const
+{
+	return m_dim;
+}
+
+}}}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_KNN_H
+#define PAGMO_UTIL_KNN_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../config.h"
+#include "../population.h"
+#include "pairwise_distance.h"
+
+namespace pagmo{ namespace util { namespace neighbourhood {
+
+/// k-nearest-neighbours index
+/**
+ * Answers k-nearest-neighbours queries (according to the euclidian distance) on a fixed set of points. Neighbours are
+ * returned ordered by increasing distance, ties being broken by increasing index, so that the result does not depend on
+ * the method used: a kd-tree (for low dimensional points, e.g. fitness or weight vectors) or a blocked brute-force
+ * search (for high dimensional points, or when k is a large fraction of the number of points). Only the k nearest
+ * neighbours are sorted.
+ */
+class __PAGMO_VISIBLE knn {
+public:
+	/// Search method
+	enum method_type {
+		AUTO = 0, ///< Chosen according to the dimension and number of the points
+		KD_TREE = 1, ///< Kd-tree
+		BRUTE_FORCE = 2 ///< Blocked brute-force search
+	};
+	knn(const std::vector<std::vector<double> > &, method_type = AUTO);
+	void query(std::vector<population::size_type> &, std::vector<double> &, const std::vector<double> &, population::size_type) const;
+	void query_all(std::vector<std::vector<population::size_type> > &, std::vector<std::vector<double> > &, population::size_type) const;
+	method_type get_method() const;
+	population::size_type size() const;
+	population::size_type dimension() const;
+private:
+	// Candidate neighbour: squared distance and index.
+	typedef std::pair<double,population::size_type> candidate;
+	// Node of the kd-tree, holding the points m_data[begin, end) if it is a leaf (left == 0).
+	struct node {
+		population::size_type begin;
+		population::size_type end;
+		population::size_type split_dim;
+		double split_value;
+		population::size_type left;
+		population::size_type right;
+	};
+	population::size_type build(population::size_type, population::size_type);
+	void search(std::vector<candidate> &, const double *, population::size_type, population::size_type) const;
+	void query_kd_tree(std::vector<candidate> &, const double *, population::size_type) const;
+	class selector;
+	void query_brute_force(std::vector<std::vector<candidate> > &, const double *, population::size_type, population::size_type) const;
+	static void output(std::vector<population::size_type> &, std::vector<double> &, std::vector<candidate> &);
+	const population::size_type	m_n;
+	const population::size_type	m_dim;
+	method_type			m_method;
+	// Points stored contiguously (in the order of the leaves of the kd-tree, if any).
+	std::vector<double>		m_data;
+	// Original index of the points in m_data.
+	std::vector<population::size_type>	m_index;
+	std::vector<node>		m_nodes;
+};
+
+}}}
+
+#endif
@@ -6,6 +6,7 @@
 # include <ctime>
 # include <cstring>
 
+# include "knn.h"
 # include "neighbourhood.h"
 
 using namespace std;
@@ -18,13 +19,22 @@ namespace pagmo{ namespace util {namespace neighbourhood {
  * @param[in]  weights the vector of real vectors
  */
 void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &retval, const std::vector<std::vector<double> > &weights) {
-	for(unsigned int i = 0; i < weights.size(); ++i) {
-		std::vector<double> distances;
-		for(unsigned int j = 0; j < weights.size(); ++j) {
-			distances.push_back(distance(weights[i],weights[j]));
-		}
-		retval.push_back(order(distances));
-	}
+	compute_neighbours(retval, weights, weights.size());
+}
+
+/**
+ * Compute the neighbourhood graph restricted to the k closest vectors. At the end of the call retval[i][j] will contain the j-th closest vector
+ * (according to the euclidian distance, ties being broken by index) to the i-th vector, for j < k.
+ * @param[out] retval a matrix representing the neigborhood graph
+ * @param[in]  weights the vector of real vectors
+ * @param[in]  k the number of neighbours
+ * @see pagmo::util::neighbourhood::knn
+ */
+void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &retval, const std::vector<std::vector<double> > &weights, pagmo::population::size_type k) {
+	std::vector<std::vector<pagmo::population::size_type> > neighbours;
+	std::vector<std::vector<double> > distances;
+	knn(weights).query_all(neighbours, distances, k);
+	retval.insert(retval.end(), neighbours.begin(), neighbours.end());
 }
 
 /**
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <vector>
+
+#include "../exceptions.h"
+#include "pairwise_distance.h"
+
+namespace pagmo{ namespace util {
+
+const pairwise_distance::size_type pairwise_distance::row_block;
+const pairwise_distance::size_type pairwise_distance::col_block;
+// Number of columns processed together by compute_tile (col_block must be a multiple of it).
+static const pairwise_distance::size_type chunk = 4;
+
+// Copies the first dim coordinates of the points into a contiguous array (all the coordinates if dim is zero).
+static pairwise_distance::size_type flatten(std::vector<double> &retval, const std::vector<std::vector<double> > &points, pairwise_distance::size_type dim)
+{
+	if (dim == 0 && !points.empty()) {
+		dim = points[0].size();
+		for (pairwise_distance::size_type i = 0; i < points.size(); ++i) {
+			if (points[i].size() != dim) {
+				pagmo_throw(value_error,"all the points must have the same dimension");
+			}
+		}
+	}
+	retval.resize(points.size() * dim);
+	for (pairwise_distance::size_type i = 0; i < points.size(); ++i) {
+		if (points[i].size() < dim) {
+			pagmo_throw(value_error,"the points have less coordinates than requested");
+		}
+		std::copy(points[i].begin(), points[i].begin() + dim, retval.begin() + i * dim);
+	}
+	return dim;
+}
+
+/// Constructor from a single set of points
+/**
+ * The matrix is symmetric, rows and columns being the same points.
+ *
+ * @param[in] points the points
+ * @param[in] dim number of leading coordinates to be used (all of them if zero)
+ *
+ * @throws value_error if the points do not have dim coordinates (or have different dimensions, if dim is zero)
+ */
+pairwise_distance::pairwise_distance(const std::vector<std::vector<double> > &points, size_type dim):m_symmetric(true)
+{
+	std::vector<double> tmp;
+	m_dim = flatten(tmp, points, dim);
+	init(tmp.empty() ? 0 : &tmp[0], points.size(), tmp.empty() ? 0 : &tmp[0], points.size());
+}
+
+/// Constructor from two sets of points
+/**
+ * @param[in] rows the points corresponding to the rows of the matrix
+ * @param[in] cols the points corresponding to the columns of the matrix
+ * @param[in] dim number of leading coordinates to be used (all of them if zero)
+ *
+ * @throws value_error if the points do not have dim coordinates (or different dimensions, if dim is zero)
+ */
+pairwise_distance::pairwise_distance(const std::vector<std::vector<double> > &rows, const std::vector<std::vector<double> > &cols, size_type dim):m_symmetric(false)
+{
+	std::vector<double> tmp_rows, tmp_cols;
+	const size_type rows_dim = flatten(tmp_rows, rows, dim), cols_dim = flatten(tmp_cols, cols, dim);
+	if (!rows.empty() && !cols.empty() && rows_dim != cols_dim) {
+		pagmo_throw(value_error,"all the points must have the same dimension");
+	}
+	m_dim = rows.empty() ? cols_dim : rows_dim;
+	init(tmp_rows.empty() ? 0 : &tmp_rows[0], rows.size(), tmp_cols.empty() ? 0 : &tmp_cols[0], cols.size());
+}
+
+/// Constructor from contiguous arrays
+/**
+ * @param[in] rows the points corresponding to the rows of the matrix, stored one after the other
+ * @param[in] n_rows number of rows
+ * @param[in] cols the points corresponding to the columns of the matrix, stored one after the other
+ * @param[in] n_cols number of columns
+ * @param[in] dim dimension of the points
+ */
+pairwise_distance::pairwise_distance(const double *rows, size_type n_rows, const double *cols, size_type n_cols, size_type dim):
+	m_dim(dim),m_symmetric(false)
+{
+	init(rows, n_rows, cols, n_cols);
+}
+
+void pairwise_distance::init(const double *rows, size_type n_rows, const double *cols, size_type n_cols)
+{
+	m_n_rows = n_rows;
+	m_n_cols = n_cols;
+	m_rows.assign(rows, rows + n_rows * m_dim);
+	// Each block is padded to col_block columns, so that the innermost loop of compute_tile has a fixed length.
+	m_cols.assign(((n_cols + col_block - 1) / col_block) * col_block * m_dim, 0.);
+	for (size_type cb = 0; cb < n_cols; cb += col_block) {
+		const size_type width = std::min(col_block, n_cols - cb);
+		double *block = &m_cols[cb * m_dim];
+		for (size_type j = 0; j < width; ++j) {
+			for (size_type k = 0; k < m_dim; ++k) {
+				block[k * col_block + j] = cols[(cb + j) * m_dim + k];
+			}
+		}
+	}
+}
+
+/// Number of rows
+pairwise_distance::size_type pairwise_distance::get_n_rows() const
+{
+	return m_n_rows;
+}
+
+/// Number of columns
+pairwise_distance::size_type pairwise_distance::get_n_cols() const
+{
+	return m_n_cols;
+}
+
+/// Dimension of the points
+pairwise_distance::size_type pairwise_distance::get_dimension() const
+{
+	return m_dim;
+}
+
+/// True if rows and columns are the same points
+bool pairwise_distance::is_symmetric() const
+{
+	return m_symmetric;
+}
+
+/// Computes a tile of the matrix
+/**
+ * @param[out] out the (row_end - row_begin) x min(col_block, n_cols - col_begin) tile, stored by rows
+ * @param[in] row_begin first row
+ * @param[in] row_end one past the last row
+ * @param[in] col_begin first column (a multiple of col_block)
+ *
+ * @throws value_error if the tile is not within the matrix or col_begin is not a multiple of col_block
+ */
+void pairwise_distance::compute_tile(double *out, size_type row_begin, size_type row_end, size_type col_begin) const
+{
+	if (row_begin > row_end || row_end > m_n_rows || col_begin >= m_n_cols || col_begin % col_block) {
+		pagmo_throw(value_error,"invalid tile");
+	}
+	const size_type width = std::min(col_block, m_n_cols - col_begin);
+	const double *block = &m_cols[col_begin * m_dim];
+	// Pairs of rows are processed against chunks of columns, so that the loads of the columns are shared and the
+	// accumulators stay in registers. The loop over the chunk has a fixed length, so that it is vectorised.
+	for (size_type i = row_begin; i < row_end; i += 2) {
+		// An odd last row is paired with itself.
+		const size_type i1 = std::min(i + 1, row_end - 1);
+		const double *x0 = &m_rows[i * m_dim], *x1 = &m_rows[i1 * m_dim];
+		double *out0 = out + (i - row_begin) * width, *out1 = out + (i1 - row_begin) * width;
+		for (size_type jb = 0; jb < width; jb += chunk) {
+			double a0 = 0., a1 = 0., a2 = 0., a3 = 0., b0 = 0., b1 = 0., b2 = 0., b3 = 0.;
+			for (size_type k = 0; k < m_dim; ++k) {
+				const double x0k = x0[k], x1k = x1[k];
+				const double *ck = block + k * col_block + jb;
+				const double c0 = ck[0], c1 = ck[1], c2 = ck[2], c3 = ck[3];
+				a0 += (x0k - c0) * (x0k - c0);
+				a1 += (x0k - c1) * (x0k - c1);
+				a2 += (x0k - c2) * (x0k - c2);
+				a3 += (x0k - c3) * (x0k - c3);
+				b0 += (x1k - c0) * (x1k - c0);
+				b1 += (x1k - c1) * (x1k - c1);
+				b2 += (x1k - c2) * (x1k - c2);
+				b3 += (x1k - c3) * (x1k - c3);
+			}
+			const double acc0[chunk] = {a0, a1, a2, a3}, acc1[chunk] = {b0, b1, b2, b3};
+			const size_type n = std::min(chunk, width - jb);
+			std::copy(acc0, acc0 + n, out0 + jb);
+			std::copy(acc1, acc1 + n, out1 + jb);
+		}
+	}
+}
+
+// Gathers the tiles into a matrix.
+class pairwise_distance::matrix_task {
+public:
+	matrix_task(std::vector<std::vector<double> > &retval, bool symmetric):m_retval(retval),m_symmetric(symmetric) {}
+	void operator()(const tile &t, unsigned int)
+	{
+		for (size_type i = t.row_begin; i < t.row_end; ++i) {
+			// In the symmetric case each row block fills its part of the upper triangle and its mirror image, so
+			// that different workers never write the same entry.
+			for (size_type j = m_symmetric ? std::max(i, t.col_begin) : t.col_begin; j < t.col_end; ++j) {
+				m_retval[i][j] = t(i,j);
+				if (m_symmetric) {
+					m_retval[j][i] = t(i,j);
+				}
+			}
+		}
+	}
+private:
+	std::vector<std::vector<double> > &m_retval;
+	const bool m_symmetric;
+};
+
+/// Full squared distance matrix
+/**
+ * @param[out] retval retval[i][j] will contain the squared distance between the i-th row and the j-th column
+ * @param[in] n_threads maximum number of threads to be used
+ */
+void pairwise_distance::matrix(std::vector<std::vector<double> > &retval, unsigned int n_threads) const
+{
+	retval.resize(m_n_rows);
+	for (size_type i = 0; i < m_n_rows; ++i) {
+		retval[i].resize(m_n_cols);
+	}
+	matrix_task task(retval, m_symmetric);
+	for_each_tile(task, n_threads);
+}
+
+// Keeps the largest entry seen by each worker.
+class pairwise_distance::max_task {
+public:
+	max_task(unsigned int n_threads):m_max(n_threads, 0.) {}
+	void operator()(const tile &t, unsigned int worker_idx)
+	{
+		const size_type size = (t.row_end - t.row_begin) * (t.col_end - t.col_begin);
+		// Independent partial maxima, which the compiler can keep in vector registers.
+		double m[4] = {m_max[worker_idx], 0., 0., 0.};
+		size_type i = 0;
+		for (; i + 4 <= size; i += 4) {
+			for (size_type j = 0; j < 4; ++j) {
+				m[j] = t.values[i + j] > m[j] ? t.values[i + j] : m[j];
+			}
+		}
+		for (; i < size; ++i) {
+			m[0] = t.values[i] > m[0] ? t.values[i] : m[0];
+		}
+		m_max[worker_idx] = std::max(std::max(m[0], m[1]), std::max(m[2], m[3]));
+	}
+	double get() const
+	{
+		return *std::max_element(m_max.begin(), m_max.end());
+	}
+private:
+	std::vector<double> m_max;
+};
+
+/// Largest squared distance
+/**
+ * The matrix is streamed, and never stored.
+ *
+ * @param[in] n_threads maximum number of threads to be used
+ *
+ * @return the largest entry of the matrix (zero if it is empty).
+ */
+double pairwise_distance::max(unsigned int n_threads) const
+{
+	max_task task(std::max(n_threads, 1u));
+	for_each_tile(task, n_threads);
+	return task.get();
+}
+
+}}
@@ -0,0 +1,139 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_PAIRWISE_DISTANCE_H
+#define PAGMO_UTIL_PAIRWISE_DISTANCE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "parallel.h"
+
+namespace pagmo{ namespace util {
+
+/// Pairwise squared distances
+/**
+ * Computes the squared euclidian distances between the points of two sets (the rows and the columns of the distance
+ * matrix), or among the points of a single set. The matrix is produced in tiles of at most row_block x col_block entries,
+ * which can be streamed to a functor (e.g., to reduce them without ever storing the full matrix) or gathered into a
+ * full matrix. Row blocks can be processed by several threads.
+ *
+ * The columns are stored transposed, one block at a time, so that the innermost loop runs over contiguous columns and is
+ * vectorised by the compiler. Each distance is still accumulated coordinate by coordinate, hence it is bitwise identical
+ * to the one computed by the naive loop.
+ */
+class __PAGMO_VISIBLE pairwise_distance {
+public:
+	typedef std::vector<double>::size_type size_type;
+	/// Maximum number of rows of a tile
+	static const size_type row_block = 64;
+	/// Maximum number of columns of a tile
+	static const size_type col_block = 256;
+	/// Tile of the squared distance matrix
+	/**
+	 * Entries (i,j), with i in [row_begin, row_end) and j in [col_begin, col_end), stored by rows.
+	 */
+	struct tile {
+		/// First row
+		size_type row_begin;
+		/// One past the last row
+		size_type row_end;
+		/// First column
+		size_type col_begin;
+		/// One past the last column
+		size_type col_end;
+		/// Values
+		const double *values;
+		/// Squared distance between the i-th row and the j-th column
+		double operator()(size_type i, size_type j) const {
+			return values[(i - row_begin) * (col_end - col_begin) + (j - col_begin)];
+		}
+	};
+	pairwise_distance(const std::vector<std::vector<double> > &, size_type = 0);
+	pairwise_distance(const std::vector<std::vector<double> > &, const std::vector<std::vector<double> > &, size_type = 0);
+	pairwise_distance(const double *, size_type, const double *, size_type, size_type);
+	size_type get_n_rows() const;
+	size_type get_n_cols() const;
+	size_type get_dimension() const;
+	bool is_symmetric() const;
+	void compute_tile(double *, size_type, size_type, size_type) const;
+	void matrix(std::vector<std::vector<double> > &, unsigned int = 1) const;
+	double max(unsigned int = 1) const;
+	/// Streams the tiles of the matrix to a functor
+	/**
+	 * f is invoked as f(t, worker_idx) for each tile t, where worker_idx is the one of pagmo::util::parallel::for_each_index.
+	 * The tiles of a row block are all visited by the same worker, by increasing columns. If the matrix is symmetric only
+	 * the tiles containing entries (i,j) with j >= i are visited.
+	 *
+	 * @param[in] f functor to be invoked.
+	 * @param[in] n_threads maximum number of threads to be used (one row block per task).
+	 */
+	template <class F>
+	void for_each_tile(F &f, unsigned int n_threads = 1) const
+	{
+		tile_task<F> task(*this, f);
+		parallel::for_each_index((m_n_rows + row_block - 1) / row_block, n_threads, task);
+	}
+private:
+	template <class F>
+	class tile_task {
+	public:
+		tile_task(const pairwise_distance &d, F &f):m_d(d),m_f(f) {}
+		void operator()(std::size_t rb, unsigned int worker_idx)
+		{
+			tile t;
+			t.row_begin = rb * row_block;
+			t.row_end = std::min(t.row_begin + row_block, m_d.m_n_rows);
+			std::vector<double> values((t.row_end - t.row_begin) * col_block);
+			t.values = &values[0];
+			// In the symmetric case start from the column block containing the diagonal.
+			for (t.col_begin = m_d.m_symmetric ? t.row_begin - t.row_begin % col_block : 0; t.col_begin < m_d.m_n_cols; t.col_begin += col_block) {
+				t.col_end = std::min(t.col_begin + col_block, m_d.m_n_cols);
+				m_d.compute_tile(&values[0], t.row_begin, t.row_end, t.col_begin);
+				m_f(static_cast<const tile &>(t), worker_idx);
+			}
+		}
+	private:
+		const pairwise_distance &m_d;
+		F &m_f;
+	};
+	class matrix_task;
+	class max_task;
+	void init(const double *, size_type, const double *, size_type);
+
+	size_type		m_n_rows;
+	size_type		m_n_cols;
+	size_type		m_dim;
+	bool			m_symmetric;
+	// Rows, stored by rows.
+	std::vector<double>	m_rows;
+	// Columns, stored transposed by blocks of col_block columns.
+	std::vector<double>	m_cols;
+};
+
+}}
+
+#endif
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_PARALLEL_H
+#define PAGMO_UTIL_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../config.h"
+#include "../exceptions.h"
+
+namespace pagmo { namespace util {
+
+/// Parallel execution utilities.
+/**
+ * Helpers to distribute independent tasks (e.g., fitness evaluations or full evolutions)
+ * over a pool of boost threads.
+ */
+namespace parallel {
+
+//! @cond
+// Worker pulling task indices from a shared counter until all tasks are consumed
+// or one of the tasks has failed.
+template <class F>
+class index_worker
+{
+	public:
+		index_worker(F &f, const std::size_t &n_tasks, std::size_t &next, boost::mutex &mutex, std::string &error, const unsigned int &worker_idx):
+			m_f(f),m_n_tasks(n_tasks),m_next(next),m_mutex(mutex),m_error(error),m_worker_idx(worker_idx) {}
+		void operator()()
+		{
+			while (true) {
+				std::size_t task;
+				{
+					boost::lock_guard<boost::mutex> lock(m_mutex);
+					if (!m_error.empty() || m_next >= m_n_tasks) {
+						return;
+					}
+					task = m_next++;
+				}
+				try {
+					m_f(task,m_worker_idx);
+				} catch (const std::exception &e) {
+					set_error(e.what());
+					return;
+				} catch (...) {
+					set_error("unknown exception caught in parallel task");
+					return;
+				}
+			}
+		}
+	private:
+		void set_error(const std::string &msg)
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			if (m_error.empty()) {
+				m_error = msg;
+			}
+		}
+		F		&m_f;
+		std::size_t	m_n_tasks;
+		std::size_t	&m_next;
+		boost::mutex	&m_mutex;
+		std::string	&m_error;
+		unsigned int	m_worker_idx;
+};
+//! @endcond
+
+/// Execute n_tasks independent tasks on a pool of threads.
+/**
+ * The functor f is invoked as f(task_idx, worker_idx) exactly once for each task_idx in [0, n_tasks).
+ * worker_idx lies in [0, n_threads) and can be used to address per-thread state (e.g., problem or algorithm
+ * clones), as no two concurrent invocations share the same worker_idx. Tasks are handed out dynamically, so
+ * results are independent of the thread count only if each task depends on its index alone.
+ *
+ * If n_threads is 1 (or there is at most one task) everything runs in the calling thread.
+ *
+ * @param[in] n_tasks number of tasks.
+ * @param[in] n_threads maximum number of threads to be used.
+ * @param[in] f functor to be invoked.
+ *
+ * @throws value_error if n_threads is zero.
+ * @throws std::runtime_error if any of the tasks threw, carrying the message of the first failure.
+ */
+template <class F>
+inline void for_each_index(const std::size_t &n_tasks, const unsigned int &n_threads, F &f)
+{
+	if (n_threads == 0) {
+		pagmo_throw(value_error,"the number of threads must be strictly positive");
+	}
+	const std::size_t n_workers = std::min<std::size_t>(n_threads,n_tasks);
+	if (n_workers <= 1) {
+		for (std::size_t i = 0; i < n_tasks; ++i) {
+			f(i,0u);
+		}
+		return;
+	}
+	std::size_t next = 0;
+	boost::mutex mutex;
+	std::string error;
+	boost::thread_group pool;
+	try {
+		for (std::size_t i = 0; i < n_workers; ++i) {
+			pool.create_thread(index_worker<F>(f,n_tasks,next,mutex,error,static_cast<unsigned int>(i)));
+		}
+	} catch (...) {
+		{
+			boost::lock_guard<boost::mutex> lock(mutex);
+			error = "failed to launch the thread";
+		}
+		pool.join_all();
+		pagmo_throw(std::runtime_error,error);
+	}
+	pool.join_all();
+	if (!error.empty()) {
+		pagmo_throw(std::runtime_error,error);
+	}
+}
+
+}}}
+
+#endif
@@ -142,18 +142,26 @@ void standard::setup(const std::vector<problem::base_ptr> &probs, const std::vec
 }
 
 /// Copy Constructor. Performs a deep copy
+/**
+ * Algorithms and problems are cloned as well, so that copies can be
+ * evaluated concurrently from different threads.
+ */
 standard::standard(const standard &standard_copy):
 	base_stochastic(1, 1, standard_copy.get_f_dimension(),
 			standard_copy.get_c_dimension(),
 			standard_copy.get_ic_dimension(), 0, standard_copy.m_seed),
-	m_algos(standard_copy.m_algos),
-	m_probs(standard_copy.m_probs),
 	m_pop_size(standard_copy.m_pop_size),
 	m_is_first_evaluation(standard_copy.m_is_first_evaluation),
 	m_database_seed(standard_copy.m_database_seed),
 	m_database_f(standard_copy.m_database_f),
 	m_database_c(standard_copy.m_database_c)
 {
+	for(unsigned int i = 0; i < standard_copy.m_algos.size(); i++){
+		m_algos.push_back(standard_copy.m_algos[i]->clone());
+	}
+	for(unsigned int i = 0; i < standard_copy.m_probs.size(); i++){
+		m_probs.push_back(standard_copy.m_probs[i]->clone());
+	}
 	set_bounds(standard_copy.get_lb(), standard_copy.get_ub());
 }
 
@@ -265,13 +273,19 @@ void standard::evaluate_algorithm(unsigned int algo_idx) const
  * @param[in] prob The problem to be considered
  * @param[in] pop_size The size of the population that the algorithms will be evolving
  * @param[in] seed Seed to be used in racing mechanisms
+ * @param[in] n_threads Number of threads used to evolve the algorithms during each racing iteration
+ *
+ * @throws value_error if n_threads is zero
  */
-race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const problem::base &prob, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed)
+race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const problem::base &prob, unsigned int pop_size, unsigned int seed, unsigned int n_threads): m_pop_size(pop_size), m_seed(seed), m_n_threads(n_threads)
 {
 	for(unsigned int i = 0; i < algos.size(); i++){
 		m_algos.push_back(algos[i]->clone());
 	}
 	m_probs.push_back(prob.clone());
+	if(n_threads == 0){
+		pagmo_throw(value_error, "The number of threads must be strictly positive");
+	}
 }
 
 /// Constructor of the racing mechanism for algorithms
@@ -282,8 +296,11 @@ race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const proble
  * @param[in] probs The set of problems to be considered
  * @param[in] pop_size The size of the population that the algorithms will be evolving
  * @param[in] seed Seed to be used in racing mechanisms
+ * @param[in] n_threads Number of threads used to evolve the algorithms during each racing iteration
+ *
+ * @throws value_error if n_threads is zero
  */
-race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &probs, unsigned int pop_size, unsigned int seed): m_pop_size(pop_size), m_seed(seed)
+race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &probs, unsigned int pop_size, unsigned int seed, unsigned int n_threads): m_pop_size(pop_size), m_seed(seed), m_n_threads(n_threads)
 {
 	for(unsigned int i = 0; i < algos.size(); i++){
 		m_algos.push_back(algos[i]->clone());
@@ -291,6 +308,9 @@ race_algo::race_algo(const std::vector<algorithm::base_ptr> &algos, const std::v
 	for(unsigned int i = 0; i < probs.size(); i++){
 		m_probs.push_back(probs[i]->clone());
 	}
+	if(n_threads == 0){
+		pagmo_throw(value_error, "The number of threads must be strictly positive");
+	}
 }
 
 /// Juice of racing mechanisms for algorithms
@@ -331,7 +351,7 @@ std::pair<std::vector<unsigned int>, unsigned int> race_algo::run(
 	// Construct an internal population, such that the winners of the race in
 	// this population corresponds to the winning algorithm
 	metrics_algos::standard metrics(m_probs, m_algos, m_seed, m_pop_size);
-	population algos_pop(metrics);
+	population algos_pop(metrics, 0, m_seed);
 	for(unsigned int i = 0; i < m_algos.size(); i++){
 		decision_vector algo_idx(1);
 		algo_idx[0] = i;
@@ -344,10 +364,15 @@ std::pair<std::vector<unsigned int>, unsigned int> race_algo::run(
 		pop_race_active_set[i] = active_set[i];
 	}
 
-	// Run the actual race
+	// Run the actual race. The racing seed is derived from m_seed only, and
+	// the algorithms still in the race at each iteration are evolved
+	// concurrently (each thread works on its own clone of the meta-problem).
+	// Algorithms eliminated by the statistical test are not evolved any more.
+	race_pop algos_race(algos_pop, m_seed);
+	algos_race.set_n_threads(m_n_threads);
 	std::pair<std::vector<population::size_type>, unsigned int> res =
-	    algos_pop.race(n_final, min_trials, max_count, delta,
-	                   pop_race_active_set, race_best, screen_output);
+	    algos_race.run(n_final, min_trials, max_count, delta,
+	                   pop_race_active_set, race_pop::MAX_BUDGET, race_best, screen_output);
 
 	// Convert the result to the algo's context
 	std::pair<std::vector<unsigned int>, unsigned int> res_algo_race;
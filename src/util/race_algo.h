@@ -42,12 +42,18 @@ namespace pagmo { namespace util { namespace racing {
  * This class allows the racing of a set of algorithms on a problem or a set of
  * problems. It supports the racing over single objective box-constrained and
  * equality / inequality constrained problems.
+ *
+ * Within each racing iteration the algorithms still in the race are
+ * evolved independently of each other, so their evolutions can be
+ * performed concurrently on a pool of threads. Every evolution is seeded
+ * only by the racing seed, hence the outcome of the race does not depend on
+ * the number of threads used.
  */
 class __PAGMO_VISIBLE race_algo
 {
 	public:
-		race_algo(const std::vector<algorithm::base_ptr> &algos = std::vector<algorithm::base_ptr>(), const problem::base &prob = problem::ackley(), unsigned int pop_size = 100, unsigned int seed = 0);
-		race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &prob, unsigned int pop_size = 100, unsigned int seed = 0);
+		race_algo(const std::vector<algorithm::base_ptr> &algos = std::vector<algorithm::base_ptr>(), const problem::base &prob = problem::ackley(), unsigned int pop_size = 100, unsigned int seed = 0, unsigned int n_threads = 1);
+		race_algo(const std::vector<algorithm::base_ptr> &algos, const std::vector<problem::base_ptr> &prob, unsigned int pop_size = 100, unsigned int seed = 0, unsigned int n_threads = 1);
 
 		// Main method containing all the juice
 		std::pair<std::vector<unsigned int>, unsigned int> run(
@@ -66,6 +72,7 @@ class __PAGMO_VISIBLE race_algo
 		std::vector<problem::base_ptr> m_probs;
 		unsigned int m_pop_size;
 		unsigned int m_seed;
+		unsigned int m_n_threads;
 };
 
 }}}
@@ -1,4 +1,5 @@
 #include "race_pop.h"
+#include "batch_evaluator.h"
 #include "../problems.h"
 #include "../problem/base_stochastic.h"
 
@@ -15,7 +16,7 @@ namespace pagmo { namespace util { namespace racing {
  * @param[in] pop population containing the individuals to race
  * @param[in] seed seed of the race
  */
-race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed), m_pop(pop), m_pop_wilcoxon(pop), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(pop.size()), m_cache_averaged_data(pop.size())
+race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed), m_pop(pop), m_pop_wilcoxon(pop), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(pop.size()), m_cache_averaged_data(pop.size()), m_n_threads(1)
 {
 	register_population(pop);
 }
@@ -28,7 +29,7 @@ race_pop::race_pop(const population& pop, unsigned int seed): m_race_seed(seed),
  *
  * @param[in] seed seed of the race
  */
-race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(problem::ackley())), m_pop_wilcoxon(population(problem::ackley())), m_pop_registered(false), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(0), m_cache_averaged_data(0)
+race_pop::race_pop(unsigned int seed): m_race_seed(seed), m_pop(population(problem::ackley())), m_pop_wilcoxon(population(problem::ackley())), m_pop_registered(false), m_seeds(), m_seeder(seed), m_use_caching(true), m_cache_data(0), m_cache_averaged_data(0), m_n_threads(1)
 {
 }
 
@@ -162,8 +163,7 @@ std::vector<population::size_type> race_pop::construct_output_list(
 // @return The number of objective function calls made
 unsigned int race_pop::prepare_population_friedman(const std::vector<population::size_type>& in_race, unsigned int count_iter)
 {
-	unsigned int count_nfes = 0;
-	// Perform re-evaluation on necessary individuals under current seed
+	std::vector<population::size_type> to_evaluate;
 	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
 		// Case 1: Current racer has previous data that can be reused, no
 		// need to be evaluated with this seed
@@ -171,19 +171,23 @@ unsigned int race_pop::prepare_population_friedman(const std::vector<population:
 			const eval_data& cached_data = cache_get_entry(*it, count_iter-1);
 			m_pop.set_fc(*it, cached_data.f, cached_data.c);
 		}
-		// Case 2: No previous data can be reused, perform actual
-		// re-evaluation and update the cache
+		// Case 2: No previous data can be reused, actual re-evaluation
+		// is needed
 		else{
-			count_nfes++;
-			const population::individual_type &ind = m_pop.get_individual(*it);
-			fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-			constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
-			m_pop.set_fc(*it, f_vec, c_vec);
-			if(m_use_caching)
-				cache_insert_data(*it, f_vec, c_vec);
+			to_evaluate.push_back(*it);
 		}
 	}
-	return count_nfes;
+	// Perform re-evaluation on necessary individuals under current seed,
+	// then update the cache
+	std::vector<fitness_vector> f_vecs;
+	std::vector<constraint_vector> c_vecs;
+	evaluate_batch(to_evaluate, f_vecs, c_vecs);
+	for(unsigned int i = 0; i < to_evaluate.size(); i++){
+		m_pop.set_fc(to_evaluate[i], f_vecs[i], c_vecs[i]);
+		if(m_use_caching)
+			cache_insert_data(to_evaluate[i], f_vecs[i], c_vecs[i]);
+	}
+	return to_evaluate.size();
 }
 
 /// Update m_pop_wilcoxon to contain evaluation data required for Wilcoxon test
@@ -194,7 +198,6 @@ unsigned int race_pop::prepare_population_friedman(const std::vector<population:
  **/
 unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population::size_type>& in_race, unsigned int count_iter)
 {
-	unsigned int count_nfes = 0;
 	if(in_race.size() != 2){
 		pagmo_throw(value_error, "Wilcoxon rank sum test is only applicable when there are two active individuals");
 	}	
@@ -211,33 +214,75 @@ unsigned int race_pop::prepare_population_wilcoxon(const std::vector<population:
 	else{
 		start_count_iter = count_iter;
 	}
+	// Evaluate in one batch all the data points which cannot be reused from
+	// the cache, then append all the data points in order
+	std::vector<population::size_type> to_evaluate;
+	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
+		for(unsigned int i = start_count_iter; i <= count_iter; i++){
+			if(!(m_use_caching && cache_data_exist(*it, i-1))){
+				to_evaluate.push_back(*it);
+			}
+		}
+	}
+	std::vector<fitness_vector> f_vecs;
+	std::vector<constraint_vector> c_vecs;
+	evaluate_batch(to_evaluate, f_vecs, c_vecs);
+
+	unsigned int count_nfes = 0;
 	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); ++it) {
 		decision_vector dummy_x;
 		for(unsigned int i = start_count_iter; i <= count_iter; i++){
+			m_pop_wilcoxon.push_back_noeval(dummy_x);
 			// Case 1: Current racer has previous data that can be reused, no
 			// need to be evaluated with this seed
 			if(m_use_caching && cache_data_exist(*it, i-1)){
-				m_pop_wilcoxon.push_back_noeval(dummy_x);
 				const eval_data& cached_data = cache_get_entry(*it, i-1);
 				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, cached_data.f, cached_data.c);
 			}
-			// Case 2: No previous data can be reused, perform actual
-			// re-evaluation and update the cache
+			// Case 2: No previous data can be reused, use the fresh
+			// evaluation and update the cache
 			else{
-				count_nfes++;
-				const population::individual_type &ind = m_pop.get_individual(*it);
-				fitness_vector f_vec = m_pop.problem().objfun(ind.cur_x);
-				constraint_vector c_vec = m_pop.problem().compute_constraints(ind.cur_x);
-				m_pop_wilcoxon.push_back_noeval(dummy_x);
-				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, f_vec, c_vec);
+				m_pop_wilcoxon.set_fc(m_pop_wilcoxon.size()-1, f_vecs[count_nfes], c_vecs[count_nfes]);
 				if(m_use_caching)
-					cache_insert_data(*it, f_vec, c_vec);
+					cache_insert_data(*it, f_vecs[count_nfes], c_vecs[count_nfes]);
+				count_nfes++;
 			}
 		}
 	}
 	return count_nfes;
 }
 
+/// Evaluates a batch of individuals under the current seed
+/**
+ * If more than one thread is allowed (see set_n_threads()), the evaluations
+ * are distributed over a pool of threads, each working on its own clone of
+ * the problem, and the results are returned in the same order as the input
+ * indices. As the problem is evaluated with the same seed by all the
+ * threads, the outcome does not depend on the number of threads.
+ *
+ * @param[in] idx Indices of the individuals to be evaluated
+ * @param[out] f_vecs Fitness vectors, aligned with idx
+ * @param[out] c_vecs Constraint vectors, aligned with idx
+ */
+void race_pop::evaluate_batch(const std::vector<population::size_type> &idx, std::vector<fitness_vector> &f_vecs, std::vector<constraint_vector> &c_vecs) const
+{
+	f_vecs.resize(idx.size());
+	c_vecs.resize(idx.size());
+	if(m_n_threads <= 1 || idx.size() <= 1){
+		for(unsigned int i = 0; i < idx.size(); i++){
+			const population::individual_type &ind = m_pop.get_individual(idx[i]);
+			f_vecs[i] = m_pop.problem().objfun(ind.cur_x);
+			c_vecs[i] = m_pop.problem().compute_constraints(ind.cur_x);
+		}
+		return;
+	}
+	std::vector<decision_vector> x(idx.size());
+	for(unsigned int i = 0; i < idx.size(); i++){
+		x[i] = m_pop.get_individual(idx[i]).cur_x;
+	}
+	batch_evaluator(m_pop.problem(), std::min<unsigned int>(m_n_threads, idx.size())).evaluate(x, f_vecs, c_vecs);
+}
+
 /// Computes the required number of actual fevals to complete the current iteration
 /*
  * This function takes into account the existence of cache. For example, if the
@@ -700,6 +745,30 @@ void race_pop::set_seed(unsigned int seed)
 	reset_cache();
 }
 
+/// Set the number of threads used to evaluate the racers.
+/**
+ * During each racing iteration the individuals which need to be
+ * re-evaluated under the new seed are evaluated concurrently using up to
+ * n_threads threads. The race outcome is not affected.
+ *
+ * @param[in] n_threads Maximum number of threads (1 means serial evaluation)
+ *
+ * @throws value_error if n_threads is zero
+ */
+void race_pop::set_n_threads(unsigned int n_threads)
+{
+	if(n_threads == 0){
+		pagmo_throw(value_error, "The number of threads must be strictly positive");
+	}
+	m_n_threads = n_threads;
+}
+
+/// Get the number of threads used to evaluate the racers.
+unsigned int race_pop::get_n_threads() const
+{
+	return m_n_threads;
+}
+
 // Produce new seeds and append to the list of seeds
 void race_pop::generate_seeds(unsigned int num_seeds)
 {
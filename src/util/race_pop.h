@@ -88,6 +88,8 @@ public:
 	void inherit_memory(const race_pop&);
 	std::vector<fitness_vector> get_mean_fitness(const std::vector<population::size_type> &active_set = std::vector<population::size_type>()) const;
 	void set_seed(unsigned int);
+	void set_n_threads(unsigned int);
+	unsigned int get_n_threads() const;
 
 private:
 	// Helper methods to validate input data
@@ -101,6 +103,8 @@ private:
 
 	unsigned int compute_required_fevals(const std::vector<population::size_type>& in_race, unsigned int num_iter) const;
 
+	void evaluate_batch(const std::vector<population::size_type> &, std::vector<fitness_vector> &, std::vector<constraint_vector> &) const;
+
 	// Atoms of the cache
 	struct eval_data
 	{
@@ -140,6 +144,7 @@ private:
 	std::vector<std::vector<eval_data> > m_cache_data;
 	std::vector<eval_data> m_cache_averaged_data;
 	std::vector<decision_vector> m_cache_signatures;
+	unsigned int m_n_threads;
 };
 
 }}}
@@ -5,6 +5,7 @@
 #include <boost/math/distributions/students_t.hpp>
 #include <boost/math/distributions/normal.hpp>
 
+#include <algorithm>
 #include <utility>
 
 namespace pagmo{ namespace util{
@@ -130,43 +131,50 @@ void racing_population::push_back_noeval(const decision_vector &x)
 }
 
 
-/// Returns the ``rankings" of the individuals.
-/**
- * The rankings are obtained using get_best_idx() in the base population class.
- * The rankings are further processed to cater for possible ties, which is a
- * step typically required by ranking-based statistical testing.
- **/
-std::vector<double> racing_population::get_rankings() const
+namespace {
+
+// Comparison of two individuals of a racing population, single objective
+// case. Only the fitness and constraint vectors are used. Individuals are
+// addressed by their position in idx, so that a subset of the population
+// can be compared as if it was a population on its own.
+struct racing_fc_comparator
 {
-	std::vector<double> rankings(size());
-	std::vector<size_type> raw_order = get_best_idx(size());
+	racing_fc_comparator(const population &pop, const std::vector<population::size_type> &idx): m_pop(pop), m_idx(idx) { }
+	bool operator()(population::size_type pos1, population::size_type pos2) const
+	{
+		const population::individual_type &i1 = m_pop.get_individual(m_idx[pos1]);
+		const population::individual_type &i2 = m_pop.get_individual(m_idx[pos2]);
+		return m_pop.problem().compare_fc(i1.cur_f, i1.cur_c, i2.cur_f, i2.cur_c);
+	}
+	const population &m_pop;
+	const std::vector<population::size_type> &m_idx;
+};
+
+// Turns the order of some individuals (best first) into their rankings,
+// processed to cater for possible ties.
+template <class Comparator>
+std::vector<double> order_to_rankings(const std::vector<population::size_type> &raw_order, const Comparator &comparator)
+{
+	typedef population::size_type size_type;
+	const size_type size = raw_order.size();
 
+	std::vector<double> rankings(size);
 	int cur_rank = 1;
 	for(size_type i = 0; i < raw_order.size(); i++){
 		int ind_idx = raw_order[i];
 		rankings[ind_idx] = cur_rank;
 		cur_rank++;
 	}
-	
+	if(size < 2){
+		return rankings;
+	}
+
 	// --Adjust ranking to cater for ties--
 	// 1. Check consecutively ranked individuals whether they are tied.
-	std::vector<bool> tied(size() - 1, false);
-	if(problem().get_f_dimension() == 1){
-		// Single-objective case
-		population::trivial_comparison_operator comparator(*this);
-		for(size_type i = 0; i < size() - 1; i++){	
-			if (!comparator(i, i+1) && !comparator(i+1, i)){
-				tied[i] = true;
-			}
-		}
-	}	
-	else{
-		// Multi-objective case
-		population::crowded_comparison_operator comparator(*this);
-		for(size_type i = 0; i < size() - 1; i++){	
-			if (!comparator(i, i+1) && !comparator(i+1, i)){
-				tied[i] = true;
-			}
+	std::vector<bool> tied(size - 1, false);
+	for(size_type i = 0; i < size - 1; i++){	
+		if (!comparator(i, i+1) && !comparator(i+1, i)){
+			tied[i] = true;
 		}
 	}
 
@@ -199,6 +207,95 @@ std::vector<double> racing_population::get_rankings() const
 	return rankings;
 }
 
+}
+
+/// Returns the ``rankings" of the individuals.
+/**
+ * The rankings are obtained using get_best_idx() in the base population class.
+ * The rankings are further processed to cater for possible ties, which is a
+ * step typically required by ranking-based statistical testing.
+ **/
+std::vector<double> racing_population::get_rankings() const
+{
+	std::vector<size_type> raw_order = get_best_idx(size());
+	if(problem().get_f_dimension() == 1){
+		// Single-objective case
+		return order_to_rankings(raw_order, population::trivial_comparison_operator(*this));
+	}	
+	else{
+		// Multi-objective case
+		return order_to_rankings(raw_order, population::crowded_comparison_operator(*this));
+	}
+}
+
+
+namespace {
+
+// Orders the positions of some ranks from the best to the worst one.
+struct rank_comparator
+{
+	rank_comparator(const std::vector<double> &ranks): m_ranks(ranks) { }
+	bool operator()(population::size_type pos1, population::size_type pos2) const
+	{
+		return m_ranks[pos1] < m_ranks[pos2];
+	}
+	const std::vector<double> &m_ranks;
+};
+
+// Removes racer i from the links of trial j.
+void unlink_racer(std::vector<racer_type> &racers, unsigned int j, population::size_type i)
+{
+	const population::size_type prev = racers[i].m_prev[j], next = racers[i].m_next[j];
+	if(prev != i){
+		racers[prev].m_next[j] = (next == i ? prev : next);
+	}
+	if(next != i){
+		racers[next].m_prev[j] = (prev == i ? next : prev);
+	}
+	racers[i].m_prev[j] = racers[i].m_next[j] = i;
+}
+
+// Links the unlinked racer i just before racer pos in trial j.
+void link_racer_before(std::vector<racer_type> &racers, unsigned int j, population::size_type i, population::size_type pos)
+{
+	const population::size_type prev = racers[pos].m_prev[j];
+	racers[i].m_next[j] = pos;
+	racers[i].m_prev[j] = (prev == pos ? i : prev);
+	if(prev != pos){
+		racers[prev].m_next[j] = i;
+	}
+	racers[pos].m_prev[j] = i;
+}
+
+}
+
+/// Appends the ranks of a new trial to the histories of the racers
+/**
+ * Besides pushing the ranks, links the racers of the trial from the best to
+ * the worst rank, for the benefit of f_race_adjust_ranks().
+ *
+ * @param[out] racers Data structure storing the racing data which will be updated
+ * @param[in] idx Indices of the racers ranked in the trial
+ * @param[in] rankings Ranks of the racers in idx
+ *
+**/
+void f_race_push_ranks(std::vector<racer_type>& racers, const std::vector<population::size_type>& idx, const std::vector<double>& rankings)
+{
+	typedef population::size_type size_type;
+	pagmo_assert(idx.size() == rankings.size());
+
+	std::vector<size_type> order(idx.size());
+	for(size_type i = 0; i < order.size(); i++){
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), rank_comparator(rankings));
+	for(size_type i = 0; i < order.size(); i++){
+		racer_type &racer = racers[idx[order[i]]];
+		racer.push_rank(rankings[order[i]]);
+		racer.m_prev.push_back(idx[order[i == 0 ? i : i - 1]]);
+		racer.m_next.push_back(idx[order[i + 1 == order.size() ? i : i + 1]]);
+	}
+}
 
 /// Friedman rank assignment (before every racing iteration)
 /**
@@ -207,46 +304,50 @@ std::vector<double> racing_population::get_rankings() const
  * as the one returned by get_best_idx(N), but in case of ties an average rank
  * will be assigned among those who tied.
  *
+ * In the single-objective case the active individuals are ranked in place,
+ * without building an auxiliary population. The running rank sums of the
+ * racers are updated in constant time per racer.
+ *
  * @param[out] racers Data strcture storing the racing data which will be updated
  * @param[in] racing_pop Population on which racing will run
  *
 **/
 void f_race_assign_ranks(std::vector<racer_type>& racers, const racing_population& racing_pop_full)
 {
-	// Update ranking to be used for stat test
-	// Note that the ranking returned by get_best_idx() requires some post-processing,
-	// as individuals not currently in race should be ignored.
-
 	typedef population::size_type size_type;
 
-	// Construct a more condensed population with only active individuals
-	racing_population racing_pop(racing_pop_full.problem());
-	decision_vector dummy_x(racing_pop_full.problem().get_dimension(), 0);
-	std::vector<size_type> idx_mapping;
+	std::vector<size_type> active_idx;
 	for(size_type i = 0; i < racers.size(); i++){
 		if(racers[i].active){
-			racing_pop.push_back_noeval(dummy_x);
-			racing_pop.set_fc(racing_pop.size()-1, racing_pop_full.get_individual(i).cur_f, racing_pop_full.get_individual(i).cur_c);
-			idx_mapping.push_back(i);
+			active_idx.push_back(i);
 		}
 	}
-	
-	// Get the rankings in the sense of satistical testing
-	std::vector<double> rankings = racing_pop.get_rankings();
-	for(unsigned int i = 0; i < racing_pop.size(); i++){
-		racers[idx_mapping[i]].m_hist.push_back(rankings[i]);
-	}
-
-	// Update mean of rank (which also reflects the sum of rank, useful for
-	// later pair-wise test)
-	for(size_type i = 0; i < rankings.size(); i++){
-		racer_type& cur_racer = racers[idx_mapping[i]];
-		cur_racer.m_mean = 0;
-		for(unsigned int j = 0; j < cur_racer.length(); j++){
-			cur_racer.m_mean += (cur_racer.m_hist[j]) / (double)cur_racer.length();
+
+	if(racing_pop_full.problem().get_f_dimension() == 1){
+		// Sort the active individuals directly, from best to worst. This
+		// gives the same ranks as get_rankings() on the condensed population.
+		racing_fc_comparator comparator(racing_pop_full, active_idx);
+		std::vector<size_type> raw_order(active_idx.size());
+		for(size_type i = 0; i < raw_order.size(); i++){
+			raw_order[i] = i;
 		}
+		std::sort(raw_order.begin(), raw_order.end(), comparator);
+		f_race_push_ranks(racers, active_idx, order_to_rankings(raw_order, comparator));
+		return;
+	}
+
+	// Multi-objective case: Pareto ranks and crowding distances are relative
+	// to the active individuals only, hence construct a more condensed
+	// population with only active individuals
+	racing_population racing_pop(racing_pop_full.problem());
+	decision_vector dummy_x(racing_pop_full.problem().get_dimension(), 0);
+	for(size_type i = 0; i < active_idx.size(); i++){
+		racing_pop.push_back_noeval(dummy_x);
+		racing_pop.set_fc(racing_pop.size()-1, racing_pop_full.get_individual(active_idx[i]).cur_f, racing_pop_full.get_individual(active_idx[i]).cur_c);
 	}
 	
+	// Get the rankings in the sense of satistical testing
+	f_race_push_ranks(racers, active_idx, racing_pop.get_rankings());
 }
 
 /// Rank adjustment (after every racing iteration)
@@ -255,22 +356,81 @@ void f_race_assign_ranks(std::vector<racer_type>& racers, const racing_populatio
  * adjust the previous ranks of the remaining individuals. The resulted ranks
  * are free of influence from those just-deleted individuals.
  *
+ * In every trial only the racers ranked after the best deleted one are
+ * visited, following the links set by f_race_push_ranks(), and the deleted
+ * racers are then unlinked: the cost is that of the ranks which actually
+ * change, and nothing when no individual was removed.
+ *
  * @param[out] racers Data structure for storing racing data which will be updated
  * @param[in] deleted_racers Indices of the individuals who have just be de-activated
  *
 **/
 void f_race_adjust_ranks(std::vector<racer_type>& racers, const std::vector<population::size_type>& deleted_racers)
 {
-	for(unsigned int i = 0; i < racers.size(); i++){
-		if(!racers[i].active) continue;
-		for(unsigned int j = 0; j < racers[i].length(); j++){
-			int adjustment = 0;
-			for(unsigned int k = 0; k < deleted_racers.size(); k++){
-				if(racers[i].m_hist[j] > racers[deleted_racers[k]].m_hist[j]){
-					adjustment++;
-				}
+	typedef population::size_type size_type;
+	if(deleted_racers.empty()){
+		return;
+	}
+
+	std::vector<bool> deleted(racers.size(), false);
+	for(size_type k = 0; k < deleted_racers.size(); k++){
+		deleted[deleted_racers[k]] = true;
+	}
+
+	const unsigned int n_trials = racers[deleted_racers[0]].length();
+	for(unsigned int j = 0; j < n_trials; j++){
+		// Start from the first racer tied with the best deleted one
+		size_type start = deleted_racers[0];
+		for(size_type k = 1; k < deleted_racers.size(); k++){
+			if(racers[deleted_racers[k]].m_hist[j] < racers[start].m_hist[j]){
+				start = deleted_racers[k];
+			}
+		}
+		while(racers[start].m_prev[j] != start && racers[racers[start].m_prev[j]].m_hist[j] == racers[start].m_hist[j]){
+			start = racers[start].m_prev[j];
+		}
+
+		// Every active racer loses one rank per deleted racer ranked
+		// strictly better
+		std::vector<size_type> adjusted;
+		double tie_rank = racers[start].m_hist[j];
+		int adjustment = 0, deleted_ties = 0;
+		for(size_type i = start; ; i = racers[i].m_next[j]){
+			const double rank = racers[i].m_hist[j];
+			if(rank != tie_rank){
+				adjustment += deleted_ties;
+				deleted_ties = 0;
+				tie_rank = rank;
+			}
+			if(deleted[i]){
+				deleted_ties++;
+			}
+			else if(racers[i].active && adjustment){
+				racers[i].adjust_rank(j, adjustment);
+				adjusted.push_back(i);
+			}
+			if(racers[i].m_next[j] == i){
+				break;
+			}
+		}
+
+		for(size_type k = 0; k < deleted_racers.size(); k++){
+			unlink_racer(racers, j, deleted_racers[k]);
+		}
+
+		// The adjustment keeps the order of the ranks, except next to racers
+		// which were tied with a deleted one: move the few racers which now
+		// rank better than their predecessors back into place
+		for(size_type k = 0; k < adjusted.size(); k++){
+			const size_type i = adjusted[k];
+			size_type pos = i;
+			while(racers[pos].m_prev[j] != pos && racers[racers[pos].m_prev[j]].m_hist[j] > racers[i].m_hist[j]){
+				pos = racers[pos].m_prev[j];
+			}
+			if(pos != i){
+				unlink_racer(racers, j, i);
+				link_racer_before(racers, j, i, pos);
 			}
-			racers[i].m_hist[j] -= adjustment;
 		}
 	}
 }
@@ -297,20 +457,9 @@ stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X,
 	unsigned int N = X.size(); // # of different configurations
 	unsigned int B = X[0].size(); // # of different instances
 
-	// Compute mean rank
-	std::vector<double> X_mean(N, 0);
-	for(unsigned int i = 0; i < N; i++){
-		for(unsigned int j = 0; j < X[i].size(); j++){
-			X_mean[i] += X[i][j];
-		}
-		X_mean[i] /= (double)X[i].size();
-	}
-
-	// Fill in R and T
+	// Fill in R and A1
 	std::vector<double> R(N, 0);
 	double A1 = 0;
-	double C1 = B * N * (N+1) * (N+1) / 4.0;
-
 	for(unsigned int i = 0; i < N; i++){
 		for(unsigned int j = 0; j < B; j++){
 			R[i] += X[i][j];
@@ -318,6 +467,31 @@ stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X,
 		}
 	}
 
+	return core_friedman_test(R, A1, B, delta);
+}
+
+/// Perform a Friedman test from the rank sums
+/**
+ * Same as core_friedman_test() above, but taking directly the sufficient
+ * statistics of the observations, which the racers keep up to date while
+ * new trials are added. The cost is thus independent of the number of
+ * trials.
+ *
+ * @param[in] R Sum of the ranks of each "treatment"
+ * @param[in] A1 Sum of the squared ranks over all the treatments and instances
+ * @param[in] B Number of instances (trials)
+ * @param[in] delta Confidence level for the statistical test
+ *
+ * @return Result of the statistical test 
+ */
+stat_test_result core_friedman_test(const std::vector<double>& R, double A1, unsigned int B, double delta)
+{
+	pagmo_assert(R.size() > 0);
+
+	unsigned int N = R.size(); // # of different configurations
+
+	double C1 = B * N * (N+1) * (N+1) / 4.0;
+
 	double T1 = 0;
 	for(unsigned int i = 0; i < N; i++){
 		T1 += ((R[i] - B*(N+1)/2.0) * (R[i] - B*(N+1)/2.0));
@@ -353,11 +527,13 @@ stat_test_result core_friedman_test(const std::vector<std::vector<double> >& X,
 			for(unsigned int j = i + 1; j < N; j++){
 				double diff_r = fabs(R[i] - R[j]);
 				// Check if a pair is statistically significantly different
+				// (comparing rank sums is the same as comparing mean ranks,
+				// as all the treatments share the same number of instances)
 				if(diff_r > t_delta2_quantile * Q){
-					if(X_mean[i] < X_mean[j]){
+					if(R[i] < R[j]){
 						is_better[i][j] = true;
 					}
-					if(X_mean[j] < X_mean[i]){
+					if(R[j] < R[i]){
 						is_better[j][i] = true;
 					}
 				}
@@ -380,17 +556,17 @@ stat_test_result friedman_test(std::vector<racer_type> &racers, const std::vecto
 {
 	f_race_assign_ranks(racers, pop);
 
-	// Observation data (TODO: is this necessary ? ... a lot of memory
-	// allocation gets done here and we already have in memory all we need.
-	// could we not pass by reference directly racers and in_race to the
-	// friedman test?)
-	std::vector<std::vector<double> > X;
+	// The statistic only needs the rank sums, which are maintained by the
+	// racers themselves
+	std::vector<double> R(in_race.size());
+	double A1 = 0;
 	for(unsigned int i = 0; i < in_race.size(); i++){
-		X.push_back(racers[in_race[i]].m_hist);
+		R[i] = racers[in_race[i]].m_rank_sum;
+		A1 += racers[in_race[i]].m_rank_sq_sum;
 	}
 
 	// Friedman Test
-	stat_test_result ss_result = core_friedman_test(X, delta);
+	stat_test_result ss_result = core_friedman_test(R, A1, racers[in_race[0]].length(), delta);
 	return ss_result;
 }
 
@@ -413,17 +589,10 @@ stat_test_result wilcoxon_ranksum_test(std::vector<racer_type> &racers, const st
 	// found, which will then default to selecting the one with best mean. Two
 	// specific individuals in the wilcoxon_pop correspond to the newest two
 	// evaluated points.
-	racers[in_race[0]].m_hist.push_back(rankings[wilcoxon_pop.size()/2 - 1]);
-	racers[in_race[1]].m_hist.push_back(rankings[wilcoxon_pop.size() - 1]);
-
-	// Compute the mean ranks
-	for(std::vector<population::size_type>::const_iterator it = in_race.begin(); it != in_race.end(); it++){
-		racer_type& cur_racer = racers[*it];
-		cur_racer.m_mean = 0;
-		for(unsigned int j = 0; j < cur_racer.length(); j++){
-			cur_racer.m_mean += (cur_racer.m_hist[j]) / (double)cur_racer.length();
-		}
-	}
+	std::vector<double> newest(2);
+	newest[0] = rankings[wilcoxon_pop.size()/2 - 1];
+	newest[1] = rankings[wilcoxon_pop.size() - 1];
+	f_race_push_ranks(racers, in_race, newest);
 
 	std::vector<std::vector<double> > X(2);
 	unsigned int n_samples = wilcoxon_pop.size() / 2;
@@ -54,23 +54,54 @@ namespace racing{
 	struct racer_type
 	{
 		public:
-			racer_type(): m_mean(0), active(false) { }
+			racer_type(): m_mean(0), active(false), m_rank_sum(0), m_rank_sq_sum(0) { }
 
 			// Using double type to cater for tied ranks
 			std::vector<double> m_hist;
 			double m_mean;
 			bool active;
+			// Running sums of m_hist and of its squares, kept up to date so
+			// that the test statistics do not need to scan the histories
+			double m_rank_sum;
+			double m_rank_sq_sum;
+			// For each trial, the racers ranked just before and just after
+			// this one (the racers themselves at the ends), so that the ranks
+			// affected by a removal can be found without scanning the
+			// histories
+			std::vector<population::size_type> m_prev;
+			std::vector<population::size_type> m_next;
 
 			unsigned int length()
 			{
 				return m_hist.size();
 			}
 
+			void push_rank(double rank)
+			{
+				m_hist.push_back(rank);
+				m_rank_sum += rank;
+				m_rank_sq_sum += rank * rank;
+				m_mean = m_rank_sum / m_hist.size();
+			}
+
+			void adjust_rank(unsigned int idx, double adjustment)
+			{
+				const double old_rank = m_hist[idx];
+				m_hist[idx] -= adjustment;
+				m_rank_sum -= adjustment;
+				m_rank_sq_sum += m_hist[idx] * m_hist[idx] - old_rank * old_rank;
+				m_mean = m_rank_sum / m_hist.size();
+			}
+
 			void reset()
 			{
 				m_hist.clear();
 				m_mean = 0;
 				active = false;
+				m_rank_sum = 0;
+				m_rank_sq_sum = 0;
+				m_prev.clear();
+				m_next.clear();
 			}
 
 
@@ -82,6 +113,10 @@ namespace racing{
 				ar & m_hist;
 				ar & m_mean;
 				ar & active;
+				ar & m_rank_sum;
+				ar & m_rank_sq_sum;
+				ar & m_prev;
+				ar & m_next;
 			}
 	};
 
@@ -101,6 +136,15 @@ namespace racing{
 	stat_test_result core_friedman_test(const std::vector<std::vector<double> > &,
 	                                    double delta);
 
+	stat_test_result core_friedman_test(const std::vector<double> &,
+	                                    double,
+	                                    unsigned int,
+	                                    double delta);
+
+	void f_race_push_ranks(std::vector<racer_type> &,
+	                       const std::vector<population::size_type> &,
+	                       const std::vector<double> &);
+
 	void f_race_assign_ranks(std::vector<racer_type> &,
 	                         const racing_population &);
 
@@ -0,0 +1,297 @@
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/weak_ptr.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+	#include <sys/types.h>
+#endif
+
+#include "../exceptions.h"
+#include "shared_data.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Registry of the live tables, by content hash.
+typedef boost::unordered_map<boost::uint64_t,boost::weak_ptr<const std::vector<double> > > registry_type;
+
+// Function-local statics, so that the registry can be used during static initialisation.
+boost::mutex &registry_mutex()
+{
+	static boost::mutex retval;
+	return retval;
+}
+
+registry_type &registry()
+{
+	static registry_type retval;
+	return retval;
+}
+
+// Size of the registry above which the expired entries are purged.
+registry_type::size_type registry_purge_size = 64u;
+
+// Header of the binary cache files: magic string, byte order mark, size and hash of the bytes of the text file, number
+// of elements and hash of the table.
+const char cache_magic[8] = {'P','A','G','M','O','T','B','2'};
+const boost::uint64_t cache_bom = 0x0102030405060708ULL;
+
+// 64-bit FNV-1a hash of the bytes of a text.
+boost::uint64_t text_hash(const std::string &text)
+{
+	boost::uint64_t retval = 14695981039346656037ULL;
+	for (std::string::size_type i = 0; i < text.size(); ++i) {
+		retval ^= static_cast<unsigned char>(text[i]);
+		retval *= 1099511628211ULL;
+	}
+	return retval;
+}
+
+// Create a directory, returning false on failure unless it already exists.
+bool make_dir(const std::string &dir)
+{
+#ifdef _WIN32
+	const int status = _mkdir(dir.c_str());
+#else
+	const int status = mkdir(dir.c_str(),0755);
+#endif
+	return !status || errno == EEXIST;
+}
+
+// Directory of the caches of pagmo, i.e., the "pagmo" subdirectory of the cache directory of the user (XDG_CACHE_HOME,
+// ~/.cache or, on Windows, LOCALAPPDATA), created if needed. Of the cache directory of the user, only the default ~/.cache
+// is created. Empty if unknown or if it cannot be created.
+std::string user_cache_dir()
+{
+	const char *names[3] = {"XDG_CACHE_HOME","HOME","LOCALAPPDATA"};
+	for (int i = 0; i < 3; ++i) {
+		const char *dir = std::getenv(names[i]);
+		if (dir && *dir) {
+			const std::string user_dir(i == 1 ? std::string(dir) + "/.cache" : std::string(dir));
+			if ((i != 1 || make_dir(user_dir)) && make_dir(user_dir + "/pagmo")) {
+				return user_dir + "/pagmo";
+			}
+			return std::string();
+		}
+	}
+	return std::string();
+}
+
+// Read the binary cache, returning false if it is missing or stale.
+bool read_cache(std::vector<double> &data, const std::string &path, boost::uint64_t txt_size, boost::uint64_t txt_hash)
+{
+	std::ifstream f(path.c_str(),std::ios::binary);
+	if (!f.is_open()) {
+		return false;
+	}
+	char magic[8];
+	boost::uint64_t bom, size, th, n, h;
+	f.read(magic,8);
+	f.read(reinterpret_cast<char *>(&bom),sizeof(bom));
+	f.read(reinterpret_cast<char *>(&size),sizeof(size));
+	f.read(reinterpret_cast<char *>(&th),sizeof(th));
+	f.read(reinterpret_cast<char *>(&n),sizeof(n));
+	f.read(reinterpret_cast<char *>(&h),sizeof(h));
+	if (!f || std::memcmp(magic,cache_magic,8) || bom != cache_bom || size != txt_size || th != txt_hash || n > txt_size) {
+		return false;
+	}
+	data.resize(static_cast<std::vector<double>::size_type>(n));
+	if (n) {
+		f.read(reinterpret_cast<char *>(&data[0]),static_cast<std::streamsize>(n * sizeof(double)));
+	}
+	return f && shared_data::hash(data) == h;
+}
+
+// Write the binary cache, returning false on failure (e.g., a read-only directory).
+bool write_cache(const std::vector<double> &data, const std::string &path, boost::uint64_t txt_size, boost::uint64_t txt_hash)
+{
+	// Write a temporary file first, so that concurrent readers never see a partial cache.
+	const std::string tmp_path(path + ".tmp");
+	{
+		std::ofstream f(tmp_path.c_str(),std::ios::binary | std::ios::trunc);
+		if (!f.is_open()) {
+			return false;
+		}
+		const boost::uint64_t n = data.size(), h = shared_data::hash(data);
+		f.write(cache_magic,8);
+		f.write(reinterpret_cast<const char *>(&cache_bom),sizeof(cache_bom));
+		f.write(reinterpret_cast<const char *>(&txt_size),sizeof(txt_size));
+		f.write(reinterpret_cast<const char *>(&txt_hash),sizeof(txt_hash));
+		f.write(reinterpret_cast<const char *>(&n),sizeof(n));
+		f.write(reinterpret_cast<const char *>(&h),sizeof(h));
+		if (n) {
+			f.write(reinterpret_cast<const char *>(&data[0]),static_cast<std::streamsize>(n * sizeof(double)));
+		}
+		if (!f) {
+			f.close();
+			std::remove(tmp_path.c_str());
+			return false;
+		}
+	}
+	if (std::rename(tmp_path.c_str(),path.c_str())) {
+		std::remove(tmp_path.c_str());
+		return false;
+	}
+	return true;
+}
+
+}
+
+/// Default constructor
+/**
+ * Builds an empty table.
+ */
+shared_data::shared_data()
+{
+	intern(boost::shared_ptr<const std::vector<double> >(new std::vector<double>()));
+}
+
+/// Constructor from data
+/**
+ * @param[in] data the content of the table
+ */
+shared_data::shared_data(const std::vector<double> &data)
+{
+	intern(boost::shared_ptr<const std::vector<double> >(new std::vector<double>(data)));
+}
+
+/// Read a table from a text file
+/**
+ * Reads all the whitespace separated numbers of a text file. The first time the file is read, a binary copy of the
+ * table is written, and the following reads load it instead of parsing the text. The binary copy is named after the hash
+ * of the bytes of the text file ("<hash>.bin") and is stored in the "pagmo" subdirectory of the cache directory of the
+ * user (XDG_CACHE_HOME, ~/.cache or, on Windows, LOCALAPPDATA), created if needed, so that the directory of the text
+ * file (e.g., installed data) is left alone.
+ * Only if that fails, it is written next to the text file, with the ".bin" suffix appended to the file name. The binary
+ * copy is discarded if the size or the content of the text file change, and it is silently not written if no directory
+ * is writable.
+ *
+ * @param[in] path path of the text file
+ *
+ * @return the table
+ *
+ * @throws io_error if the text file cannot be opened
+ */
+shared_data shared_data::from_text_file(const std::string &path)
+{
+	std::ifstream txt(path.c_str(),std::ios::binary);
+	if (!txt.is_open()) {
+		pagmo_throw(io_error,std::string("Error: file not found. I was looking for (") + path + ")");
+	}
+	const std::string text((std::istreambuf_iterator<char>(txt)),std::istreambuf_iterator<char>());
+	const boost::uint64_t txt_size = text.size(), txt_hash = text_hash(text);
+	std::string cache_paths[2];
+	const std::string user_dir(user_cache_dir());
+	if (!user_dir.empty()) {
+		std::ostringstream oss;
+		oss << user_dir << "/" << std::hex << std::setw(16) << std::setfill('0') << txt_hash << ".bin";
+		cache_paths[0] = oss.str();
+	}
+	cache_paths[1] = path + ".bin";
+	std::vector<double> data;
+	for (int i = 0; i < 2; ++i) {
+		if (!cache_paths[i].empty() && read_cache(data,cache_paths[i],txt_size,txt_hash)) {
+			return shared_data(data);
+		}
+	}
+	std::istringstream iss(text);
+	std::istream_iterator<double> start(iss), end;
+	data.assign(start,end);
+	for (int i = 0; i < 2; ++i) {
+		if (!cache_paths[i].empty() && write_cache(data,cache_paths[i],txt_size,txt_hash)) {
+			break;
+		}
+	}
+	return shared_data(data);
+}
+
+/// Equality operator
+/**
+ * @return true if the two tables have the same content
+ */
+bool shared_data::operator==(const shared_data &other) const
+{
+	return m_data == other.m_data || (m_hash == other.m_hash && *m_data == *other.m_data);
+}
+
+/// Inequality operator
+/**
+ * @return true if the two tables have a different content
+ */
+bool shared_data::operator!=(const shared_data &other) const
+{
+	return !(*this == other);
+}
+
+/// Content hash
+/**
+ * 64-bit FNV-1a hash of the bit patterns of the elements, independent of the platform's byte order.
+ *
+ * @param[in] data the table to hash
+ *
+ * @return the hash
+ */
+boost::uint64_t shared_data::hash(const std::vector<double> &data)
+{
+	boost::uint64_t retval = 14695981039346656037ULL;
+	for (std::vector<double>::size_type i = 0; i < data.size(); ++i) {
+		// Normalise the zeroes, which compare equal.
+		const double x = data[i] == 0 ? 0. : data[i];
+		boost::uint64_t bits;
+		std::memcpy(&bits,&x,sizeof(bits));
+		for (int j = 0; j < 8; ++j) {
+			retval ^= (bits >> (8 * j)) & 0xff;
+			retval *= 1099511628211ULL;
+		}
+	}
+	return retval;
+}
+
+// Point to data, or to a live table with the same content.
+void shared_data::intern(const boost::shared_ptr<const std::vector<double> > &data)
+{
+	m_hash = hash(*data);
+	m_data = data;
+	boost::lock_guard<boost::mutex> lock(registry_mutex());
+	registry_type &reg = registry();
+	std::pair<registry_type::iterator,bool> res = reg.insert(std::make_pair(m_hash,boost::weak_ptr<const std::vector<double> >(data)));
+	if (!res.second) {
+		const boost::shared_ptr<const std::vector<double> > other(res.first->second.lock());
+		if (!other) {
+			res.first->second = data;
+		} else if (*other == *data) {
+			m_data = other;
+		}
+		// Otherwise it is a hash collision, and this table simply keeps its own copy.
+		return;
+	}
+	if (reg.size() > registry_purge_size) {
+		for (registry_type::iterator it = reg.begin(); it != reg.end();) {
+			if (it->second.expired()) {
+				it = reg.erase(it);
+			} else {
+				++it;
+			}
+		}
+		registry_purge_size = 2u * reg.size() + 64u;
+	}
+}
+
+}}
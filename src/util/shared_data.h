@@ -0,0 +1,103 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_SHARED_DATA_H
+#define PAGMO_UTIL_SHARED_DATA_H
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+#include "../config.h"
+#include "../exceptions.h"
+#include "../serialization.h"
+
+namespace pagmo{ namespace util {
+
+/// Shared immutable table of doubles
+/**
+ * Read-only data of a problem (rotation matrices, shift vectors, distance tables, ...) held through a reference-counted
+ * pointer, so that copying the problem (e.g., when cloning it for an island, a meta-problem or a thread) does not copy the
+ * data. The tables are also interned by their 64-bit content hash: building or loading a table equal to one already
+ * alive in the process returns the existing copy.
+ *
+ * When serialized, the data is written once per archive together with its content hash, and all the tables of the
+ * archive sharing it refer to that single copy. On load the hash is verified and the data is interned again.
+ */
+class __PAGMO_VISIBLE shared_data {
+public:
+	/// Size type.
+	typedef std::vector<double>::size_type size_type;
+	shared_data();
+	explicit shared_data(const std::vector<double> &);
+	static shared_data from_text_file(const std::string &);
+	/// Data.
+	const std::vector<double> &get() const {return *m_data;}
+	/// Pointer to the first element, null if the table is empty.
+	const double *data() const {return m_data->empty() ? 0 : &(*m_data)[0];}
+	/// Element access.
+	const double &operator[](size_type i) const {return (*m_data)[i];}
+	/// Number of elements.
+	size_type size() const {return m_data->size();}
+	/// Whether the table is empty.
+	bool empty() const {return m_data->empty();}
+	/// Content hash.
+	boost::uint64_t get_hash() const {return m_hash;}
+	/// Number of shared_data objects referring to the same copy of the data.
+	long use_count() const {return m_data.use_count();}
+	bool operator==(const shared_data &) const;
+	bool operator!=(const shared_data &) const;
+	static boost::uint64_t hash(const std::vector<double> &);
+private:
+	void intern(const boost::shared_ptr<const std::vector<double> > &);
+	friend class boost::serialization::access;
+	template <class Archive>
+	void save(Archive &ar, const unsigned int) const
+	{
+		ar << m_hash;
+		// The data goes through a tracked pointer, so that it is written only once per archive.
+		const boost::shared_ptr<std::vector<double> > data(boost::const_pointer_cast<std::vector<double> >(m_data));
+		ar << data;
+	}
+	template <class Archive>
+	void load(Archive &ar, const unsigned int)
+	{
+		boost::uint64_t h;
+		boost::shared_ptr<std::vector<double> > data;
+		ar >> h;
+		ar >> data;
+		if (!data || hash(*data) != h) {
+			pagmo_throw(value_error,"the content hash of the shared data does not match the archived one");
+		}
+		intern(data);
+	}
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+	boost::shared_ptr<const std::vector<double> >	m_data;
+	boost::uint64_t					m_hash;
+};
+
+}}
+
+#endif
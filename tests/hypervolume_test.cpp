@@ -67,8 +67,16 @@ public:
 			m_method = util::hv_algorithm::base_ptr(new util::hv_algorithm::hv4d());
 		} else if (method_name == "wfg") {
 			m_method = util::hv_algorithm::base_ptr(new util::hv_algorithm::wfg());
+		} else if (method_name == "wfg_mt") {
+			util::hv_algorithm::wfg *method = new util::hv_algorithm::wfg();
+			method->set_n_threads(4);
+			m_method = util::hv_algorithm::base_ptr(method);
 		} else if (method_name == "hoy") {
 			m_method = util::hv_algorithm::base_ptr(new util::hv_algorithm::hoy());
+		} else if (method_name == "hoy_mt") {
+			util::hv_algorithm::hoy *method = new util::hv_algorithm::hoy();
+			method->set_n_threads(4);
+			m_method = util::hv_algorithm::base_ptr(method);
 		} else if (method_name == "bf_approx") {
 			m_method = util::hv_algorithm::base_ptr(new util::hv_algorithm::bf_approx());
 		} else if (method_name == "bf_fpras") {
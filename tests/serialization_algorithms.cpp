@@ -101,6 +101,8 @@ int main()
 	algos_new.push_back(algorithm::cs().clone());
 	algos.push_back(algorithm::de(gen,0.9,0.9,3).clone());
 	algos_new.push_back(algorithm::de().clone());
+	algos.push_back(algorithm::async_evolution(gen*10,algorithm::async_evolution::PSO,2,3).clone());
+	algos_new.push_back(algorithm::async_evolution().clone());
 	algos.push_back(algorithm::de_1220(1,2,std::vector<int>(1,9),false,1e-5,1e-5).clone());
 	algos_new.push_back(algorithm::de_1220().clone());
 	algos.push_back(algorithm::ihs(gen,0.2,0.2,0.2,0.2,0.2).clone());
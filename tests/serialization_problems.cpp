@@ -162,6 +162,9 @@ int main()
 	//----- robust ----- //
 	probs.push_back(problem::robust(zdt1_before_transform1, 10, 0.1, 123).clone());
 	probs_new.push_back(problem::robust(zdt1_before_transform1, 1, 1.23, 456).clone());
+	//----- surrogate ----- //
+	probs.push_back(problem::surrogate(zdt1_before_transform1, 50, 0.3, 1e-5).clone());
+	probs_new.push_back(problem::surrogate(zdt1_before_transform1).clone());
 
 	//----- Test constraints handling meta-problems -----//
 	problem::cec2006 cec2006_before_cstrs_handling(7);
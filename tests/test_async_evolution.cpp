@@ -0,0 +1,87 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the asynchronous steady-state evolution
+
+#include <iostream>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+const char *names[] = {"DE", "PSO", "SGA"};
+
+population evolve(const problem::base &prob, algorithm::async_evolution::generator_type generator, unsigned int n_threads)
+{
+	algorithm::async_evolution alg(3000, generator, n_threads, 8);
+	alg.reset_rngs(7);
+	population pop(prob, 20, 42);
+	alg.evolve(pop);
+	return pop;
+}
+
+// With one thread the evolution must be reproducible.
+int test_serial(const problem::base &prob)
+{
+	std::cout << "Testing serial reproducibility on " << prob.get_name() << ": ";
+	for(int g = 0; g < 3; g++){
+		const algorithm::async_evolution::generator_type generator = static_cast<algorithm::async_evolution::generator_type>(g);
+		const population pop1 = evolve(prob, generator, 1), pop2 = evolve(prob, generator, 1);
+		for(population::size_type i = 0; i < pop1.size(); i++){
+			if(pop1.get_individual(i).cur_x != pop2.get_individual(i).cur_x ||
+				pop1.get_individual(i).cur_v != pop2.get_individual(i).cur_v){
+				std::cout << "FAILED (" << names[g] << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// With several threads every generator must improve the population and report its throughput.
+int test_threads(const problem::base &prob)
+{
+	std::cout << "Testing threads on " << prob.get_name() << ": ";
+	for(int g = 0; g < 3; g++){
+		const algorithm::async_evolution::generator_type generator = static_cast<algorithm::async_evolution::generator_type>(g);
+		algorithm::async_evolution alg(3000, generator, 3);
+		population pop(prob, 20, 42);
+		const fitness_vector initial = pop.champion().f;
+		alg.evolve(pop);
+		if(!prob.compare_fitness(pop.champion().f, initial) || alg.get_evaluations_per_second() <= 0 ||
+			alg.get_idle_fraction() < 0 || alg.get_idle_fraction() > 1){
+			std::cout << "FAILED (" << names[g] << ")" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_serial(problem::rosenbrock(6)) ||
+		test_serial(problem::noisy(problem::ackley(5), 3, 0, 0.1)) ||
+		test_threads(problem::rosenbrock(6));
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the multi-threaded and separable variants of CMA-ES
+
+#include <iostream>
+#include <string>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+population evolve(const problem::base &prob, unsigned int n_threads, bool separable, double eigen_lag, int gen = 200)
+{
+	algorithm::cmaes alg(gen, -1, -1, -1, -1, 0.5, 1e-15, 1e-15, false);
+	alg.set_n_threads(n_threads);
+	alg.set_separable(separable);
+	alg.set_eigen_lag(eigen_lag);
+	alg.reset_rngs(123);
+	population pop(prob, 20, 42);
+	alg.evolve(pop);
+	return pop;
+}
+
+bool same_populations(const population &pop1, const population &pop2)
+{
+	if(pop1.size() != pop2.size()){
+		return false;
+	}
+	for(population::size_type i = 0; i < pop1.size(); i++){
+		if(pop1.get_individual(i).cur_x != pop2.get_individual(i).cur_x ||
+			pop1.get_individual(i).cur_f != pop2.get_individual(i).cur_f){
+			return false;
+		}
+	}
+	return pop1.champion().x == pop2.champion().x;
+}
+
+// The offspring evaluated in parallel must not change the evolution.
+int test_threads(const problem::base &prob, bool separable)
+{
+	std::cout << "Testing threads on " << prob.get_name() << (separable ? " (separable)" : "") << ": ";
+	const population pop = evolve(prob, 1, separable, -1);
+	if(!same_populations(pop, evolve(prob, 2, separable, -1)) || !same_populations(pop, evolve(prob, 5, separable, -1))){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	// The fitness stored with the individuals must be the one of their decision vectors.
+	for(population::size_type i = 0; !dynamic_cast<const problem::base_stochastic *>(&prob) && i < pop.size(); i++){
+		if(prob.objfun(pop.get_individual(i).cur_x) != pop.get_individual(i).cur_f){
+			std::cout << "FAILED (fitness)" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int test_convergence(const problem::base &prob, bool separable, double eigen_lag, int gen, double tol)
+{
+	std::cout << "Testing convergence on " << prob.get_name() << (separable ? " (separable)" : "") << ", eigen lag " << eigen_lag << ": ";
+	const double best = evolve(prob, 1, separable, eigen_lag, gen).champion().f[0];
+	if(!(best < tol)){
+		std::cout << "FAILED (" << best << ")" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_threads(problem::rosenbrock(10), false) ||
+		test_threads(problem::ackley(10), true) ||
+		test_threads(problem::noisy(problem::ackley(10), 1, 0, 0.1), false) ||
+		test_convergence(problem::ackley(10), false, -1, 200, 1e-6) ||
+		test_convergence(problem::ackley(10), false, 0, 200, 1e-6) ||
+		test_convergence(problem::ackley(10), false, 10, 200, 1e-6) ||
+		test_convergence(problem::ackley(100), true, -1, 2000, 1e-6);
+}
@@ -0,0 +1,65 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the parallel evaluation of the trial vectors in DE
+
+#include <iostream>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+population evolve(const problem::base &prob, int strategy, unsigned int n_threads)
+{
+	algorithm::de alg(50, 0.8, 0.9, strategy, 1e-30, 1e-30);
+	alg.set_n_threads(n_threads);
+	alg.reset_rngs(7);
+	population pop(prob, 20, 42);
+	alg.evolve(pop);
+	return pop;
+}
+
+// The evolution must not depend on the number of threads.
+int test_threads(const problem::base &prob)
+{
+	std::cout << "Testing threads on " << prob.get_name() << ": ";
+	for(int strategy = 1; strategy <= 10; strategy++){
+		const population pop1 = evolve(prob, strategy, 1), pop3 = evolve(prob, strategy, 3);
+		for(population::size_type i = 0; i < pop1.size(); i++){
+			if(pop1.get_individual(i).cur_x != pop3.get_individual(i).cur_x ||
+				pop1.get_individual(i).cur_f != pop3.get_individual(i).cur_f ||
+				pop1.get_individual(i).cur_v != pop3.get_individual(i).cur_v){
+				std::cout << "FAILED (strategy " << strategy << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_threads(problem::rosenbrock(8)) ||
+		test_threads(problem::noisy(problem::ackley(5), 3, 0, 0.1));
+}
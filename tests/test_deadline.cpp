@@ -0,0 +1,111 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the deadline of the algorithms
+
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+namespace pt = boost::posix_time;
+
+// With a deadline in the past every algorithm must return without touching the population.
+int test_expired(const algorithm::base &alg, const problem::base &prob)
+{
+	std::cout << "Testing expired deadline for " << alg.get_name() << ": ";
+	algorithm::base_ptr a = alg.clone();
+	a->set_deadline(pt::microsec_clock::universal_time() - pt::seconds(1));
+	population pop(prob, 20, 42);
+	const population orig(pop);
+	a->evolve(pop);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		if(pop.get_individual(i).cur_x != orig.get_individual(i).cur_x){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	// Once cleared, the algorithm must evolve again.
+	a->clear_deadline();
+	a->evolve(pop);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		if(pop.get_individual(i).cur_x != orig.get_individual(i).cur_x){
+			std::cout << "PASSED" << std::endl;
+			return 0;
+		}
+	}
+	std::cout << "FAILED (not evolving after clear_deadline)" << std::endl;
+	return 1;
+}
+
+// An endless evolution must stop shortly after the deadline.
+int test_budget()
+{
+	std::cout << "Testing deadline of an endless evolution: ";
+	algorithm::sga alg(100000000);
+	population pop(problem::dejong(10), 20, 42);
+	const fitness_vector initial = pop.champion().f;
+	const pt::ptime start = pt::microsec_clock::universal_time();
+	alg.set_deadline(start + pt::milliseconds(100));
+	alg.evolve(pop);
+	const long elapsed = (pt::microsec_clock::universal_time() - start).total_milliseconds();
+	if(elapsed > 2000 || pop.size() != 20u || !pop.problem().compare_fitness(pop.champion().f, initial)){
+		std::cout << "FAILED (" << elapsed << " ms)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// A time-budgeted island must not overrun its budget by a whole evolution, and must leave the algorithm without a deadline.
+int test_island()
+{
+	std::cout << "Testing time-budgeted island: ";
+	island isl(algorithm::de(100000000, 0.8, 0.9, 2, 0, 0), problem::dejong(10), 20);
+	const pt::ptime start = pt::microsec_clock::universal_time();
+	isl.evolve_t(100);
+	isl.join();
+	const long elapsed = (pt::microsec_clock::universal_time() - start).total_milliseconds();
+	if(elapsed > 2000 || !isl.get_algorithm()->get_deadline().is_not_a_date_time()){
+		std::cout << "FAILED (" << elapsed << " ms)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	const problem::dejong so(10);
+	const problem::zdt mo(1, 10);
+	return test_expired(algorithm::de(10), so) +
+		test_expired(algorithm::pso(10), so) +
+		test_expired(algorithm::sga(10), so) +
+		test_expired(algorithm::cmaes(10), so) +
+		test_expired(algorithm::nsga2(10), mo) +
+		test_expired(algorithm::sms_emoa(10), mo) +
+		test_budget() +
+		test_island();
+}
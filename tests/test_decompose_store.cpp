@@ -0,0 +1,145 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the evaluation store shared by decomposed problems
+
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/parallel.h"
+
+using namespace pagmo;
+
+// A problem decomposed through a store must have the same fitness as the plain decomposed problem.
+int test_same_fitness(const problem::base &prob, problem::decompose::method_type method)
+{
+	std::cout << "Testing decomposition through a store of " << prob.get_name() << " (method " << method << "): ";
+	const problem::decompose::evaluation_store_ptr store(new problem::decompose::evaluation_store(prob));
+	std::vector<double> weights(prob.get_f_dimension(), 1.0 / prob.get_f_dimension());
+	std::vector<double> z(prob.get_f_dimension(), 0.1);
+	problem::decompose plain(prob, method, weights, z);
+	problem::decompose shared(store, method, weights, z);
+	problem::base_ptr shared_copy = shared.clone();
+	population pop(prob, 20, 123);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		if(plain.objfun(x) != shared.objfun(x) || plain.objfun(x) != shared_copy->objfun(x)){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	// The copy evaluated through the store, which has evaluated every decision vector once.
+	if(dynamic_cast<const problem::decompose &>(*shared_copy).get_evaluation_store() != store ||
+		store->get_n_evaluations() != pop.size() || store->get_n_hits() != pop.size()){
+		std::cout << "FAILED: unexpected store statistics" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The oldest fitnesses are dropped when the store is full.
+int test_capacity()
+{
+	std::cout << "Testing the capacity of the store: ";
+	problem::zdt prob(1, 5);
+	problem::decompose::evaluation_store store(prob, 2);
+	population pop(prob, 3, 42);
+	fitness_vector f(prob.get_f_dimension());
+	for(population::size_type i = 0; i < pop.size(); i++){
+		store.objfun(f, pop.get_individual(i).cur_x);
+	}
+	// x_2 is still there, x_0 is not.
+	store.objfun(f, pop.get_individual(2).cur_x);
+	store.objfun(f, pop.get_individual(0).cur_x);
+	if(store.get_n_evaluations() != 4 || store.get_n_hits() != 1 || f != prob.objfun(pop.get_individual(0).cur_x)){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Evaluates decision vector i % n_x on the decomposed problem of worker w.
+struct store_evaluation
+{
+	store_evaluation(const std::vector<problem::base_ptr> &probs, const std::vector<decision_vector> &x, std::vector<fitness_vector> &f):
+		m_probs(probs), m_x(x), m_f(f) {}
+	void operator()(std::size_t i, unsigned int w)
+	{
+		m_f[i] = m_probs[w]->objfun(m_x[i % m_x.size()]);
+	}
+	const std::vector<problem::base_ptr> &m_probs;
+	const std::vector<decision_vector> &m_x;
+	std::vector<fitness_vector> &m_f;
+};
+
+// Decomposed problems evaluated concurrently through the same store must give the serial results.
+int test_concurrent()
+{
+	std::cout << "Testing concurrent evaluations through the store: ";
+	problem::zdt prob(2, 10);
+	const problem::decompose::evaluation_store_ptr store(new problem::decompose::evaluation_store(prob));
+	problem::decompose plain(prob, problem::decompose::TCHEBYCHEFF);
+	problem::decompose shared(store, problem::decompose::TCHEBYCHEFF, plain.get_weights());
+	const unsigned int n_threads = 8;
+	std::vector<problem::base_ptr> probs;
+	for(unsigned int i = 0; i < n_threads; i++){
+		probs.push_back(shared.clone());
+	}
+	population pop(prob, 50, 321);
+	std::vector<decision_vector> x;
+	for(population::size_type i = 0; i < pop.size(); i++){
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	const std::size_t n_tasks = 20 * x.size();
+	std::vector<fitness_vector> f(n_tasks);
+	store_evaluation task(probs, x, f);
+	util::parallel::for_each_index(n_tasks, n_threads, task);
+	for(std::size_t i = 0; i < n_tasks; i++){
+		if(f[i] != plain.objfun(x[i % x.size()])){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	// Each decision vector was evaluated at least once, and each evaluation of the decomposed
+	// problems either hit the store or evaluated the original problem.
+	if(store->get_n_evaluations() < x.size() || store->get_n_hits() + store->get_n_evaluations() > n_tasks){
+		std::cout << "FAILED: unexpected store statistics" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	problem::zdt zdt1(1, 10);
+	problem::dtlz dtlz2(2, 8, 3);
+	return test_same_fitness(zdt1, problem::decompose::WEIGHTED) ||
+	       test_same_fitness(zdt1, problem::decompose::TCHEBYCHEFF) ||
+	       test_same_fitness(dtlz2, problem::decompose::BI) ||
+	       test_capacity() ||
+	       test_concurrent();
+}
@@ -0,0 +1,134 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the batched low-discrepancy sequences
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/discrepancy.h"
+
+using namespace pagmo;
+using namespace pagmo::util::discrepancy;
+
+// Batches and jumps must give the same points as the point by point generation.
+int test_batch(const base &gen, const std::string &name)
+{
+	std::cout << "Testing " << name << ": ";
+	const unsigned int n = 1000, dim = gen.get_dimension();
+	base_ptr single = gen.clone(), batch = gen.clone(), jump = gen.clone();
+	std::vector<double> points;
+	batch->generate(points,n);
+	if(points.size() != n * dim || batch->get_count() != gen.get_count() + n){
+		std::cout << "FAILED (size)" << std::endl;
+		return 1;
+	}
+	for(unsigned int i = 0; i < n; i++){
+		const std::vector<double> p = (*single)();
+		if(!std::equal(p.begin(),p.end(),points.begin() + i * dim)){
+			std::cout << "FAILED (point " << i << ")" << std::endl;
+			return 1;
+		}
+	}
+	// Chunks generated after a jump must be the same as the sequential ones.
+	jump->set_count(gen.get_count() + n / 2);
+	std::vector<double> chunk(n / 2 * dim);
+	jump->generate(&chunk[0],n / 2);
+	if(!std::equal(chunk.begin(),chunk.end(),points.begin() + n / 2 * dim)){
+		std::cout << "FAILED (jump)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Known points of the Sobol sequence, and stratification of each coordinate.
+int test_sobol()
+{
+	std::cout << "Testing sobol: ";
+	sobol gen(3);
+	const double ref[3][3] = {{0.5,0.5,0.5},{0.75,0.25,0.25},{0.25,0.75,0.75}};
+	for(int i = 0; i < 3; i++){
+		const std::vector<double> p = gen();
+		if(!std::equal(p.begin(),p.end(),ref[i])){
+			std::cout << "FAILED (point " << i + 1 << ")" << std::endl;
+			return 1;
+		}
+	}
+	// The first 2^m points have exactly one coordinate in each interval [k/2^m,(k+1)/2^m).
+	const unsigned int m = 1024, dim = 40;
+	sobol gen40(dim,0);
+	std::vector<double> points;
+	gen40.generate(points,m);
+	for(unsigned int d = 0; d < dim; d++){
+		std::vector<bool> hit(m,false);
+		for(unsigned int i = 0; i < m; i++){
+			const unsigned int k = static_cast<unsigned int>(points[i * dim + d] * m);
+			if(k >= m || hit[k]){
+				std::cout << "FAILED (stratification of dimension " << d << ")" << std::endl;
+				return 1;
+			}
+			hit[k] = true;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Throughput of the point by point and of the batched generation.
+void benchmark(base &gen, const std::string &name)
+{
+	const unsigned int n = 200000;
+	base_ptr single = gen.clone();
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	double sum = 0;
+	for(unsigned int i = 0; i < n; i++){
+		sum += (*single)()[0];
+	}
+	const long single_ms = (boost::posix_time::microsec_clock::local_time() - start).total_milliseconds();
+	std::vector<double> points(n * gen.get_dimension());
+	start = boost::posix_time::microsec_clock::local_time();
+	gen.generate(&points[0],n);
+	const long batch_ms = (boost::posix_time::microsec_clock::local_time() - start).total_milliseconds();
+	std::cout << name << ", " << n << " points in dimension " << gen.get_dimension() << ": one at a time " << single_ms
+		<< " ms, batched " << batch_ms << " ms (checksum " << sum + points[0] << ")" << std::endl;
+}
+
+int main()
+{
+	if(test_batch(halton(5),"halton") || test_batch(faure(5),"faure") || test_batch(simplex(4,1),"simplex") ||
+		test_batch(sobol(7),"sobol batches") || test_batch(sobol(7,100),"sobol batches (from 100)") || test_sobol())
+	{
+		return 1;
+	}
+	halton h(10);
+	faure f(10);
+	sobol s(10);
+	benchmark(h,"halton");
+	benchmark(f,"faure");
+	benchmark(s,"sobol");
+	return 0;
+}
@@ -0,0 +1,188 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the dynamic hypervolume structures
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include "../src/rng.h"
+#include "../src/util/hypervolume.h"
+
+using namespace pagmo;
+using namespace pagmo::util;
+
+// Hypervolume from scratch, also for empty or degenerate sets.
+double reference_hv(const std::vector<fitness_vector> &points, const fitness_vector &r_point)
+{
+	if(points.empty()){
+		return 0;
+	}
+	std::vector<fitness_vector> cpy(points);
+	return hypervolume(cpy, false).compute(r_point, hv_algorithm::base_ptr(new hv_algorithm::wfg()));
+}
+
+bool close(double a, double b)
+{
+	return std::fabs(a - b) <= 1e-9 * std::max(1., std::fabs(b));
+}
+
+// Random insertions and erasures on a coarse grid (so that there are plenty of duplicate and dominated points), checking
+// the total hypervolume and all the contributions against the computation from scratch.
+int test_random(const fitness_vector &r_point, const std::string &name)
+{
+	std::cout << "Testing " << name << ": ";
+	rng_uint32 urng(42);
+	hypervolume hv(std::vector<fitness_vector>(1, fitness_vector(r_point.size(), 0.)), false);
+	dynamic_hypervolume_ptr dyn = hv.get_dynamic(r_point);
+	std::vector<dynamic_hypervolume::size_type> handles(1, 0);
+	for(int step = 0; step < 600; step++){
+		if(handles.size() < 5 || (handles.size() < 40 && boost::uniform_int<int>(0, 2)(urng))){
+			fitness_vector p(r_point.size());
+			for(fitness_vector::size_type j = 0; j < p.size(); j++){
+				p[j] = boost::uniform_int<int>(0, static_cast<int>(r_point[j]))(urng);
+			}
+			handles.push_back(dyn->insert(p));
+		} else {
+			// Erase either the least contributor or a random point.
+			std::vector<dynamic_hypervolume::size_type>::iterator it = handles.begin() + boost::uniform_int<std::size_t>(0, handles.size() - 1)(urng);
+			if(step % 3 == 0){
+				it = std::find(handles.begin(), handles.end(), dyn->least_contributor());
+			}
+			dyn->erase(*it);
+			handles.erase(it);
+		}
+		std::vector<fitness_vector> points;
+		for(std::size_t i = 0; i < handles.size(); i++){
+			points.push_back(dyn->get_point(handles[i]));
+		}
+		const double total = reference_hv(points, r_point);
+		if(!close(dyn->get_hypervolume(), total) || dyn->size() != handles.size()){
+			std::cout << "FAILED (hypervolume at step " << step << ": " << dyn->get_hypervolume() << " instead of " << total << ")" << std::endl;
+			return 1;
+		}
+		double least = 0, greatest = 0;
+		for(std::size_t i = 0; i < handles.size(); i++){
+			std::vector<fitness_vector> others(points);
+			others.erase(others.begin() + i);
+			const double c = total - reference_hv(others, r_point);
+			if(!close(dyn->exclusive(handles[i]), c)){
+				std::cout << "FAILED (contribution at step " << step << ")" << std::endl;
+				return 1;
+			}
+			least = (i == 0) ? c : std::min(least, c);
+			greatest = (i == 0) ? c : std::max(greatest, c);
+		}
+		if(!close(dyn->exclusive(dyn->least_contributor()), least) || !close(dyn->exclusive(dyn->greatest_contributor()), greatest)){
+			std::cout << "FAILED (extreme contributors at step " << step << ")" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Invalid points and handles must be rejected.
+int test_errors()
+{
+	std::cout << "Testing errors: ";
+	dynamic_hv2d dyn(fitness_vector(2, 1.));
+	const dynamic_hypervolume::size_type h = dyn.insert(fitness_vector(2, 0.5));
+	int n_caught = 0;
+	try { dyn.insert(fitness_vector(2, 2.)); } catch(const value_error &) { n_caught++; }
+	try { dyn.insert(fitness_vector(3, 0.)); } catch(const value_error &) { n_caught++; }
+	try { dyn.erase(h + 1); } catch(const index_error &) { n_caught++; }
+	try { dynamic_hv3d d3(fitness_vector(2, 1.)); } catch(const value_error &) { n_caught++; }
+	try { hypervolume(std::vector<fitness_vector>(1, fitness_vector(4, 0.))).get_dynamic(fitness_vector(4, 1.)); } catch(const value_error &) { n_caught++; }
+	dyn.erase(h);
+	try { dyn.least_contributor(); } catch(const value_error &) { n_caught++; }
+	if(n_caught != 6 || dyn.get_hypervolume() != 0 || dyn.contains(h)){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Point of a front in 2 or 3 dimensions, moved along the last objective by the given offset.
+fitness_vector front_point(rng_double &drng, fitness_vector::size_type dim, double offset)
+{
+	fitness_vector p(dim);
+	const double t = boost::uniform_real<double>(0, 1)(drng);
+	p[0] = t;
+	if(dim == 2){
+		p[1] = 1 - std::sqrt(t);
+	} else {
+		p[1] = boost::uniform_real<double>(0, 1)(drng);
+		p[2] = 1 - (t + p[1]) / 2;
+	}
+	p[dim - 1] += offset;
+	return p;
+}
+
+// Steady-state selection on a front: insert one point, remove the least contributor.
+void benchmark(fitness_vector::size_type dim)
+{
+	const unsigned int n = 500, steps = 20;
+	rng_double drng(7);
+	fitness_vector r_point(dim, 1.1);
+	std::vector<fitness_vector> front;
+	for(unsigned int i = 0; i < n; i++){
+		front.push_back(front_point(drng, dim, 0));
+	}
+	std::vector<fitness_vector> offspring;
+	for(unsigned int i = 0; i < steps; i++){
+		offspring.push_back(front_point(drng, dim, boost::uniform_real<double>(-0.01, 0.01)(drng)));
+	}
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	std::vector<fitness_vector> points(front);
+	for(unsigned int i = 0; i < steps; i++){
+		points.push_back(offspring[i]);
+		points.erase(points.begin() + hypervolume(points, false).least_contributor(r_point));
+	}
+	const long static_ms = (boost::posix_time::microsec_clock::local_time() - start).total_milliseconds();
+	start = boost::posix_time::microsec_clock::local_time();
+	dynamic_hypervolume_ptr dyn = hypervolume(front, false).get_dynamic(r_point);
+	for(unsigned int i = 0; i < steps; i++){
+		dyn->insert(offspring[i]);
+		dyn->erase(dyn->least_contributor());
+	}
+	const long dynamic_ms = (boost::posix_time::microsec_clock::local_time() - start).total_milliseconds();
+	std::cout << steps << " steady-state steps on " << n << " points in " << dim << " dimensions: recomputed " << static_ms << " ms, dynamic "
+		<< dynamic_ms << " ms (hypervolume " << hypervolume(points, false).compute(r_point) << " vs " << dyn->get_hypervolume() << ")" << std::endl;
+}
+
+int main()
+{
+	if(test_random(fitness_vector(2, 20.), "dynamic_hv2d") || test_random(fitness_vector(3, 8.), "dynamic_hv3d") || test_errors()){
+		return 1;
+	}
+	benchmark(2);
+	benchmark(3);
+	return 0;
+}
@@ -0,0 +1,257 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the batched Monte Carlo sampling of the approximated hypervolume algorithms
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../src/rng.h"
+#include "../src/util/hypervolume.h"
+#include "../src/util/hv_algorithm/mc_sampler.h"
+
+using namespace pagmo;
+using namespace pagmo::util;
+
+struct testcase
+{
+	fitness_vector			r_point;
+	std::vector<fitness_vector>	points;
+	double				answer;
+};
+
+// Reads the testcases of a file of hypervolume_test_data.
+std::vector<testcase> load(const std::string &name)
+{
+	std::vector<testcase> retval;
+	std::ifstream input(("hypervolume_test_data/testcases/" + name).c_str());
+	int n_tests = 0;
+	input >> n_tests;
+	for (int t = 0; t < n_tests && input; ++t) {
+		int f_dim, n_points;
+		input >> f_dim >> n_points;
+		testcase tc;
+		tc.r_point.resize(f_dim);
+		for (int d = 0; d < f_dim; ++d) {
+			input >> tc.r_point[d];
+		}
+		tc.points.resize(n_points, fitness_vector(f_dim));
+		for (int i = 0; i < n_points; ++i) {
+			for (int d = 0; d < f_dim; ++d) {
+				input >> tc.points[i][d];
+			}
+		}
+		input >> tc.answer;
+		retval.push_back(tc);
+	}
+	return retval;
+}
+
+// The counts of the sampler against a scalar count of the non-dominated samples, on a coarse grid (so that there are
+// plenty of ties) and with partial blocks.
+int test_sampler()
+{
+	rng_double drng(42);
+	const unsigned int dim = 4, n_points = 37;
+	std::vector<fitness_vector> points(n_points, fitness_vector(dim));
+	for (unsigned int i = 0; i < n_points; ++i) {
+		for (unsigned int d = 0; d < dim; ++d) {
+			points[i][d] = std::floor(drng() * 5);
+		}
+	}
+	std::vector<unsigned int> subset;
+	for (unsigned int i = 0; i < n_points; i += 3) {
+		subset.push_back(i);
+	}
+	const hv_algorithm::mc_sampler all(points), some(points, subset);
+	const unsigned int n_samples[] = {1, 7, 200, hv_algorithm::mc_sampler::block_size};
+	std::vector<double> samples(hv_algorithm::mc_sampler::block_size * dim);
+	for (int b = 0; b < 4; ++b) {
+		for (unsigned int s = 0; s < n_samples[b]; ++s) {
+			for (unsigned int d = 0; d < dim; ++d) {
+				samples[d * hv_algorithm::mc_sampler::block_size + s] = std::floor(drng() * 6);
+			}
+		}
+		unsigned int expected_all = 0, expected_some = 0;
+		for (unsigned int s = 0; s < n_samples[b]; ++s) {
+			bool free_all = true, free_some = true;
+			for (unsigned int i = 0; i < n_points; ++i) {
+				bool dominates = true;
+				for (unsigned int d = 0; d < dim; ++d) {
+					dominates = dominates && points[i][d] <= samples[d * hv_algorithm::mc_sampler::block_size + s];
+				}
+				free_all = free_all && !dominates;
+				free_some = free_some && !(dominates && i % 3 == 0);
+			}
+			expected_all += free_all;
+			expected_some += free_some;
+		}
+		// The block is overwritten by the sampler.
+		std::vector<double> copy(samples);
+		unsigned long long tests_all, tests_some;
+		const unsigned int count_all = all.count_non_dominated(&samples[0], n_samples[b], tests_all);
+		const unsigned int count_some = some.count_non_dominated(&copy[0], n_samples[b], tests_some);
+		// The non-dominated samples are tested against every point, the dominated ones at least against one.
+		if (count_all != expected_all || count_some != expected_some ||
+			tests_all < n_samples[b] + count_all * (n_points - 1) || tests_all > n_samples[b] * n_points ||
+			tests_some < n_samples[b] + count_some * (subset.size() - 1) || tests_some > n_samples[b] * subset.size())
+		{
+			std::cout << "Wrong count for a block of " << n_samples[b] << " samples" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "Sampler counts: OK" << std::endl;
+	return 0;
+}
+
+hv_algorithm::base_ptr make_fpras(const double eps, const unsigned int n_threads, const bool early_stop)
+{
+	hv_algorithm::bf_fpras *method = new hv_algorithm::bf_fpras(eps, 1e-2);
+	method->set_n_threads(n_threads);
+	method->set_early_stop(early_stop);
+	return hv_algorithm::base_ptr(method);
+}
+
+hv_algorithm::base_ptr make_approx(const unsigned int n_threads)
+{
+	hv_algorithm::bf_approx *method = new hv_algorithm::bf_approx();
+	method->set_n_threads(n_threads);
+	return hv_algorithm::base_ptr(method);
+}
+
+// The approximation must be within eps of the exact hypervolume (the probability of failure over these testcases being
+// negligible), and the same for any number of threads.
+int test_fpras(const std::string &name, const unsigned int n_tests, const double eps, const bool early_stop)
+{
+	std::vector<testcase> tcs = load(name);
+	if (tcs.empty()) {
+		std::cout << "Could not load " << name << std::endl;
+		return 1;
+	}
+	tcs.resize(std::min<std::vector<testcase>::size_type>(tcs.size(), n_tests));
+	std::cout << "bf_fpras " << name << (early_stop ? " (early stop)" : "") << ":";
+	const unsigned int threads[] = {1, 3, 8};
+	std::vector<double> serial;
+	for (int i = 0; i < 3; ++i) {
+		const hv_algorithm::base_ptr method = make_fpras(eps, threads[i], early_stop);
+		const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+		for (std::vector<testcase>::size_type t = 0; t < tcs.size(); ++t) {
+			std::vector<fitness_vector> points(tcs[t].points);
+			const double hv = hypervolume(points, false).compute(tcs[t].r_point, method);
+			if (std::fabs(hv - tcs[t].answer) > eps * tcs[t].answer) {
+				std::cout << "\nApproximation of test " << t << " out of bounds: " << hv << " instead of " << tcs[t].answer << std::endl;
+				return 1;
+			}
+			if (i == 0) {
+				serial.push_back(hv);
+			} else if (hv != serial[t]) {
+				std::cout << "\nMismatch in test " << t << " with " << threads[i] << " threads: " << hv << " instead of " << serial[t] << std::endl;
+				return 1;
+			}
+		}
+		std::cout << " " << threads[i] << " thread(s) " << (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1e-6 << "s";
+	}
+	std::cout << std::endl;
+	return 0;
+}
+
+// The estimate must be unbiased, even with a small budget (in which the draws of the rounds left unfinished by the
+// chains would be significant): the mean of repeated approximations must be within 4 standard errors of the exact value.
+int test_fpras_bias(const std::string &name, const double eps, const unsigned int n_runs)
+{
+	std::vector<testcase> tcs = load(name);
+	if (tcs.empty()) {
+		std::cout << "Could not load " << name << std::endl;
+		return 1;
+	}
+	const hv_algorithm::base_ptr method = make_fpras(eps, 1, false);
+	double sum = 0, sum2 = 0;
+	for (unsigned int r = 0; r < n_runs; ++r) {
+		std::vector<fitness_vector> points(tcs[0].points);
+		const double x = hypervolume(points, false).compute(tcs[0].r_point, method) / tcs[0].answer;
+		sum += x;
+		sum2 += x * x;
+	}
+	const double mean = sum / n_runs, stderr_mean = std::sqrt(std::max(0., (sum2 - mean * sum) / (n_runs - 1)) / n_runs);
+	std::cout << "bf_fpras " << name << " bias: " << mean - 1 << " (standard error " << stderr_mean << ")" << std::endl;
+	if (std::fabs(mean - 1) > 4 * stderr_mean) {
+		std::cout << "Biased approximation" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// The least contributor must have a contribution within the accuracy of the algorithm from the smallest one, and be the
+// same for any number of threads.
+int test_approx(const std::string &name, const unsigned int n_tests)
+{
+	std::vector<testcase> tcs = load(name);
+	if (tcs.empty()) {
+		std::cout << "Could not load " << name << std::endl;
+		return 1;
+	}
+	tcs.resize(std::min<std::vector<testcase>::size_type>(tcs.size(), n_tests));
+	std::cout << "bf_approx " << name << ":";
+	const unsigned int threads[] = {1, 3, 8};
+	std::vector<unsigned int> serial;
+	for (int i = 0; i < 3; ++i) {
+		const hv_algorithm::base_ptr method = make_approx(threads[i]);
+		const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+		for (std::vector<testcase>::size_type t = 0; t < tcs.size(); ++t) {
+			std::vector<fitness_vector> points(tcs[t].points);
+			const unsigned int lc = hypervolume(points, false).least_contributor(tcs[t].r_point, method);
+			const std::vector<double> c = hypervolume(points, false).contributions(tcs[t].r_point, hv_algorithm::base_ptr(new hv_algorithm::wfg()));
+			// (allowing for the rounding errors of the exact contributions, some of which are zero)
+			const double c_min = *std::min_element(c.begin(), c.end()), c_max = *std::max_element(c.begin(), c.end());
+			if (c[lc] > c_min + 1e-1 * std::fabs(c_min) + 1e-9 * c_max) {
+				std::cout << "\nWrong least contributor in test " << t << " with " << threads[i] << " threads: " << lc << " contributes " << c[lc] << std::endl;
+				return 1;
+			}
+			if (i == 0) {
+				serial.push_back(lc);
+			} else if (lc != serial[t]) {
+				std::cout << "\nMismatch in test " << t << " with " << threads[i] << " threads: " << lc << " instead of " << serial[t] << std::endl;
+				return 1;
+			}
+		}
+		std::cout << " " << threads[i] << " thread(s) " << (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1e-6 << "s";
+	}
+	std::cout << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_sampler() ||
+		test_fpras_bias("c_max_t100_d3_n128", 0.5, 400) ||
+		test_fpras("c_max_t100_d3_n128", 10, 5e-2, false) ||
+		test_fpras("c_max_t100_d3_n128", 10, 5e-2, true) ||
+		test_fpras("c_max_t1_d5_n1024", 1, 5e-2, false) ||
+		test_fpras("c_max_t1_d5_n1024", 1, 5e-2, true) ||
+		test_approx("c_max_t100_d3_n128", 10);
+}
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Benchmark of the parallel modes of WFG and HOY on the compute testcases of hypervolume_test_data
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../src/util/hypervolume.h"
+
+using namespace pagmo;
+using namespace pagmo::util;
+
+struct testcase
+{
+	fitness_vector			r_point;
+	std::vector<fitness_vector>	points;
+	double				hv;
+};
+
+// Reads the testcases of a 'compute' file of hypervolume_test_data.
+std::vector<testcase> load(const std::string &name)
+{
+	std::vector<testcase> retval;
+	std::ifstream input(("hypervolume_test_data/testcases/" + name).c_str());
+	int n_tests = 0;
+	input >> n_tests;
+	for (int t = 0; t < n_tests && input; ++t) {
+		int f_dim, n_points;
+		input >> f_dim >> n_points;
+		testcase tc;
+		tc.r_point.resize(f_dim);
+		for (int d = 0; d < f_dim; ++d) {
+			input >> tc.r_point[d];
+		}
+		tc.points.resize(n_points, fitness_vector(f_dim));
+		for (int i = 0; i < n_points; ++i) {
+			for (int d = 0; d < f_dim; ++d) {
+				input >> tc.points[i][d];
+			}
+		}
+		input >> tc.hv;
+		retval.push_back(tc);
+	}
+	return retval;
+}
+
+// Computes all the testcases with the given method, returning the elapsed time in seconds.
+double run(const std::vector<testcase> &tcs, const hv_algorithm::base_ptr &method, std::vector<double> &results)
+{
+	results.clear();
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	for (std::vector<testcase>::size_type t = 0; t < tcs.size(); ++t) {
+		std::vector<fitness_vector> points(tcs[t].points);
+		results.push_back(hypervolume(points, false).compute(tcs[t].r_point, method));
+	}
+	return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1e-6;
+}
+
+template <class Algo>
+hv_algorithm::base_ptr make_method(const unsigned int n_threads)
+{
+	Algo *method = new Algo();
+	method->set_n_threads(n_threads);
+	return hv_algorithm::base_ptr(method);
+}
+
+// Checks that the parallel modes agree with the serial ones (exactly for WFG, up to rounding for HOY) and
+// with the expected values, for several numbers of threads.
+template <class Algo>
+int bench(const std::string &algo_name, const std::string &name, const bool exact)
+{
+	const std::vector<testcase> tcs = load(name);
+	if (tcs.empty()) {
+		std::cout << "Could not load " << name << std::endl;
+		return 1;
+	}
+	std::vector<double> serial, parallel;
+	const double t_serial = run(tcs, make_method<Algo>(1), serial);
+	std::cout << algo_name << " " << name << ": 1 thread " << t_serial << "s";
+	for (std::vector<testcase>::size_type t = 0; t < tcs.size(); ++t) {
+		if (std::fabs(serial[t] - tcs[t].hv) > 1e-8 * std::max(1., std::fabs(tcs[t].hv))) {
+			std::cout << "\nWrong serial result in test " << t << ": " << serial[t] << " instead of " << tcs[t].hv << std::endl;
+			return 1;
+		}
+	}
+	const unsigned int threads[] = {2, 4, 8};
+	for (int i = 0; i < 3; ++i) {
+		const double t_parallel = run(tcs, make_method<Algo>(threads[i]), parallel);
+		std::cout << ", " << threads[i] << " threads " << t_parallel << "s";
+		for (std::vector<testcase>::size_type t = 0; t < tcs.size(); ++t) {
+			if (exact ? parallel[t] != serial[t] : std::fabs(parallel[t] - serial[t]) > 1e-10 * std::max(1., std::fabs(serial[t]))) {
+				std::cout << "\nMismatch in test " << t << " with " << threads[i] << " threads: " << parallel[t] << " instead of " << serial[t] << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return bench<hv_algorithm::wfg>("WFG", "c_max_t1_d5_n1024", true) ||
+		bench<hv_algorithm::wfg>("WFG", "c_max_t100_d3_n128", true) ||
+		bench<hv_algorithm::hoy>("HOY", "c_max_t1_d5_n1024", false) ||
+		bench<hv_algorithm::hoy>("HOY", "c_max_t100_d3_n128", false);
+}
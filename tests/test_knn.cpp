@@ -0,0 +1,127 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the k-nearest-neighbours index
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/knn.h"
+
+using namespace pagmo;
+using util::neighbourhood::knn;
+
+// Reference answer: all the distances, fully sorted by (distance, index).
+void reference(std::vector<population::size_type> &idx, std::vector<double> &dist, const std::vector<std::vector<double> > &points, const std::vector<double> &x, population::size_type k)
+{
+	std::vector<std::pair<double,population::size_type> > all;
+	for(population::size_type i = 0; i < points.size(); i++){
+		double d2 = 0.;
+		for(unsigned int j = 0; j < x.size(); j++){
+			d2 += (x[j] - points[i][j]) * (x[j] - points[i][j]);
+		}
+		all.push_back(std::make_pair(d2, i));
+	}
+	std::sort(all.begin(), all.end());
+	k = std::min<population::size_type>(k, points.size());
+	idx.resize(k);
+	dist.resize(k);
+	for(population::size_type i = 0; i < k; i++){
+		idx[i] = all[i].second;
+		dist[i] = std::sqrt(all[i].first);
+	}
+}
+
+// Random points, rounded to a grid in order to have many ties.
+std::vector<std::vector<double> > random_points(population::size_type n, unsigned int dim, bool grid, unsigned int seed)
+{
+	rng_double drng(seed);
+	boost::uniform_real<double> uniform(0.0,1.0);
+	std::vector<std::vector<double> > retval(n, std::vector<double>(dim));
+	for(population::size_type i = 0; i < n; i++){
+		for(unsigned int j = 0; j < dim; j++){
+			retval[i][j] = uniform(drng);
+			if(grid){
+				retval[i][j] = std::floor(retval[i][j] * 4) / 4;
+			}
+		}
+	}
+	return retval;
+}
+
+int test_knn(population::size_type n, unsigned int dim, bool grid, knn::method_type method)
+{
+	std::cout << "Testing knn, " << n << " points of dimension " << dim << (grid ? " on a grid" : "") << ", method " << method << ": ";
+	const std::vector<std::vector<double> > points = random_points(n, dim, grid, n + dim);
+	const knn index(points, method);
+	const population::size_type ks[] = {1, 2, 5, 17, n / 3, n, n + 10};
+	for(unsigned int ik = 0; ik < sizeof(ks) / sizeof(ks[0]); ik++){
+		const population::size_type k = ks[ik];
+		std::vector<std::vector<population::size_type> > idx;
+		std::vector<std::vector<double> > dist;
+		index.query_all(idx, dist, k);
+		std::vector<population::size_type> ref_idx, q_idx;
+		std::vector<double> ref_dist, q_dist;
+		for(population::size_type i = 0; i < n; i++){
+			reference(ref_idx, ref_dist, points, points[i], k);
+			if(idx[i] != ref_idx || dist[i] != ref_dist){
+				std::cout << "FAILED (query_all, k = " << k << ")" << std::endl;
+				return 1;
+			}
+		}
+		// Points that are not in the set.
+		const std::vector<std::vector<double> > queries = random_points(20, dim, grid, 1000 + n);
+		for(unsigned int i = 0; i < queries.size(); i++){
+			reference(ref_idx, ref_dist, points, queries[i], k);
+			index.query(q_idx, q_dist, queries[i], k);
+			if(q_idx != ref_idx || q_dist != ref_dist){
+				std::cout << "FAILED (query, k = " << k << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	int retval = 0;
+	const knn::method_type methods[] = {knn::AUTO, knn::KD_TREE, knn::BRUTE_FORCE};
+	for(unsigned int m = 0; m < 3; m++){
+		retval = retval || test_knn(1, 2, false, methods[m]) ||
+			test_knn(10, 2, false, methods[m]) ||
+			test_knn(300, 2, false, methods[m]) ||
+			test_knn(300, 3, true, methods[m]) ||
+			test_knn(500, 5, false, methods[m]) ||
+			test_knn(200, 30, false, methods[m]) ||
+			test_knn(100, 1, true, methods[m]);
+	}
+	return retval;
+}
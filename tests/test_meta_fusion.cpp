@@ -0,0 +1,191 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the evaluation of chains of meta-problems (collapsed affine transformations and work spaces)
+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/parallel.h"
+
+using namespace pagmo;
+
+const double EPS = 1e-9;
+
+bool is_eq(const std::vector<double> &v1, const std::vector<double> &v2)
+{
+	if(v1.size() != v2.size()) return false;
+	for(unsigned int i = 0; i < v1.size(); i++){
+		if(std::fabs(v1[i]-v2[i]) > EPS * std::max(1.0, std::fabs(v2[i]))) return false;
+	}
+	return true;
+}
+
+// Transformation applied by one layer of a chain to the decision vector.
+decision_vector transform(const problem::base &layer, const decision_vector &x)
+{
+	if(const problem::shifted *s = dynamic_cast<const problem::shifted *>(&layer)){
+		return s->deshift(x);
+	}
+	if(const problem::rotated *r = dynamic_cast<const problem::rotated *>(&layer)){
+		return r->derotate(x);
+	}
+	const problem::normalized &n = dynamic_cast<const problem::normalized &>(layer);
+	return n.denormalize(x);
+}
+
+// Compares the chain (layers[0] is the outermost meta-problem, inner the innermost problem)
+// with the evaluation of inner on the decision vector transformed layer by layer.
+int test_chain(const std::vector<problem::base_ptr> &layers, const problem::base &inner)
+{
+	const problem::base &chain = *layers[0];
+	std::cout << "Testing " << chain.get_name() << ": ";
+	// The bounds of rotated problems are relaxed: many points will test the projection to the original bounds.
+	population pop(chain, 50, 42);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		decision_vector y = x;
+		for(unsigned int j = 0; j < layers.size(); j++){
+			y = transform(*layers[j], y);
+		}
+		if(!is_eq(chain.objfun(x), inner.objfun(y)) || !is_eq(chain.compute_constraints(x), inner.compute_constraints(y))){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+		// A copy (with its own collapsed transformation) must agree.
+		problem::base_ptr copy = chain.clone();
+		if(copy->objfun(x) != chain.objfun(x)){
+			std::cout << "FAILED: the copy differs" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Builds the chain described by ops (outermost first: 's' shifted, 'r' rotated, 'n' normalized) over inner.
+int test_chain(const std::string &ops, const problem::base &inner)
+{
+	std::vector<problem::base_ptr> layers(ops.size());
+	problem::base_ptr current = inner.clone();
+	for(int i = (int)ops.size() - 1; i >= 0; i--){
+		switch(ops[i]){
+		case 's':
+			current = problem::shifted(*current).clone();
+			break;
+		case 'r':
+			current = problem::rotated(*current).clone();
+			break;
+		default:
+			current = problem::normalized(*current).clone();
+		}
+		layers[i] = current;
+	}
+	return test_chain(layers, inner);
+}
+
+// Meta-problems evaluating the original problem without transformation must give its results.
+int test_constrained_chains()
+{
+	std::cout << "Testing death_penalty and con2mo over a shifted problem: ";
+	problem::cec2006 g7(7);
+	problem::shifted shifted(g7, 1.0);
+	problem::death_penalty dp(shifted, problem::death_penalty::KURI);
+	problem::con2mo c2mo(shifted, problem::con2mo::OBJ_CSTRS);
+	problem::death_penalty dp_ref(g7, problem::death_penalty::KURI);
+	problem::con2mo c2mo_ref(g7, problem::con2mo::OBJ_CSTRS);
+	population pop(shifted, 50, 42);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		const decision_vector &x = pop.get_individual(i).cur_x;
+		const decision_vector y = shifted.deshift(x);
+		if(dp.objfun(x) != dp_ref.objfun(y) || c2mo.objfun(x) != c2mo_ref.objfun(y)){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Evaluates the points of a population with a shared problem.
+struct evaluation_task
+{
+	evaluation_task(const problem::base &prob, const population &pop, std::vector<fitness_vector> &f):
+		m_prob(prob), m_pop(pop), m_f(f) {}
+	void operator()(std::size_t i, unsigned int)
+	{
+		m_f[i] = m_prob.objfun(m_pop.get_individual(i % m_pop.size()).cur_x);
+	}
+	const problem::base &m_prob;
+	const population &m_pop;
+	std::vector<fitness_vector> &m_f;
+};
+
+// Chains nested below a non-affine meta-problem use the work space of the next level, and concurrent evaluations
+// those of their own threads.
+int test_nested_chains()
+{
+	std::cout << "Testing nested chains from several threads: ";
+	problem::cec2006 g7(7);
+	problem::rotated rotated(g7);
+	problem::shifted inner(rotated, 1.0);
+	problem::shifted outer(problem::death_penalty(inner, problem::death_penalty::KURI), 0.5);
+	problem::death_penalty ref(g7, problem::death_penalty::KURI);
+	population pop(outer, 50, 42);
+	std::vector<fitness_vector> f(4 * pop.size());
+	evaluation_task task(outer, pop, f);
+	util::parallel::for_each_index(f.size(), 4, task);
+	for(std::size_t i = 0; i < f.size(); i++){
+		const decision_vector &x = pop.get_individual(i % pop.size()).cur_x;
+		if(!is_eq(f[i], ref.objfun(rotated.derotate(inner.deshift(outer.deshift(x)))))){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	srand(123);
+	problem::rastrigin rastrigin(10);
+	problem::zdt zdt1(1, 10);
+	problem::cec2006 g7(7);
+	return test_chain("s", rastrigin) ||
+	       test_chain("r", rastrigin) ||
+	       test_chain("n", zdt1) ||
+	       test_chain("rs", rastrigin) ||
+	       test_chain("sr", rastrigin) ||
+	       test_chain("srs", zdt1) ||
+	       test_chain("nrs", rastrigin) ||
+	       test_chain("rnr", zdt1) ||
+	       test_chain("rsrn", rastrigin) ||
+	       test_chain("sn", g7) ||
+	       test_chain("rs", g7) ||
+	       test_constrained_chains() ||
+	       test_nested_chains();
+}
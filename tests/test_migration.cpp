@@ -0,0 +1,207 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the evaluation-free migration
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// Number of calls to the objective function of counting_rosenbrock.
+unsigned int n_evals = 0;
+
+// Rosenbrock problem counting its evaluations.
+class counting_rosenbrock : public problem::rosenbrock
+{
+	public:
+		counting_rosenbrock(int n):problem::rosenbrock(n) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new counting_rosenbrock(*this));
+		}
+	protected:
+		void objfun_impl(fitness_vector &f, const decision_vector &x) const
+		{
+			++n_evals;
+			problem::rosenbrock::objfun_impl(f,x);
+		}
+};
+
+// The replacement policies must select on the known fitness of the immigrants.
+int test_r_policy(const migration::base_r_policy &policy, const std::string &name, const problem::base &prob)
+{
+	std::cout << "Testing " << name << ": ";
+	population dest(prob,20,0), src(prob,10,1);
+	std::vector<population::individual_type> immigrants(src.begin(),src.end());
+	const unsigned int n_evals_before = n_evals;
+	const std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> > result = policy.select(immigrants,dest);
+	if(n_evals != n_evals_before){
+		std::cout << "FAILED (" << n_evals - n_evals_before << " evaluations)" << std::endl;
+		return 1;
+	}
+	if(result.empty()){
+		std::cout << "FAILED (no replacement)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Immigrants must be re-evaluated only when the source and destination problems differ.
+int test_archipelago()
+{
+	std::cout << "Testing archipelago: ";
+	archipelago a(algorithm::de(5), problem::rosenbrock(5), 4, 20, topology::ring());
+	a.evolve(5);
+	a.join();
+	const boost::uint64_t saved = a.get_saved_evaluations();
+	if(saved == 0){
+		std::cout << "FAILED (no saved evaluation)" << std::endl;
+		return 1;
+	}
+	// The fitness of the inserted immigrants must still be exact.
+	for(archipelago::size_type i = 0; i < a.get_size(); i++){
+		const population pop = a.get_island(i)->get_population();
+		for(population::size_type j = 0; j < pop.size(); j++){
+			if(pop.get_individual(j).cur_f != pop.problem().objfun(pop.get_individual(j).cur_x)){
+				std::cout << "FAILED (fitness)" << std::endl;
+				return 1;
+			}
+		}
+	}
+	// Islands with different bounds are not identical.
+	problem::rosenbrock wide(5), narrow(5);
+	narrow.set_bounds(-1,1);
+	const topology::ring ring;
+	archipelago b(ring);
+	for(int i = 0; i < 4; i++){
+		b.push_back(island(algorithm::de(5),i % 2 ? wide : narrow,20));
+	}
+	b.evolve(5);
+	b.join();
+	if(b.get_saved_evaluations() != 0){
+		std::cout << "FAILED (bounds)" << std::endl;
+		return 1;
+	}
+	// Islands whose problems differ only in their parameters are not identical.
+	std::vector<double> w1(2), w2(2);
+	w1[0] = 0.2;
+	w1[1] = 0.8;
+	w2[0] = 0.8;
+	w2[1] = 0.2;
+	const problem::decompose d1(problem::zdt(1,5),problem::decompose::WEIGHTED,w1), d2(problem::zdt(1,5),problem::decompose::WEIGHTED,w2);
+	archipelago d(ring);
+	for(int i = 0; i < 4; i++){
+		d.push_back(island(algorithm::de(5),i % 2 ? d1 : d2,20));
+	}
+	d.evolve(5);
+	d.join();
+	if(d.get_saved_evaluations() != 0){
+		std::cout << "FAILED (parameters)" << std::endl;
+		return 1;
+	}
+	for(archipelago::size_type i = 0; i < d.get_size(); i++){
+		const population pop = d.get_island(i)->get_population();
+		for(population::size_type j = 0; j < pop.size(); j++){
+			if(pop.get_individual(j).cur_f != pop.problem().objfun(pop.get_individual(j).cur_x)){
+				std::cout << "FAILED (fitness with parameters)" << std::endl;
+				return 1;
+			}
+		}
+	}
+	// Stochastic problems are always re-evaluated.
+	archipelago c(algorithm::de(5), problem::noisy(problem::rosenbrock(5)), 4, 20, topology::ring());
+	c.evolve(5);
+	c.join();
+	if(c.get_saved_evaluations() != 0){
+		std::cout << "FAILED (stochastic)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED (" << saved << " evaluations saved)" << std::endl;
+	return 0;
+}
+
+// Selecting a few individuals out of a large population must only partially sort it. The size of the population
+// can be given on the command line, e.g. "test_migration 10000" for the microbenchmark (building the population
+// itself is much slower than the selection).
+int test_partial_selection(population::size_type np)
+{
+	std::cout << "Testing partial selection: ";
+	const population::size_type n = 2;
+	population pop(problem::rosenbrock(10),np,0);
+	// Reference: sort the whole population.
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	std::vector<population::size_type> ref(np);
+	for(population::size_type i = 0; i < np; i++){
+		ref[i] = i;
+	}
+	std::sort(ref.begin(),ref.end(),population::trivial_comparison_operator(pop));
+	const long full_us = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds();
+	start = boost::posix_time::microsec_clock::local_time();
+	const std::vector<population::size_type> best = pop.get_best_idx(n), worst = pop.get_worst_idx(n);
+	const long partial_us = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds();
+	if(best.size() != n || worst.size() != n || best[0] != ref[0] || best[1] != ref[1] || worst[0] != ref[np - 1] || worst[1] != ref[np - 2]){
+		std::cout << "FAILED (get_best_idx/get_worst_idx)" << std::endl;
+		return 1;
+	}
+	// Both replacement policies must target the worst natives.
+	population src(problem::rosenbrock(10),n,1);
+	const std::vector<population::individual_type> immigrants(src.begin(),src.end());
+	start = boost::posix_time::microsec_clock::local_time();
+	const std::vector<std::pair<population::size_type,std::vector<population::individual_type>::size_type> >
+		fair = migration::fair_r_policy(n).select(immigrants,pop), worst_r = migration::worst_r_policy(n).select(immigrants,pop);
+	const long policies_us = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds();
+	if(worst_r.size() != n || worst_r[0].first != ref[np - 1] || worst_r[1].first != ref[np - 2]){
+		std::cout << "FAILED (worst_r_policy)" << std::endl;
+		return 1;
+	}
+	for(std::vector<population::size_type>::size_type i = 0; i < fair.size(); i++){
+		if(fair[i].first != ref[np - 1 - i] || !pop.problem().compare_fc(immigrants[fair[i].second].cur_f,immigrants[fair[i].second].cur_c,
+			pop.get_individual(fair[i].first).cur_f,pop.get_individual(fair[i].first).cur_c))
+		{
+			std::cout << "FAILED (fair_r_policy)" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED (NP = " << np << ", full sort " << full_us << " us, best/worst " << n << " " << partial_us
+		<< " us, fair and worst policies " << policies_us << " us)" << std::endl;
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	const population::size_type np = argc > 1 ? boost::lexical_cast<population::size_type>(argv[1]) : 2000;
+	const counting_rosenbrock prob(5);
+	return test_r_policy(migration::fair_r_policy(5),"fair_r_policy",prob) ||
+		test_r_policy(migration::worst_r_policy(5),"worst_r_policy",prob) ||
+		test_r_policy(migration::hv_fair_r_policy(5),"hv_fair_r_policy",prob) ||
+		test_r_policy(migration::hv_greedy_r_policy(5),"hv_greedy_r_policy",prob) ||
+		test_archipelago() || test_partial_selection(np);
+}
@@ -0,0 +1,241 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the migration log
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+migration_log::record make_record(unsigned int i)
+{
+	migration_log::record r;
+	r.timestamp = i;
+	r.src = i;
+	r.dst = i + 1;
+	r.count = 1;
+	r.best_f = -static_cast<double>(i);
+	return r;
+}
+
+// The ring buffer must keep the most recent records, oldest first.
+int test_ring()
+{
+	std::cout << "Testing ring buffer: ";
+	migration_log log(10);
+	for(unsigned int i = 0; i < 25; i++){
+		log.push_back(make_record(i));
+	}
+	std::vector<migration_log::record> records = log.get_records();
+	if(records.size() != 10 || records.front().src != 15 || records.back().src != 24 || log.get_n_recorded() != 25){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	log.set_capacity(4);
+	log.push_back(make_record(25));
+	records = log.get_records();
+	if(records.size() != 4 || records.front().src != 22 || records.back().src != 25){
+		std::cout << "FAILED (capacity)" << std::endl;
+		return 1;
+	}
+	log.clear();
+	if(log.size() != 0 || log.get_n_recorded() != 26){
+		std::cout << "FAILED (clear)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// All the records pushed while the sink is open must be written to the file.
+int test_sink()
+{
+	std::cout << "Testing file sink: ";
+	const std::string path("test_migration_log.bin");
+	std::remove(path.c_str());
+	{
+		migration_log log(1000);
+		log.open_sink(path);
+		for(unsigned int i = 0; i < 500; i++){
+			log.push_back(make_record(i));
+		}
+		log.close_sink();
+		log.push_back(make_record(500));
+		if(log.get_n_dropped() != 0){
+			std::cout << "FAILED (dropped)" << std::endl;
+			return 1;
+		}
+	}
+	const std::vector<migration_log::record> records = migration_log::load(path);
+	std::remove(path.c_str());
+	if(records.size() != 500){
+		std::cout << "FAILED (size)" << std::endl;
+		return 1;
+	}
+	for(unsigned int i = 0; i < records.size(); i++){
+		if(records[i].timestamp != i || records[i].src != i || records[i].dst != i + 1 || records[i].count != 1 || records[i].best_f != -static_cast<double>(i)){
+			std::cout << "FAILED (record " << i << ")" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Pushes records into a log until stopped.
+struct pusher
+{
+	pusher(migration_log &log, boost::mutex &mutex, bool &stop):m_log(log),m_mutex(mutex),m_stop(stop) {}
+	void operator()()
+	{
+		for(unsigned int i = 0; ; i++){
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				if(m_stop){
+					return;
+				}
+			}
+			m_log.push_back(make_record(i));
+		}
+	}
+	migration_log &m_log;
+	boost::mutex &m_mutex;
+	bool &m_stop;
+};
+
+// The records pushed while a sink is being closed must not end up in the next sink.
+int test_sink_reopen()
+{
+	std::cout << "Testing sink reopening: ";
+	const std::string path("test_migration_log_a.bin"), next_path("test_migration_log_b.bin");
+	migration_log log(1000);
+	for(unsigned int round = 0; round < 500; round++){
+		std::remove(next_path.c_str());
+		boost::mutex mutex;
+		bool stop = false;
+		boost::thread thread((pusher(log,mutex,stop)));
+		log.open_sink(path);
+		boost::this_thread::yield();
+		log.close_sink();
+		{
+			boost::lock_guard<boost::mutex> lock(mutex);
+			stop = true;
+		}
+		thread.join();
+		log.open_sink(next_path);
+		log.close_sink();
+		if(!migration_log::load(next_path).empty()){
+			std::remove(path.c_str());
+			std::remove(next_path.c_str());
+			std::cout << "FAILED (round " << round << ")" << std::endl;
+			return 1;
+		}
+	}
+	std::remove(path.c_str());
+	std::remove(next_path.c_str());
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The archipelago must log its migrations, consistently with dump_migr_history().
+int test_archipelago()
+{
+	std::cout << "Testing archipelago: ";
+	archipelago a(algorithm::de(10), problem::rosenbrock(5), 4, 20, topology::ring());
+	a.get_migr_log().set_capacity(5);
+	a.evolve(10);
+	a.join();
+	const std::vector<migration_log::record> records = a.get_migr_log().get_records();
+	std::ostringstream oss;
+	for(unsigned int i = 0; i < records.size(); i++){
+		oss << "(" << records[i].count << "," << records[i].src << "," << records[i].dst << ")\n";
+		if(records[i].src >= 4 || records[i].dst >= 4 || records[i].count == 0 || records[i].timestamp <= 0){
+			std::cout << "FAILED (record)" << std::endl;
+			return 1;
+		}
+	}
+	if(records.size() != 5 || a.get_migr_log().get_n_recorded() < 5 || oss.str() != a.dump_migr_history()){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The fitness logged must be the one of the immigrant accepted by the replacement policy, not of the best one offered.
+int test_accepted_fitness()
+{
+	std::cout << "Testing fitness of the accepted immigrants: ";
+	for(unsigned int trial = 0; trial < 10; trial++){
+		// Island 0 offers its 5 best individuals to island 1, which accepts one of them at random.
+		archipelago a((topology::custom()));
+		for(unsigned int i = 0; i < 2; i++){
+			a.push_back(island(algorithm::null(), problem::rosenbrock(5), 20, 1, migration::best_s_policy(5), migration::random_r_policy(1)));
+		}
+		topology::custom t(*a.get_topology());
+		t.add_edge(0, 1);
+		a.set_topology(t);
+		const population before = a.get_island(1)->get_population();
+		for(unsigned int i = 0; i < 10 && a.get_migr_log().size() == 0; i++){
+			a.evolve(1);
+			a.join();
+		}
+		const std::vector<migration_log::record> records = a.get_migr_log().get_records();
+		if(records.size() != 1 || records[0].src != 0 || records[0].dst != 1 || records[0].count != 1){
+			std::cout << "FAILED (record)" << std::endl;
+			return 1;
+		}
+		// The only individual of island 1 that changed is the accepted immigrant.
+		const population after = a.get_island(1)->get_population();
+		unsigned int n_changed = 0;
+		for(population::size_type i = 0; i < after.size(); i++){
+			if(after.get_individual(i).cur_x != before.get_individual(i).cur_x){
+				++n_changed;
+				if(after.get_individual(i).cur_f[0] != records[0].best_f){
+					std::cout << "FAILED (trial " << trial << ")" << std::endl;
+					return 1;
+				}
+			}
+		}
+		if(n_changed != 1){
+			std::cout << "FAILED (population)" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_ring() || test_sink() || test_sink_reopen() || test_archipelago() || test_accepted_fitness();
+}
@@ -0,0 +1,157 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the parallel restarts of ms and the parallel trials of mbh
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+bool same_population(const population &pop1, const population &pop2)
+{
+	if(pop1.size() != pop2.size()){
+		return false;
+	}
+	for(population::size_type i = 0; i < pop1.size(); i++){
+		if(pop1.get_individual(i).cur_x != pop2.get_individual(i).cur_x ||
+			pop1.get_individual(i).cur_f != pop2.get_individual(i).cur_f ||
+			pop1.get_individual(i).cur_v != pop2.get_individual(i).cur_v){
+			return false;
+		}
+	}
+	return true;
+}
+
+population evolve_ms(const problem::base &prob, int starts, unsigned int n_threads, const fitness_vector &target = fitness_vector())
+{
+	algorithm::ms alg(algorithm::de(20, 0.8, 0.9, 2, 1e-30, 1e-30), starts);
+	alg.set_n_threads(n_threads);
+	alg.set_target(target);
+	alg.reset_rngs(7);
+	population pop(prob, 10, 42);
+	alg.evolve(pop);
+	return pop;
+}
+
+population evolve_mbh(const problem::base &prob, unsigned int n_trials, unsigned int n_threads, const fitness_vector &target = fitness_vector())
+{
+	algorithm::mbh alg(algorithm::cs(200), 3, 0.1);
+	alg.set_n_trials(n_trials);
+	alg.set_n_threads(n_threads);
+	alg.set_target(target);
+	alg.reset_rngs(7);
+	population pop(prob, 1, 42);
+	alg.evolve(pop);
+	return pop;
+}
+
+// The evolutions must not depend on the number of threads.
+int test_threads(const problem::base &prob)
+{
+	std::cout << "Testing threads on " << prob.get_name() << ": ";
+	if(!same_population(evolve_ms(prob, 8, 1), evolve_ms(prob, 8, 4))){
+		std::cout << "FAILED (ms)" << std::endl;
+		return 1;
+	}
+	if(!same_population(evolve_mbh(prob, 4, 1), evolve_mbh(prob, 4, 3))){
+		std::cout << "FAILED (mbh)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// A target reached by the first restart must discard all the others, and a target reached from the start must leave
+// the population of mbh untouched.
+int test_target(const problem::base &prob)
+{
+	std::cout << "Testing target on " << prob.get_name() << ": ";
+	const fitness_vector easy(1, 1e300);
+	if(!same_population(evolve_ms(prob, 1, 1), evolve_ms(prob, 16, 4, easy))){
+		std::cout << "FAILED (ms)" << std::endl;
+		return 1;
+	}
+	if(!same_population(population(prob, 1, 42), evolve_mbh(prob, 4, 4, easy))){
+		std::cout << "FAILED (mbh)" << std::endl;
+		return 1;
+	}
+	// An unreachable target must not change anything.
+	const fitness_vector hard(1, -1.);
+	if(!same_population(evolve_ms(prob, 8, 1), evolve_ms(prob, 8, 2, hard)) ||
+		!same_population(evolve_mbh(prob, 4, 1), evolve_mbh(prob, 4, 2, hard)) ||
+		!same_population(evolve_mbh(prob, 1, 1), evolve_mbh(prob, 1, 1, hard))){
+		std::cout << "FAILED (unreachable target)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Reports the champions found with one and with several trials per iteration.
+int test_trials(const problem::base &prob)
+{
+	std::cout << "Testing trials on " << prob.get_name() << ": ";
+	const population pop1 = evolve_mbh(prob, 1, 1), pop8 = evolve_mbh(prob, 8, 4);
+	std::cout << "1 trial: " << pop1.champion().f[0] << ", 8 trials: " << pop8.champion().f[0] << std::endl;
+	return 0;
+}
+
+// With one or several trials, a rejected iteration must leave the decision vectors alone and perturb the velocities of
+// the current population.
+int test_velocities()
+{
+	std::cout << "Testing velocities: ";
+	const problem::dejong prob(5);
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	for(unsigned int n_trials = 1; n_trials <= 3; n_trials += 2){
+		// The population starts at the optimum, so that no perturbation is accepted.
+		population pop(prob, 1, 42);
+		pop.set_x(0, decision_vector(5, 0.));
+		const population::individual_type before = pop.get_individual(0);
+		algorithm::mbh alg(algorithm::null(), 1, 0.1);
+		alg.set_n_trials(n_trials);
+		alg.set_n_threads(2);
+		alg.evolve(pop);
+		const population::individual_type &after = pop.get_individual(0);
+		bool ok = after.cur_x == before.cur_x && after.cur_v != before.cur_v;
+		for(unsigned int k = 0; k < 5; k++){
+			ok = ok && std::fabs(after.cur_v[k] - before.cur_v[k]) <= 0.1 * (ub[k] - lb[k]);
+		}
+		if(!ok){
+			std::cout << "FAILED (" << n_trials << " trials)" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_threads(problem::rosenbrock(5)) || test_threads(problem::noisy(problem::ackley(5), 3, 0, 0.1)) ||
+		test_target(problem::rosenbrock(5)) || test_velocities() || test_trials(problem::ackley(10));
+}
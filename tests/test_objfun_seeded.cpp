@@ -0,0 +1,144 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the seeded evaluation of stochastic problems
+
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/parallel.h"
+
+using namespace pagmo;
+
+// Known answer of Philox4x32-10 for zero key and counter (Random123 test vectors).
+int test_philox_known_answer()
+{
+	std::cout << "Testing rng_philox known answer: ";
+	const boost::uint32_t expected[4] = {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u};
+	rng_philox drng(0u, 0u);
+	for(int i = 0; i < 4; i++){
+		if(drng() != expected[i]){
+			std::cout << "FAILED" << std::endl;
+			return 1;
+		}
+	}
+	// Re-seeding restarts the stream, different streams differ.
+	drng.seed(0u, 0u);
+	rng_philox other(0u, 1u);
+	if(drng() != expected[0] || other() == expected[0]){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// objfun_seeded(x, s) must be the same as objfun(x) after set_seed(s), and must leave the seed alone.
+int test_seeded_consistency(const problem::base_stochastic &prob)
+{
+	std::cout << "Testing seeded evaluation of " << prob.get_name() << ": ";
+	problem::base_ptr prob_copy = prob.clone();
+	const problem::base_stochastic &prob_stoc = dynamic_cast<const problem::base_stochastic &>(*prob_copy);
+	population pop(prob, 20, 123);
+	const unsigned int original_seed = prob_stoc.get_seed();
+	for(unsigned int seed = 0; seed < 10; seed++){
+		for(population::size_type i = 0; i < pop.size(); i++){
+			const decision_vector &x = pop.get_individual(i).cur_x;
+			fitness_vector f_seeded = prob_stoc.objfun_seeded(x, seed);
+			constraint_vector c_seeded = prob_stoc.compute_constraints_seeded(x, seed);
+			if(prob_stoc.get_seed() != original_seed){
+				std::cout << "FAILED: the seed of the problem was modified" << std::endl;
+				return 1;
+			}
+			problem::base_ptr tmp = prob.clone();
+			dynamic_cast<const problem::base_stochastic &>(*tmp).set_seed(seed);
+			if(f_seeded != tmp->objfun(x) || c_seeded != tmp->compute_constraints(x)){
+				std::cout << "FAILED: results differ from objfun() with the same seed" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Evaluates, on a single shared problem, decision vector i % n_x with seed i / n_x.
+struct shared_evaluation
+{
+	shared_evaluation(const problem::base_stochastic &prob, const std::vector<decision_vector> &x, std::vector<fitness_vector> &f):
+		m_prob(prob), m_x(x), m_f(f) {}
+	void operator()(std::size_t i, unsigned int)
+	{
+		m_f[i] = m_prob.objfun_seeded(m_x[i % m_x.size()], i / m_x.size());
+	}
+	const problem::base_stochastic &m_prob;
+	const std::vector<decision_vector> &m_x;
+	std::vector<fitness_vector> &m_f;
+};
+
+// Many threads evaluating the same problem instance must give the serial results.
+int test_shared_problem(const problem::base_stochastic &prob)
+{
+	std::cout << "Testing concurrent seeded evaluation of " << prob.get_name() << ": ";
+	population pop(prob, 10, 321);
+	std::vector<decision_vector> x;
+	for(population::size_type i = 0; i < pop.size(); i++){
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	const std::size_t n_tasks = 50 * x.size();
+	std::vector<fitness_vector> f_serial(n_tasks), f_parallel(n_tasks);
+	shared_evaluation serial(prob, x, f_serial), parallel(prob, x, f_parallel);
+	util::parallel::for_each_index(n_tasks, 1, serial);
+	util::parallel::for_each_index(n_tasks, 8, parallel);
+	if(f_serial != f_parallel){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	problem::noisy noisy_normal(problem::cec2006(5), 3, 0.0, 0.3, problem::noisy::NORMAL, 42);
+	problem::noisy noisy_uniform(problem::zdt(1, 10), 2, -0.1, 0.2, problem::noisy::UNIFORM, 43);
+	problem::robust robust_ackley(problem::ackley(5), 4, 0.1, 44);
+	problem::robust robust_cec(problem::cec2006(5), 2, 0.1, 45);
+	// Meta-problems wrapped by a single shared instance.
+	problem::noisy noisy_shifted(problem::shifted(problem::rotated(problem::ackley(6)), 0.5), 3, 0.0, 0.3, problem::noisy::NORMAL, 46);
+	problem::noisy noisy_decompose(problem::decompose(problem::shifted(problem::zdt(1, 10), 0.1), problem::decompose::TCHEBYCHEFF), 2, 0.0, 0.1, problem::noisy::UNIFORM, 47);
+	problem::robust robust_penalty(problem::death_penalty(problem::shifted(problem::cec2006(5), 0.2), problem::death_penalty::SIMPLE), 3, 0.1, 48);
+	return test_philox_known_answer() ||
+	       test_seeded_consistency(noisy_normal) ||
+	       test_seeded_consistency(noisy_uniform) ||
+	       test_seeded_consistency(robust_ackley) ||
+	       test_seeded_consistency(robust_cec) ||
+	       test_shared_problem(noisy_normal) ||
+	       test_shared_problem(noisy_uniform) ||
+	       test_shared_problem(robust_ackley) ||
+	       test_seeded_consistency(noisy_shifted) ||
+	       test_shared_problem(noisy_shifted) ||
+	       test_shared_problem(noisy_decompose) ||
+	       test_shared_problem(robust_penalty);
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the pairwise distance kernel
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <boost/random/uniform_real.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/pairwise_distance.h"
+
+using namespace pagmo;
+using util::pairwise_distance;
+
+std::vector<std::vector<double> > random_points(unsigned int n, unsigned int dim, unsigned int seed)
+{
+	rng_double drng(seed);
+	boost::uniform_real<double> uniform(-1.0,1.0);
+	std::vector<std::vector<double> > retval(n, std::vector<double>(dim));
+	for(unsigned int i = 0; i < n; i++){
+		for(unsigned int j = 0; j < dim; j++){
+			retval[i][j] = uniform(drng);
+		}
+	}
+	return retval;
+}
+
+// The naive loop, which the kernel must reproduce exactly.
+double naive(const std::vector<double> &a, const std::vector<double> &b, unsigned int dim)
+{
+	double retval = 0.;
+	for(unsigned int k = 0; k < dim; k++){
+		retval += (a[k] - b[k]) * (a[k] - b[k]);
+	}
+	return retval;
+}
+
+int test_pairwise_distance(unsigned int n_rows, unsigned int n_cols, unsigned int dim, unsigned int n_threads)
+{
+	std::cout << "Testing pairwise distance, " << n_rows << "x" << n_cols << " points of dimension " << dim << ", " << n_threads << " threads: ";
+	// The last coordinate is left out.
+	const std::vector<std::vector<double> > rows = random_points(n_rows, dim + 1, n_rows), cols = random_points(n_cols, dim + 1, n_cols + 1);
+	std::vector<std::vector<double> > cross, sym;
+	pairwise_distance(rows, cols, dim).matrix(cross, n_threads);
+	const pairwise_distance d(rows, dim);
+	d.matrix(sym, n_threads);
+	double max = 0.;
+	for(unsigned int i = 0; i < n_rows; i++){
+		for(unsigned int j = 0; j < n_cols; j++){
+			if(cross[i][j] != naive(rows[i], cols[j], dim)){
+				std::cout << "FAILED (cross)" << std::endl;
+				return 1;
+			}
+		}
+		for(unsigned int j = 0; j < n_rows; j++){
+			if(sym[i][j] != naive(rows[i], rows[j], dim)){
+				std::cout << "FAILED (symmetric)" << std::endl;
+				return 1;
+			}
+			max = std::max(max, sym[i][j]);
+		}
+	}
+	if(d.max(n_threads) != max){
+		std::cout << "FAILED (max)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_pairwise_distance(0, 5, 3, 1) ||
+		test_pairwise_distance(1, 1, 3, 1) ||
+		test_pairwise_distance(10, 7, 1, 1) ||
+		test_pairwise_distance(65, 300, 5, 1) ||
+		test_pairwise_distance(300, 65, 5, 4) ||
+		test_pairwise_distance(513, 257, 17, 4) ||
+		test_pairwise_distance(200, 200, 2, 2);
+}
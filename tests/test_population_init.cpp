@@ -0,0 +1,156 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the initialisation strategies of the population
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+// All individuals must be within the bounds, their best and current values must match the problem's evaluation,
+// and the domination lists must be the ones built incrementally.
+int check_consistency(const population &pop, const std::string &name)
+{
+	const problem::base &prob = pop.problem();
+	for(population::size_type i = 0; i < pop.size(); i++){
+		const population::individual_type &ind = pop.get_individual(i);
+		if(!prob.verify_x(ind.cur_x) || ind.best_x != ind.cur_x || ind.best_f != ind.cur_f || ind.cur_f != prob.objfun(ind.cur_x)){
+			std::cout << name << " FAILED (individual " << i << ")" << std::endl;
+			return 1;
+		}
+		for(population::size_type j = 0; j < prob.get_dimension() - prob.get_i_dimension(); j++){
+			if(std::abs(ind.cur_v[j]) > (prob.get_ub()[j] - prob.get_lb()[j]) / 2){
+				std::cout << name << " FAILED (velocity of individual " << i << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	population ref(prob,0);
+	for(population::size_type i = 0; i < pop.size(); i++){
+		ref.push_back(pop.get_individual(i).cur_x);
+	}
+	for(population::size_type i = 0; i < pop.size(); i++){
+		std::vector<population::size_type> l1 = pop.get_domination_list(i), l2 = ref.get_domination_list(i);
+		std::sort(l1.begin(),l1.end());
+		std::sort(l2.begin(),l2.end());
+		if(l1 != l2){
+			std::cout << name << " FAILED (domination list of individual " << i << ")" << std::endl;
+			return 1;
+		}
+	}
+	if(pop.size() && pop.champion().f != ref.champion().f){
+		std::cout << name << " FAILED (champion)" << std::endl;
+		return 1;
+	}
+	std::cout << name << " PASSED" << std::endl;
+	return 0;
+}
+
+// The uniform strategy must give the same population as the historical constructor, whatever the number of threads.
+int test_uniform(const problem::base &prob)
+{
+	const population ref(prob,50,42u), pop(prob,50,population::UNIFORM,1,42u), pop4(prob,50,population::UNIFORM,4,42u);
+	for(population::size_type i = 0; i < ref.size(); i++){
+		if(ref.get_individual(i).cur_x != pop.get_individual(i).cur_x || ref.get_individual(i).cur_v != pop.get_individual(i).cur_v ||
+			ref.get_individual(i).cur_f != pop4.get_individual(i).cur_f || pop.get_individual(i).cur_x != pop4.get_individual(i).cur_x)
+		{
+			std::cout << "uniform (" << prob.get_name() << ") FAILED (individual " << i << ")" << std::endl;
+			return 1;
+		}
+	}
+	return check_consistency(pop4,"uniform (" + prob.get_name() + ")");
+}
+
+// Each slice of each continuous dimension must hold exactly one individual of a Latin hypercube.
+int test_latin_hypercube()
+{
+	const problem::rosenbrock prob(10);
+	const population::size_type n = 64;
+	const population pop(prob,n,population::LATIN_HYPERCUBE,2);
+	for(problem::base::size_type j = 0; j < prob.get_dimension(); j++){
+		std::vector<bool> hit(n,false);
+		for(population::size_type i = 0; i < n; i++){
+			const double u = (pop.get_individual(i).cur_x[j] - prob.get_lb()[j]) / (prob.get_ub()[j] - prob.get_lb()[j]);
+			const population::size_type k = std::min(static_cast<population::size_type>(u * n),n - 1);
+			if(hit[k]){
+				std::cout << "latin hypercube FAILED (stratification of dimension " << j << ")" << std::endl;
+				return 1;
+			}
+			hit[k] = true;
+		}
+	}
+	return check_consistency(pop,"latin hypercube");
+}
+
+// The seeds must come first, untouched, and the strategy must fill the rest of the population.
+int test_seeds()
+{
+	const problem::rosenbrock prob(5);
+	const char *path = "test_population_init_seeds.txt";
+	{
+		std::ofstream f(path);
+		f << "# known good solutions\n1 1 1 1 1\n\n0.5 -1 2 0 1.25\n";
+	}
+	const std::vector<decision_vector> seeds = population::load_decision_vectors(path);
+	std::remove(path);
+	if(seeds.size() != 2 || seeds[0] != decision_vector(5,1.) || seeds[1][3] != 0 || seeds[1][4] != 1.25){
+		std::cout << "seeds FAILED (reading)" << std::endl;
+		return 1;
+	}
+	population pop(prob,20,population::UNIFORM);
+	pop.reinit(population::SOBOL,3,seeds);
+	if(pop.get_individual(0).cur_x != seeds[0] || pop.get_individual(1).cur_x != seeds[1] || pop.champion().f[0] != 0){
+		std::cout << "seeds FAILED (placement)" << std::endl;
+		return 1;
+	}
+	try {
+		pop.reinit(population::UNIFORM,1,std::vector<decision_vector>(21,seeds[0]));
+		std::cout << "seeds FAILED (too many seeds accepted)" << std::endl;
+		return 1;
+	} catch(const value_error &) {}
+	try {
+		population::load_decision_vectors("this_file_does_not_exist.txt");
+		std::cout << "seeds FAILED (missing file accepted)" << std::endl;
+		return 1;
+	} catch(const io_error &) {}
+	return check_consistency(pop,"seeds");
+}
+
+int main()
+{
+	const problem::rosenbrock rosen(10);
+	const problem::zdt zdt1(1,10);
+	const problem::golomb_ruler golomb(5,10);
+	return test_uniform(rosen) || test_uniform(zdt1) || test_uniform(golomb) || test_latin_hypercube() || test_seeds() ||
+		check_consistency(population(zdt1,100,population::HALTON,4),"halton (zdt1)") ||
+		check_consistency(population(golomb,100,population::SOBOL,4),"sobol (golomb ruler)") ||
+		check_consistency(population(golomb,100,population::LATIN_HYPERCUBE),"latin hypercube (golomb ruler)") ||
+		check_consistency(population(rosen,0,population::HALTON),"empty population");
+}
@@ -215,6 +215,41 @@ int test_heterogeneous_constraints()
 	return 0;
 }
 
+// Test that concurrent evolution of the racing algorithms yields exactly the
+// same race (winners and number of evolutions) as the serial one.
+int test_concurrent_race(const problem::base& prob)
+{
+	std::cout << "Testing concurrent racing on problem " << prob.get_name() << std::endl;
+
+	std::vector<algorithm::base_ptr> algos;
+	unsigned int gen_interval = 50;
+	unsigned int num_instances = 5;
+	for(unsigned int i = 1; i <= num_instances; i++){
+		algos.push_back(algorithm::base_ptr(new algorithm::pso_generational(i * gen_interval, 0.7298, 2.05, 2.05, 0.5, 1, 2, 4)));
+	}
+
+	unsigned int pop_size = 50;
+	unsigned int seed = 1234;
+
+	util::racing::race_algo race_serial(algos, prob, pop_size, seed, 1);
+	util::racing::race_algo race_concurrent(algos, prob, pop_size, seed, 4);
+
+	std::pair<std::vector<unsigned int>, unsigned int> res_serial = race_serial.run(2, 1, 500, 0.05, std::vector<unsigned int>(), true, false);
+	std::pair<std::vector<unsigned int>, unsigned int> res_concurrent = race_concurrent.run(2, 1, 500, 0.05, std::vector<unsigned int>(), true, false);
+
+	if(res_serial.first != res_concurrent.first){
+		std::cout << "\tWinners differ: " << res_serial.first << " vs " << res_concurrent.first << std::endl;
+		return 1;
+	}
+	if(res_serial.second != res_concurrent.second){
+		std::cout << "\tNumber of evolutions differ: " << res_serial.second << " vs " << res_concurrent.second << std::endl;
+		return 1;
+	}
+
+	std::cout << "Test passed [concurrent race]" << std::endl;
+	return 0;
+}
+
 /*
 // TODO: Find out offline which variant works best and verify in this test?
 int varied_pso_variant(const problem::base_ptr& prob)
@@ -245,5 +280,6 @@ int main()
 		varied_n_gen(prob, 2) ||
 		varied_n_gen(prob_list, 1) ||
 		varied_n_gen(prob_list, 2) ||
-		test_heterogeneous_constraints();
+		test_heterogeneous_constraints() ||
+		test_concurrent_race(prob);
 }
@@ -0,0 +1,317 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Regression tests for the statistics used by racing: the incremental rank
+// sums must lead to exactly the same races as the full recomputation.
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "../src/pagmo.h"
+#include "../src/util/racing.h"
+#include "../src/util/race_pop.h"
+
+using namespace pagmo;
+using namespace util::racing;
+
+// Reference races, recorded with the from-scratch statistics (rankings of a
+// condensed population, means and Friedman test recomputed from the full rank
+// histories at every iteration), i.e. racing as it was before the running rank
+// sums were introduced. They must be re-recorded with that implementation
+// whenever the noise of problem::noisy changes.
+struct race_reference
+{
+	int prob_idx;
+	int config_idx;
+	bool race_best;
+	unsigned int winners[5];
+	unsigned int fevals;
+};
+
+const race_reference references[] = {
+	{0, 0, false, {0}, 138},
+	{0, 0, true, {1}, 33},
+	{0, 1, false, {10, 13, 18}, 448},
+	{0, 1, true, {14, 16, 4}, 2999},
+	{0, 2, false, {40, 9, 48, 4, 35}, 743},
+	{0, 2, true, {17, 34, 49, 6, 22}, 355},
+	{1, 0, false, {7}, 44},
+	{1, 0, true, {2}, 55},
+	{1, 1, false, {0, 17, 4}, 76},
+	{1, 1, true, {8, 16, 2}, 213},
+	{1, 2, false, {21, 44, 26, 41, 13}, 1175},
+	{1, 2, true, {20, 46, 6, 12, 0}, 237},
+	{2, 0, false, {2}, 80},
+	{2, 0, true, {4}, 40},
+	{2, 1, false, {13, 11, 10}, 1171},
+	{2, 1, true, {8, 3, 6}, 1683},
+	{2, 2, false, {9, 33, 35, 38, 5}, 2999},
+	{2, 2, true, {8, 29, 20, 6, 12}, 634}
+};
+
+namespace {
+
+// From-scratch counterparts of f_race_assign_ranks() and friedman_test():
+// rank the active individuals in a condensed population and recompute the
+// means and the test statistic from the full rank histories.
+void scratch_assign_ranks(std::vector<racer_type> &racers, const racing_population &pop_full)
+{
+	racing_population pop(pop_full.problem());
+	decision_vector dummy_x(pop_full.problem().get_dimension(), 0);
+	std::vector<population::size_type> idx_mapping;
+	for(population::size_type i = 0; i < racers.size(); i++){
+		if(racers[i].active){
+			pop.push_back_noeval(dummy_x);
+			pop.set_fc(pop.size() - 1, pop_full.get_individual(i).cur_f, pop_full.get_individual(i).cur_c);
+			idx_mapping.push_back(i);
+		}
+	}
+	std::vector<double> rankings = pop.get_rankings();
+	for(unsigned int i = 0; i < rankings.size(); i++){
+		racer_type &racer = racers[idx_mapping[i]];
+		racer.m_hist.push_back(rankings[i]);
+		racer.m_mean = 0;
+		for(unsigned int j = 0; j < racer.length(); j++){
+			racer.m_mean += racer.m_hist[j] / racer.length();
+		}
+	}
+}
+
+stat_test_result scratch_friedman_test(std::vector<racer_type> &racers, const std::vector<population::size_type> &in_race, const racing_population &pop, double delta)
+{
+	scratch_assign_ranks(racers, pop);
+	std::vector<std::vector<double> > X;
+	for(unsigned int i = 0; i < in_race.size(); i++){
+		X.push_back(racers[in_race[i]].m_hist);
+	}
+	return core_friedman_test(X, delta);
+}
+
+void scratch_adjust_ranks(std::vector<racer_type> &racers, const std::vector<population::size_type> &deleted)
+{
+	for(unsigned int i = 0; i < racers.size(); i++){
+		if(!racers[i].active) continue;
+		for(unsigned int j = 0; j < racers[i].length(); j++){
+			int adjustment = 0;
+			for(unsigned int k = 0; k < deleted.size(); k++){
+				if(racers[i].m_hist[j] > racers[deleted[k]].m_hist[j]){
+					adjustment++;
+				}
+			}
+			racers[i].m_hist[j] -= adjustment;
+		}
+	}
+}
+
+}
+
+// The incremental statistics must agree with the from-scratch ones at every
+// iteration of a race, including after racers have been dropped. Fitness
+// values are drawn from a small set, so that ties occur.
+int test_incremental_vs_scratch()
+{
+	std::cout << "Testing incremental statistics against from-scratch ones" << std::endl;
+
+	problem::base_ptr probs[2] = {
+		problem::base_ptr(new problem::ackley(3)),
+		problem::base_ptr(new problem::zdt(1, 3))
+	};
+	rng_uint32 urng(321);
+	for(unsigned int p = 0; p < 2; p++){
+		const problem::base &prob = *probs[p];
+		for(unsigned int trial = 0; trial < 20; trial++){
+			const unsigned int N = 3 + urng() % 10;
+			racing_population pop(prob);
+			for(unsigned int i = 0; i < N; i++){
+				pop.push_back_noeval(decision_vector(prob.get_dimension(), 0));
+			}
+			std::vector<racer_type> inc(N), ref(N);
+			std::vector<population::size_type> in_race;
+			for(unsigned int i = 0; i < N; i++){
+				inc[i].active = ref[i].active = true;
+				in_race.push_back(i);
+			}
+			for(unsigned int it = 0; it < 30 && in_race.size() > 1; it++){
+				for(unsigned int i = 0; i < N; i++){
+					fitness_vector f(prob.get_f_dimension());
+					for(unsigned int d = 0; d < f.size(); d++){
+						f[d] = urng() % 4;
+					}
+					pop.set_fc(i, f, constraint_vector(prob.get_c_dimension(), 0));
+				}
+				stat_test_result res_inc = friedman_test(inc, in_race, pop, 0.05);
+				stat_test_result res_ref = scratch_friedman_test(ref, in_race, pop, 0.05);
+				if(res_inc.trivial != res_ref.trivial || res_inc.is_better != res_ref.is_better){
+					std::cout << "\tFAILED: test results differ on " << prob.get_name() << " at iteration " << it << std::endl;
+					return 1;
+				}
+				for(unsigned int i = 0; i < in_race.size(); i++){
+					const racer_type &a = inc[in_race[i]], &b = ref[in_race[i]];
+					if(a.m_hist != b.m_hist || std::fabs(a.m_mean - b.m_mean) > 1e-12){
+						std::cout << "\tFAILED: ranks differ on " << prob.get_name() << " at iteration " << it << std::endl;
+						return 1;
+					}
+				}
+				// Drop one or two random racers every few iterations
+				if(it % 3 == 2 && in_race.size() > 2){
+					std::vector<population::size_type> deleted;
+					for(unsigned int n_drops = 1 + urng() % 2; n_drops > 0 && in_race.size() > 2; n_drops--){
+						const unsigned int pos = urng() % in_race.size();
+						deleted.push_back(in_race[pos]);
+						inc[in_race[pos]].active = ref[in_race[pos]].active = false;
+						in_race.erase(in_race.begin() + pos);
+					}
+					f_race_adjust_ranks(inc, deleted);
+					scratch_adjust_ranks(ref, deleted);
+				}
+				// Eliminations without any racer dropped must not change anything
+				f_race_adjust_ranks(inc, std::vector<population::size_type>());
+			}
+		}
+	}
+
+	std::cout << "\tPASSED" << std::endl;
+	return 0;
+}
+
+int test_race_regression()
+{
+	std::cout << "Testing races against reference results" << std::endl;
+
+	int dimension = 10;
+	problem::base_ptr probs[3] = {
+		problem::base_ptr(new problem::ackley(dimension)),
+		problem::base_ptr(new problem::cec2006(5)),
+		problem::base_ptr(new problem::zdt(1, dimension))
+	};
+	const unsigned int pop_sizes[3] = {10, 20, 50};
+	const unsigned int n_finals[3] = {1, 3, 5};
+
+	for(unsigned int i = 0; i < sizeof(references) / sizeof(race_reference); i++){
+		const race_reference &ref = references[i];
+		const int k = ref.config_idx;
+		problem::noisy prob_noisy(*probs[ref.prob_idx], 1, 0, 0.3, problem::noisy::NORMAL, 42);
+		population pop(prob_noisy, pop_sizes[k], 42 + k);
+		race_pop race(pop, 7 + k);
+		std::pair<std::vector<population::size_type>, unsigned int> res = race.run(n_finals[k], 2, 3000, 0.05, std::vector<population::size_type>(), race_pop::MAX_BUDGET, ref.race_best, false);
+		std::vector<population::size_type> expected(ref.winners, ref.winners + n_finals[k]);
+		if(res.first != expected || res.second != ref.fevals){
+			std::cout << "\tFAILED on " << probs[ref.prob_idx]->get_name() << " (configuration " << k << ", race_best = " << ref.race_best << ")" << std::endl;
+			std::cout << "\tExpected: " << expected << ", " << ref.fevals << " fevals" << std::endl;
+			std::cout << "\tObtained: " << res.first << ", " << res.second << " fevals" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "\tPASSED" << std::endl;
+	return 0;
+}
+
+// The Friedman test computed from the running rank sums must agree with the
+// one computed from the full observation matrix.
+int test_friedman_from_sums()
+{
+	std::cout << "Testing Friedman test on rank sums" << std::endl;
+
+	rng_uint32 urng(123);
+	for(unsigned int trial = 0; trial < 200; trial++){
+		unsigned int N = 2 + urng() % 8;
+		unsigned int B = 2 + urng() % 30;
+		// Build B blocks of ranks, each a random permutation of 1..N
+		std::vector<std::vector<double> > X(N, std::vector<double>(B));
+		for(unsigned int j = 0; j < B; j++){
+			std::vector<double> block(N);
+			for(unsigned int i = 0; i < N; i++){
+				block[i] = i + 1;
+			}
+			for(unsigned int i = N - 1; i > 0; i--){
+				std::swap(block[i], block[urng() % (i + 1)]);
+			}
+			for(unsigned int i = 0; i < N; i++){
+				X[i][j] = block[i];
+			}
+		}
+		std::vector<double> R(N, 0);
+		double A1 = 0;
+		for(unsigned int i = 0; i < N; i++){
+			for(unsigned int j = 0; j < B; j++){
+				R[i] += X[i][j];
+				A1 += X[i][j] * X[i][j];
+			}
+		}
+		stat_test_result res_full = core_friedman_test(X, 0.05);
+		stat_test_result res_sums = core_friedman_test(R, A1, B, 0.05);
+		if(res_full.trivial != res_sums.trivial || res_full.is_better != res_sums.is_better){
+			std::cout << "\tFAILED: results differ for N = " << N << ", B = " << B << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "\tPASSED" << std::endl;
+	return 0;
+}
+
+// Running sums of the racers must match their rank histories after rank
+// adjustments.
+int test_racer_running_sums()
+{
+	std::cout << "Testing running rank sums of racers" << std::endl;
+
+	std::vector<racer_type> racers(4);
+	const double ranks[3][4] = {{1, 2, 3, 4}, {2.5, 2.5, 1, 4}, {4, 3, 2, 1}};
+	std::vector<population::size_type> idx;
+	for(unsigned int i = 0; i < racers.size(); i++){
+		racers[i].active = true;
+		idx.push_back(i);
+	}
+	for(unsigned int j = 0; j < 3; j++){
+		f_race_push_ranks(racers, idx, std::vector<double>(ranks[j], ranks[j] + 4));
+	}
+	racers[3].active = false;
+	f_race_adjust_ranks(racers, std::vector<population::size_type>(1, 3));
+
+	for(unsigned int i = 0; i < 3; i++){
+		double sum = 0, sq_sum = 0;
+		for(unsigned int j = 0; j < racers[i].length(); j++){
+			sum += racers[i].m_hist[j];
+			sq_sum += racers[i].m_hist[j] * racers[i].m_hist[j];
+		}
+		if(sum != racers[i].m_rank_sum || sq_sum != racers[i].m_rank_sq_sum || racers[i].m_mean != sum / racers[i].length()){
+			std::cout << "\tFAILED: running sums of racer " << i << " are not consistent" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "\tPASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_friedman_from_sums() ||
+	       test_racer_running_sums() ||
+	       test_incremental_vs_scratch() ||
+	       test_race_regression();
+}
@@ -0,0 +1,236 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the counter-based random number generators
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+
+#include "../src/rng.h"
+
+using namespace pagmo;
+
+// discard(n) must be equivalent to n calls to operator()(), from any position in a block.
+int test_discard()
+{
+	std::cout << "Testing rng_philox::discard(): ";
+	for(unsigned int offset = 0; offset < 5; offset++){
+		for(unsigned int n = 0; n < 40; n++){
+			rng_philox r1(42u, 7u), r2(42u, 7u);
+			r1.discard(offset);
+			r2.discard(offset);
+			for(unsigned int i = 0; i < n; i++){
+				r1();
+			}
+			r2.discard(n);
+			if(r1 != r2 || r1() != r2()){
+				std::cout << "FAILED (offset = " << offset << ", n = " << n << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	// Large jumps, crossing the 64 bit boundary of the counter.
+	rng_philox r1(1u), r2(1u);
+	r1.discard(0xFFFFFFFFFFFFFFFFull);
+	r1.discard(0xFFFFFFFFFFFFFFFFull);
+	r1.discard(8u);
+	r2.discard(0x7FFFFFFFFFFFFFFFull);
+	r2.discard(0x7FFFFFFFFFFFFFFFull);
+	r2.discard(0x7FFFFFFFFFFFFFFFull);
+	r2.discard(0x7FFFFFFFFFFFFFFFull);
+	r2.discard(10u);
+	if(r1 != r2 || r1() != r2()){
+		std::cout << "FAILED (large jumps)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Batch generation must produce the same sequence as repeated calls, and leave the generator in the same state.
+int test_batch()
+{
+	std::cout << "Testing batch generation: ";
+	for(unsigned int offset = 0; offset < 5; offset++){
+		for(unsigned int n = 0; n < 150; n += 7){
+			rng_philox r1(3u, 11u), r2(3u, 11u), r3(3u, 11u);
+			r1.discard(offset);
+			r2.discard(offset);
+			r3.discard(offset);
+			std::vector<boost::uint32_t> raw(n);
+			std::vector<double> uniform(n);
+			r2.generate(raw.begin(), raw.end());
+			r3.generate_uniform(uniform.begin(), uniform.end());
+			for(unsigned int i = 0; i < n; i++){
+				const boost::uint32_t expected = r1();
+				if(raw[i] != expected || uniform[i] != expected / 4294967296.){
+					std::cout << "FAILED (offset = " << offset << ", n = " << n << ")" << std::endl;
+					return 1;
+				}
+			}
+			if(r1 != r2 || r1 != r3 || r1() != r2()){
+				std::cout << "FAILED: wrong state after the batch (offset = " << offset << ", n = " << n << ")" << std::endl;
+				return 1;
+			}
+		}
+	}
+	rng_philox_double d1(5u), d2(5u);
+	std::vector<double> doubles(77);
+	d2.generate(doubles.begin(), doubles.end());
+	for(unsigned int i = 0; i < doubles.size(); i++){
+		const double expected = d1();
+		if(doubles[i] != expected || expected < 0. || expected >= 1.){
+			std::cout << "FAILED (rng_philox_double)" << std::endl;
+			return 1;
+		}
+	}
+	if(d1 != d2){
+		std::cout << "FAILED: wrong state after the batch (rng_philox_double)" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Sample moments of the uniform and normal batches.
+int test_distributions()
+{
+	std::cout << "Testing distributions: ";
+	const unsigned int n = 1000001;
+	std::vector<double> v(n);
+	rng_philox r(2013u);
+	r.generate_uniform(v.begin(), v.end());
+	double mean = 0., var = 0.;
+	for(unsigned int i = 0; i < n; i++){
+		if(v[i] < 0. || v[i] >= 1.){
+			std::cout << "FAILED: uniform number out of range" << std::endl;
+			return 1;
+		}
+		mean += v[i] / n;
+	}
+	for(unsigned int i = 0; i < n; i++){
+		var += (v[i] - mean) * (v[i] - mean) / n;
+	}
+	if(std::fabs(mean - 0.5) > 1e-3 || std::fabs(var - 1. / 12.) > 1e-3){
+		std::cout << "FAILED: uniform mean " << mean << ", variance " << var << std::endl;
+		return 1;
+	}
+	r.generate_normal(v.begin(), v.end(), 1., 2.);
+	mean = 0.;
+	var = 0.;
+	for(unsigned int i = 0; i < n; i++){
+		mean += v[i] / n;
+	}
+	for(unsigned int i = 0; i < n; i++){
+		var += (v[i] - mean) * (v[i] - mean) / n;
+	}
+	if(std::fabs(mean - 1.) > 1e-2 || std::fabs(var - 4.) > 2e-2){
+		std::cout << "FAILED: normal mean " << mean << ", variance " << var << std::endl;
+		return 1;
+	}
+	// Normal numbers generated in two chunks must be the same as in one go.
+	rng_philox r1(7u), r2(7u);
+	std::vector<double> v1(1000), v2(1000);
+	r1.generate_normal(v1.begin(), v1.end());
+	r2.generate_normal(v2.begin(), v2.begin() + 333);
+	r2.generate_normal(v2.begin() + 333, v2.end());
+	if(v1 != v2 || r1 != r2){
+		std::cout << "FAILED: normal numbers depend on the size of the batches" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Splitting must be deterministic, must not depend on the position of the parent and must give distinct streams.
+int test_split()
+{
+	std::cout << "Testing rng_philox::split(): ";
+	rng_philox parent(99u);
+	const rng_philox child0 = parent.split(0u), child1 = parent.split(1u);
+	parent();
+	const rng_philox parent_copy(parent);
+	if(parent.split(0u) != child0 || parent != parent_copy){
+		std::cout << "FAILED: splitting is not deterministic" << std::endl;
+		return 1;
+	}
+	// Any two of the streams must differ somewhere in the first 100 draws.
+	rng_philox streams[4] = {child0, child1, rng_philox(99u), child0.split(0u)};
+	std::vector<std::vector<boost::uint32_t> > draws(4, std::vector<boost::uint32_t>(100));
+	for(unsigned int k = 0; k < 4; k++){
+		for(unsigned int i = 0; i < 100; i++){
+			draws[k][i] = streams[k]();
+		}
+	}
+	for(unsigned int k = 0; k < 4; k++){
+		for(unsigned int l = k + 1; l < 4; l++){
+			if(draws[k] == draws[l]){
+				std::cout << "FAILED: split streams " << k << " and " << l << " coincide" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Serialization must preserve the position in the sequence.
+int test_serialization()
+{
+	std::cout << "Testing serialization: ";
+	rng_philox r(17u, 4u);
+	rng_philox_double d(18u);
+	r.discard(6u);
+	d.discard(3u);
+	std::stringstream ss;
+	{
+		boost::archive::text_oarchive oa(ss);
+		oa << r << d;
+	}
+	rng_philox r_new;
+	rng_philox_double d_new;
+	{
+		boost::archive::text_iarchive ia(ss);
+		ia >> r_new >> d_new;
+	}
+	if(r != r_new || r() != r_new() || d != d_new || d() != d_new()){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_discard() ||
+	       test_batch() ||
+	       test_distributions() ||
+	       test_split() ||
+	       test_serialization();
+}
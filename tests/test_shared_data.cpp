@@ -0,0 +1,244 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the shared problem tables
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/shared_data.h"
+
+using namespace pagmo;
+
+void write_file(const std::string &path, const std::vector<double> &data)
+{
+	std::ofstream f(path.c_str());
+	for(std::vector<double>::size_type i = 0; i < data.size(); i++){
+		f << data[i] << (i % 10 == 9 ? '\n' : ' ');
+	}
+}
+
+bool file_exists(const std::string &path)
+{
+	return std::ifstream(path.c_str()).is_open();
+}
+
+// Points the cache directory of the user to dir.
+void set_cache_dir(const std::string &dir)
+{
+	static char buffer[256];
+	std::strcpy(buffer, ("XDG_CACHE_HOME=" + dir).c_str());
+	putenv(buffer);
+}
+
+// Name of the binary cache of a text file in the "pagmo" subdirectory of the cache directory of the user (FNV-1a hash of
+// its bytes).
+std::string user_cache_path(const std::string &dir, const std::string &path)
+{
+	std::ifstream f(path.c_str(), std::ios::binary);
+	const std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+	boost::uint64_t h = 14695981039346656037ULL;
+	for(std::string::size_type i = 0; i < text.size(); i++){
+		h ^= static_cast<unsigned char>(text[i]);
+		h *= 1099511628211ULL;
+	}
+	std::ostringstream oss;
+	oss << dir << "/pagmo/" << std::hex << std::setw(16) << std::setfill('0') << h << ".bin";
+	return oss.str();
+}
+
+// Equal tables must share one copy of the data.
+int test_interning()
+{
+	std::cout << "Testing interning: ";
+	std::vector<double> v(1000);
+	for(std::vector<double>::size_type i = 0; i < v.size(); i++){
+		v[i] = i * 0.5;
+	}
+	const util::shared_data a(v), b(v), c(std::vector<double>(10, 1.));
+	const util::shared_data d(a);
+	if(a.data() != b.data() || a.data() != d.data() || a.data() == c.data() || a != b || a == c ||
+		a.get_hash() != util::shared_data::hash(v) || a.use_count() != 3 || a.get() != v){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The data must be archived once, and interned again on load.
+int test_serialization()
+{
+	std::cout << "Testing serialization: ";
+	const util::shared_data a(std::vector<double>(10000, 3.));
+	std::vector<util::shared_data> tables(4, a), loaded;
+	std::stringstream ss, ss_single;
+	{
+		boost::archive::text_oarchive oa(ss);
+		oa << tables;
+		boost::archive::text_oarchive oa_single(ss_single);
+		const std::vector<util::shared_data> single(1, a);
+		oa_single << single;
+	}
+	{
+		boost::archive::text_iarchive ia(ss);
+		ia >> loaded;
+	}
+	if(loaded.size() != 4 || loaded[0].data() != a.data() || loaded[3].data() != a.data() ||
+		ss.str().size() > ss_single.str().size() + 100){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Text tables must be parsed once, then read from the binary cache until the text file changes. With no writable cache
+// directory for the user, the cache is written next to the text file.
+int test_text_file()
+{
+	std::cout << "Testing text files: ";
+	const std::string path("test_shared_data.txt");
+	std::vector<double> v(100);
+	for(std::vector<double>::size_type i = 0; i < v.size(); i++){
+		v[i] = i * 0.25;
+	}
+	write_file(path, v);
+	std::remove((path + ".bin").c_str());
+	const util::shared_data a = util::shared_data::from_text_file(path);
+	const bool cached = file_exists(path + ".bin");
+	const util::shared_data b = util::shared_data::from_text_file(path);
+	const std::vector<double> u(v);
+	v.push_back(1000.5);
+	write_file(path, v);
+	const util::shared_data c = util::shared_data::from_text_file(path);
+	const std::vector<double> w(v);
+	// An edit that keeps the size of the file must be detected as well.
+	v[1] = 0.75;
+	write_file(path, v);
+	const util::shared_data d = util::shared_data::from_text_file(path);
+	std::remove(path.c_str());
+	std::remove((path + ".bin").c_str());
+	if(!cached || a.get() != u || a.data() != b.data() || c.get() != w || d.get() != v){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The cache must go to the "pagmo" subdirectory of the cache directory of the user when there is one, creating it if
+// needed and leaving the directory of the text file alone.
+int test_user_cache()
+{
+	std::cout << "Testing user cache directory: ";
+	set_cache_dir(".");
+	const std::string path("test_shared_data_user.txt");
+	std::vector<double> v(100, 1.5);
+	write_file(path, v);
+	const std::string cache_path(user_cache_path(".", path));
+	std::remove(cache_path.c_str());
+	std::remove("pagmo");
+	const util::shared_data a = util::shared_data::from_text_file(path);
+	const bool cached = file_exists(cache_path) && !file_exists(path + ".bin");
+	const util::shared_data b = util::shared_data::from_text_file(path);
+	v[0] = 2.5;
+	write_file(path, v);
+	const util::shared_data c = util::shared_data::from_text_file(path);
+	const std::string new_cache_path(user_cache_path(".", path));
+	std::remove(path.c_str());
+	std::remove(cache_path.c_str());
+	std::remove(new_cache_path.c_str());
+	std::remove("pagmo");
+	set_cache_dir("test_shared_data_no_such_dir");
+	if(!cached || a.get() != std::vector<double>(100, 1.5) || a.data() != b.data() || c.get() != v){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The problems must behave as before, with their clones sharing the tables.
+int test_problems()
+{
+	std::cout << "Testing problems: ";
+	// Synthetic CEC2013 input files: identity rotations and a shift of 1.
+	std::vector<double> rotation;
+	for(int k = 0; k < 10; k++){
+		rotation.push_back(1.); rotation.push_back(0.); rotation.push_back(0.); rotation.push_back(1.);
+	}
+	write_file("M_D2.txt", rotation);
+	write_file("shift_data.txt", std::vector<double>(1000, 1.));
+	const problem::cec2013 cec(1, 2, "");
+	std::remove("M_D2.txt");
+	std::remove("shift_data.txt");
+	std::remove("M_D2.txt.bin");
+	std::remove("shift_data.txt.bin");
+	const problem::base_ptr cec_copy = cec.clone();
+	const problem::knapsack ks;
+	const problem::tsp tsp;
+	std::stringstream ss;
+	{
+		boost::archive::text_oarchive oa(ss);
+		oa << cec_copy;
+	}
+	problem::base_ptr cec_loaded;
+	{
+		boost::archive::text_iarchive ia(ss);
+		ia >> cec_loaded;
+	}
+	decision_vector x(2, 1.), tour(5);
+	for(int i = 0; i < 5; i++){
+		tour[i] = i;
+	}
+	if(cec.objfun(x)[0] != -1400 || cec_copy->objfun(x)[0] != -1400 || cec_loaded->objfun(x)[0] != -1400 ||
+		cec.origin_shift().size() != 1000 || ks.objfun(decision_vector(5, 1.))[0] != 15 ||
+		*ks.clone() != ks || std::fabs(tsp.objfun(tour)[0] - 15.841618) > 1e-12){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	// Keep the caches of the tests out of the cache directory of the user.
+	set_cache_dir("test_shared_data_no_such_dir");
+	return test_interning() +
+		test_serialization() +
+		test_text_file() +
+		test_user_cache() +
+		test_problems();
+}
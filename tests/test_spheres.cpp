@@ -0,0 +1,98 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the parallel and fixed step evaluation of the spheres problem (requires GSL)
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/problem/spheres.h"
+
+using namespace pagmo;
+
+// Random neural network weights in the bounds of the problem.
+static decision_vector random_weights(const problem::spheres &prob, unsigned int seed)
+{
+	rng_double drng(seed);
+	decision_vector x(prob.get_dimension());
+	for(decision_vector::size_type i = 0; i < x.size(); i++){
+		x[i] = drng() * 2 - 1;
+	}
+	return x;
+}
+
+// The fitness must not depend on the number of threads, with both integrators.
+int test_threads()
+{
+	std::cout << "Testing spheres with several threads: ";
+	for(int fixed = 0; fixed < 2; fixed++){
+		problem::spheres prob(12, 5, 1e-6, 3u);
+		if(fixed){
+			prob.set_fixed_step(0.05);
+		}
+		for(unsigned int k = 0; k < 3; k++){
+			const decision_vector x = random_weights(prob, 10 + k);
+			fitness_vector f1(1), fn(1);
+			prob.set_n_threads(1);
+			prob.reset_caches();
+			prob.objfun(f1, x);
+			prob.set_n_threads(4);
+			prob.reset_caches();
+			prob.objfun(fn, x);
+			if(f1 != fn){
+				std::cout << "FAILED: " << f1 << " with 1 thread, " << fn << " with 4 threads" << (fixed ? " (fixed step)" : "") << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// The fixed step integrator must agree with the adaptive one when the step is small.
+int test_fixed_step()
+{
+	std::cout << "Testing spheres with the fixed step integrator: ";
+	problem::spheres adaptive(8, 5, 1e-10, 5u), fixed(8, 5, 1e-10, 5u);
+	fixed.set_fixed_step(0.01);
+	for(unsigned int k = 0; k < 3; k++){
+		const decision_vector x = random_weights(adaptive, 20 + k);
+		fitness_vector fa(1), ff(1);
+		adaptive.objfun(fa, x);
+		fixed.objfun(ff, x);
+		if(std::fabs(fa[0] - ff[0]) > 1e-9 * std::max(1.0, std::fabs(fa[0]))){
+			std::cout << "FAILED: " << fa << " with the adaptive integrator, " << ff << " with the fixed step one" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_threads() ||
+	       test_fixed_step();
+}
@@ -0,0 +1,255 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the surrogate model and meta-problem
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <boost/random/uniform_real.hpp>
+#include "../src/pagmo.h"
+#include "../src/util/gaussian_process.h"
+#include "../src/util/parallel.h"
+
+using namespace pagmo;
+
+// The incrementally updated model must predict as a model fitted from scratch on the retained samples.
+int test_incremental()
+{
+	std::cout << "Testing incremental updates: ";
+	const unsigned int dim = 3, max_size = 10;
+	const double l = 0.2 * std::sqrt(static_cast<double>(dim)), nugget = 1e-6;
+	util::gaussian_process gp(dim, 2, max_size, 0.2, nugget);
+	rng_double drng(42);
+	std::vector<std::vector<double> > X, Y;
+	for(int k = 0; k < 25; k++){
+		std::vector<double> x(dim), y(2);
+		for(unsigned int j = 0; j < dim; j++){
+			x[j] = drng();
+		}
+		y[0] = x[0] * x[0] + std::sin(3 * x[1]);
+		y[1] = x[2] - x[1];
+		if(!gp.add(x, y)){
+			std::cout << "FAILED (sample discarded)" << std::endl;
+			return 1;
+		}
+		X.push_back(x);
+		Y.push_back(y);
+	}
+	if(gp.size() != max_size){
+		std::cout << "FAILED (size)" << std::endl;
+		return 1;
+	}
+	X.erase(X.begin(), X.end() - max_size);
+	Y.erase(Y.begin(), Y.end() - max_size);
+	// Fit from scratch.
+	Eigen::MatrixXd K(max_size, max_size), R(max_size, 2);
+	Eigen::VectorXd mean(Eigen::VectorXd::Zero(2)), sigma(2);
+	for(unsigned int i = 0; i < max_size; i++){
+		for(unsigned int j = 0; j < max_size; j++){
+			double d2 = 0;
+			for(unsigned int k = 0; k < dim; k++){
+				d2 += (X[i][k] - X[j][k]) * (X[i][k] - X[j][k]);
+			}
+			K(i, j) = std::exp(-d2 / (2 * l * l)) + (i == j ? nugget : 0);
+		}
+		mean(0) += Y[i][0] / max_size;
+		mean(1) += Y[i][1] / max_size;
+	}
+	for(unsigned int o = 0; o < 2; o++){
+		double var = 0;
+		for(unsigned int i = 0; i < max_size; i++){
+			R(i, o) = Y[i][o] - mean(o);
+			var += R(i, o) * R(i, o) / (max_size - 1);
+		}
+		sigma(o) = std::sqrt(var);
+	}
+	const Eigen::LLT<Eigen::MatrixXd> llt(K);
+	const Eigen::MatrixXd alpha = llt.solve(R);
+	for(int t = 0; t < 20; t++){
+		std::vector<double> x(dim), m, s;
+		for(unsigned int j = 0; j < dim; j++){
+			x[j] = drng();
+		}
+		gp.predict(m, s, x);
+		Eigen::VectorXd k(max_size);
+		for(unsigned int i = 0; i < max_size; i++){
+			double d2 = 0;
+			for(unsigned int j = 0; j < dim; j++){
+				d2 += (X[i][j] - x[j]) * (X[i][j] - x[j]);
+			}
+			k(i) = std::exp(-d2 / (2 * l * l));
+		}
+		const double s0 = std::sqrt(std::max(0., 1 + nugget - k.dot(llt.solve(k))));
+		for(unsigned int o = 0; o < 2; o++){
+			if(std::fabs(m[o] - (mean(o) + alpha.col(o).dot(k))) > 1e-8 || std::fabs(s[o] - s0 * sigma(o)) > 1e-6){
+				std::cout << "FAILED (prediction)" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// A discarded sample must leave a full model untouched.
+int test_duplicate()
+{
+	std::cout << "Testing discarded samples: ";
+	const unsigned int dim = 2, max_size = 10;
+	util::gaussian_process gp(dim, 1, max_size);
+	rng_double drng(5);
+	std::vector<double> x(dim), y(1);
+	for(unsigned int k = 0; k < max_size; k++){
+		for(unsigned int j = 0; j < dim; j++){
+			x[j] = drng();
+		}
+		y[0] = x[0] - x[1];
+		gp.add(x, y);
+	}
+	std::vector<std::vector<double> > probes(20, std::vector<double>(dim));
+	std::vector<double> before, m, s;
+	for(unsigned int t = 0; t < probes.size(); t++){
+		for(unsigned int j = 0; j < dim; j++){
+			probes[t][j] = drng();
+		}
+		gp.predict(m, s, probes[t]);
+		before.push_back(m[0]);
+		before.push_back(s[0]);
+	}
+	const unsigned int size = gp.size();
+	if(size != max_size || gp.add(x, y)){
+		std::cout << "FAILED (duplicate accepted)" << std::endl;
+		return 1;
+	}
+	for(unsigned int t = 0; t < probes.size(); t++){
+		gp.predict(m, s, probes[t]);
+		if(gp.size() != size || m[0] != before[2 * t] || s[0] != before[2 * t + 1]){
+			std::cout << "FAILED (model changed)" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Pre-screening must favour the good candidates, and the evaluations must be counted.
+int test_pre_screen()
+{
+	std::cout << "Testing pre-screening: ";
+	const problem::dejong original(5);
+	population pop(problem::surrogate(original), 60, 42);
+	const problem::surrogate &prob = dynamic_cast<const problem::surrogate &>(pop.problem());
+	if(prob.get_true_evaluations() != 60 || prob.get_n_samples() != 60){
+		std::cout << "FAILED (training)" << std::endl;
+		return 1;
+	}
+	rng_double drng(7);
+	std::vector<decision_vector> candidates(100, decision_vector(5));
+	double mean_all = 0;
+	fitness_vector f(1);
+	for(unsigned int i = 0; i < candidates.size(); i++){
+		for(unsigned int j = 0; j < 5; j++){
+			candidates[i][j] = boost::uniform_real<double>(original.get_lb()[j], original.get_ub()[j])(drng);
+		}
+		original.objfun(f, candidates[i]);
+		mean_all += f[0] / candidates.size();
+	}
+	const std::vector<population::size_type> selected = prob.pre_screen(candidates, 10);
+	double mean_selected = 0;
+	for(unsigned int i = 0; i < selected.size(); i++){
+		original.objfun(f, candidates[selected[i]]);
+		mean_selected += f[0] / selected.size();
+	}
+	if(selected.size() != 10 || !(mean_selected < 0.5 * mean_all) || prob.get_surrogate_evaluations() != 100 ||
+		prob.get_true_evaluations() != 60){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Adds samples to, or predicts with, a surrogate shared among threads.
+struct shared_surrogate_task
+{
+	shared_surrogate_task(const problem::surrogate &prob, const std::vector<decision_vector> &x, const std::vector<fitness_vector> &f):
+		m_prob(prob), m_x(x), m_f(f) {}
+	void operator()(std::size_t i, unsigned int)
+	{
+		if(i % 2){
+			fitness_vector mean, stddev;
+			m_prob.predict(mean, stddev, m_x[i]);
+		} else {
+			m_prob.add_sample(m_x[i], m_f[i]);
+		}
+	}
+	const problem::surrogate &m_prob;
+	const std::vector<decision_vector> &m_x;
+	const std::vector<fitness_vector> &m_f;
+};
+
+// The same surrogate can be trained and queried concurrently. The samples are few enough for none of them to be
+// discarded as too close to the others, which would depend on the order of the additions.
+int test_concurrent()
+{
+	std::cout << "Testing concurrent use: ";
+	const problem::dejong original(3);
+	const problem::surrogate prob(original), serial(original);
+	rng_double drng(11);
+	std::vector<decision_vector> x(120, decision_vector(3));
+	std::vector<fitness_vector> f(x.size(), fitness_vector(1));
+	for(unsigned int i = 0; i < x.size(); i++){
+		for(unsigned int j = 0; j < 3; j++){
+			x[i][j] = boost::uniform_real<double>(original.get_lb()[j], original.get_ub()[j])(drng);
+		}
+		original.objfun(f[i], x[i]);
+	}
+	shared_surrogate_task task(prob, x, f);
+	util::parallel::for_each_index(x.size(), 4, task);
+	for(unsigned int i = 0; i < x.size(); i += 2){
+		serial.add_sample(x[i], f[i]);
+	}
+	if(prob.get_n_samples() != serial.get_n_samples() || serial.get_n_samples() != x.size() / 2 ||
+		prob.get_surrogate_evaluations() != x.size() / 2){
+		std::cout << "FAILED (counters)" << std::endl;
+		return 1;
+	}
+	fitness_vector mean, stddev, mean_serial, stddev_serial;
+	for(unsigned int i = 1; i < x.size(); i += 2){
+		prob.predict(mean, stddev, x[i]);
+		serial.predict(mean_serial, stddev_serial, x[i]);
+		if(std::fabs(mean[0] - mean_serial[0]) > 1e-6 * std::max(1.0, std::fabs(mean_serial[0]))){
+			std::cout << "FAILED (predictions)" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_incremental() || test_duplicate() || test_pre_screen() || test_concurrent();
+}
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2013 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *   http://apps.sourceforge.net/mediawiki/pagmo                             *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Developers  *
+ *   http://apps.sourceforge.net/mediawiki/pagmo/index.php?title=Credits     *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test code for the topologies
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "../src/pagmo.h"
+
+using namespace pagmo;
+
+typedef topology::base::vertices_size_type v_size;
+
+// The neighbour ranges must match the graph, and the graph must be undirected.
+bool check_ranges(const topology::base &t)
+{
+	topology::base::edges_size_type n_edges = 0;
+	for(v_size i = 0; i < t.get_number_of_vertices(); i++){
+		const topology::base::vertices_range adj = t.get_adjacent_range(i), inv_adj = t.get_inv_adjacent_range(i);
+		if(static_cast<topology::base::edges_size_type>(adj.second - adj.first) != t.get_num_adjacent_vertices(i) ||
+			static_cast<topology::base::edges_size_type>(inv_adj.second - inv_adj.first) != t.get_num_inv_adjacent_vertices(i)){
+			return false;
+		}
+		for(const v_size *j = adj.first; j != adj.second; j++){
+			if(!t.are_adjacent(i, *j) || !t.are_adjacent(*j, i)){
+				return false;
+			}
+		}
+		for(const v_size *j = inv_adj.first; j != inv_adj.second; j++){
+			if(!t.are_inv_adjacent(i, *j)){
+				return false;
+			}
+		}
+		n_edges += adj.second - adj.first;
+	}
+	return n_edges == t.get_number_of_edges();
+}
+
+// The snapshot must follow the changes in the topology.
+int test_snapshot()
+{
+	std::cout << "Testing snapshot: ";
+	topology::ring t;
+	for(int i = 0; i < 5; i++){
+		t.push_back();
+	}
+	const bool before = check_ranges(t) && t.get_adjacent_range(4).second - t.get_adjacent_range(4).first == 2;
+	t.push_back();
+	const std::vector<v_size> adj = t.get_v_adjacent_vertices(5);
+	if(!before || !check_ranges(t) || adj.size() != 2 || t.get_num_adjacent_vertices(0) != 2){
+		std::cout << "FAILED" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+// Barabasi-Albert: every vertex after the kernel must bring m edges, and large topologies must build quickly.
+int test_barabasi_albert()
+{
+	std::cout << "Testing Barabasi-Albert: ";
+	topology::barabasi_albert t(3, 2);
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	for(int i = 0; i < 50000; i++){
+		t.push_back();
+	}
+	const long elapsed = (boost::posix_time::microsec_clock::local_time() - start).total_milliseconds();
+	bool ok = check_ranges(t);
+	for(v_size i = 3; i < t.get_number_of_vertices() && ok; i++){
+		ok = t.get_num_adjacent_vertices(i) >= 2;
+	}
+	// Scale-free: the hubs must be much more connected than the average.
+	topology::base::edges_size_type max_degree = 0;
+	for(v_size i = 0; i < t.get_number_of_vertices(); i++){
+		max_degree = std::max(max_degree, t.get_num_adjacent_vertices(i));
+	}
+	if(!ok || max_degree < 50 || elapsed > 30000){
+		std::cout << "FAILED (" << elapsed << " ms, max degree " << max_degree << ")" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED (" << elapsed << " ms)" << std::endl;
+	return 0;
+}
+
+// Erdos-Renyi: the number of edges must match the model.
+int test_erdos_renyi()
+{
+	std::cout << "Testing Erdos-Renyi: ";
+	const v_size n = 3000;
+	const double p = 0.01;
+	topology::erdos_renyi t(p), t_full(1), t_empty(0);
+	for(v_size i = 0; i < n; i++){
+		t.push_back();
+	}
+	for(v_size i = 0; i < 20; i++){
+		t_full.push_back();
+		t_empty.push_back();
+	}
+	// Each undirected link is a pair of edges.
+	const double links = t.get_number_of_edges() / 2., mean = n * (n - 1) / 2. * p, sigma = std::sqrt(mean * (1 - p));
+	if(!check_ranges(t) || std::fabs(links - mean) > 5 * sigma || t_full.get_number_of_edges() != 20 * 19 ||
+		t_empty.get_number_of_edges() != 0 || !check_ranges(t_full)){
+		std::cout << "FAILED (" << links << " links, expected " << mean << ")" << std::endl;
+		return 1;
+	}
+	std::cout << "PASSED" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_snapshot() +
+		test_barabasi_albert() +
+		test_erdos_renyi();
+}